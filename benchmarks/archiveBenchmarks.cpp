@@ -0,0 +1,122 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <gegelati.h>
+
+#include "benchmarkEnvironment.h"
+
+/**
+ * Recording of Program results in a full Archive, with new data at each
+ * recording.
+ *
+ * Arguments: size of the Archive.
+ */
+static void BM_ArchiveAddRecording(benchmark::State& state)
+{
+    const size_t archiveSize = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv(8);
+    Mutator::RNG rng(0);
+    Program::Program program(*benchEnv.env);
+    BenchmarkEnvironment::fillProgram(program, 8, rng);
+
+    Data::PrimitiveTypeArray<double>& data =
+        (Data::PrimitiveTypeArray<double>&)benchEnv.dataSources.at(0).get();
+    Archive archive(archiveSize);
+    double value = 0.0;
+
+    // Fill the archive
+    for (size_t idx = 0; idx < archiveSize; idx++) {
+        data.setDataAt(typeid(double), idx % data.getLargestAddressSpace(),
+                       value++);
+        archive.addRecording(&program, benchEnv.dataSources, value);
+    }
+
+    for (auto _ : state) {
+        data.setDataAt(typeid(double),
+                       (size_t)value % data.getLargestAddressSpace(), value);
+        archive.addRecording(&program, benchEnv.dataSources, value);
+        value++;
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_ArchiveAddRecording)->Arg(50)->Arg(500)->Arg(5000)->ArgNames(
+    {"archive"});
+
+/**
+ * Neutrality check of a Program against an Archive whose large data sources
+ * change by a single element between recordings, as observations of most
+ * LearningEnvironment do between consecutive actions.
+ *
+ * Arguments: size of the Archive, whether delta snapshots are stored.
+ */
+static void BM_ArchiveNeutralityCheck(benchmark::State& state)
+{
+    const size_t archiveSize = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv(8, 4096);
+    Mutator::RNG rng(0);
+    Program::Program program(*benchEnv.env);
+    BenchmarkEnvironment::fillProgram(program, 8, rng);
+
+    Data::PrimitiveTypeArray<double>& data =
+        (Data::PrimitiveTypeArray<double>&)benchEnv.dataSources.at(0).get();
+    Archive archive(archiveSize, 1.0, 0, state.range(1) != 0);
+    for (size_t idx = 0; idx < archiveSize; idx++) {
+        data.setDataAt(typeid(double), (idx * 67) % 4096, (double)idx);
+        archive.addRecording(&program, benchEnv.dataSources, (double)idx);
+    }
+
+    Program::ProgramExecutionEngine pee(program);
+    for (auto _ : state) {
+        std::map<size_t, double> hashesAndResults;
+        archive.forEachDataHandlers(
+            [&pee, &hashesAndResults](
+                size_t hash,
+                const std::vector<std::reference_wrapper<
+                    const Data::DataHandler>>& dataHandlers) {
+                pee.setDataSources(dataHandlers);
+                hashesAndResults.insert({hash, pee.executeProgram()});
+            });
+        benchmark::DoNotOptimize(
+            archive.areProgramResultsUnique(hashesAndResults));
+    }
+    state.SetItemsProcessed((int64_t)(state.iterations() * archiveSize));
+}
+BENCHMARK(BM_ArchiveNeutralityCheck)
+    ->Args({500, 0})
+    ->Args({500, 1})
+    ->ArgNames({"archive", "deltas"});
@@ -0,0 +1,177 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef BENCHMARK_ENVIRONMENT_H
+#define BENCHMARK_ENVIRONMENT_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <gegelati.h>
+
+/**
+ * \brief Environment shared by the GEGELATI microbenchmarks.
+ *
+ * The BenchmarkEnvironment owns the Instructions::Set, the data sources and
+ * the Environment used to build Programs and TPGGraphs in the benchmarks, so
+ * that their lifetime is guaranteed during a whole benchmark.
+ *
+ * The Instructions::Set contains scalar instructions on doubles and an
+ * instruction whose operands are arrays of two doubles. Two
+ * PrimitiveTypeArray<double> data sources, whose size is given at
+ * construction, are filled with pseudo-random values.
+ */
+class BenchmarkEnvironment
+{
+  protected:
+    /// Instructions referenced by the Instructions::Set.
+    std::vector<std::unique_ptr<Instructions::Instruction>> instructions;
+
+    /// Data sources referenced by the Environment.
+    std::vector<std::unique_ptr<Data::PrimitiveTypeArray<double>>> arrays;
+
+  public:
+    /// Instructions::Set of the Environment.
+    Instructions::Set set;
+
+    /// References to the data sources.
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataSources;
+
+    /// Environment built from the set and data sources.
+    std::unique_ptr<Environment> env;
+
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] nbRegisters the number of registers of Programs.
+     * \param[in] dataSize the number of elements of each data source.
+     * \param[in] nbConstants the number of constants of Programs.
+     */
+    BenchmarkEnvironment(size_t nbRegisters, size_t dataSize = 32,
+                         size_t nbConstants = 4)
+    {
+        this->instructions.emplace_back(
+            new Instructions::AddPrimitiveType<double>());
+        this->instructions.emplace_back(
+            new Instructions::MultByConstant<double>());
+        this->instructions.emplace_back(
+            new Instructions::LambdaInstruction<double, double>(
+                [](double a, double b) { return a - b; }));
+        this->instructions.emplace_back(
+            new Instructions::LambdaInstruction<const double[2],
+                                                const double[2]>(
+                [](const double a[2], const double b[2]) {
+                    return a[0] * b[0] + a[1] * b[1];
+                }));
+        for (const auto& instruction : this->instructions) {
+            this->set.add(*instruction);
+        }
+
+        Mutator::RNG rng(0);
+        for (size_t idx = 0; idx < 2; idx++) {
+            this->arrays.emplace_back(
+                new Data::PrimitiveTypeArray<double>(dataSize));
+            for (size_t addr = 0; addr < dataSize; addr++) {
+                this->arrays.back()->setDataAt(typeid(double), addr,
+                                               rng.getDouble(-10.0, 10.0));
+            }
+            this->dataSources.push_back(*this->arrays.back());
+        }
+
+        this->env = std::make_unique<Environment>(
+            this->set, this->dataSources, nbRegisters, nbConstants);
+    }
+
+    /**
+     * \brief Fill the given Program with the given number of random Lines.
+     *
+     * None of the Lines is an intron, so that the executed work is
+     * proportional to the number of Lines. Lines are drawn at the beginning
+     * of the Program, which does not change the intron status of the next
+     * Lines, and a Line is kept only if it is not an intron and reads a
+     * register, which ensures that a register is still useful for the next
+     * drawn Line.
+     *
+     * \param[in,out] program the Program to fill.
+     * \param[in] nbLines the number of Lines of the Program.
+     * \param[in] rng the RNG used to draw the Lines.
+     */
+    static void fillProgram(Program::Program& program, size_t nbLines,
+                            Mutator::RNG& rng)
+    {
+        const Instructions::Set& set =
+            program.getEnvironment().getInstructionSet();
+        while (program.getNbLines() < nbLines) {
+            Program::Line& line = program.addNewLine(0);
+            Mutator::LineMutator::initRandomCorrectLine(line, rng);
+            program.identifyIntrons();
+
+            bool readsRegister = false;
+            const Instructions::Instruction& instruction =
+                set.getInstruction(line.getInstructionIndex());
+            for (uint64_t idx = 0; idx < instruction.getNbOperands(); idx++) {
+                readsRegister |= (line.getOperand(idx).first == 0);
+            }
+            if (program.isIntron(0) || !readsRegister) {
+                program.removeLine(0);
+            }
+        }
+        program.identifyIntrons();
+    }
+
+    /**
+     * \brief Default MutationParameters for the benchmarks.
+     *
+     * \param[in] nbActions the number of actions of TPGGraphs.
+     * \param[in] maxProgramSize the maximum number of Lines of Programs.
+     */
+    static Mutator::MutationParameters getMutationParameters(
+        size_t nbActions, size_t maxProgramSize)
+    {
+        Mutator::MutationParameters params;
+        params.tpg.nbActions = nbActions;
+        params.tpg.nbRoots = nbActions;
+        params.tpg.maxInitOutgoingEdges = 3;
+        params.tpg.maxOutgoingEdges = 5;
+        params.prog.maxProgramSize = maxProgramSize;
+        params.prog.minConstValue = -10;
+        params.prog.maxConstValue = 10;
+        return params;
+    }
+};
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <gegelati.h>
+
+/**
+ * Access to all valid addresses of an ArrayWrapper<double> for an operand
+ * type of the given width.
+ */
+template <size_t WIDTH>
+static void accessAllAddresses(benchmark::State& state,
+                               const Data::ArrayWrapper<double>& wrapper)
+{
+    typedef typename std::conditional<WIDTH == 1, double, double[WIDTH]>::type
+        OperandType;
+    typedef typename std::conditional<WIDTH == 1, const double,
+                                      const double[]>::type PointerType;
+    const size_t nbAddresses = wrapper.getAddressSpace(typeid(OperandType));
+    for (auto _ : state) {
+        for (size_t addr = 0; addr < nbAddresses; addr++) {
+            benchmark::DoNotOptimize(wrapper.getDataAt(typeid(OperandType), addr)
+                                         .getSharedPointer<PointerType>()
+                                         .get());
+        }
+    }
+    state.SetItemsProcessed((int64_t)(state.iterations() * nbAddresses));
+}
+
+/**
+ * Access to the data of an ArrayWrapper<double>.
+ *
+ * Arguments: number of elements of the ArrayWrapper, width of the accessed
+ * operand type (1 for double, N for double[N]).
+ */
+static void BM_ArrayWrapperGetDataAt(benchmark::State& state)
+{
+    const size_t size = (size_t)state.range(0);
+    std::vector<double> values(size);
+    for (size_t idx = 0; idx < size; idx++) {
+        values.at(idx) = (double)idx;
+    }
+    Data::ArrayWrapper<double> wrapper(size, &values);
+
+    switch (state.range(1)) {
+    case 1:
+        accessAllAddresses<1>(state, wrapper);
+        break;
+    case 2:
+        accessAllAddresses<2>(state, wrapper);
+        break;
+    case 4:
+        accessAllAddresses<4>(state, wrapper);
+        break;
+    case 8:
+        accessAllAddresses<8>(state, wrapper);
+        break;
+    default:
+        throw std::runtime_error("Unsupported operand width.");
+    }
+}
+BENCHMARK(BM_ArrayWrapperGetDataAt)
+    ->ArgsProduct({{64, 1024}, {1, 2, 4, 8}})
+    ->ArgNames({"size", "width"});
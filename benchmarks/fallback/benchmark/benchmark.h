@@ -0,0 +1,527 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef GEGELATI_BENCHMARK_FALLBACK_H
+#define GEGELATI_BENCHMARK_FALLBACK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Minimal subset of the Google Benchmark API.
+ *
+ * This header is used to build the GEGELATI benchmarks when Google Benchmark
+ * is not available. It supports the features used by the benchmarks (State
+ * loops, ranges, items processed, argument lists and names) and the
+ * --benchmark_filter, --benchmark_min_time, --benchmark_out and
+ * --benchmark_out_format=json command line options.
+ *
+ * The JSON files produced by this harness follow the layout of Google
+ * Benchmark files, so that they can be compared with the same scripts.
+ */
+namespace benchmark {
+
+    /// Prevent the compiler from optimizing away the given value.
+    template <class T> inline void DoNotOptimize(T const& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /// Prevent the compiler from reordering memory accesses.
+    inline void ClobberMemory()
+    {
+        std::atomic_signal_fence(std::memory_order_acq_rel);
+    }
+
+    class State;
+
+    namespace internal {
+        /// Clock used for real time measurements.
+        typedef std::chrono::steady_clock Clock;
+
+        /// Iterator of the State loop.
+        class StateIterator
+        {
+          protected:
+            /// State whose iterations are counted.
+            State* state;
+
+            /// Number of iterations left.
+            uint64_t remaining;
+
+          public:
+            /// Value returned when dereferencing the iterator.
+            struct Value
+            {
+            };
+
+            /// Constructor.
+            StateIterator(State* state, uint64_t remaining)
+                : state{state}, remaining{remaining}
+            {
+            }
+
+            /// Dereference operator.
+            Value operator*() const
+            {
+                return Value();
+            }
+
+            /// Increment operator.
+            StateIterator& operator++()
+            {
+                this->remaining--;
+                return *this;
+            }
+
+            /// Stops the timer of the State when the last iteration ends.
+            inline bool operator!=(const StateIterator&);
+        };
+    } // namespace internal
+
+    /// State of a running benchmark.
+    class State
+    {
+      protected:
+        /// Arguments of the benchmark.
+        const std::vector<int64_t> args;
+
+        /// Number of iterations to run.
+        const uint64_t maxIterations;
+
+        /// Start of the measured real time.
+        internal::Clock::time_point startReal;
+
+        /// Start of the measured processor time.
+        std::clock_t startCPU;
+
+        /// Measured real time, in seconds.
+        double realTime = 0.0;
+
+        /// Measured processor time, in seconds.
+        double cpuTime = 0.0;
+
+        /// Number of items processed, if set by the benchmark.
+        int64_t itemsProcessed = -1;
+
+        friend class internal::StateIterator;
+
+      public:
+        /// Constructor.
+        State(const std::vector<int64_t>& args, uint64_t maxIterations)
+            : args{args}, maxIterations{maxIterations}, startCPU{0}
+        {
+        }
+
+        /// Get the argument at the given index.
+        int64_t range(size_t idx = 0) const
+        {
+            return this->args.at(idx);
+        }
+
+        /// Number of iterations run by the State loop.
+        uint64_t iterations() const
+        {
+            return this->maxIterations;
+        }
+
+        /// Set the number of items processed by all iterations.
+        void SetItemsProcessed(int64_t items)
+        {
+            this->itemsProcessed = items;
+        }
+
+        /// Get the number of items processed, or -1 if not set.
+        int64_t getItemsProcessed() const
+        {
+            return this->itemsProcessed;
+        }
+
+        /// Get the measured real time, in seconds.
+        double getRealTime() const
+        {
+            return this->realTime;
+        }
+
+        /// Get the measured processor time, in seconds.
+        double getCPUTime() const
+        {
+            return this->cpuTime;
+        }
+
+        /// Starts the timers and the State loop.
+        internal::StateIterator begin()
+        {
+            this->startCPU = std::clock();
+            this->startReal = internal::Clock::now();
+            return internal::StateIterator(this, this->maxIterations);
+        }
+
+        /// End of the State loop.
+        internal::StateIterator end()
+        {
+            return internal::StateIterator(this, 0);
+        }
+    };
+
+    inline bool internal::StateIterator::operator!=(const StateIterator&)
+    {
+        if (this->remaining != 0) {
+            return true;
+        }
+        this->state->realTime =
+            std::chrono::duration<double>(Clock::now() - this->state->startReal)
+                .count();
+        this->state->cpuTime =
+            (double)(std::clock() - this->state->startCPU) / CLOCKS_PER_SEC;
+        return false;
+    }
+
+    namespace internal {
+        /// Registered benchmark function and its argument lists.
+        class Benchmark
+        {
+          protected:
+            /// Name of the benchmark.
+            const std::string name;
+
+            /// Function running the benchmark.
+            const std::function<void(State&)> function;
+
+            /// List of arguments for which the benchmark is run.
+            std::vector<std::vector<int64_t>> argsList;
+
+            /// Names of the arguments.
+            std::vector<std::string> argNames;
+
+          public:
+            /// Constructor.
+            Benchmark(const std::string& name,
+                      std::function<void(State&)> function)
+                : name{name}, function{function}
+            {
+            }
+
+            /// Run the benchmark with the given single argument.
+            Benchmark* Arg(int64_t arg)
+            {
+                this->argsList.push_back({arg});
+                return this;
+            }
+
+            /// Run the benchmark with the given arguments.
+            Benchmark* Args(const std::vector<int64_t>& args)
+            {
+                this->argsList.push_back(args);
+                return this;
+            }
+
+            /// Run the benchmark with the cartesian product of arguments,
+            /// the first argument varying fastest as in Google Benchmark.
+            Benchmark* ArgsProduct(
+                const std::vector<std::vector<int64_t>>& argLists)
+            {
+                std::vector<size_t> indexes(argLists.size(), 0);
+                while (true) {
+                    std::vector<int64_t> args;
+                    for (size_t idx = 0; idx < argLists.size(); idx++) {
+                        args.push_back(argLists.at(idx).at(indexes.at(idx)));
+                    }
+                    this->argsList.push_back(args);
+
+                    // Increment indexes, first one first.
+                    size_t idx = 0;
+                    while (idx < argLists.size() &&
+                           ++indexes.at(idx) == argLists.at(idx).size()) {
+                        indexes.at(idx) = 0;
+                        idx++;
+                    }
+                    if (idx == argLists.size()) {
+                        return this;
+                    }
+                }
+            }
+
+            /// Set the names of the arguments.
+            Benchmark* ArgNames(const std::vector<std::string>& names)
+            {
+                this->argNames = names;
+                return this;
+            }
+
+            /// Get the names of the runs of this benchmark, one per argument
+            /// list, formatted as in Google Benchmark.
+            std::vector<std::string> getRunNames() const
+            {
+                std::vector<std::string> result;
+                if (this->argsList.empty()) {
+                    result.push_back(this->name);
+                }
+                for (const std::vector<int64_t>& args : this->argsList) {
+                    std::stringstream runName;
+                    runName << this->name;
+                    for (size_t idx = 0; idx < args.size(); idx++) {
+                        runName << "/";
+                        if (idx < this->argNames.size() &&
+                            !this->argNames.at(idx).empty()) {
+                            runName << this->argNames.at(idx) << ":";
+                        }
+                        runName << args.at(idx);
+                    }
+                    result.push_back(runName.str());
+                }
+                return result;
+            }
+
+            /// Get the argument lists of this benchmark.
+            std::vector<std::vector<int64_t>> getArgsList() const
+            {
+                if (this->argsList.empty()) {
+                    return {{}};
+                }
+                return this->argsList;
+            }
+
+            /// Run the benchmark function on the given State.
+            void run(State& state) const
+            {
+                this->function(state);
+            }
+        };
+
+        /// Get the list of registered benchmarks.
+        inline std::vector<std::unique_ptr<Benchmark>>& getRegistry()
+        {
+            static std::vector<std::unique_ptr<Benchmark>> registry;
+            return registry;
+        }
+
+        /// Command line options of the harness.
+        struct Options
+        {
+            /// Regex selecting the benchmarks to run.
+            std::string filter = ".";
+
+            /// Minimum time of the measured run, in seconds.
+            double minTime = 0.5;
+
+            /// Path of the JSON file produced, if any.
+            std::string out;
+        };
+
+        /// Get the command line options of the harness.
+        inline Options& getOptions()
+        {
+            static Options options;
+            return options;
+        }
+
+        /// Escape a string for JSON output.
+        inline std::string escapeJSON(const std::string& str)
+        {
+            std::string result;
+            for (char c : str) {
+                if (c == '"' || c == '\\') {
+                    result += '\\';
+                }
+                result += c;
+            }
+            return result;
+        }
+    } // namespace internal
+
+    /// Register a benchmark function.
+    inline internal::Benchmark* RegisterBenchmark(
+        const std::string& name, std::function<void(State&)> function)
+    {
+        internal::getRegistry().push_back(
+            std::make_unique<internal::Benchmark>(name, function));
+        return internal::getRegistry().back().get();
+    }
+
+    /// Parse the command line options.
+    inline void Initialize(int* argc, char** argv)
+    {
+        internal::Options& options = internal::getOptions();
+        for (int idx = 1; idx < *argc; idx++) {
+            std::string arg(argv[idx]);
+            std::string value = arg.substr(arg.find('=') + 1);
+            if (arg.rfind("--benchmark_filter=", 0) == 0) {
+                options.filter = value;
+            }
+            else if (arg.rfind("--benchmark_min_time=", 0) == 0) {
+                if (!value.empty() && value.back() == 's') {
+                    value.pop_back();
+                }
+                options.minTime = std::stod(value);
+            }
+            else if (arg.rfind("--benchmark_out=", 0) == 0) {
+                options.out = value;
+            }
+            else if (arg.rfind("--benchmark_out_format=", 0) == 0) {
+                if (value != "json") {
+                    std::cerr << "Only the json output format is supported."
+                              << std::endl;
+                }
+            }
+            else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+            }
+        }
+    }
+
+    /// Run the benchmarks selected by the command line options.
+    inline size_t RunSpecifiedBenchmarks()
+    {
+        const internal::Options& options = internal::getOptions();
+        const std::regex filter(options.filter);
+        std::stringstream json;
+        size_t nbRuns = 0;
+
+        std::cout << std::left << std::setw(60) << "Benchmark" << std::right
+                  << std::setw(15) << "Time" << std::setw(15) << "CPU"
+                  << std::setw(12) << "Iterations" << std::endl;
+
+        for (const auto& bench : internal::getRegistry()) {
+            const std::vector<std::string> runNames = bench->getRunNames();
+            const std::vector<std::vector<int64_t>> argsList =
+                bench->getArgsList();
+            for (size_t runIdx = 0; runIdx < runNames.size(); runIdx++) {
+                const std::string& runName = runNames.at(runIdx);
+                if (!std::regex_search(runName, filter)) {
+                    continue;
+                }
+
+                // Double the number of iterations until the minimum time
+                // is reached.
+                uint64_t nbIterations = 1;
+                while (true) {
+                    State state(argsList.at(runIdx), nbIterations);
+                    bench->run(state);
+                    if (state.getRealTime() >= options.minTime ||
+                        nbIterations >= (uint64_t)1e9) {
+                        double realNs =
+                            state.getRealTime() * 1e9 / (double)nbIterations;
+                        double cpuNs =
+                            state.getCPUTime() * 1e9 / (double)nbIterations;
+                        std::cout << std::left << std::setw(60) << runName
+                                  << std::right << std::fixed
+                                  << std::setprecision(0) << std::setw(12)
+                                  << realNs << " ns" << std::setw(12) << cpuNs
+                                  << " ns" << std::setw(12) << nbIterations
+                                  << std::endl;
+
+                        json << ((nbRuns == 0) ? "\n" : ",\n") << "    {\n"
+                             << "      \"name\": \""
+                             << internal::escapeJSON(runName) << "\",\n"
+                             << "      \"run_name\": \""
+                             << internal::escapeJSON(runName) << "\",\n"
+                             << "      \"run_type\": \"iteration\",\n"
+                             << "      \"iterations\": " << nbIterations
+                             << ",\n"
+                             << std::setprecision(6) << std::scientific
+                             << "      \"real_time\": " << realNs << ",\n"
+                             << "      \"cpu_time\": " << cpuNs << ",\n"
+                             << "      \"time_unit\": \"ns\"";
+                        if (state.getItemsProcessed() >= 0 &&
+                            state.getCPUTime() > 0.0) {
+                            json << ",\n      \"items_per_second\": "
+                                 << (double)state.getItemsProcessed() /
+                                        state.getCPUTime();
+                        }
+                        json << "\n    }";
+                        nbRuns++;
+                        break;
+                    }
+                    nbIterations *= 2;
+                }
+            }
+        }
+
+        if (!options.out.empty()) {
+            std::time_t now = std::time(nullptr);
+            char date[64];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S",
+                          std::localtime(&now));
+            std::ofstream file(options.out);
+            file << "{\n  \"context\": {\n"
+                 << "    \"date\": \"" << date << "\",\n"
+                 << "    \"library_build_type\": \"fallback\"\n"
+                 << "  },\n  \"benchmarks\": [" << json.str() << "\n  ]\n}\n";
+        }
+
+        return nbRuns;
+    }
+} // namespace benchmark
+
+#define BENCHMARK_PRIVATE_CONCAT2(a, b) a##b
+#define BENCHMARK_PRIVATE_CONCAT(a, b) BENCHMARK_PRIVATE_CONCAT2(a, b)
+
+/// Register a benchmark function.
+#define BENCHMARK(fn)                                                          \
+    static ::benchmark::internal::Benchmark* BENCHMARK_PRIVATE_CONCAT(         \
+        benchmark_registration_, __LINE__) =                                   \
+        ::benchmark::RegisterBenchmark(#fn, fn)
+
+/// Define a main function running the selected benchmarks.
+#define BENCHMARK_MAIN()                                                       \
+    int main(int argc, char** argv)                                            \
+    {                                                                          \
+        ::benchmark::Initialize(&argc, argv);                                  \
+        ::benchmark::RunSpecifiedBenchmarks();                                 \
+        return 0;                                                              \
+    }                                                                          \
+    int main(int, char**)
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <gegelati.h>
+
+#include "benchmarkEnvironment.h"
+
+/**
+ * Execution of a random Program.
+ *
+ * Arguments: number of Lines of the Program, number of registers.
+ */
+static void BM_ProgramExecutionEngine(benchmark::State& state)
+{
+    const size_t nbLines = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv((size_t)state.range(1));
+    Mutator::RNG rng(0);
+    Program::Program program(*benchEnv.env);
+    BenchmarkEnvironment::fillProgram(program, nbLines, rng);
+
+    Program::ProgramExecutionEngine engine(program);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.executeProgram());
+    }
+    state.SetItemsProcessed((int64_t)(state.iterations() * nbLines));
+}
+BENCHMARK(BM_ProgramExecutionEngine)
+    ->ArgsProduct({{8, 32, 128}, {4, 8, 16}})
+    ->ArgNames({"lines", "registers"});
+
+/**
+ * Execution of a random Program from its optimized form.
+ *
+ * Arguments: number of Lines of the Program, execution mode (0: optimized
+ * Operations, 1: bytecode, 2: bytecode with all scalar pairs of Instructions
+ * fused into superinstructions).
+ */
+static void BM_ProgramExecutionEngineOptimized(benchmark::State& state)
+{
+    const size_t nbLines = (size_t)state.range(0);
+    const int64_t mode = state.range(1);
+    BenchmarkEnvironment benchEnv(8);
+    if (mode > 0) {
+        auto superinstructions =
+            std::make_shared<Program::SuperinstructionSet>();
+        for (uint64_t first = 0; mode == 2 && first < 3; first++) {
+            for (uint64_t second = 0; second < 3; second++) {
+                superinstructions->add(first, second);
+            }
+        }
+        benchEnv.env->setBytecodeExecution(true, superinstructions);
+    }
+    Mutator::RNG rng(0);
+    Program::Program program(*benchEnv.env);
+    BenchmarkEnvironment::fillProgram(program, nbLines, rng);
+    program.optimize();
+
+    Program::ProgramExecutionEngine engine(program);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.executeProgram());
+    }
+    state.SetItemsProcessed((int64_t)(state.iterations() * nbLines));
+}
+BENCHMARK(BM_ProgramExecutionEngineOptimized)
+    ->ArgsProduct({{8, 32, 128}, {0, 1, 2}})
+    ->ArgNames({"lines", "mode"});
+
+/**
+ * Copy and mutation of a random Program, as done when creating new roots.
+ *
+ * Arguments: number of Lines of the mutated Program, number of registers.
+ */
+static void BM_ProgramMutatorMutateProgram(benchmark::State& state)
+{
+    const size_t nbLines = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv((size_t)state.range(1));
+    Mutator::RNG rng(0);
+    Program::Program program(*benchEnv.env);
+    BenchmarkEnvironment::fillProgram(program, nbLines, rng);
+    const Mutator::MutationParameters params =
+        BenchmarkEnvironment::getMutationParameters(4, 2 * nbLines);
+
+    for (auto _ : state) {
+        Program::Program copy(program);
+        benchmark::DoNotOptimize(
+            Mutator::ProgramMutator::mutateProgram(copy, params, rng));
+    }
+    state.SetItemsProcessed((int64_t)state.iterations());
+}
+BENCHMARK(BM_ProgramMutatorMutateProgram)
+    ->ArgsProduct({{8, 32, 128}, {8}})
+    ->ArgNames({"lines", "registers"});
@@ -0,0 +1,107 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+
+#include <gegelati.h>
+
+#include "benchmarkEnvironment.h"
+
+/**
+ * Execution of all roots of a random TPGGraph.
+ *
+ * Arguments: number of actions (and of initial teams) of the TPGGraph.
+ */
+static void BM_TPGExecutionEngine(benchmark::State& state)
+{
+    const size_t nbActions = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv(8);
+    Mutator::RNG rng(0);
+    TPG::TPGGraph graph(*benchEnv.env);
+    Mutator::TPGMutator::initRandomTPG(
+        graph, BenchmarkEnvironment::getMutationParameters(nbActions, 32),
+        rng);
+    const std::vector<const TPG::TPGVertex*> roots = graph.getRootVertices();
+
+    TPG::TPGExecutionEngine tee(*benchEnv.env);
+    for (auto _ : state) {
+        for (const TPG::TPGVertex* root : roots) {
+            benchmark::DoNotOptimize(tee.executeFromRoot(*root));
+        }
+    }
+    state.SetItemsProcessed((int64_t)(state.iterations() * roots.size()));
+}
+BENCHMARK(BM_TPGExecutionEngine)->Arg(4)->Arg(16)->Arg(64)->ArgNames(
+    {"actions"});
+
+/**
+ * Import of a random TPGGraph from a dot file.
+ *
+ * Arguments: number of actions (and of initial teams) of the TPGGraph.
+ */
+static void BM_TPGGraphDotImporter(benchmark::State& state)
+{
+    const size_t nbActions = (size_t)state.range(0);
+    BenchmarkEnvironment benchEnv(8);
+    Mutator::RNG rng(0);
+    TPG::TPGGraph graph(*benchEnv.env);
+    Mutator::TPGMutator::initRandomTPG(
+        graph, BenchmarkEnvironment::getMutationParameters(nbActions, 32),
+        rng);
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() /
+         ("gegelati_benchmark_" + std::to_string(nbActions) + ".dot"))
+            .string();
+    File::TPGGraphDotExporter(path.c_str(), graph).print();
+
+    TPG::TPGGraph importedGraph(*benchEnv.env);
+    File::TPGGraphDotImporter importer(path.c_str(), *benchEnv.env,
+                                       importedGraph);
+    for (auto _ : state) {
+        importer.importGraph();
+        benchmark::DoNotOptimize(importedGraph.getNbVertices());
+    }
+    state.SetItemsProcessed(
+        (int64_t)(state.iterations() * importedGraph.getNbVertices()));
+
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_TPGGraphDotImporter)->Arg(4)->Arg(16)->Arg(64)->ArgNames(
+    {"actions"});
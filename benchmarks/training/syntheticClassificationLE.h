@@ -0,0 +1,189 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef SYNTHETIC_CLASSIFICATION_LE_H
+#define SYNTHETIC_CLASSIFICATION_LE_H
+
+#include <memory>
+#include <vector>
+
+#include <gegelati.h>
+
+/**
+ * \brief Synthetic ClassificationLearningEnvironment of configurable size.
+ *
+ * The dataset of this LearningEnvironment is made of nbSamples samples of
+ * nbFeatures features each. Samples of each class are drawn around a random
+ * center, with a deterministic RNG, so that the dataset only depends on the
+ * parameters given at construction.
+ *
+ * Each episode presents all samples of the dataset, in an order depending on
+ * the seed given to the reset() method. The dataset is shared between the
+ * clones of the LearningEnvironment.
+ */
+class SyntheticClassificationLE : public Learn::ClassificationLearningEnvironment
+{
+  protected:
+    /// Number of features per sample.
+    const size_t nbFeatures;
+
+    /// Features of all samples, sample after sample.
+    std::shared_ptr<const std::vector<double>> features;
+
+    /// Class of all samples.
+    std::shared_ptr<const std::vector<uint64_t>> classes;
+
+    /// Order in which samples are presented during the current episode.
+    std::vector<size_t> order;
+
+    /// Index, in the order vector, of the current sample.
+    size_t currentSample = 0;
+
+    /// Features of the current sample.
+    Data::PrimitiveTypeArray<double> currentFeatures;
+
+    /// Set the currentFeatures and currentClass from the current sample.
+    void loadCurrentSample()
+    {
+        const size_t sampleIdx =
+            this->order.at(this->currentSample % this->order.size());
+        for (size_t idx = 0; idx < this->nbFeatures; idx++) {
+            this->currentFeatures.setDataAt(
+                typeid(double), idx,
+                this->features->at(sampleIdx * this->nbFeatures + idx));
+        }
+        this->currentClass = this->classes->at(sampleIdx);
+    }
+
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] nbClasses the number of classes of the dataset.
+     * \param[in] nbFeatures the number of features of each sample.
+     * \param[in] nbSamples the number of samples of the dataset.
+     * \param[in] seed the seed used to generate the dataset.
+     */
+    SyntheticClassificationLE(size_t nbClasses, size_t nbFeatures,
+                              size_t nbSamples, size_t seed = 0)
+        : ClassificationLearningEnvironment(nbClasses), nbFeatures{nbFeatures},
+          order(nbSamples), currentFeatures(nbFeatures)
+    {
+        Mutator::RNG rng(seed);
+
+        std::vector<double> centers(nbClasses * nbFeatures);
+        rng.fillDouble(-10.0, 10.0, centers);
+
+        auto newFeatures = std::make_shared<std::vector<double>>();
+        auto newClasses = std::make_shared<std::vector<uint64_t>>();
+        std::vector<double> noise(nbFeatures);
+        for (size_t sample = 0; sample < nbSamples; sample++) {
+            uint64_t sampleClass = sample % nbClasses;
+            rng.fillDouble(-5.0, 5.0, noise);
+            for (size_t idx = 0; idx < nbFeatures; idx++) {
+                newFeatures->push_back(
+                    centers.at(sampleClass * nbFeatures + idx) +
+                    noise.at(idx));
+            }
+            newClasses->push_back(sampleClass);
+        }
+        this->features = newFeatures;
+        this->classes = newClasses;
+
+        this->reset(0);
+    }
+
+    /// Default copy constructor.
+    SyntheticClassificationLE(const SyntheticClassificationLE& other) = default;
+
+    /// Inherited via LearningEnvironment
+    void reset(size_t seed = 0,
+               Learn::LearningMode mode = Learn::LearningMode::TRAINING,
+               uint16_t iterationNumber = 0,
+               uint64_t generationNumber = 0) override
+    {
+        ClassificationLearningEnvironment::reset(seed, mode);
+
+        // Shuffle the samples
+        Mutator::RNG rng(Data::Hash<size_t>()(seed) ^
+                         Data::Hash<Learn::LearningMode>()(mode));
+        for (size_t idx = 0; idx < this->order.size(); idx++) {
+            this->order.at(idx) = idx;
+        }
+        for (size_t idx = this->order.size(); idx > 1; idx--) {
+            std::swap(this->order.at(idx - 1),
+                      this->order.at(rng.getUnsignedInt64(0, idx - 1)));
+        }
+
+        this->currentSample = 0;
+        this->loadCurrentSample();
+    }
+
+    /// Inherited via LearningEnvironment
+    void doAction(uint64_t actionID) override
+    {
+        ClassificationLearningEnvironment::doAction(actionID);
+        this->currentSample++;
+        this->loadCurrentSample();
+    }
+
+    /// Inherited via LearningEnvironment
+    std::vector<std::reference_wrapper<const Data::DataHandler>>
+    getDataSources() override
+    {
+        return {this->currentFeatures};
+    }
+
+    /// Inherited via LearningEnvironment
+    bool isCopyable() const override
+    {
+        return true;
+    }
+
+    /// Inherited via LearningEnvironment
+    Learn::LearningEnvironment* clone() const override
+    {
+        return new SyntheticClassificationLE(*this);
+    }
+
+    /// Inherited via LearningEnvironment
+    bool isTerminal() const override
+    {
+        return this->currentSample >= this->order.size();
+    }
+};
+
+#endif
@@ -0,0 +1,667 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+/**
+ * \file trainingBenchmarks.cpp
+ * \brief End-to-end training throughput and scaling harness.
+ *
+ * This executable trains LearningAgents on reproducible workloads, with a
+ * fixed seed, for a sweep of thread counts. For each run, it reports the
+ * number of generations, episodes, actions and Program executions per
+ * second, the speedup and parallel efficiency with respect to the first
+ * thread count, and checks that the trained TPGGraph is identical for all
+ * thread counts and agents of a workload.
+ *
+ * Usage: runTrainingBenchmarks [--threads=1,2,4] [--generations=5]
+ *        [--roots=60] [--workloads=<regex>] [--classes=4] [--features=16]
+ *        [--samples=200] [--boards=20000] [--bytecode] [--out=<file.json>]
+ *
+ * The executable returns a non-zero exit code if the results of a workload
+ * differ between thread counts or agents.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gegelati.h>
+
+#include "stickGameAdversarial.h"
+#include "stickGameWithOpponent.h"
+
+#include "syntheticClassificationLE.h"
+#include "trainingCounters.h"
+
+/// Command line options of the harness.
+struct Options
+{
+    /// Thread counts of the sweep.
+    std::vector<size_t> threads;
+
+    /// Number of trained generations per run.
+    uint64_t nbGenerations = 5;
+
+    /// Number of roots of the trained TPGGraphs.
+    size_t nbRoots = 60;
+
+    /// Regex selecting the workloads.
+    std::string workloads = ".";
+
+    /// Number of classes of the synthetic classification workload.
+    size_t nbClasses = 4;
+
+    /// Number of features of the synthetic classification workload.
+    size_t nbFeatures = 16;
+
+    /// Number of samples of the synthetic classification workload.
+    size_t nbSamples = 200;
+
+    /// Number of boards of the tic-tac-toe inference workload.
+    size_t nbBoards = 20000;
+
+    /// Whether the tic-tac-toe inference workload uses bytecode execution.
+    bool bytecode = false;
+
+    /// Path of the JSON file produced, if any.
+    std::string out;
+};
+
+/// Measures of a single run.
+struct RunResult
+{
+    /// Name of the workload.
+    std::string workload;
+
+    /// Name of the trained agent.
+    std::string agent;
+
+    /// Number of threads.
+    size_t nbThreads = 1;
+
+    /// Measured time, in seconds.
+    double time = 0.0;
+
+    /// Number of trained generations.
+    uint64_t nbGenerations = 0;
+
+    /// Number of episodes.
+    uint64_t nbEpisodes = 0;
+
+    /// Number of actions.
+    uint64_t nbActions = 0;
+
+    /// Number of Program executions.
+    uint64_t nbProgramExecutions = 0;
+
+    /// Characteristics of the result, compared between thread counts.
+    std::string fingerprint;
+};
+
+/// A workload run for a given number of threads.
+struct Workload
+{
+    /// Name of the workload.
+    std::string name;
+
+    /// Name of the trained agent.
+    std::string agent;
+
+    /// Is the workload run for all thread counts, or with a single thread.
+    bool parallel;
+
+    /// Function running the workload.
+    std::function<RunResult(const Options&, size_t)> run;
+};
+
+/**
+ * \brief Instructions::Set owning its Instruction.
+ */
+class OwningSet
+{
+  protected:
+    /// Instructions referenced by the set.
+    std::vector<std::unique_ptr<Instructions::Instruction>> instructions;
+
+  public:
+    /// Instructions::Set.
+    Instructions::Set set;
+
+    /// Add an Instruction to the set.
+    void add(Instructions::Instruction* instruction)
+    {
+        this->instructions.emplace_back(instruction);
+        this->set.add(*instruction);
+    }
+};
+
+/// Instructions used for the pendulum and classification workloads.
+static void fillArithmeticSet(OwningSet& owningSet)
+{
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a + b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a - b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a * b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return (b != 0.0) ? a / b : DBL_MIN; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return std::max(a, b); }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return std::cos(a); }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return std::sin(a); }));
+}
+
+/// Instructions used for the stick game workloads (see test/codeGen).
+static void fillStickGameSet(OwningSet& owningSet)
+{
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return (b != 0.0) ? fmod(a, b) : DBL_MIN; }));
+    owningSet.add(new Instructions::LambdaInstruction<int, int>(
+        [](int a, int b) { return (double)a - (double)b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a + b; }));
+    owningSet.add(new Instructions::LambdaInstruction<int>(
+        [](int a) { return (double)a; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return std::max(a, b); }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return (a == 0.0) ? 10.0 : 0.0; }));
+}
+
+/// Instructions used by the pre-trained tic-tac-toe TPGGraph (see
+/// test/codeGen).
+static void fillTicTacToeSet(OwningSet& owningSet)
+{
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a - b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a + b; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return std::max(a, b); }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return (b != 0.0) ? fmod(a, b) : DBL_MIN; }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return (a == -1.0) ? 10.0 : 0.0; }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return (a == 0.0) ? 10.0 : 0.0; }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return (a == 1.0) ? 10.0 : 0.0; }));
+    owningSet.add(new Instructions::LambdaInstruction<double>(
+        [](double a) { return (a >= 15.0) ? 10.0 : 0.0; }));
+    owningSet.add(new Instructions::LambdaInstruction<double, double>(
+        [](double a, double b) { return a < b ? -a : a; }));
+}
+
+/// LearningParameters shared by all training workloads.
+static Learn::LearningParameters getParameters(const Options& options,
+                                               size_t nbThreads)
+{
+    Learn::LearningParameters params;
+    params.nbThreads = nbThreads;
+    params.nbRegisters = 8;
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.ratioDeletedRoots = 0.5;
+    params.mutation.tpg.nbRoots = options.nbRoots;
+    params.mutation.tpg.maxInitOutgoingEdges = 3;
+    params.mutation.tpg.maxOutgoingEdges = 5;
+    params.mutation.prog.maxProgramSize = 20;
+    return params;
+}
+
+/**
+ * \brief Train a LearningAgent on a CountingLearningEnvironment.
+ *
+ * \param[in] params the LearningParameters of the LearningAgent.
+ * \param[in] nbGenerations the number of trained generations.
+ * \param[in] makeAgent function building the LearningAgent from the
+ * LearningEnvironment and TPGFactory.
+ * \param[in] leArgs the arguments of the LearningEnvironment constructor.
+ */
+template <class LE, class... LEArgs>
+static RunResult train(
+    const Learn::LearningParameters& params, uint64_t nbGenerations,
+    std::function<std::unique_ptr<Learn::LearningAgent>(
+        Learn::LearningEnvironment&, const Learn::LearningParameters&,
+        const TPG::TPGFactory&)>
+        makeAgent,
+    LEArgs&&... leArgs)
+{
+    RunResult result;
+    result.nbThreads = params.nbThreads;
+    result.nbGenerations = nbGenerations;
+    auto counters = std::make_shared<TrainingCounters>();
+    {
+        CountingLearningEnvironment<LE> le(counters,
+                                           std::forward<LEArgs>(leArgs)...);
+        std::unique_ptr<Learn::LearningAgent> la =
+            makeAgent(le, params, CountingTPGFactory(counters));
+        la->init(0);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t generation = 0; generation < nbGenerations;
+             generation++) {
+            la->trainOneGeneration(generation);
+        }
+        result.time = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+        // It is quite unlikely that two different TPGs end up with the same
+        // number of vertices, roots, edges, calls to the RNG and best score
+        // without being identical.
+        const TPG::TPGGraph& tpg = *la->getTPGGraph();
+        std::stringstream fingerprint;
+        fingerprint << tpg.getNbVertices() << "/" << tpg.getNbRootVertices()
+                    << "/" << tpg.getEdges().size() << "/" << std::hex
+                    << la->getRNG().getUnsignedInt64(0, UINT64_MAX);
+        if (la->getBestRoot().second != nullptr) {
+            fingerprint << "/" << std::hexfloat
+                        << la->getBestRoot().second->getResult();
+        }
+        result.fingerprint = fingerprint.str();
+    }
+    result.nbEpisodes = counters->nbEpisodes;
+    result.nbActions = counters->nbActions;
+    result.nbProgramExecutions = counters->nbProgramExecutions;
+    return result;
+}
+
+/// Train a LearningAgent or ParallelLearningAgent on the PendulumLE.
+template <class Agent>
+static RunResult trainPendulum(const Options& options, size_t nbThreads)
+{
+    OwningSet owningSet;
+    fillArithmeticSet(owningSet);
+    Learn::LearningParameters params = getParameters(options, nbThreads);
+    params.maxNbActionsPerEval = 300;
+    params.nbIterationsPerPolicyEvaluation = 2;
+    const std::vector<double> actions{0.05, 0.1, 0.2, 0.4, 0.6, 0.8, 1.0};
+
+    return train<PendulumLE>(
+        params, options.nbGenerations,
+        [&owningSet](Learn::LearningEnvironment& le,
+                     const Learn::LearningParameters& p,
+                     const TPG::TPGFactory& factory) {
+            return std::make_unique<Agent>(le, owningSet.set, p, factory);
+        },
+        actions);
+}
+
+/// Train a ParallelLearningAgent on the StickGameWithOpponent.
+static RunResult trainStickGame(const Options& options, size_t nbThreads)
+{
+    OwningSet owningSet;
+    fillStickGameSet(owningSet);
+    Learn::LearningParameters params = getParameters(options, nbThreads);
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 10;
+
+    return train<StickGameWithOpponent>(
+        params, options.nbGenerations,
+        [&owningSet](Learn::LearningEnvironment& le,
+                     const Learn::LearningParameters& p,
+                     const TPG::TPGFactory& factory) {
+            return std::make_unique<Learn::ParallelLearningAgent>(
+                le, owningSet.set, p, factory);
+        });
+}
+
+/// Train an AdversarialLearningAgent on the StickGameAdversarial.
+static RunResult trainStickGameAdversarial(const Options& options,
+                                           size_t nbThreads)
+{
+    OwningSet owningSet;
+    fillStickGameSet(owningSet);
+    Learn::LearningParameters params = getParameters(options, nbThreads);
+    params.maxNbActionsPerEval = 22;
+    params.nbIterationsPerPolicyEvaluation = 10;
+
+    return train<StickGameAdversarial>(
+        params, options.nbGenerations,
+        [&owningSet](Learn::LearningEnvironment& le,
+                     const Learn::LearningParameters& p,
+                     const TPG::TPGFactory& factory) {
+            return std::make_unique<Learn::AdversarialLearningAgent>(
+                le, owningSet.set, p, 2, factory);
+        });
+}
+
+/// Train a ClassificationLearningAgent on the SyntheticClassificationLE.
+static RunResult trainClassification(const Options& options, size_t nbThreads)
+{
+    OwningSet owningSet;
+    fillArithmeticSet(owningSet);
+    Learn::LearningParameters params = getParameters(options, nbThreads);
+    params.maxNbActionsPerEval = options.nbSamples;
+    params.nbIterationsPerPolicyEvaluation = 1;
+
+    return train<SyntheticClassificationLE>(
+        params, options.nbGenerations,
+        [&owningSet](Learn::LearningEnvironment& le,
+                     const Learn::LearningParameters& p,
+                     const TPG::TPGFactory& factory) {
+            return std::make_unique<Learn::ClassificationLearningAgent<>>(
+                (Learn::ClassificationLearningEnvironment&)le, owningSet.set,
+                p, factory);
+        },
+        options.nbClasses, options.nbFeatures, options.nbSamples);
+}
+
+/**
+ * \brief Execute the pre-trained tic-tac-toe TPGGraph on random boards.
+ *
+ * No LearningEnvironment of the tic-tac-toe is available in this
+ * repository, only the pre-trained TPGGraph used for code generation tests.
+ * Boards are split in contiguous slices executed by parallel threads, each
+ * with its own data and TPGExecutionEngine.
+ */
+static RunResult inferTicTacToe(const Options& options, size_t nbThreads)
+{
+    OwningSet owningSet;
+    fillTicTacToeSet(owningSet);
+    Data::PrimitiveTypeArray<double> board(9);
+    Environment env(owningSet.set, {board}, 8);
+    env.setBytecodeExecution(options.bytecode);
+    TPG::TPGGraph tpg(env);
+    // The importer must outlive the TPGGraph, whose Programs reference its
+    // copy of the Environment.
+    File::TPGGraphDotImporter importer(TESTS_DAT_PATH "TicTacToe_out_best.dot",
+                                       env, tpg);
+    const TPG::TPGVertex* root = tpg.getRootVertices().at(0);
+
+    // Draw boards
+    Mutator::RNG rng(0);
+    std::vector<double> cells(9 * options.nbBoards);
+    for (double& cell : cells) {
+        cell = (double)rng.getUnsignedInt64(0, 2) - 1.0;
+    }
+
+    RunResult result;
+    result.nbThreads = nbThreads;
+    result.nbEpisodes = options.nbBoards;
+    result.nbActions = options.nbBoards;
+    auto counters = std::make_shared<TrainingCounters>();
+    std::vector<uint64_t> actions(options.nbBoards);
+
+    auto executeSlice = [&](size_t threadIdx) {
+        // Private data must be a copy of the Environment data.
+        Data::PrimitiveTypeArray<double> privateBoard(board);
+        Environment privateEnv(owningSet.set, {privateBoard}, 8);
+        CountingTPGExecutionEngine tee(counters, privateEnv, NULL);
+        size_t begin = threadIdx * options.nbBoards / nbThreads;
+        size_t end = (threadIdx + 1) * options.nbBoards / nbThreads;
+        for (size_t boardIdx = begin; boardIdx < end; boardIdx++) {
+            for (size_t cell = 0; cell < 9; cell++) {
+                privateBoard.setDataAt(typeid(double), cell,
+                                       cells.at(9 * boardIdx + cell));
+            }
+            actions.at(boardIdx) =
+                ((const TPG::TPGAction*)tee.executeFromRoot(*root).back())
+                    ->getActionID();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t threadIdx = 1; threadIdx < nbThreads; threadIdx++) {
+        threads.emplace_back(executeSlice, threadIdx);
+    }
+    executeSlice(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    result.time = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    result.nbProgramExecutions = counters->nbProgramExecutions;
+
+    uint64_t checksum = 0;
+    for (size_t boardIdx = 0; boardIdx < actions.size(); boardIdx++) {
+        checksum = checksum * 31 + actions.at(boardIdx);
+    }
+    std::stringstream fingerprint;
+    fingerprint << std::hex << checksum;
+    result.fingerprint = fingerprint.str();
+    return result;
+}
+
+/// Parse a comma-separated list of thread counts.
+static std::vector<size_t> parseThreads(const std::string& list)
+{
+    std::vector<size_t> threads;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        threads.push_back(std::stoul(item));
+    }
+    return threads;
+}
+
+/// Default sweep: powers of two up to the hardware concurrency (included).
+static std::vector<size_t> defaultThreads()
+{
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threads;
+    for (size_t nbThreads = 1; nbThreads < hardware; nbThreads *= 2) {
+        threads.push_back(nbThreads);
+    }
+    threads.push_back(hardware);
+    return threads;
+}
+
+/// Parse the command line options.
+static Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    options.threads = defaultThreads();
+    for (int idx = 1; idx < argc; idx++) {
+        std::string arg(argv[idx]);
+        std::string value = arg.substr(arg.find('=') + 1);
+        if (arg.rfind("--threads=", 0) == 0) {
+            options.threads = parseThreads(value);
+        }
+        else if (arg.rfind("--generations=", 0) == 0) {
+            options.nbGenerations = std::stoull(value);
+        }
+        else if (arg.rfind("--roots=", 0) == 0) {
+            options.nbRoots = std::stoul(value);
+        }
+        else if (arg.rfind("--workloads=", 0) == 0) {
+            options.workloads = value;
+        }
+        else if (arg.rfind("--classes=", 0) == 0) {
+            options.nbClasses = std::stoul(value);
+        }
+        else if (arg.rfind("--features=", 0) == 0) {
+            options.nbFeatures = std::stoul(value);
+        }
+        else if (arg.rfind("--samples=", 0) == 0) {
+            options.nbSamples = std::stoul(value);
+        }
+        else if (arg.rfind("--boards=", 0) == 0) {
+            options.nbBoards = std::stoul(value);
+        }
+        else if (arg == "--bytecode") {
+            options.bytecode = true;
+        }
+        else if (arg.rfind("--out=", 0) == 0) {
+            options.out = value;
+        }
+        else {
+            throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+    return options;
+}
+
+/// Print the scaling table of a workload.
+static void printTable(const std::vector<RunResult>& results,
+                       const std::vector<bool>& matches)
+{
+    std::cout << std::left << std::setw(24) << "Workload" << std::setw(30)
+              << "Agent" << std::right << std::setw(8) << "Threads"
+              << std::setw(10) << "Time (s)" << std::setw(10) << "Gen/s"
+              << std::setw(12) << "Episodes/s" << std::setw(12) << "Actions/s"
+              << std::setw(14) << "Programs/s" << std::setw(9) << "Speedup"
+              << std::setw(11) << "Efficiency" << std::setw(7) << "Match"
+              << std::endl;
+    for (size_t idx = 0; idx < results.size(); idx++) {
+        const RunResult& run = results.at(idx);
+        const RunResult* reference = &run;
+        for (size_t ref = 0; ref < idx; ref++) {
+            if (results.at(ref).workload == run.workload &&
+                results.at(ref).agent == run.agent) {
+                reference = &results.at(ref);
+                break;
+            }
+        }
+        double speedup = reference->time / run.time;
+        double efficiency =
+            speedup * (double)reference->nbThreads / (double)run.nbThreads;
+        std::cout << std::left << std::setw(24) << run.workload
+                  << std::setw(30) << run.agent << std::right << std::fixed
+                  << std::setw(8) << run.nbThreads << std::setprecision(3)
+                  << std::setw(10) << run.time << std::setprecision(2)
+                  << std::setw(10) << (double)run.nbGenerations / run.time
+                  << std::setprecision(0) << std::setw(12)
+                  << (double)run.nbEpisodes / run.time << std::setw(12)
+                  << (double)run.nbActions / run.time << std::setw(14)
+                  << (double)run.nbProgramExecutions / run.time
+                  << std::setprecision(2) << std::setw(9) << speedup
+                  << std::setw(11) << efficiency << std::setw(7)
+                  << (matches.at(idx) ? "yes" : "NO") << std::endl;
+    }
+}
+
+/// Write the results in a JSON file.
+static void writeJSON(const std::string& path,
+                      const std::vector<RunResult>& results,
+                      const std::vector<bool>& matches)
+{
+    std::ofstream file(path);
+    file << "{\n  \"runs\": [";
+    for (size_t idx = 0; idx < results.size(); idx++) {
+        const RunResult& run = results.at(idx);
+        file << ((idx == 0) ? "\n" : ",\n") << "    {\n"
+             << "      \"workload\": \"" << run.workload << "\",\n"
+             << "      \"agent\": \"" << run.agent << "\",\n"
+             << "      \"threads\": " << run.nbThreads << ",\n"
+             << "      \"time\": " << std::setprecision(6) << run.time
+             << ",\n"
+             << "      \"generations\": " << run.nbGenerations << ",\n"
+             << "      \"episodes\": " << run.nbEpisodes << ",\n"
+             << "      \"actions\": " << run.nbActions << ",\n"
+             << "      \"program_executions\": " << run.nbProgramExecutions
+             << ",\n"
+             << "      \"fingerprint\": \"" << run.fingerprint << "\",\n"
+             << "      \"match\": " << (matches.at(idx) ? "true" : "false")
+             << "\n    }";
+    }
+    file << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv)
+{
+    const Options options = parseOptions(argc, argv);
+    const std::regex filter(options.workloads);
+
+    const std::vector<Workload> workloads{
+        {"pendulum", "LearningAgent", false,
+         trainPendulum<Learn::LearningAgent>},
+        {"pendulum", "ParallelLearningAgent", true,
+         trainPendulum<Learn::ParallelLearningAgent>},
+        {"stickgame", "ParallelLearningAgent", true, trainStickGame},
+        {"stickgame-adversarial", "AdversarialLearningAgent", true,
+         trainStickGameAdversarial},
+        {"classification", "ClassificationLearningAgent", true,
+         trainClassification},
+        {"tictactoe-inference", "TPGExecutionEngine", true, inferTicTacToe}};
+
+    // Results of all agents trained on the same workload must be identical.
+    std::map<std::string, std::string> references;
+    std::vector<RunResult> results;
+    std::vector<bool> matches;
+    bool allMatch = true;
+    for (const Workload& workload : workloads) {
+        if (!std::regex_search(workload.name, filter)) {
+            continue;
+        }
+        const std::vector<size_t> threads =
+            workload.parallel ? options.threads : std::vector<size_t>{1};
+        for (size_t nbThreads : threads) {
+            std::cout << "Running " << workload.name << " ("
+                      << workload.agent << ") with " << nbThreads
+                      << " thread(s)..." << std::endl;
+            RunResult result = workload.run(options, nbThreads);
+            result.workload = workload.name;
+            result.agent = workload.agent;
+            references.emplace(workload.name, result.fingerprint);
+            matches.push_back(result.fingerprint ==
+                              references.at(workload.name));
+            allMatch &= matches.back();
+            results.push_back(result);
+        }
+    }
+
+    std::cout << std::endl;
+    printTable(results, matches);
+
+    if (!options.out.empty()) {
+        writeJSON(options.out, results, matches);
+    }
+
+    if (!allMatch) {
+        std::cout << std::endl
+                  << "Results differ between thread counts or agents."
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef TRAINING_COUNTERS_H
+#define TRAINING_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <gegelati.h>
+
+/**
+ * \brief Counters of the work performed during a training.
+ *
+ * Counters are updated by the CountingLearningEnvironment and
+ * CountingTPGExecutionEngine classes. To avoid contention between threads,
+ * these classes count locally and add their counts to the shared counters
+ * when they are destroyed.
+ */
+struct TrainingCounters
+{
+    /// Number of episodes, that is, of resets of LearningEnvironments.
+    std::atomic<uint64_t> nbEpisodes{0};
+
+    /// Number of actions executed in LearningEnvironments.
+    std::atomic<uint64_t> nbActions{0};
+
+    /// Number of Programs executed by TPGExecutionEngines.
+    std::atomic<uint64_t> nbProgramExecutions{0};
+};
+
+/**
+ * \brief LearningEnvironment wrapper counting episodes and actions.
+ *
+ * The template parameter is the wrapped LearningEnvironment class, which must
+ * be copy constructible. Clones of the CountingLearningEnvironment count
+ * their episodes and actions in the same TrainingCounters.
+ */
+template <class LE> class CountingLearningEnvironment : public LE
+{
+  protected:
+    /// Shared counters.
+    std::shared_ptr<TrainingCounters> counters;
+
+    /// Number of episodes not yet added to the counters.
+    uint64_t nbEpisodes = 0;
+
+    /// Number of actions not yet added to the counters.
+    uint64_t nbActions = 0;
+
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] counters the TrainingCounters updated by this
+     * LearningEnvironment and its clones.
+     * \param[in] args the arguments of the wrapped LearningEnvironment
+     * constructor.
+     */
+    template <class... Args>
+    CountingLearningEnvironment(std::shared_ptr<TrainingCounters> counters,
+                                Args&&... args)
+        : LE(std::forward<Args>(args)...), counters{counters}
+    {
+    }
+
+    /// Copy constructor, counting from zero.
+    CountingLearningEnvironment(const CountingLearningEnvironment& other)
+        : LE(other), counters{other.counters}
+    {
+    }
+
+    /// Destructor, adding the local counts to the shared counters.
+    ~CountingLearningEnvironment()
+    {
+        this->counters->nbEpisodes += this->nbEpisodes;
+        this->counters->nbActions += this->nbActions;
+    }
+
+    /// Inherited via LearningEnvironment
+    void reset(size_t seed = 0,
+               Learn::LearningMode mode = Learn::LearningMode::TRAINING,
+               uint16_t iterationNumber = 0,
+               uint64_t generationNumber = 0) override
+    {
+        this->nbEpisodes++;
+        LE::reset(seed, mode, iterationNumber, generationNumber);
+    }
+
+    /// Inherited via LearningEnvironment
+    void doAction(uint64_t actionID) override
+    {
+        this->nbActions++;
+        LE::doAction(actionID);
+    }
+
+    /// Inherited via LearningEnvironment
+    Learn::LearningEnvironment* clone() const override
+    {
+        return new CountingLearningEnvironment(*this);
+    }
+};
+
+/**
+ * \brief TPGExecutionEngine counting the executed Programs.
+ */
+class CountingTPGExecutionEngine : public TPG::TPGExecutionEngine
+{
+  protected:
+    /// Shared counters.
+    std::shared_ptr<TrainingCounters> counters;
+
+    /// Number of Program executions not yet added to the counters.
+    uint64_t nbProgramExecutions = 0;
+
+  public:
+    /// Constructor.
+    CountingTPGExecutionEngine(std::shared_ptr<TrainingCounters> counters,
+                               const Environment& env, Archive* arch)
+        : TPGExecutionEngine(env, arch), counters{counters}
+    {
+    }
+
+    /// Destructor, adding the local count to the shared counters.
+    ~CountingTPGExecutionEngine()
+    {
+        this->counters->nbProgramExecutions += this->nbProgramExecutions;
+    }
+
+    /// Inherited via TPGExecutionEngine
+    double evaluateEdge(const TPG::TPGEdge& edge) override
+    {
+        this->nbProgramExecutions++;
+        return TPGExecutionEngine::evaluateEdge(edge);
+    }
+};
+
+/**
+ * \brief TPGFactory creating CountingTPGExecutionEngine.
+ */
+class CountingTPGFactory : public TPG::TPGFactory
+{
+  protected:
+    /// Shared counters.
+    std::shared_ptr<TrainingCounters> counters;
+
+  public:
+    /// Constructor.
+    CountingTPGFactory(std::shared_ptr<TrainingCounters> counters)
+        : counters{counters}
+    {
+    }
+
+    /// Inherited via TPGFactory
+    std::shared_ptr<TPG::TPGGraph> createTPGGraph(
+        const Environment& env) const override
+    {
+        return std::make_shared<TPG::TPGGraph>(
+            env, std::make_unique<CountingTPGFactory>(this->counters));
+    }
+
+    /// Inherited via TPGFactory
+    std::unique_ptr<TPG::TPGExecutionEngine> createTPGExecutionEngine(
+        const Environment& env, Archive* arch = NULL) const override
+    {
+        return std::make_unique<CountingTPGExecutionEngine>(this->counters,
+                                                            env, arch);
+    }
+};
+
+#endif
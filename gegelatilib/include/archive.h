@@ -38,11 +38,13 @@
 #define ARCHIVE_H
 
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <random>
 
 #include "data/dataHandler.h"
+#include "data/snapshotStore.h"
 #include "mutator/rng.h"
 #include "program/program.h"
 
@@ -95,17 +97,26 @@ class Archive
      */
     Mutator::RNG rng;
 
+    /**
+     * \brief Store owning the DataHandler copies used in recordings.
+     *
+     * Each DataHandler state is copied only once, even when it is part of
+     * several sets of DataHandler stored in the Archive. When delta snapshots
+     * are enabled, successive states of a DataHandler are stored as
+     * differences with an earlier copy.
+     */
+    Data::SnapshotStore snapshots;
+
     /**
      * \brief Storage for DataHandler copies used in recordings.
      *
      * This map associates a hash values with the corresonding copy of the set
      * of DataHandler that produced this value. The hash value is used in
      * recordings to associate each recording to the right copy of the
-     * DataHandler.
+     * DataHandler. Copies are identified by the hash of their snapshot in the
+     * snapshots attribute.
      */
-    std::map<size_t,
-             std::vector<std::reference_wrapper<const Data::DataHandler>>>
-        dataHandlers;
+    std::map<size_t, std::vector<size_t>> dataHandlers;
 
     /**
      * \brief Map storing the Program pointers referenced in recordings the
@@ -128,6 +139,21 @@ class Archive
      */
     const double archivingProbability;
 
+    /**
+     * \brief Store a recording whose DataHandler copies are already in the
+     * dataHandlers attribute.
+     *
+     * If the maximum number of recordings held in the archive is exceeded,
+     * the oldest recordings are removed, as well as the DataHandler copies
+     * that are no longer referenced.
+     *
+     * \param[in] program the Program associated to this recording.
+     * \param[in] hash the hash of the DataHandler copies of the recording.
+     * \param[in] result double value produced by the Program.
+     */
+    void insertRecording(const Program::Program* const program, size_t hash,
+                         double result);
+
   public:
     /**
      * \brief Main constructor for Archive.
@@ -136,11 +162,13 @@ class Archive
      * addRecording to actually lead to a new recodring in the Archive.
      * \param[in] size maximum number of recordings kept in the Archive.
      * \param[in] initialSeed Seed value for the randomEngine.
+     * \param[in] deltaSnapshots whether DataHandler copies are stored as
+     * differences with an earlier copy of the same DataHandler when possible.
      */
     Archive(size_t size = 50, double archivingProbability = 1.0,
-            size_t initialSeed = 0)
+            size_t initialSeed = 0, bool deltaSnapshots = false)
         : archivingProbability{archivingProbability}, maxSize{size},
-          recordings(), rng(initialSeed){};
+          recordings(), rng(initialSeed), snapshots(deltaSnapshots){};
 
     /**
      * Disable Archive copy construction.
@@ -150,13 +178,8 @@ class Archive
      */
     Archive(const Archive& other) = delete;
 
-    /**
-     * \brief Destructor of the class.
-     *
-     * In addition to default behavior, free all the memory associated to the
-     * referenced DataHandler in the dataHandlers attribute.
-     */
-    ~Archive();
+    /// Default destructor.
+    ~Archive() = default;
 
     /**
      * \brief Combien the hash of a set of dataHandlers into a single one.
@@ -196,7 +219,8 @@ class Archive
      * oldest recording will be removed.
      * If this is the first time this set of DataHandler is stored in the
      * Archive according to its DataHandler::getHash() method, a copy of the
-     * dataHandler will be created.
+     * dataHandler will be created. Only DataHandler whose individual state is
+     * not yet in the Archive are cloned, the others share the existing copy.
      * If an identical recording is already in the Archive (same hash, same
      * Program), the recording is not added.
      *
@@ -213,6 +237,27 @@ class Archive
             dHandler,
         double result, bool forced = false);
 
+    /**
+     * \brief Move recordings of another Archive into this Archive.
+     *
+     * The recordings of the other Archive are added, in order and without
+     * randomness, as with a forced call to addRecording. Instead of cloning
+     * the DataHandler of the recordings, copies owned by the other Archive are
+     * moved into this Archive when needed.
+     *
+     * At most getMaxSize() recordings are adopted: if there are more
+     * recordings in the other Archive, starting from the firstRecording,
+     * only the last ones are adopted.
+     *
+     * The other Archive is cleared by this method.
+     *
+     * \param[in,out] other the Archive whose recordings are adopted.
+     * \param[in] firstRecording the index of the first recording of the other
+     * Archive to adopt.
+     * \throw std::runtime_error if the other Archive is this Archive.
+     */
+    void adoptRecordings(Archive& other, size_t firstRecording = 0);
+
     /**
      * \brief Check whether the given hash is already in the archive.
      *
@@ -235,6 +280,11 @@ class Archive
         const std::map<size_t, double>& hashesAndResults,
         double tau = 1e-4) const;
 
+    /**
+     * \brief Get the maximum number of recordings held in the Archive.
+     */
+    size_t getMaxSize() const;
+
     /**
      * \brief Get the number of recordings currently held in the Archive.
      *
@@ -251,18 +301,62 @@ class Archive
     size_t getNbDataHandlers() const;
 
     /**
-     * \brief Const accessor to the dataHandlers attribute.
+     * \brief Get the number of distinct DataHandler copies held in the
+     * Archive.
+     *
+     * This number may be lower than the number of DataHandler referenced in
+     * the dataHandlers attribute, as unchanged DataHandler are shared between
+     * sets of DataHandler.
+     *
+     * \return the number of snapshots in the snapshots attribute.
+     */
+    size_t getNbSnapshots() const;
+
+    /**
+     * \brief Get the memory used by the Archive.
+     *
+     * The returned MemoryFootprint contains the "recordings", the
+     * "recordingsPerProgram" index, the "dataHandlers" sets, and the
+     * "snapshots" of DataHandler copies.
+     *
+     * \return the MemoryFootprint of the Archive.
+     */
+    Util::MemoryFootprint getMemoryFootprint() const;
+
+    /**
+     * \brief Accessor to the sets of DataHandler copies of the Archive.
      *
      * In order to test the unicity of a Program value, this Program must be
      * executed on all DataHandlers contained in an Archive to assess the
      * uniqueness of the results it produces.
      *
-     * \return a const reference to the dataHandlers attribute.
+     * \return a map associating the hash of each set of DataHandler to
+     * references to the copies owned by the Archive.
+     * \throw std::runtime_error if some copies are delta snapshots, which
+     * can only be accessed with the forEachDataHandlers() method.
      */
-    const std::map<
-        size_t, std::vector<std::reference_wrapper<const Data::DataHandler>>>&
+    std::map<size_t,
+             std::vector<std::reference_wrapper<const Data::DataHandler>>>
     getDataHandlers() const;
 
+    /**
+     * \brief Call a function on each set of DataHandler copies of the
+     * Archive.
+     *
+     * Contrary to getDataHandlers(), this method also supports delta
+     * snapshots: each delta snapshot is materialized once, for the duration
+     * of the call for its set of DataHandler. Hence, at most one set of
+     * DataHandler is materialized at a time.
+     *
+     * \param[in] function the function called with the hash of each set of
+     * DataHandler, and references to DataHandler in the state of the set.
+     */
+    void forEachDataHandlers(
+        const std::function<void(
+            size_t,
+            const std::vector<std::reference_wrapper<const Data::DataHandler>>&)>&
+            function) const;
+
     /**
      * \brief Clear all content from the Archive.
      */
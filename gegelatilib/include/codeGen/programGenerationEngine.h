@@ -39,10 +39,12 @@
 #ifndef PROGRAM_GENERATION_ENGINE_H
 #define PROGRAM_GENERATION_ENGINE_H
 #include <fstream>
+#include <regex>
 
 #include "data/dataHandlerPrinter.h"
 #include "data/primitiveTypeArray.h"
 #include "instructions/instruction.h"
+#include "program/optimizedProgram.h"
 #include "program/programEngine.h"
 
 namespace CodeGen {
@@ -58,6 +60,10 @@ namespace CodeGen {
      * In the generated code, inclusion of externHeader.h allows including
      * necessary headers (like math.h) to compile the generated code without
      * modifying it.
+     *
+     * In batch mode, no global variable is generated. Each Program is
+     * generated as a function processing several lanes of data, given as
+     * parameters with a structure of arrays layout.
      */
     class ProgramGenerationEngine : public Program::ProgramEngine
     {
@@ -84,6 +90,21 @@ namespace CodeGen {
         /// name of the temporary operand used in the TPG's programs.
         static const std::string nameOperandVariable;
 
+        /// name of the values computed by optimized programs.
+        static const std::string nameValueVariable;
+
+        /// name of the number of lanes of the data in batch mode.
+        static const std::string nameNbLanesVariable;
+
+        /// name of the current lane in batch mode.
+        static const std::string nameLaneVariable;
+
+        /// name of the values shared by the programs of a team.
+        static const std::string nameSharedValueVariable;
+
+        /// Is the code generated for batch inference.
+        const bool batch;
+
         /// The file in which programs will be added.
         std::ofstream fileC;
         /// The file in which prototypes of programs will be added.
@@ -92,6 +113,9 @@ namespace CodeGen {
         ///  Utility class used to print data accesses in generated code.
         Data::DataHandlerPrinter dataPrinter;
 
+        /// Utility class used to print data accesses in batch mode.
+        Data::DataHandlerPrinter batchDataPrinter;
+
       public:
         /// inherited from Program::ProgramEngine
         virtual void processLine() override;
@@ -113,11 +137,16 @@ namespace CodeGen {
          * \param[in] path a const reference to the path in which the file must
          * be generated. By default, the file is generated in the current
          * directory.
+         *
+         * \param[in] batch when true, Programs are generated for batch
+         * inference with the generateBatchProgram() method.
          */
         ProgramGenerationEngine(const std::string& filename,
                                 const Environment& env,
-                                const std::string& path = "./")
-            : ProgramEngine(env), dataPrinter()
+                                const std::string& path = "./",
+                                bool batch = false)
+            : ProgramEngine(env), batch{batch}, dataPrinter(),
+              batchDataPrinter(nameNbLanesVariable, nameLaneVariable)
         {
             openFile(filename, path, env.getNbConstant());
         }
@@ -139,11 +168,16 @@ namespace CodeGen {
          *
          * \param[in] path const reference to the path in which the file is
          * generated
+         *
+         * \param[in] batch when true, Programs are generated for batch
+         * inference with the generateBatchProgram() method.
          */
         ProgramGenerationEngine(const std::string& filename,
                                 const Program::Program& p,
-                                const std::string& path = "./")
-            : ProgramEngine(p), dataPrinter()
+                                const std::string& path = "./",
+                                bool batch = false)
+            : ProgramEngine(p), batch{batch}, dataPrinter(),
+              batchDataPrinter(nameNbLanesVariable, nameLaneVariable)
         {
             openFile(filename, path, p.getEnvironment().getNbConstant());
             setProgram(p);
@@ -179,6 +213,9 @@ namespace CodeGen {
          * declaration of function of the program with ID=1 is double P1(int*
          * action)
          *
+         * If the Program has an OptimizedProgram, its Operations are printed
+         * instead of the Lines of the Program.
+         *
          * \param[in] progID : unique identifier of the program used to generate
          *            the name of the function in the C file.
          * \param[in] ignoreException When true, all exceptions thrown when
@@ -192,6 +229,93 @@ namespace CodeGen {
         void generateProgram(uint64_t progID,
                              const bool ignoreException = false);
 
+        /**
+         * \brief Generate the C code of the member program of the class for
+         * batch inference.
+         *
+         * The declaration of the function of the program with ID=1 is
+         * void P1Batch(int nb, const int* lanes, int n, const double* in1,
+         * double* scores), with one parameter per data source. The Program is
+         * executed for the nb lanes whose indices are given in lanes, and the
+         * result of the i-th of these lanes is written in scores[i].
+         *
+         * Data sources hold the data of n lanes as a structure of arrays:
+         * element idx of lane l of in1 is in1[idx * n + l]. The generated
+         * function uses no global variable and can be called concurrently.
+         *
+         * \param[in] progID : unique identifier of the program used to generate
+         *            the name of the function in the C file.
+         * \param[in] ignoreException same as in generateProgram().
+         * \throws std::runtime_error if the engine is not in batch mode.
+         */
+        void generateBatchProgram(uint64_t progID,
+                                  const bool ignoreException = false);
+
+        /**
+         * \brief Generate the C code computing the bids of all the Programs
+         * of the outgoing edges of a team.
+         *
+         * Print a function void T<teamID>Bids(double* scores) in the file
+         * "filename"_program.c, which stores the result of the i-th Program
+         * in scores[i].
+         *
+         * The Operations of the OptimizedProgram of all Programs (built
+         * locally for Programs that were not optimized) are merged into a
+         * single block, where each value is stored in its own variable. An
+         * Operation executing the same Instruction as a previous Operation of
+         * the block, with operands reading the same data, values or literals,
+         * is not generated again, whichever Program it comes from. As for the
+         * OptimizedProgram, this assumes that Instructions are pure functions
+         * of their operands.
+         *
+         * Scalar reads of Data::Constant are printed as literals, so that
+         * Operations of different Programs reading the same constant value
+         * are merged. Programs accessing registers or constants as arrays,
+         * or that can not be optimized, are generated in their own scope as
+         * in generateProgram().
+         *
+         * \param[in] teamID unique identifier of the team used to generate the
+         *            name of the function in the C file.
+         * \param[in] programs the Programs of the outgoing edges of the team,
+         *            in order.
+         * \throws std::runtime_error if an Instruction is not printable.
+         */
+        void generateTeamPrograms(
+            uint64_t teamID,
+            const std::vector<const Program::Program*>& programs);
+
+        /**
+         * \brief Generate the C code computing the bids of all the Programs
+         * of the outgoing edges of a team for batch inference.
+         *
+         * Print a function void T<teamID>BidsBatch(int nb, const int* lanes,
+         * int n, const double* in1, double* scores, int stride), with one
+         * parameter per data source as in generateBatchProgram(). The bids
+         * are computed as in generateTeamPrograms() for the nb lanes whose
+         * indices are given in lanes, and the bid of the p-th Program for the
+         * i-th of these lanes is written in scores[p * stride + i].
+         *
+         * \param[in] teamID unique identifier of the team used to generate the
+         *            name of the function in the C file.
+         * \param[in] programs the Programs of the outgoing edges of the team,
+         *            in order.
+         * \throws std::runtime_error if the engine is not in batch mode, or if
+         *         an Instruction is not printable.
+         */
+        void generateBatchTeamPrograms(
+            uint64_t teamID,
+            const std::vector<const Program::Program*>& programs);
+
+        /**
+         * \brief Get the type and name of the variables giving access to the
+         * data sources in the generated code.
+         *
+         * \return a vector with the demangled type of the elements, and the
+         * name of each data source of the Environment, in order.
+         */
+        std::vector<std::pair<std::string, std::string>>
+        getDataSourceVariables() const;
+
       protected:
         /**
          * \brief Set global variables in the file holding the programs.
@@ -201,11 +325,50 @@ namespace CodeGen {
          * type of the global variable accordingly to the type of the data
          * sources of the Environment of the printed Program.
          *
+         * In batch mode, data sources are given as parameters of the
+         * generated functions and no global variable is declared.
+         *
          * \param[in] nbConstant size_t of the number of Data::Constant
          * available for a Program.
          */
         void initGlobalVar(size_t nbConstant);
 
+        /**
+         * \brief Generate the declarations of the registers and constants,
+         * and the code of the current Program.
+         *
+         * \param[in] ignoreException same as in generateProgram().
+         * \return the C expression of the result of the Program.
+         */
+        std::string generateProgramBody(const bool ignoreException);
+
+        /**
+         * \brief Generate the merged code computing the bids of the Programs
+         * of a team.
+         *
+         * \param[in] programs the Programs of the outgoing edges of the team.
+         * \param[in] scoreOffset the code appended to the index of each
+         *            Program when writing its bid in scores.
+         */
+        void generateTeamProgramsBody(
+            const std::vector<const Program::Program*>& programs,
+            const std::string& scoreOffset);
+
+        /**
+         * \brief Print the initialization of an operand from a data source.
+         *
+         * Accesses to the data sources of the Environment go through the
+         * batchDataPrinter in batch mode. Registers and constants are always
+         * accessed through the dataPrinter.
+         *
+         * \param[in] sourceIdx index of the data source in the Environment.
+         * \param[in] type the std::type_info of the operand.
+         * \param[in] location the location of the operand in the data source.
+         * \return the end of the declaration of the operand.
+         */
+        std::string printDataAt(uint64_t sourceIdx, const std::type_info& type,
+                                size_t location);
+
         /**
          * \brief Generates the line of C code that implements the instruction
          * in parameter.
@@ -222,6 +385,76 @@ namespace CodeGen {
         std::string completeFormat(
             const Instructions::Instruction& instruction) const;
 
+        /**
+         * \brief Generates the line of C code that implements the instruction
+         * in parameter, with the given result variable.
+         *
+         * \param[in] instruction that as to be converted into a line of code
+         * \param[in] result the variable in which the result is stored.
+         *
+         * @return a copy of the printTemplate with the variables changed
+         * according to the operand of the instruction.
+         */
+        std::string completeFormat(const Instructions::Instruction& instruction,
+                                   const std::string& result) const;
+
+        /**
+         * \brief Generate the C code of an OptimizedProgram.
+         *
+         * Each Operation stores its value in an element of a dedicated array,
+         * and the registers are only written when they are accessed as arrays.
+         *
+         * \param[in] optimized the OptimizedProgram of the current Program.
+         * \return the C expression of the result of the Program.
+         * \throws std::runtime_error if an Instruction is not printable.
+         */
+        std::string generateOptimizedProgram(
+            const Program::OptimizedProgram& optimized);
+
+        /**
+         * \brief Get the C expression of a VALUE or LITERAL operand of an
+         * OptimizedProgram.
+         *
+         * Literals are printed in hexadecimal notation, so that the generated
+         * code uses exactly the same values.
+         *
+         * \param[in] optimized the OptimizedProgram of the operand.
+         * \param[in] operand the VALUE or LITERAL operand.
+         * \return the C expression of the operand value.
+         */
+        std::string printValue(
+            const Program::OptimizedProgram& optimized,
+            const Program::OptimizedProgram::Operand& operand) const;
+
+        /**
+         * \brief Get the C expression of a literal value.
+         *
+         * \param[in] value the literal value.
+         * \return the value in hexadecimal notation, or an expression giving
+         * the same non-finite value.
+         */
+        std::string printLiteral(double value) const;
+
+        /**
+         * \brief Check if an OptimizedProgram can be merged with the
+         * OptimizedProgram of other Programs.
+         *
+         * \param[in] optimized the OptimizedProgram.
+         * \return false if an Operation accesses registers, or accesses
+         * constants as arrays, true otherwise.
+         */
+        bool isMergeable(const Program::OptimizedProgram& optimized) const;
+
+        /**
+         * \brief Check if an Operand is a scalar read of a Data::Constant.
+         *
+         * \param[in] operand the Operand of an OptimizedProgram Operation.
+         * \return true if the Operand reads a single Data::Constant of the
+         * current Program.
+         */
+        bool isScalarConstant(
+            const Program::OptimizedProgram::Operand& operand) const;
+
         /**
          * \brief Function used to open the file that is generated.
          *
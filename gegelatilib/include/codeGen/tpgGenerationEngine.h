@@ -41,7 +41,9 @@
 #define TPG_GENERATION_ENGINE_H
 #include <ios>
 #include <iostream>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "codeGen/programGenerationEngine.h"
 #include "tpg/tpgAbstractEngine.h"
@@ -65,6 +67,14 @@ namespace CodeGen {
      *
      * The repo gegelati apps give some example of the template code completed
      * for TicTacToe, Pendulum and StickGame.
+     *
+     * In batch mode, the generated code instead provides a thread-safe
+     * void inferenceTPGBatch(int n, const double* in1, ..., int* actions)
+     * function, with one parameter per data source. This function infers
+     * the actions of n inputs stored as a structure of arrays: element idx
+     * of input l of in1 is in1[idx * n + l]. Inputs are processed by chunks
+     * of TPG_BATCH_SIZE lanes (64 by default), each lane being routed
+     * through the teams independently.
      */
     class TPGGenerationEngine : public TPG::TPGAbstractEngine
     {
@@ -80,6 +90,18 @@ namespace CodeGen {
         /// header file for the function that iterates through the TPG.
         std::ofstream fileMainH;
 
+        /// Is the code generated for batch inference.
+        const bool batch;
+
+        /**
+         * \brief Are the Programs of the outgoing edges of each team merged.
+         *
+         * When true, the bids of each team are computed by a single function
+         * generated with ProgramGenerationEngine::generateTeamPrograms(), or
+         * ProgramGenerationEngine::generateBatchTeamPrograms() in batch mode.
+         */
+        bool mergeTeamPrograms = false;
+
         /**
          * \brief ProgramGenerationEngine for generating Programs of edges.
          *
@@ -118,10 +140,14 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] batch when true, the generated code implements the
+         * inferenceTPGBatch() function instead of inferenceTPG().
          */
         TPGGenerationEngine(const std::string& filename,
                             const TPG::TPGGraph& tpg,
-                            const std::string& path = "./");
+                            const std::string& path = "./",
+                            bool batch = false);
 
         /**
          * \brief destructor of the class.
@@ -139,6 +165,20 @@ namespace CodeGen {
          */
         virtual void generateTPGGraph() = 0;
 
+        /**
+         * \brief Set whether the Programs of the outgoing edges of each team
+         * are merged when generating the TPGGraph.
+         *
+         * Merging Programs lets the generated code compute only once the
+         * Operations shared by several Programs of a team, as is common for
+         * Programs cloned by mutations, and computes all the bids of a team
+         * with a single call. In batch mode, the bids of each team are
+         * computed with ProgramGenerationEngine::generateBatchTeamPrograms().
+         *
+         * \param[in] merge whether Programs of a team are merged.
+         */
+        void setMergeTeamPrograms(bool merge);
+
       protected:
         /**
          * \brief Method for generating the code for an edge of the graph.
@@ -178,6 +218,33 @@ namespace CodeGen {
          * generated.
          */
         virtual void generateAction(const TPG::TPGAction& action) = 0;
+
+        /**
+         * \brief Generate the code of the TPGGraph for batch inference.
+         *
+         * Teams reachable from the first root of the TPGGraph are visited in
+         * topological order. For each team, the lanes currently on this team
+         * are gathered, the batch functions of the Programs of its outgoing
+         * edges are executed on these lanes, and each lane moves to the
+         * destination of its best edge.
+         *
+         * \throws std::runtime_error if the TPGGraph contains a cycle.
+         */
+        void generateBatchTPGGraph();
+
+        /**
+         * \brief Append the teams reachable from a vertex to a list in
+         * depth-first post-order.
+         *
+         * \param[in] vertex the vertex from which teams are visited.
+         * \param[in,out] visited vertices visited so far, associated to true
+         * once all their successors were visited.
+         * \param[in,out] order the list of teams in post-order.
+         * \throws std::runtime_error if a cycle is found.
+         */
+        void sortTeams(const TPG::TPGVertex& vertex,
+                       std::map<const TPG::TPGVertex*, bool>& visited,
+                       std::vector<const TPG::TPGTeam*>& order);
     };
 } // namespace CodeGen
 
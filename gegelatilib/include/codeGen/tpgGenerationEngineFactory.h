@@ -55,7 +55,8 @@ namespace CodeGen {
         enum generationEngineMode
         {
             stackMode,
-            switchMode
+            switchMode,
+            tableMode
         };
 
         /**
@@ -74,11 +75,13 @@ namespace CodeGen {
         /**
          * @brief Factory method to create a codegen with the configured mode.
          *
+         * @param batch when true, the created codegen generates the
+         * inferenceTPGBatch() function instead of inferenceTPG().
          * @return a unique_ptr<TPGGenerationEngine>.
          */
         std::unique_ptr<TPGGenerationEngine> create(
             const std::string& filename, const TPG::TPGGraph& tpg,
-            const std::string& path = "./");
+            const std::string& path = "./", bool batch = false);
 
       private:
         enum generationEngineMode mode;
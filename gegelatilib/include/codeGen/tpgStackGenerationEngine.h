@@ -92,10 +92,14 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] batch when true, the generated code implements the
+         * inferenceTPGBatch() function instead of inferenceTPG().
          */
         TPGStackGenerationEngine(const std::string& filename,
                                  const TPG::TPGGraph& tpg,
-                                 const std::string& path = "./");
+                                 const std::string& path = "./",
+                                 bool batch = false);
 
         /**
          * \brief destructor of the class.
@@ -83,11 +83,15 @@ namespace CodeGen {
          *
          * \param[in] path to the folder in which the file are generated. If the
          * folder does not exist.
+         *
+         * \param[in] batch when true, the generated code implements the
+         * inferenceTPGBatch() function instead of inferenceTPG().
          */
         TPGSwitchGenerationEngine(const std::string& filename,
                                   const TPG::TPGGraph& tpg,
-                                  const std::string& path = "./")
-            : TPGGenerationEngine(filename, tpg, path){};
+                                  const std::string& path = "./",
+                                  bool batch = false)
+            : TPGGenerationEngine(filename, tpg, path, batch){};
 
         /**
          * \brief destructor of the class.
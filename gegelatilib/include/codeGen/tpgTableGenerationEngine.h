@@ -0,0 +1,201 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifdef CODE_GENERATION
+
+#ifndef TPG_TABLE_GENERATION_ENGINE_H
+#define TPG_TABLE_GENERATION_ENGINE_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "codeGen/tpgGenerationEngine.h"
+
+namespace CodeGen {
+    /**
+     * \brief Class in charge of generating the C code of a TPGGraph as
+     * constant tables.
+     *
+     * Each program of the TPGGraph is represented by a C function, as in the
+     * other engines. The topology of the graph is not unrolled into code but
+     * stored in constant arrays following the Compressed Sparse Row layout:
+     * the outgoing edges of team i are the edges teamEdges[i] to
+     * teamEdges[i+1]-1, each with a destination vertex and a program index in
+     * a table of function pointers. A single generic loop walks these tables
+     * during the inference.
+     *
+     * Teams are numbered first, so that a destination lower than the number
+     * of teams is a team and any other destination is an action.
+     *
+     * The size of the generated code does not depend on the number of
+     * teams, which keeps the compilation time and binary size low for large
+     * graphs.
+     *
+     * In batch mode, the same tables are walked by a single loop over the
+     * teams, numbered in topological order, which executes the batch
+     * functions of the programs on the lanes gathered on each team.
+     */
+    class TPGTableGenerationEngine : public CodeGen::TPGGenerationEngine
+    {
+      protected:
+        /// Index of the first edge of each team, plus the total edge count.
+        std::vector<uint64_t> teamEdges;
+
+        /// Destination vertex of each edge.
+        std::vector<uint64_t> edgeDestinations;
+
+        /// Index of the program of each edge.
+        std::vector<uint64_t> edgePrograms;
+
+        /// Action identifier of each action vertex.
+        std::vector<uint64_t> vertexActions;
+
+        /// Number of teams in the generated graph.
+        uint64_t nbTeams = 0;
+
+        /**
+         * \brief function printing generic code in the main file.
+         *
+         * This function prints the includes required by the generated tables
+         * and inference function.
+         */
+        virtual void initTpgFile();
+
+        /**
+         * \brief function printing generic code declaration in the main file
+         * header.
+         *
+         * This function prints the prototype of the inference function.
+         */
+        virtual void initHeaderFile();
+
+        /**
+         * \brief Print a constant C array in the main file.
+         *
+         * The element type of the array is the smallest unsigned integer
+         * type able to hold all the given values. An empty table is printed
+         * with a single null element, as C forbids empty arrays.
+         *
+         * \param[in] name of the printed array.
+         * \param[in] values content of the printed array.
+         */
+        void printTable(const std::string& name,
+                        const std::vector<uint64_t>& values);
+
+        /**
+         * \brief Print the table of batch functions and the
+         * inferenceTPGBatch() function walking the tables in the main file.
+         *
+         * \param[in] maxNbEdges the largest number of outgoing edges of a
+         * team.
+         */
+        void generateBatchInference(uint64_t maxNbEdges);
+
+      public:
+        /**
+         * \brief Main constructor of the class.
+         *
+         * \param[in] filename : filename of the file holding the main function
+         *                of the generated program.
+         *
+         * \param[in] tpg Environment in which the Program of the TPGGraph will
+         *                be executed.
+         *
+         * \param[in] path to the folder in which the file are generated. If the
+         * folder does not exist.
+         *
+         * \param[in] batch when true, the generated code implements the
+         * inferenceTPGBatch() function instead of inferenceTPG().
+         */
+        TPGTableGenerationEngine(const std::string& filename,
+                                 const TPG::TPGGraph& tpg,
+                                 const std::string& path = "./",
+                                 bool batch = false)
+            : TPGGenerationEngine(filename, tpg, path, batch){};
+
+        /**
+         * \brief function that creates the C files required to execute the TPG
+         * without gegelati.
+         *
+         * This function fills the tables describing the TPGGraph, prints them
+         * in the main file, and prints the inference function walking them.
+         *
+         * \throws std::runtime_error in batch mode, if the TPGGraph contains
+         * a cycle.
+         */
+        virtual void generateTPGGraph();
+
+      protected:
+        /**
+         * \brief Method for generating the code for an edge of the graph.
+         *
+         * This method appends the destination and the program index of the
+         * edge to the edge tables, and generates the program of the edge the
+         * first time it is encountered, or its batch function in batch mode.
+         *
+         * \param[in] edge that must be generated.
+         */
+        virtual void generateEdge(const TPG::TPGEdge& edge);
+
+        /**
+         * \brief Method for generating the code for a team of the graph.
+         *
+         * This method appends the outgoing edges of the team to the edge
+         * tables, and the index of the end of its edge range to the team
+         * table. When programs of teams are merged, the T<id>Bids() function
+         * of the team, or its T<id>BidsBatch() function in batch mode, is
+         * generated instead of its programs.
+         *
+         * \param[in] team const reference of the TPGTeam that must be
+         * generated.
+         */
+        virtual void generateTeam(const TPG::TPGTeam& team);
+
+        /**
+         * \brief Method for generating a action of the graph.
+         *
+         * This method appends the action identifier to the action table.
+         *
+         * \param[in] action const reference of the TPGAction that must be
+         * generated.
+         */
+        virtual void generateAction(const TPG::TPGAction& action);
+    };
+} // namespace CodeGen
+
+#endif // TPG_TABLE_GENERATION_ENGINE_H
+
+#endif // CODE_GENERATION
@@ -66,25 +66,6 @@ namespace Data {
      */
     template <class T> class Array2DWrapper : public ArrayWrapper<T>
     {
-      private:
-        /**
-         * \brief Caching mechanism for storing addressSpace for different
-         * types.
-         *
-         * This map stores for each data type the size of the addressSpace for
-         * the Array2DWrapper. The purpose of this cache is to accelerate
-         * the numerous access to the addressSpace for different data types, by
-         * performing it only once per data type requested by the Instructions,
-         * through the ProgramExecutionEngine.
-         *
-         * This map is updated and used by the getAddressSpace method.
-         *
-         * Like the getAddressSpace method of the 2D array, this map stores all
-         * type dimensions.
-         */
-        mutable std::map<std::type_index, std::tuple<size_t, size_t, size_t>>
-            cachedAddressSpace;
-
       protected:
         /// Number of columns of the 2D array.
         size_t width;
@@ -217,68 +198,54 @@ namespace Data {
     size_t Array2DWrapper<T>::getAddressSpace(const std::type_info& type,
                                               size_t* dim1, size_t* dim2) const
     {
-        // Has the result been cached
-        auto iter = this->cachedAddressSpace.find(type);
-        if (iter != this->cachedAddressSpace.end()) {
+        if (type == typeid(T)) {
             if (dim1 != nullptr) {
-                *dim1 = std::get<1>(iter->second);
+                *dim1 = 0;
             }
             if (dim2 != nullptr) {
-                *dim2 = std::get<2>(iter->second);
+                *dim2 = 0;
             }
-            return std::get<0>(iter->second);
-        }
-
-        size_t result = 0;
-        // The parent function is not used to avoid performing 2 regex matches.
-        if (type == typeid(T)) {
-            this->cachedAddressSpace.emplace(
-                type, std::make_tuple(this->nbElements, 0, 0));
-            result = this->nbElements;
+            return this->nbElements;
         }
 
         // Check if it is a 1D or 2D array
         // with a size (h and w) inferior to the container dimensions.
-        if (result == 0) {
-            std::string typeName = DEMANGLE_TYPEID_NAME(type.name());
-            std::string regex{DEMANGLE_TYPEID_NAME(typeid(T).name())};
-            regex.append("\\s*(const\\s*)?\\[([0-9]+)\\](\\[([0-9]+)\\])?");
-            std::regex arrayType(regex);
-            std::cmatch cm;
-            if (std::regex_match(typeName.c_str(), cm, arrayType)) {
-                int typeH = 0;
-                int typeW = 0;
-                if (cm[2].matched && !cm[4].matched) {
-                    // 1D array
-                    typeH = 1;
-                    typeW = std::atoi(cm[2].str().c_str());
-                }
-                else if (cm[2].matched && cm[4].matched) {
-                    // 2D array
-                    typeH = std::atoi(cm[2].str().c_str());
-                    typeW = std::atoi(cm[4].str().c_str());
-                }
+        const OperandType& operandType = OperandTypeRegistry::get(type);
+        if (!ArrayWrapper<T>::isArrayOfNativeType(operandType)) {
+            return 0;
+        }
 
-                // Make sure dimensions are valid for this array
-                // Only spatially coherent data can be provided.
-                // Data spanning over several lines can not be
-                // provided
-                if (typeH <= this->height && typeW <= this->width) {
-                    result = (this->height - typeH + 1) *
-                             ((this->width - typeW + 1));
-                    if (dim1 != nullptr) {
-                        *dim1 = typeH;
-                    }
-                    if (dim2 != nullptr) {
-                        *dim2 = typeW;
-                    }
-                    this->cachedAddressSpace.emplace(
-                        type, std::make_tuple(result, typeH, typeW));
-                }
-            }
+        size_t typeH = 0;
+        size_t typeW = 0;
+        if (operandType.nbDimensions == 1) {
+            // 1D array
+            typeH = 1;
+            typeW = operandType.dim1;
+        }
+        else if (operandType.nbDimensions == 2) {
+            // 2D array
+            typeH = operandType.dim1;
+            typeW = operandType.dim2;
+        }
+        else {
+            return 0;
         }
 
-        return result;
+        // Make sure dimensions are valid for this array
+        // Only spatially coherent data can be provided.
+        // Data spanning over several lines can not be
+        // provided
+        if (typeH > this->height || typeW > this->width) {
+            return 0;
+        }
+
+        if (dim1 != nullptr) {
+            *dim1 = typeH;
+        }
+        if (dim2 != nullptr) {
+            *dim2 = typeW;
+        }
+        return (this->height - typeH + 1) * (this->width - typeW + 1);
     }
 
     template <typename T>
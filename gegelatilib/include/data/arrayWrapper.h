@@ -37,18 +37,20 @@
 #ifndef ARRAY_WRAPPER_H
 #define ARRAY_WRAPPER_H
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
-#include <map>
-#include <regex>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
-#include <typeindex>
 #include <typeinfo>
 
+#include "data/blockHash.h"
 #include "data/constant.h"
 #include "data/dataHandler.h"
 #include "data/demangle.h"
 #include "data/hash.h"
+#include "data/operandTypeRegistry.h"
 
 namespace Data {
 
@@ -72,21 +74,6 @@ namespace Data {
                       "Template class PrimitiveTypeArray<T> can only be used "
                       "for primitive types.");
 
-      private:
-        /**
-         * \brief Caching mechanism for storing addressSpace for different
-         * types.
-         *
-         * This map stores for each data type the size of the addressSpace for
-         * the PrimitiveTypeArray. The purpose of this cache is to accelerate
-         * the numerous access to the addressSpace for different data types, by
-         * performing it only once per data type requested by the Instructions,
-         * through the ProgramExecutionEngine.
-         *
-         * This map is updated and used by the getAddressSpace method.
-         */
-        mutable std::map<std::type_index, size_t> cachedAddressSpace;
-
       protected:
         /**
          * \brief Number of elements contained pointer vector.
@@ -104,6 +91,64 @@ namespace Data {
          */
         std::vector<T>* containerPtr;
 
+        /**
+         * \brief Hash of each block of BlockHash::BLOCK_SIZE elements of the
+         * pointed data.
+         *
+         * Block hashes are updated by the updateHash() method, and combined
+         * into the cachedHash.
+         */
+        mutable std::vector<uint64_t> blockHashes;
+
+        /**
+         * \brief Indexes of the blocks modified since the last update of the
+         * hash.
+         *
+         * When validBlockHashes is true, only the hashes of these blocks need
+         * to be updated by the updateHash() method. Each block is listed at
+         * most once, as flagged in dirtyBlockFlags.
+         */
+        mutable std::vector<size_t> dirtyBlocks;
+
+        /**
+         * \brief Whether each block is listed in dirtyBlocks.
+         *
+         * Sized to blockHashes, so that repeated writes in a block between
+         * two updates of the hash do not grow the dirtyBlocks list.
+         */
+        mutable std::vector<bool> dirtyBlockFlags;
+
+        /**
+         * \brief Whether the blockHashes not listed in dirtyBlocks are valid.
+         *
+         * Subclasses modifying the pointed data must call one of the
+         * invalidateCachedHash() methods, rather than setting the
+         * invalidCachedHash attribute, to keep the block hashes consistent.
+         */
+        mutable bool validBlockHashes = false;
+
+        /**
+         * \brief Invalidate the hash of the block containing an element.
+         *
+         * This method should be called instead of invalidateCachedHash() when
+         * a single element of the pointed data was modified, so that only
+         * the corresponding block is hashed again.
+         *
+         * \param[in] address the index of the modified element.
+         */
+        void invalidateCachedHash(size_t address);
+
+        /**
+         * \brief Set the pointer of the ArrayWrapper to a copy of the data
+         * currently pointed.
+         *
+         * Contrary to the setPointer() method, the cached hash is not
+         * invalidated, as the pointed data is identical.
+         *
+         * \param[in] ptr the new pointer managed by the ArrayWrapper.
+         */
+        void setPointerToCopy(std::vector<T>* ptr);
+
         /**
          * Check whether the given type of data can be accessed at the given
          * address. Throws exception otherwise.
@@ -118,8 +163,22 @@ namespace Data {
         void checkAddressAndType(const std::type_info& type,
                                  const size_t& address) const;
 
+        /**
+         * \brief Check whether the given OperandType describes a c-style
+         * array of elements of type T.
+         *
+         * \param[in] operandType the OperandType description.
+         * \return true if the elements of the array are of type T (regardless
+         * of const qualifier), false otherwise.
+         */
+        static bool isArrayOfNativeType(const OperandType& operandType);
+
         /**
          * \brief Implementation of the updateHash method.
+         *
+         * The hash is computed block by block with the Data::BlockHash
+         * functions. If only some elements were modified since the last
+         * update, only the hashes of their blocks are computed again.
          */
         virtual size_t updateHash() const override;
 
@@ -187,6 +246,31 @@ namespace Data {
         /// Inherited from DataHandler. Does nothing.
         void resetData() override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * The footprint contains the "object" and the cached block "hashes"
+         * of the ArrayWrapper. The wrapped container is not counted.
+         */
+        virtual Util::MemoryFootprint getMemoryFootprint() const override;
+
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * The DataDelta holds the blocks of BlockHash::BLOCK_SIZE elements
+         * whose content differs from the base, which must be an ArrayWrapper
+         * of the same type, ID and size.
+         */
+        virtual std::unique_ptr<DataDelta> getDelta(
+            const DataHandler& base) const override;
+
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * The blocks of the DataDelta are written in the wrapped container.
+         */
+        virtual void applyDelta(const DataDelta& delta) override;
+
         /**
          * \brief Set the pointer of the ArrayWrapper.
          *
@@ -200,6 +284,18 @@ namespace Data {
          */
         void setPointer(std::vector<T>* ptr);
 
+        /**
+         * \brief Get a pointer to the first element of the wrapped container.
+         *
+         * The returned pointer gives a direct read access to the elements of
+         * type T, without going through the getDataAt() method. Elements are
+         * stored contiguously, in the order of their address.
+         *
+         * \return a pointer to the data of the container, or nullptr if no
+         * container is wrapped.
+         */
+        const T* getNativeData() const;
+
         /// Inherited from DataHandler
         virtual UntypedSharedPtr getDataAt(const std::type_info& type,
                                            const size_t address) const override;
@@ -271,34 +367,30 @@ namespace Data {
     }
 
     template <class T>
-    size_t ArrayWrapper<T>::getAddressSpace(const std::type_info& type) const
+    inline bool ArrayWrapper<T>::isArrayOfNativeType(
+        const OperandType& operandType)
     {
-        // Has the addresSpaceSize been cached
-        auto iter = this->cachedAddressSpace.find(type);
-        if (iter != this->cachedAddressSpace.end()) {
-            return iter->second;
-        }
+        static const OperandType& nativeType =
+            OperandTypeRegistry::registerType<T>();
+        return operandType.nbDimensions > 0 &&
+               operandType.elementName == nativeType.elementName;
+    }
 
+    template <class T>
+    size_t ArrayWrapper<T>::getAddressSpace(const std::type_info& type) const
+    {
         if (type == typeid(T)) {
-            this->cachedAddressSpace.emplace(type, this->nbElements);
             return this->nbElements;
         }
 
         // If the type is an array of the primitive type
         // with a size inferior to the container.
-        std::string typeName = DEMANGLE_TYPEID_NAME(type.name());
-        std::string regex{DEMANGLE_TYPEID_NAME(typeid(T).name())};
-        regex.append("\\s*(const\\s*)?\\[([0-9]+)\\]");
-        std::regex arrayType(regex);
-        std::cmatch cm;
-        if (std::regex_match(typeName.c_str(), cm, arrayType)) {
-            int size = std::atoi(cm[2].str().c_str());
-            if (size <= this->nbElements) {
-                size_t result = this->nbElements - size + 1;
-                this->cachedAddressSpace.emplace(type, result);
-                return result;
-            }
+        const OperandType& operandType = OperandTypeRegistry::get(type);
+        if (operandType.nbDimensions == 1 && isArrayOfNativeType(operandType) &&
+            operandType.dim1 <= this->nbElements) {
+            return this->nbElements - operandType.dim1 + 1;
         }
+
         // Default case
         return 0;
     }
@@ -327,6 +419,12 @@ namespace Data {
         return result;
     }
 
+    template <class T> inline const T* ArrayWrapper<T>::getNativeData() const
+    {
+        return (this->containerPtr != nullptr) ? this->containerPtr->data()
+                                               : nullptr;
+    }
+
     template <class T>
     inline UntypedSharedPtr ArrayWrapper<T>::getDataAt(
         const std::type_info& type, const size_t address) const
@@ -372,6 +470,21 @@ namespace Data {
     template <class T> void ArrayWrapper<T>::invalidateCachedHash()
     {
         this->invalidCachedHash = true;
+        this->validBlockHashes = false;
+        this->dirtyBlocks.clear();
+    }
+
+    template <class T>
+    void ArrayWrapper<T>::invalidateCachedHash(size_t address)
+    {
+        if (this->validBlockHashes) {
+            size_t block = address / BlockHash::BLOCK_SIZE;
+            if (!this->dirtyBlockFlags.at(block)) {
+                this->dirtyBlockFlags.at(block) = true;
+                this->dirtyBlocks.push_back(block);
+            }
+        }
+        this->invalidCachedHash = true;
     }
 
     template <class T> void ArrayWrapper<T>::resetData()
@@ -379,13 +492,99 @@ namespace Data {
         // Does nothing;
     }
 
+    template <class T>
+    Util::MemoryFootprint ArrayWrapper<T>::getMemoryFootprint() const
+    {
+        Util::MemoryFootprint footprint;
+        footprint.add("object", sizeof(ArrayWrapper<T>));
+        footprint.add("hashes",
+                      Util::MemoryFootprint::getHeapBytes(this->blockHashes) +
+                          Util::MemoryFootprint::getHeapBytes(
+                              this->dirtyBlocks) +
+                          (this->dirtyBlockFlags.capacity() + 7) / 8);
+        return footprint;
+    }
+
+    template <class T>
+    std::unique_ptr<DataDelta> ArrayWrapper<T>::getDelta(
+        const DataHandler& base) const
+    {
+        // std::vector<bool> does not store its elements contiguously.
+        if constexpr (std::is_same_v<T, bool>) {
+            return nullptr;
+        }
+        else {
+            const ArrayWrapper<T>* other =
+                dynamic_cast<const ArrayWrapper<T>*>(&base);
+            if (other == nullptr || typeid(*other) != typeid(*this) ||
+                other->id != this->id ||
+                other->nbElements != this->nbElements ||
+                other->containerPtr == nullptr ||
+                this->containerPtr == nullptr) {
+                return nullptr;
+            }
+
+            auto delta = std::make_unique<DataDelta>();
+            for (size_t first = 0; first < this->nbElements;
+                 first += BlockHash::BLOCK_SIZE) {
+                size_t nbBytes =
+                    std::min(BlockHash::BLOCK_SIZE, this->nbElements - first) *
+                    sizeof(T);
+                const uint8_t* data = reinterpret_cast<const uint8_t*>(
+                    this->containerPtr->data() + first);
+                if (std::memcmp(data, other->containerPtr->data() + first,
+                                nbBytes) != 0) {
+                    delta->blocks.push_back(first / BlockHash::BLOCK_SIZE);
+                    delta->bytes.insert(delta->bytes.end(), data,
+                                        data + nbBytes);
+                }
+            }
+            return delta;
+        }
+    }
+
+    template <class T>
+    void ArrayWrapper<T>::applyDelta(const DataDelta& delta)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            DataHandler::applyDelta(delta);
+        }
+        else {
+            if (this->containerPtr == nullptr) {
+                throw std::runtime_error("Null pointer access.");
+            }
+
+            size_t offset = 0;
+            for (size_t block : delta.blocks) {
+                size_t first = block * BlockHash::BLOCK_SIZE;
+                if (first >= this->nbElements) {
+                    throw std::out_of_range(
+                        "DataDelta does not match the ArrayWrapper size.");
+                }
+                size_t nbBytes =
+                    std::min(BlockHash::BLOCK_SIZE, this->nbElements - first) *
+                    sizeof(T);
+                if (offset + nbBytes > delta.bytes.size()) {
+                    throw std::out_of_range(
+                        "DataDelta does not match the ArrayWrapper size.");
+                }
+                std::memcpy(this->containerPtr->data() + first,
+                            delta.bytes.data() + offset, nbBytes);
+                offset += nbBytes;
+
+                // Invalidate the cached hash of the modified block only.
+                this->invalidateCachedHash(first);
+            }
+        }
+    }
+
     template <class T>
     inline void ArrayWrapper<T>::setPointer(std::vector<T>* ptr)
     {
         // Null ptr case
         if (ptr == nullptr) {
             this->containerPtr = ptr;
-            this->invalidCachedHash = true;
+            this->invalidateCachedHash();
             return;
         }
 
@@ -401,7 +600,26 @@ namespace Data {
 
         // Else
         this->containerPtr = ptr;
-        this->invalidCachedHash = true;
+        this->invalidateCachedHash();
+    }
+
+    template <class T>
+    inline void ArrayWrapper<T>::setPointerToCopy(std::vector<T>* ptr)
+    {
+        if (ptr == nullptr || this->containerPtr == nullptr) {
+            this->setPointer(ptr);
+            return;
+        }
+
+        if (ptr->size() != nbElements) {
+            std::stringstream message;
+            message << "Size of pointed data (" << ptr->size()
+                    << ") does not correspond to the size of the ArrayWrapper ("
+                    << this->nbElements << ").";
+            throw std::domain_error(message.str());
+        }
+
+        this->containerPtr = ptr;
     }
 
     template <class T> inline size_t ArrayWrapper<T>::updateHash() const
@@ -411,18 +629,28 @@ namespace Data {
             return this->cachedHash = 0;
         }
 
-        // reset
-        this->cachedHash = Data::Hash<size_t>()(this->id);
-
-        // hasher
-        Data::Hash<T> hasher;
-
-        for (T dataElement : *(this->containerPtr)) {
-            // Rotate by 1 because otherwise, xor is comutative.
-            this->cachedHash =
-                (this->cachedHash >> 1) | (this->cachedHash << 63);
-            this->cachedHash ^= hasher((T)dataElement);
+        if (this->validBlockHashes) {
+            // Update only the modified blocks
+            for (size_t block : this->dirtyBlocks) {
+                size_t first = block * BlockHash::BLOCK_SIZE;
+                this->blockHashes.at(block) = BlockHash::hashBlock(
+                    this->containerPtr->cbegin() + first,
+                    std::min(BlockHash::BLOCK_SIZE, this->nbElements - first));
+                this->dirtyBlockFlags.at(block) = false;
+            }
+        }
+        else {
+            BlockHash::hashBlocks(this->containerPtr->cbegin(), this->nbElements,
+                                  this->blockHashes);
+            this->dirtyBlockFlags.assign(this->blockHashes.size(), false);
+            this->validBlockHashes = true;
         }
+        this->dirtyBlocks.clear();
+
+        // Combine blocks, using the id as a seed.
+        this->cachedHash = (size_t)BlockHash::combine(
+            Data::Hash<size_t>()(this->id), this->blockHashes.data(),
+            this->blockHashes.size());
 
         // Validate the cached hash value
         this->invalidCachedHash = false;
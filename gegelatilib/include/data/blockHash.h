@@ -0,0 +1,206 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef BLOCK_HASH_H
+#define BLOCK_HASH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "data/hash.h"
+
+namespace Data {
+    /**
+     * \brief Functions used to compute the hash of arrays of data, block by
+     * block.
+     *
+     * Data is hashed by blocks of BLOCK_SIZE elements, with a 64-bit
+     * multiply-rotate hash inspired by xxHash64. Within a block, elements are
+     * spread over four independent accumulators so that consecutive elements
+     * can be processed in parallel by the CPU, instead of being chained
+     * byte-by-byte as with the FNV-1a hash of Data::Hash.
+     *
+     * Hashes of blocks are combined in order with a seed into the hash of the
+     * whole array, so that a modification of a single element only requires
+     * hashing its block again before combining the block hashes.
+     *
+     * All computations use 64-bit unsigned integers, so results only depend
+     * on the in-memory representation of the hashed elements.
+     */
+    namespace BlockHash {
+        /// Number of elements in each block.
+        inline constexpr size_t BLOCK_SIZE = 64;
+
+        /// Primes of the xxHash64 algorithm.
+        inline constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+        inline constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+        inline constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+        inline constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+
+        /// Rotate the given value left by r bits.
+        inline uint64_t rotl(uint64_t value, unsigned int r)
+        {
+            return (value << r) | (value >> (64 - r));
+        }
+
+        /// Accumulate a 64-bit lane into the given accumulator.
+        inline uint64_t mixLane(uint64_t acc, uint64_t lane)
+        {
+            acc += lane * PRIME_2;
+            acc = rotl(acc, 31);
+            return acc * PRIME_1;
+        }
+
+        /// Final mix ensuring all bits of the hash depend on all input bits.
+        inline uint64_t avalanche(uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= PRIME_2;
+            hash ^= hash >> 29;
+            hash *= PRIME_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        /**
+         * \brief Get the 64-bit lane representing an element.
+         *
+         * Elements whose size is at most 64 bits are represented by their
+         * bits, with -0.0 being mapped to 0.0 for floating-point types, as in
+         * Data::Hash. Larger elements are represented by their Data::Hash.
+         */
+        template <class T> inline uint64_t getLane(const T& element)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (element == T{0}) {
+                    return 0;
+                }
+            }
+
+            if constexpr (sizeof(T) <= sizeof(uint64_t)) {
+                uint64_t lane = 0;
+                std::memcpy(&lane, &element, sizeof(T));
+                return lane;
+            }
+            else {
+                return Data::Hash<T>()(element);
+            }
+        }
+
+        /**
+         * \brief Compute the hash of a block of elements.
+         *
+         * \param[in] data random access iterator to the first element of the
+         * block.
+         * \param[in] nbElements number of elements in the block.
+         * \return the hash of the block.
+         */
+        template <class Iterator>
+        inline uint64_t hashBlock(Iterator data, size_t nbElements)
+        {
+            uint64_t acc0 = PRIME_1 + PRIME_2;
+            uint64_t acc1 = PRIME_2;
+            uint64_t acc2 = 0;
+            uint64_t acc3 = 0 - PRIME_1;
+
+            size_t idx = 0;
+            for (; idx + 4 <= nbElements; idx += 4) {
+                acc0 = mixLane(acc0, getLane(data[idx]));
+                acc1 = mixLane(acc1, getLane(data[idx + 1]));
+                acc2 = mixLane(acc2, getLane(data[idx + 2]));
+                acc3 = mixLane(acc3, getLane(data[idx + 3]));
+            }
+
+            uint64_t hash =
+                rotl(acc0, 1) + rotl(acc1, 7) + rotl(acc2, 12) + rotl(acc3, 18);
+
+            // Remaining elements
+            for (; idx < nbElements; idx++) {
+                hash ^= mixLane(0, getLane(data[idx]));
+                hash = rotl(hash, 27) * PRIME_1 + PRIME_4;
+            }
+
+            hash += nbElements;
+            return avalanche(hash);
+        }
+
+        /**
+         * \brief Combine the hashes of consecutive blocks into a single hash.
+         *
+         * The combination depends on the order of blocks.
+         *
+         * \param[in] seed the initial value of the hash.
+         * \param[in] blockHashes pointer to the hashes of the blocks, in order.
+         * \param[in] nbBlocks number of blocks.
+         * \return the combined hash.
+         */
+        inline uint64_t combine(uint64_t seed, const uint64_t* blockHashes,
+                                size_t nbBlocks)
+        {
+            uint64_t hash = seed + PRIME_4;
+            for (size_t block = 0; block < nbBlocks; block++) {
+                hash = mixLane(hash, blockHashes[block]);
+            }
+            return avalanche(hash ^ nbBlocks);
+        }
+
+        /**
+         * \brief Compute the hash of each block of an array.
+         *
+         * \param[in] data random access iterator to the first element of the
+         * array.
+         * \param[in] nbElements number of elements in the array.
+         * \param[out] blockHashes vector filled with the hash of each block.
+         */
+        template <class Iterator>
+        inline void hashBlocks(Iterator data, size_t nbElements,
+                               std::vector<uint64_t>& blockHashes)
+        {
+            size_t nbBlocks = (nbElements + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            blockHashes.resize(nbBlocks);
+            for (size_t block = 0; block < nbBlocks; block++) {
+                size_t first = block * BLOCK_SIZE;
+                size_t size = std::min(BLOCK_SIZE, nbElements - first);
+                blockHashes[block] = hashBlock(data + first, size);
+            }
+        }
+    } // namespace BlockHash
+} // namespace Data
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+#ifndef DATA_DELTA_H
+#define DATA_DELTA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util/memoryFootprint.h"
+
+namespace Data {
+    /**
+     * \brief Differences between two states of a DataHandler.
+     *
+     * The data of a DataHandler is divided into blocks, and a DataDelta holds
+     * the raw content of the blocks of a state differing from a base state.
+     * Applying the DataDelta to a copy of the base state restores the other
+     * state exactly.
+     *
+     * DataDelta are built with the DataHandler::getDelta() method, and
+     * applied with the DataHandler::applyDelta() method.
+     */
+    typedef struct DataDelta
+    {
+        /// Index of each block differing from the base state, in order.
+        std::vector<size_t> blocks;
+
+        /// Raw content of the differing blocks, one after the other.
+        std::vector<uint8_t> bytes;
+
+        /**
+         * \brief Get the memory used by the DataDelta.
+         *
+         * \return a MemoryFootprint with the "object", the "blocks" indexes
+         * and the "bytes" of the DataDelta.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const
+        {
+            Util::MemoryFootprint footprint;
+            footprint.add("object", sizeof(DataDelta));
+            footprint.add("blocks",
+                          Util::MemoryFootprint::getHeapBytes(this->blocks));
+            footprint.add("bytes",
+                          Util::MemoryFootprint::getHeapBytes(this->bytes));
+            return footprint;
+        }
+    } DataDelta;
+} // namespace Data
+
+#endif
@@ -43,7 +43,9 @@
 #include <typeinfo>
 #include <vector>
 
+#include "data/dataDelta.h"
 #include "data/untypedSharedPtr.h"
+#include "util/memoryFootprint.h"
 
 namespace Data {
     /**
@@ -190,6 +192,52 @@ namespace Data {
          */
         virtual void resetData() = 0;
 
+        /**
+         * \brief Get the memory used by the DataHandler.
+         *
+         * The footprint contains the "object" component, the size of the
+         * DataHandler itself, and the buffers owned by the DataHandler, if
+         * any. Data which is only pointed by the DataHandler is not counted.
+         *
+         * The default implementation only counts the size of the base
+         * DataHandler class, and should be specialized by DataHandler owning
+         * data.
+         *
+         * \return the MemoryFootprint of the DataHandler.
+         */
+        virtual Util::MemoryFootprint getMemoryFootprint() const;
+
+        /**
+         * \brief Get the differences between this DataHandler and a base
+         * DataHandler.
+         *
+         * Applying the returned DataDelta to a clone of the base with the
+         * applyDelta() method restores the data of this DataHandler.
+         *
+         * The default implementation does not support delta encoding, and
+         * should be specialized by DataHandler storing their data in
+         * contiguous blocks.
+         *
+         * \param[in] base a DataHandler with the same ID, type and size.
+         * \return the DataDelta, or nullptr if this DataHandler can not be
+         * encoded against the base.
+         */
+        virtual std::unique_ptr<DataDelta> getDelta(
+            const DataHandler& base) const;
+
+        /**
+         * \brief Overwrite the data of the DataHandler with the content of a
+         * DataDelta.
+         *
+         * This method shall invalidate the cachedHash.
+         *
+         * \param[in] delta a DataDelta returned by the getDelta() method of a
+         * DataHandler, with this DataHandler as a base.
+         * \throws std::runtime_error if the DataHandler does not support delta
+         * encoding.
+         */
+        virtual void applyDelta(const DataDelta& delta);
+
         /**
          * \brief Get data of the given type, from the given address.
          *
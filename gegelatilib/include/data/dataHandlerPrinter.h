@@ -48,10 +48,35 @@ namespace Data {
      */
     class DataHandlerPrinter
     {
+      protected:
+        /**
+         * \brief Name of the variable holding the number of lanes of batched
+         * data in the generated code.
+         *
+         * When empty, data is accessed with nameVar[idx]. Otherwise, data is
+         * stored as a structure of arrays, and element idx of a lane is
+         * accessed with nameVar[idx * nbLanes + lane].
+         */
+        std::string nbLanes;
+
+        /// Name of the variable holding the accessed lane in generated code.
+        std::string lane;
+
       public:
         /// Constructor for the DataHandlerPrinter
         DataHandlerPrinter() = default;
 
+        /**
+         * \brief Constructor for a DataHandlerPrinter accessing batched data.
+         *
+         * \param[in] nbLanes name of the variable holding the number of lanes
+         * of the data in the generated code.
+         * \param[in] lane name of the variable holding the accessed lane in
+         * the generated code.
+         */
+        DataHandlerPrinter(const std::string& nbLanes, const std::string& lane)
+            : nbLanes{nbLanes}, lane{lane} {};
+
         /// destructor
         virtual ~DataHandlerPrinter() = default;
 
@@ -118,6 +143,18 @@ namespace Data {
                                  const std::vector<size_t>& generatedTabSize,
                                  const std::string& nameVar) const;
 
+        /**
+         * \brief Function that returns the access to an element of a
+         * variable.
+         *
+         * \param[in] idx the index of the accessed element.
+         * \param[in] nameVar the name of the accessed variable.
+         * \return nameVar[idx], or the strided access to the element of the
+         * lane for a DataHandlerPrinter accessing batched data.
+         */
+        std::string printElement(const size_t& idx,
+                                 const std::string& nameVar) const;
+
         /**
          * \brief function used to retrieve the typename of the template of the
          * DataHandler.
@@ -0,0 +1,168 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef OPERAND_TYPE_REGISTRY_H
+#define OPERAND_TYPE_REGISTRY_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#include "data/demangle.h"
+
+namespace Data {
+    /**
+     * \brief Immutable description of a data type accessed by Instructions.
+     *
+     * For c-style array types, the description gives the type of elements
+     * and the size of each array dimension. Non-array types are described
+     * with no dimension, their element type being the type itself.
+     */
+    typedef struct OperandType
+    {
+        /// The described type.
+        const std::type_info& type;
+
+        /// Human readable name of the element type, without const qualifier.
+        const std::string elementName;
+
+        /// Number of array dimensions of the type, 0 for non-array types.
+        const size_t nbDimensions;
+
+        /// Size of the first array dimension, if any, 0 otherwise.
+        const size_t dim1;
+
+        /// Size of the second array dimension, if any, 0 otherwise.
+        const size_t dim2;
+
+        /// Next description in the OperandTypeRegistry.
+        const OperandType* const next;
+    } OperandType;
+
+    /**
+     * \brief Process-wide registry of OperandType descriptions.
+     *
+     * This registry is used by DataHandlers to know whether a requested
+     * type is an array of the data they contain, without analysing the name
+     * of the type at each request.
+     *
+     * Types are registered at compile time by Instructions whose operand
+     * types are template parameters, like the LambdaInstruction. Types that
+     * were not registered are described once from their demangled name, on
+     * their first request.
+     *
+     * Descriptions are never modified nor removed once registered. Looking
+     * for a description does not require any lock, so DataHandlers can
+     * query the registry concurrently from several threads.
+     */
+    class OperandTypeRegistry
+    {
+      protected:
+        /// Last registered description, head of the list of descriptions.
+        static std::atomic<const OperandType*> head;
+
+        /// Mutex protecting the registration of new descriptions.
+        static std::mutex registrationMutex;
+
+        /**
+         * \brief Look for the description of a type without registering it.
+         *
+         * \param[in] type the described type.
+         * \return a pointer to the description, or nullptr if the type is not
+         * registered.
+         */
+        static const OperandType* find(const std::type_info& type);
+
+        /**
+         * \brief Register a new description, unless the type is already
+         * registered.
+         *
+         * \return a reference to the registered description.
+         */
+        static const OperandType& add(const std::type_info& type,
+                                      const std::string& elementName,
+                                      size_t nbDimensions, size_t dim1,
+                                      size_t dim2);
+
+        /**
+         * \brief Build the description of a type from its demangled name.
+         *
+         * Names of one or two dimensional arrays, with an optional const
+         * qualifier, are recognized. Other names are described as non-array
+         * types.
+         */
+        static const OperandType& parse(const std::type_info& type);
+
+      public:
+        /// Registering is done through static methods only.
+        OperandTypeRegistry() = delete;
+
+        /**
+         * \brief Register the description of the type U.
+         *
+         * The description is deduced at compile time from the type.
+         *
+         * \return a reference to the registered description.
+         */
+        template <class U> static const OperandType& registerType()
+        {
+            const OperandType* existing = find(typeid(U));
+            if (existing != nullptr) {
+                return *existing;
+            }
+
+            typedef std::remove_cv_t<std::remove_all_extents_t<U>> Element;
+            constexpr size_t nbDimensions = std::rank_v<U>;
+            return add(typeid(U), DEMANGLE_TYPEID_NAME(typeid(Element).name()),
+                       nbDimensions, std::extent_v<U, 0>, std::extent_v<U, 1>);
+        }
+
+        /**
+         * \brief Get the description of the given type.
+         *
+         * If the type was not registered yet, its description is built from
+         * its demangled name, and registered.
+         *
+         * \param[in] type the described type.
+         * \return a reference to the description of the type.
+         */
+        static const OperandType& get(const std::type_info& type);
+    };
+} // namespace Data
+
+#endif
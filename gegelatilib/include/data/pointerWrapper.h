@@ -36,6 +36,7 @@
 #ifndef POINTER_WRAPPER_H
 #define POINTER_WRAPPER_H
 
+#include "data/blockHash.h"
 #include "data/constant.h"
 #include "data/dataHandler.h"
 #include "data/hash.h"
@@ -115,6 +116,9 @@ namespace Data {
         /// Inherited from DataHandler. Does nothing.
         void resetData() override;
 
+        /// Inherited from DataHandler. The pointed data is not counted.
+        virtual Util::MemoryFootprint getMemoryFootprint() const override;
+
         /**
          * \brief Set the pointer of the PointerWrapper.
          *
@@ -151,14 +155,11 @@ namespace Data {
     {
         if (this->containerPtr != nullptr) {
 
-            // reset
-            this->cachedHash = Data::Hash<size_t>()(this->id);
-
-            // Rotate by 1 because otherwise, xor is comutative.
-            this->cachedHash =
-                (this->cachedHash >> 1) | (this->cachedHash << 63);
-
-            this->cachedHash ^= Data::Hash<T>()(*this->containerPtr);
+            // Same hash as a PrimitiveTypeArray with a single element, so
+            // that clones keep the hash of the PointerWrapper.
+            uint64_t blockHash = BlockHash::hashBlock(this->containerPtr, 1);
+            this->cachedHash = (size_t)BlockHash::combine(
+                Data::Hash<size_t>()(this->id), &blockHash, 1);
             return this->cachedHash;
         }
         else {
@@ -209,6 +210,14 @@ namespace Data {
         // Does nothing
     }
 
+    template <class T>
+    inline Util::MemoryFootprint PointerWrapper<T>::getMemoryFootprint() const
+    {
+        Util::MemoryFootprint footprint;
+        footprint.add("object", sizeof(PointerWrapper<T>));
+        return footprint;
+    }
+
     template <class T> inline void PointerWrapper<T>::setPointer(T* ptr)
     {
         this->containerPtr = ptr;
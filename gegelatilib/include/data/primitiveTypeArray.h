@@ -89,6 +89,14 @@ namespace Data {
          */
         void resetData() override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * In addition to the components of the ArrayWrapper, the footprint
+         * contains the "data" owned by the PrimitiveTypeArray.
+         */
+        virtual Util::MemoryFootprint getMemoryFootprint() const override;
+
         /**
          * \brief Set the data at the given address to the given value.
          *
@@ -109,6 +117,22 @@ namespace Data {
          */
         void setDataAt(const std::type_info& type, const size_t address,
                        const T& value);
+
+        /**
+         * \brief Get a const reference to the native data at the given
+         * address.
+         *
+         * Contrary to the getDataAt() method, this typed accessor does not
+         * wrap the accessed data into an UntypedSharedPtr, and can thus be
+         * used on performance critical paths by code knowing the native type
+         * of the PrimitiveTypeArray, such as LearningEnvironment.
+         *
+         * \param[in] address the location of the accessed data.
+         * \return a const reference to the data.
+         * \throws std::out_of_range if the given address is invalid.
+         */
+        const T& getNativeDataAt(const size_t address) const;
+
         /**
          * \brief Assignement Operator for PrimitiveTypeArray<T>
          *
@@ -138,8 +162,8 @@ namespace Data {
         const PrimitiveTypeArray<T>& other)
         : ArrayWrapper<T>(other), data(other.data)
     {
-        // Set the pointer to the right data
-        this->setPointer(&(this->data));
+        // Set the pointer to the right data, keeping the hash of other.
+        this->setPointerToCopy(&(this->data));
     }
 
     template <class T>
@@ -159,7 +183,7 @@ namespace Data {
         }
 
         // Set the pointer to the right data
-        this->setPointer(&(this->data));
+        this->setPointerToCopy(&(this->data));
     }
 
     template <class T>
@@ -193,7 +217,16 @@ namespace Data {
         }
 
         // Invalidate the cached hash
-        this->invalidCachedHash = true;
+        this->invalidateCachedHash();
+    }
+
+    template <class T>
+    Util::MemoryFootprint PrimitiveTypeArray<T>::getMemoryFootprint() const
+    {
+        Util::MemoryFootprint footprint = ArrayWrapper<T>::getMemoryFootprint();
+        footprint.set("object", sizeof(PrimitiveTypeArray<T>));
+        footprint.add("data", Util::MemoryFootprint::getHeapBytes(this->data));
+        return footprint;
     }
 
     template <class T>
@@ -207,9 +240,17 @@ namespace Data {
 
         this->data.at(address) = value;
 
-        // Invalidate the cached hash.
-        this->invalidCachedHash = true;
+        // Invalidate the cached hash of the modified block only.
+        this->invalidateCachedHash(address);
     }
+
+    template <class T>
+    inline const T& PrimitiveTypeArray<T>::getNativeDataAt(
+        const size_t address) const
+    {
+        return this->data.at(address);
+    }
+
     template <class T>
     PrimitiveTypeArray<T>& PrimitiveTypeArray<T>::operator=(
         const PrimitiveTypeArray<T>& other)
@@ -228,6 +269,9 @@ namespace Data {
             for (auto i = 0; i < this->nbElements; i++) {
                 this->data.at(i) = other.data.at(i);
             }
+
+            // Invalidate the cached hash
+            this->invalidateCachedHash();
         }
         return *this;
     }
@@ -100,6 +100,14 @@ namespace Data {
          */
         void resetData() override;
 
+        /**
+         * \brief Inherited from DataHandler.
+         *
+         * In addition to the components of the ArrayWrapper, the footprint
+         * contains the "data" owned by the PrimitiveTypeArray2D.
+         */
+        virtual Util::MemoryFootprint getMemoryFootprint() const override;
+
         /**
          * \brief Set the data at the given address to the given value.
          *
@@ -152,8 +160,8 @@ namespace Data {
         const PrimitiveTypeArray2D<T>& other)
         : Array2DWrapper<T>(other), data(other.data)
     {
-        // Set the pointer to the right data
-        this->setPointer(&(this->data));
+        // Set the pointer to the right data, keeping the hash of other.
+        this->setPointerToCopy(&(this->data));
     }
 
     template <class T>
@@ -174,7 +182,7 @@ namespace Data {
         }
 
         // Set the pointer to the right data
-        this->setPointer(&(this->data));
+        this->setPointerToCopy(&(this->data));
     }
 
     template <typename T>
@@ -193,7 +201,16 @@ namespace Data {
         }
 
         // Invalidate the cached hash
-        this->invalidCachedHash = true;
+        this->invalidateCachedHash();
+    }
+
+    template <class T>
+    Util::MemoryFootprint PrimitiveTypeArray2D<T>::getMemoryFootprint() const
+    {
+        Util::MemoryFootprint footprint = ArrayWrapper<T>::getMemoryFootprint();
+        footprint.set("object", sizeof(PrimitiveTypeArray2D<T>));
+        footprint.add("data", Util::MemoryFootprint::getHeapBytes(this->data));
+        return footprint;
     }
 
     template <class T>
@@ -208,8 +225,8 @@ namespace Data {
 
         this->data.at(address) = value;
 
-        // Invalidate the cached hash.
-        this->invalidCachedHash = true;
+        // Invalidate the cached hash of the modified block only.
+        this->invalidateCachedHash(address);
     }
 
     template <class T>
@@ -230,6 +247,9 @@ namespace Data {
             for (auto i = 0; i < this->nbElements; i++) {
                 this->data.at(i) = other.data.at(i);
             }
+
+            // Invalidate the cached hash
+            this->invalidateCachedHash();
         }
         return *this;
     }
@@ -0,0 +1,213 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef SNAPSHOT_STORE_H
+#define SNAPSHOT_STORE_H
+
+#include <memory>
+#include <unordered_map>
+
+#include "data/dataDelta.h"
+#include "data/dataHandler.h"
+
+namespace Data {
+    /**
+     * \brief Store of immutable DataHandler copies shared between recordings.
+     *
+     * Each distinct DataHandler state, identified by its DataHandler::getHash()
+     * value, is stored only once in the SnapshotStore, and the snapshot is
+     * shared by all the users acquiring an identical state. A reference
+     * counter is associated to each snapshot, which is freed when its last
+     * reference is released.
+     *
+     * Since the hash of a DataHandler depends on its identifier, DataHandlers
+     * coming from different sources are never merged, even when they contain
+     * the same data. On the contrary, when several sources are recorded
+     * together, unchanged sources share a single snapshot.
+     *
+     * When delta encoding is enabled, successive states of a source are
+     * stored as a DataDelta against a full copy of an earlier state of the
+     * same source, called the base. A state is copied fully, and becomes the
+     * new base of its source, when its DataDelta would not be at least twice
+     * smaller than a copy, or when the DataHandler does not support delta
+     * encoding. Delta-encoded snapshots must be materialized with the
+     * materialize() method to be read.
+     */
+    class SnapshotStore
+    {
+      protected:
+        /// Snapshot and number of references to it.
+        typedef struct Snapshot
+        {
+            /**
+             * \brief Copy of the DataHandler owned by the store.
+             *
+             * The copy is nullptr for delta-encoded snapshots.
+             */
+            std::unique_ptr<const DataHandler> copy;
+
+            /// Differences with the base, for delta-encoded snapshots.
+            std::unique_ptr<const DataDelta> delta;
+
+            /// Hash of the base of a delta-encoded snapshot.
+            size_t baseHash;
+
+            /**
+             * \brief Number of references to the snapshot.
+             *
+             * Each delta-encoded snapshot holds a reference to its base.
+             */
+            size_t nbReferences;
+        } Snapshot;
+
+        /// Whether new snapshots are delta-encoded when possible.
+        const bool deltaEncoding;
+
+        /// Snapshots indexed by the hash of their DataHandler.
+        std::unordered_map<size_t, Snapshot> snapshots;
+
+        /// Hash of the current base of each source, indexed by its ID.
+        std::unordered_map<size_t, size_t> bases;
+
+      public:
+        /**
+         * \brief Main constructor of the SnapshotStore.
+         *
+         * \param[in] deltaEncoding whether new snapshots are delta-encoded
+         * against the base of their source when possible.
+         */
+        SnapshotStore(bool deltaEncoding = false)
+            : deltaEncoding{deltaEncoding} {};
+
+        /// Copy is disabled as snapshots are owned by their SnapshotStore.
+        SnapshotStore(const SnapshotStore& other) = delete;
+
+        /**
+         * \brief Store a snapshot of the given DataHandler.
+         *
+         * If no snapshot with the hash of the given DataHandler is stored, a
+         * clone or a DataDelta of the DataHandler is created. Otherwise, the
+         * number of references of the existing snapshot is incremented.
+         *
+         * \param[in] dataHandler the DataHandler whose state is stored.
+         * \return the hash identifying the snapshot.
+         */
+        size_t acquire(const DataHandler& dataHandler);
+
+        /**
+         * \brief Take a reference to a snapshot acquired in another
+         * SnapshotStore.
+         *
+         * This method behaves as the acquire() method, except that instead of
+         * cloning the DataHandler when needed, the snapshot owned by the other
+         * SnapshotStore, and its base if it is delta-encoded, are moved into
+         * this one. The address of a moved copy is not changed, but the other
+         * SnapshotStore no longer owns it and must be cleared before any new
+         * use.
+         *
+         * \param[in,out] other the SnapshotStore holding the snapshot.
+         * \param[in] hash the hash of a snapshot of the other SnapshotStore.
+         * \throw std::out_of_range if the snapshot is not owned by the other
+         * SnapshotStore.
+         */
+        void adopt(SnapshotStore& other, size_t hash);
+
+        /**
+         * \brief Release a reference to a snapshot.
+         *
+         * The snapshot is freed if this was its last reference.
+         *
+         * \param[in] hash the hash of a snapshot of the store.
+         * \throw std::out_of_range if the snapshot is not in the store.
+         */
+        void release(size_t hash);
+
+        /**
+         * \brief Get the copy of a snapshot.
+         *
+         * The returned copy can be read directly, without any copy, as long
+         * as the snapshot is not released.
+         *
+         * \param[in] hash the hash of a snapshot of the store.
+         * \return a pointer to the copy, or nullptr if the snapshot is
+         * delta-encoded.
+         * \throw std::out_of_range if the snapshot is not in the store.
+         */
+        const DataHandler* get(size_t hash) const;
+
+        /**
+         * \brief Get a readable DataHandler for a snapshot.
+         *
+         * The copy of a snapshot that is not delta-encoded is returned
+         * directly. Otherwise, the base of the snapshot is cloned into the
+         * given buffer, and the DataDelta of the snapshot is applied to it.
+         *
+         * \param[in] hash the hash of a snapshot of the store.
+         * \param[in,out] buffer owner of the materialized DataHandler, if
+         * needed. Its previous content may be freed.
+         * \return a reference to a DataHandler in the state of the snapshot,
+         * valid until the snapshot is released or the buffer is modified.
+         * \throw std::out_of_range if the snapshot is not in the store.
+         */
+        const DataHandler& materialize(
+            size_t hash, std::unique_ptr<DataHandler>& buffer) const;
+
+        /// Check whether new snapshots are delta-encoded when possible.
+        bool isDeltaEncoding() const;
+
+        /// Get the number of distinct snapshots held in the store.
+        size_t getNbSnapshots() const;
+
+        /// Get the number of delta-encoded snapshots held in the store.
+        size_t getNbDeltas() const;
+
+        /// Get the number of references to a snapshot with the given hash.
+        size_t getNbReferences(size_t hash) const;
+
+        /**
+         * \brief Get the memory used by the SnapshotStore.
+         *
+         * \return a MemoryFootprint with the "index" of snapshots and bases,
+         * the DataHandler "copies" and the "deltas" owned by the store.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+
+        /// Free all snapshots, regardless of their number of references.
+        void clear();
+    };
+} // namespace Data
+
+#endif
@@ -39,6 +39,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <memory>
 
 #include "data/constantHandler.h"
 #include "data/dataHandler.h"
@@ -46,6 +47,11 @@
 #include "instructions/instruction.h"
 #include "instructions/set.h"
 
+namespace Program {
+    // Declaration to avoid circular includes.
+    class SuperinstructionSet;
+} // namespace Program
+
 /// LineSize structure to be used within the Environment.
 typedef struct LineSize
 {
@@ -121,6 +127,45 @@ class Environment
     /// Size of lines within this Environment
     const LineSize lineSize;
 
+    /**
+     * \brief Address space of each data source, for each operand of each
+     * Instruction.
+     *
+     * operandAddressSpaces[i][o][d] is the address space of the dth fake data
+     * source for the type of the oth operand of the ith Instruction, or 0 if
+     * the data source can not provide this type.
+     */
+    std::vector<std::vector<std::vector<size_t>>> operandAddressSpaces;
+
+    /**
+     * \brief Whether Programs are compiled into a Program::BytecodeProgram
+     * when they are optimized.
+     *
+     * Contrary to other attributes, the execution mode does not change the
+     * behavior of Programs and can therefore be modified after construction.
+     */
+    bool bytecodeExecution = false;
+
+    /// Superinstructions fused when compiling Programs into bytecode.
+    std::shared_ptr<const Program::SuperinstructionSet> superinstructions;
+
+    /**
+     * \brief Sorted indexes of the data sources able to provide each operand
+     * of each Instruction.
+     *
+     * operandDataSources[i][o] lists the indexes of fake data sources whose
+     * address space for the oth operand of the ith Instruction is not null.
+     */
+    std::vector<std::vector<std::vector<uint64_t>>> operandDataSources;
+
+    /**
+     * \brief Fill the operandAddressSpaces and operandDataSources tables.
+     *
+     * This method is called once, when constructing the Environment, after
+     * the fakeDataSources are set.
+     */
+    void computeOperandTables();
+
     /**
      * \brief Static method used when constructing a new Environment to compute
      * the largest AddressSpace of a set of DataHandler.
@@ -222,6 +267,8 @@ class Environment
 
         for (auto& elem : this->dataSources)
             this->fakeDataSources.push_back(elem);
+
+        this->computeOperandTables();
     };
 
     /**
@@ -295,6 +342,39 @@ class Environment
     const std::vector<std::reference_wrapper<const Data::DataHandler>>&
     getFakeDataSources() const;
 
+    /**
+     * \brief Get the indexes of the data sources able to provide an operand
+     * of an Instruction.
+     *
+     * Indexes refer to the fake data sources of the Environment, and are
+     * sorted in increasing order. Since all Instruction of an Environment are
+     * filtered at construction, the returned list is never empty for a valid
+     * operand.
+     *
+     * \param[in] instructionIndex the index of the Instruction.
+     * \param[in] operandIndex the index of the operand of the Instruction.
+     * \return a const reference to the list of valid data source indexes.
+     * \throw std::out_of_range if the Instruction or operand does not exist.
+     */
+    const std::vector<uint64_t>& getOperandDataSources(
+        uint64_t instructionIndex, uint64_t operandIndex) const;
+
+    /**
+     * \brief Get the address space of a data source for an operand of an
+     * Instruction.
+     *
+     * \param[in] instructionIndex the index of the Instruction.
+     * \param[in] operandIndex the index of the operand of the Instruction.
+     * \param[in] dataSourceIndex the index of the fake data source.
+     * \return the address space of the data source for the operand type, 0
+     * if the data source can not provide this type.
+     * \throw std::out_of_range if the Instruction, operand, or data source
+     * does not exist.
+     */
+    size_t getOperandAddressSpace(uint64_t instructionIndex,
+                                  uint64_t operandIndex,
+                                  uint64_t dataSourceIndex) const;
+
     /**
      * \brief Get the Instruction Set of the Environment.
      *
@@ -302,6 +382,37 @@ class Environment
      * Environment.
      */
     const Instructions::Set& getInstructionSet() const;
+
+    /**
+     * \brief Select the execution mode of Programs within this Environment.
+     *
+     * When the bytecode execution is enabled, Programs optimized afterwards
+     * with the Program::Program::optimize() method are also compiled into a
+     * Program::BytecodeProgram, which the Program::ProgramExecutionEngine
+     * executes with results identical to those of the Program Lines.
+     * Programs optimized before the call are not affected.
+     *
+     * \param[in] enabled whether the bytecode execution is enabled.
+     * \param[in] superinstructions pairs of Instructions fused into a single
+     * handler when compiling Programs, as profiled by
+     * Program::SuperinstructionSet::profile(). No Instruction is fused if
+     * nullptr.
+     */
+    void setBytecodeExecution(
+        bool enabled,
+        std::shared_ptr<const Program::SuperinstructionSet> superinstructions =
+            nullptr);
+
+    /// Check whether the bytecode execution of Programs is enabled.
+    bool isBytecodeExecution() const;
+
+    /**
+     * \brief Get the superinstructions used for the bytecode execution.
+     *
+     * \return a pointer to the Program::SuperinstructionSet, or nullptr if
+     * none was given.
+     */
+    const Program::SuperinstructionSet* getSuperinstructions() const;
 };
 
 #endif
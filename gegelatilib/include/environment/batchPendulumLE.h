@@ -0,0 +1,240 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef BATCH_PENDULUM_LE_H
+#define BATCH_PENDULUM_LE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "data/primitiveTypeArray.h"
+#include "environment/pendulumLE.h"
+#include "learn/batchLearningEnvironment.h"
+#include "learn/learningEnvironment.h"
+#include "mutator/rng.h"
+
+/**
+ * \brief Inverted pendulum environment simulating several episodes in
+ * lockstep.
+ *
+ * Each of the nbLanes lanes of the BatchPendulumLE behaves exactly as a
+ * PendulumLE, and produces bit-identical states, rewards and scores when
+ * reset with the same seed and given the same actions.
+ *
+ * The state of all lanes is stored in a structure-of-arrays fashion: angles,
+ * velocities, rewards accumulators and reward-window sums of all lanes are
+ * stored in contiguous vectors, and are updated by the doActions() method in
+ * simple loops over all lanes, which the compiler can vectorize. The sum of
+ * the rewards in the stability window of each lane is maintained
+ * incrementally, so that the termination of each lane is known in constant
+ * time after each step.
+ *
+ * Lanes whose episode is terminated, or which were not reset since the
+ * construction of the environment, are frozen: actions given to these lanes
+ * are ignored.
+ */
+class BatchPendulumLE : public Learn::BatchLearningEnvironment
+{
+  protected:
+    /// Torque associated to each action ID of the environment.
+    std::vector<double> actionTorques;
+
+    /// Randomness control, reseeded when resetting a lane.
+    Mutator::RNG rng;
+
+    /// Current angle of each lane.
+    std::vector<double> angles;
+
+    /// Current velocity of each lane.
+    std::vector<double> velocities;
+
+    /// Torque applied to each lane during the current step.
+    std::vector<double> torques;
+
+    /// Reward obtained by each lane during the current step.
+    std::vector<double> rewards;
+
+    /// Total reward accumulated by each lane since its last reset.
+    std::vector<double> totalRewards;
+
+    /// Sum of the rewards stored in the reward history of each lane.
+    std::vector<double> rewardWindowSums;
+
+    /**
+     * \brief Reward history of all lanes.
+     *
+     * The REWARD_HISTORY_SIZE rewards of a lane are stored contiguously,
+     * starting at index lane * PendulumLE::REWARD_HISTORY_SIZE.
+     */
+    std::vector<double> rewardHistories;
+
+    /// Number of actions executed by each lane since its last reset.
+    std::vector<uint64_t> nbActionsExecuted;
+
+    /// Whether each lane is frozen (terminated or never reset).
+    std::vector<uint8_t> terminalMask;
+
+    /**
+     * \brief DataHandler exposing the state of each lane to the TPG.
+     *
+     * The content of these DataHandler is refreshed from the structure of
+     * arrays each time a lane is reset or performs an action.
+     */
+    std::vector<Data::PrimitiveTypeArray<double>> laneStates;
+
+    /// Copy the state of a lane from the structure of arrays to its
+    /// DataHandler.
+    void updateLaneState(size_t lane);
+
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] actions the available actions, as in the PendulumLE.
+     * \param[in] nbLanes the number of episodes simulated in lockstep.
+     * \throws std::runtime_error if nbLanes is 0.
+     */
+    BatchPendulumLE(const std::vector<double>& actions, size_t nbLanes);
+
+    /**
+     * \brief Constructor of a BatchPendulumLE running lanes of the given
+     * PendulumLE.
+     *
+     * The data sources of all lanes are copies of the data sources of the
+     * given PendulumLE, so that a LearningAgent trained with the PendulumLE
+     * can use this BatchPendulumLE for lockstep evaluations.
+     *
+     * \param[in] le the PendulumLE whose actions and data sources are used.
+     * \param[in] nbLanes the number of episodes simulated in lockstep.
+     * \throws std::runtime_error if nbLanes is 0.
+     */
+    BatchPendulumLE(PendulumLE& le, size_t nbLanes);
+
+    /// Default copy constructor.
+    BatchPendulumLE(const BatchPendulumLE& other) = default;
+
+    /// Inherited via BatchLearningEnvironment
+    virtual bool isCopyable() const override;
+
+    /// Inherited via BatchLearningEnvironment
+    virtual Learn::BatchLearningEnvironment* clone() const override;
+
+    /**
+     * \brief Reset a single lane of the environment.
+     *
+     * The initial state of the lane is identical to the one of a PendulumLE
+     * reset with the same arguments.
+     *
+     * \param[in] lane the index of the reset lane.
+     * \param[in] seed the integer value for controlling the randomness.
+     * \param[in] mode the LearningMode of the episode.
+     * \param[in] iterationNumber the iteration number of the episode.
+     * \param[in] generationNumber the generation number of the episode.
+     * \throws std::out_of_range if the lane does not exist.
+     */
+    void reset(size_t lane, size_t seed,
+               Learn::LearningMode mode = Learn::LearningMode::TRAINING,
+               uint16_t iterationNumber = 0, uint64_t generationNumber = 0);
+
+    /**
+     * \brief Reset several lanes of the environment at once.
+     *
+     * Lane i is reset with seeds[i]. Lanes with an index greater or equal to
+     * seeds.size() are frozen until their next reset.
+     *
+     * \param[in] seeds the seed of each reset lane.
+     * \param[in] mode the LearningMode of the episodes.
+     * \param[in] iterationNumber the iteration number of the episodes.
+     * \param[in] generationNumber the generation number of the episodes.
+     * \throws std::runtime_error if more seeds than lanes are given.
+     */
+    virtual void resetAll(
+        const std::vector<size_t>& seeds,
+        Learn::LearningMode mode = Learn::LearningMode::TRAINING,
+        uint16_t iterationNumber = 0, uint64_t generationNumber = 0) override;
+
+    /**
+     * \brief Execute one action on every non-terminated lane.
+     *
+     * \param[in] actionIDs the action ID executed by each lane. The IDs
+     * given to frozen lanes are ignored.
+     * \throws std::runtime_error if the number of action IDs differs from the
+     * number of lanes.
+     * \throws std::out_of_range if an action ID given to a non-terminated
+     * lane is invalid.
+     */
+    virtual void doActions(const std::vector<uint64_t>& actionIDs) override;
+
+    /**
+     * \brief Get the terminal mask of the lanes.
+     *
+     * The mask contains a non-zero value for each lane which is frozen,
+     * either because its pendulum was stabilized, or because it was not
+     * reset by the last call to resetAll().
+     */
+    virtual const std::vector<uint8_t>& getTerminalMask() const override;
+
+    /**
+     * \brief Is the pendulum of the given lane stabilized.
+     *
+     * Equivalent to the PendulumLE::isTerminal() method, in constant time.
+     */
+    bool isTerminal(size_t lane) const;
+
+    /// Equivalent to the PendulumLE::getScore() method for the given lane.
+    virtual double getScore(size_t lane) const override;
+
+    /// Getter for the angle of a lane.
+    double getAngle(size_t lane) const;
+
+    /// Getter for the velocity of a lane.
+    double getVelocity(size_t lane) const;
+
+    /// Number of actions executed by the lane since its last reset.
+    uint64_t getNbActionsExecuted(size_t lane) const;
+
+    /**
+     * \brief Get the data sources of a lane.
+     *
+     * The returned DataHandler contains the angle and the velocity of the
+     * lane, in the same order as in the PendulumLE.
+     */
+    virtual std::vector<std::reference_wrapper<const Data::DataHandler>>
+    getDataSources(size_t lane) override;
+};
+
+#endif
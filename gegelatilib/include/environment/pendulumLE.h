@@ -5,7 +5,13 @@
 #ifndef GEGELATI_PENDULUMLE_H
 #define GEGELATI_PENDULUMLE_H
 
-#include <gegelati.h>
+#include <cmath>
+#include <vector>
+
+#include "data/hash.h"
+#include "data/primitiveTypeArray.h"
+#include "learn/learningEnvironment.h"
+#include "mutator/rng.h"
 
 /**
 * \brief Inverted pendulum LearningEnvironment.
@@ -16,17 +22,57 @@
  */
 class PendulumLE : public Learn::LearningEnvironment
 {
-  private:
+  public:
     // Constants for the pendulum behavior
-    static const double MAX_SPEED;
-    static const double MAX_TORQUE;
-    static const double TIME_DELTA;
-    static const double G;
-    static const double MASS;
-    static const double LENGTH;
-    static const size_t REWARD_HISTORY_SIZE = 300;
-    static const double STABILITY_THRESHOLD;
+    static constexpr double MAX_SPEED = 8.0;
+    static constexpr double MAX_TORQUE = 2.0;
+    static constexpr double TIME_DELTA = 0.05;
+    static constexpr double G = 9.81;
+    static constexpr double MASS = 1.0;
+    static constexpr double LENGTH = 1.0;
+    static constexpr size_t REWARD_HISTORY_SIZE = 300;
+    static constexpr double STABILITY_THRESHOLD = 0.1;
+    static constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * \brief Reward obtained when applying a torque to the pendulum in the
+     * given state.
+     *
+     * This function is shared with the BatchPendulumLE, to guarantee that
+     * both environments produce bit-identical results.
+     *
+     * \param[in] angle the current angle of the pendulum.
+     * \param[in] velocity the current velocity of the pendulum.
+     * \param[in] torque the torque applied to the pendulum.
+     * \return the (non-positive) reward value.
+     */
+    static inline double computeReward(double angle, double velocity,
+                                       double torque)
+    {
+        double angleToUpward = fmod((angle + PI), (2.f * PI)) - PI;
+        return -((angleToUpward * angleToUpward) +
+                 0.1f * (velocity * velocity) + 0.001f * (torque * torque));
+    }
 
+    /**
+     * \brief Update the state of the pendulum when applying the given
+     * torque during TIME_DELTA.
+     *
+     * \param[in,out] angle the angle of the pendulum.
+     * \param[in,out] velocity the velocity of the pendulum.
+     * \param[in] torque the torque applied to the pendulum.
+     */
+    static inline void computeNextState(double& angle, double& velocity,
+                                        double torque)
+    {
+        velocity = velocity + ((-3.0) * G / (2.0 * LENGTH) * (sin(angle + PI)) +
+                               (3.f / (MASS * LENGTH * LENGTH)) * torque) *
+                                  TIME_DELTA;
+        velocity = std::fmin(std::fmax(velocity, -MAX_SPEED), MAX_SPEED);
+        angle = angle + velocity * TIME_DELTA;
+    }
+
+  private:
     /**
 	* \brief Available actions for the LearningAgent.
 	*
@@ -49,6 +95,17 @@ class PendulumLE : public Learn::LearningEnvironment
     /// Total reward accumulated since the last reset
     double totalReward = 0.0;
 
+    /**
+     * \brief Sum of the rewards currently stored in the rewardHistory.
+     *
+     * This sum is updated incrementally by the doAction() method, so that
+     * the isTerminal() method does not need to sum the whole history at each
+     * call. To prevent the accumulation of rounding errors, the sum is
+     * recomputed from scratch each time the history wraps around, which
+     * keeps the cost amortized constant.
+     */
+    double rewardWindowSum = 0.0;
+
     /// Number of actions since the last reset
     uint64_t nbActionsExecuted = 0;
 
@@ -90,6 +147,12 @@ class PendulumLE : public Learn::LearningEnvironment
     /// Getter for velocity
     double getVelocity() const;
 
+    /// Getter for the number of actions executed since the last reset.
+    uint64_t getNbActionsExecuted() const;
+
+    /// Getter for the available actions given at construction.
+    const std::vector<double>& getAvailableActions() const;
+
     /// Inherited via LearningEnvironment
     std::vector<std::reference_wrapper<const Data::DataHandler>> getDataSources() override;
 
@@ -46,17 +46,22 @@
 #ifndef GEGELATI_H
 #define GEGELATI_H
 
+#include <util/memoryFootprint.h>
 #include <util/timestamp.h>
 
 #include <data/array2DWrapper.h>
 #include <data/arrayWrapper.h>
+#include <data/blockHash.h>
 #include <data/constant.h>
 #include <data/constantHandler.h>
+#include <data/dataDelta.h>
 #include <data/dataHandler.h>
 #include <data/hash.h>
+#include <data/operandTypeRegistry.h>
 #include <data/pointerWrapper.h>
 #include <data/primitiveTypeArray.h>
 #include <data/primitiveTypeArray2D.h>
+#include <data/snapshotStore.h>
 #include <data/untypedSharedPtr.h>
 
 #include <file/parametersParser.h>
@@ -69,11 +74,14 @@
 #include <instructions/multByConstant.h>
 #include <instructions/set.h>
 
+#include <learn/decimationEngine.h>
 #include <learn/evaluationResult.h>
+#include <learn/evaluationTable.h>
 #include <learn/job.h>
 #include <learn/learningAgent.h>
 #include <learn/learningEnvironment.h>
 #include <learn/learningParameters.h>
+#include <learn/matchTable.h>
 #include <learn/parallelLearningAgent.h>
 #include <learn/CLagent.h>
 
@@ -82,6 +90,7 @@
 #include <learn/adversarialLearningAgent.h>
 #include <learn/adversarialLearningEnvironment.h>
 
+#include <learn/batchLearningEnvironment.h>
 #include <learn/classificationEvaluationResult.h>
 #include <learn/classificationLearningAgent.h>
 #include <learn/classificationLearningEnvironment.h>
@@ -89,19 +98,27 @@
 #include <log/cycleDetectionLALogger.h>
 #include <log/laBasicLogger.h>
 #include <log/laLogger.h>
+#include <log/laMemoryLogger.h>
+#include <log/laPerfCounterLogger.h>
 #include <log/laPolicyStatsLogger.h>
 #include <log/logger.h>
+#include <log/perfCounters.h>
+#include <log/traceRecorder.h>
 
+#include <mutator/counterEngine.h>
 #include <mutator/lineMutator.h>
 #include <mutator/mutationParameters.h>
 #include <mutator/programMutator.h>
 #include <mutator/rng.h>
 #include <mutator/tpgMutator.h>
 
+#include <program/bytecodeProgram.h>
 #include <program/line.h>
+#include <program/optimizedProgram.h>
 #include <program/program.h>
 #include <program/programEngine.h>
 #include <program/programExecutionEngine.h>
+#include <program/superinstructionSet.h>
 
 #include <tpg/policyStats.h>
 #include <tpg/tpgAbstractEngine.h>
@@ -121,6 +138,7 @@
 #include <tpg/instrumented/tpgTeamInstrumented.h>
 #include <tpg/instrumented/tpgVertexInstrumentation.h>
 
+#include <environment/batchPendulumLE.h>
 #include <environment/pendulumLE.h>
 
 #ifdef CODE_GENERATION
@@ -129,9 +147,11 @@
 #include <codeGen/tpgGenerationEngineFactory.h>
 #include <codeGen/tpgStackGenerationEngine.h>
 #include <codeGen/tpgSwitchGenerationEngine.h>
+#include <codeGen/tpgTableGenerationEngine.h>
 #endif
 
 #include <archive.h>
+#include <shardedArchive.h>
 #include <environment.h>
 
 #endif
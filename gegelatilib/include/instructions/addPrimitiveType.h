@@ -80,6 +80,9 @@ namespace Instructions {
         virtual double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const override;
 
+        /// Inherited from Instruction
+        virtual ScalarFunction getScalarFunction() const override;
+
       private:
         /**
          * \brief Function call in constructor to setup the operand
@@ -108,6 +111,19 @@ namespace Instructions {
                (double)*(args.at(1).getSharedPointer<const T>());
     }
 
+    template <class T>
+    Instruction::ScalarFunction AddPrimitiveType<T>::getScalarFunction() const
+    {
+        if constexpr (std::is_same<T, double>::value) {
+            return [](const Instruction&, const double* operands) -> double {
+                return operands[0] + operands[1];
+            };
+        }
+        else {
+            return nullptr;
+        }
+    }
+
 #ifdef CODE_GENERATION
     template <class T>
     AddPrimitiveType<T>::AddPrimitiveType(const std::string& printTemplate)
@@ -194,6 +194,30 @@ namespace Instructions {
         virtual double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const = 0;
 
+        /**
+         * \brief Function executing an Instruction on operands given as
+         * double values.
+         *
+         * Operands whose type is Data::Constant are given with their value
+         * converted to double.
+         */
+        typedef double (*ScalarFunction)(const Instruction& instruction,
+                                         const double* operands);
+
+        /**
+         * \brief Get a ScalarFunction equivalent to the execute() method.
+         *
+         * Instructions whose operands are all of type double or
+         * Data::Constant may provide a function producing exactly the same
+         * results as their execute() method, without wrapping each operand
+         * into an UntypedSharedPtr. This function is called by the bytecode
+         * execution of Programs.
+         *
+         * \return the default implementation returns nullptr, meaning that
+         * the Instruction can only be executed through its execute() method.
+         */
+        virtual ScalarFunction getScalarFunction() const;
+
       protected:
 #ifndef CODE_GENERATION
         /**
@@ -41,6 +41,8 @@
 #include <functional>
 #include <typeinfo>
 
+#include "data/constant.h"
+#include "data/operandTypeRegistry.h"
 #include "data/untypedSharedPtr.h"
 #include "instructions/instruction.h"
 
@@ -152,7 +154,85 @@ namespace Instructions {
             return result;
         };
 
+        /**
+         * \brief Inherited from Instruction
+         *
+         * A ScalarFunction is only provided if all operands of the
+         * LambdaInstruction are of type double or Data::Constant.
+         */
+        virtual ScalarFunction getScalarFunction() const override
+        {
+            if constexpr (isScalarOperand<First>() &&
+                          (isScalarOperand<Rest>() && ...)) {
+                return &LambdaInstruction::executeScalar;
+            }
+            else {
+                return nullptr;
+            }
+        };
+
       private:
+        /**
+         * \brief Check whether an operand type can be given as a double to
+         * the ScalarFunction of the LambdaInstruction.
+         *
+         * Template parameter T is the type of the operand.
+         */
+        template <typename T> static constexpr bool isScalarOperand()
+        {
+            return std::is_same<std::remove_cv_t<T>, double>::value ||
+                   std::is_same<std::remove_cv_t<T>, Data::Constant>::value;
+        }
+
+        /**
+         * \brief ScalarFunction of the LambdaInstruction.
+         *
+         * \param[in] instruction the LambdaInstruction to execute.
+         * \param[in] operands the values of the operands.
+         * \return the value returned by the LambdaInstruction::func.
+         */
+        static double executeScalar(const Instruction& instruction,
+                                    const double* operands)
+        {
+            return static_cast<const LambdaInstruction&>(instruction)
+                .doScalarExecution(operands,
+                                   std::index_sequence_for<Rest...>{});
+        }
+
+        /**
+         * \brief Template function to expand the operands given to
+         * executeScalar() into arguments of the LambdaInstruction::func.
+         *
+         * \param[in] operands the values of the operands.
+         * \tparam I the std::index_sequence used to access operands.
+         */
+        template <size_t... I>
+        double doScalarExecution(const double* operands,
+                                 std::index_sequence<I...>) const
+        {
+            return this->func(getScalarOperand<First>(operands[0]),
+                              getScalarOperand<Rest>(operands[I + 1])...);
+        }
+
+        /**
+         * \brief Convert the double value of an operand back into its type.
+         *
+         * Template parameter T is the type of the operand.
+         *
+         * \param[in] value the value of the operand.
+         * \return the operand, with its type.
+         */
+        template <typename T> static T getScalarOperand(double value)
+        {
+            if constexpr (std::is_same<std::remove_cv_t<T>,
+                                       Data::Constant>::value) {
+                return Data::Constant{(int32_t)value};
+            }
+            else {
+                return value;
+            }
+        }
+
         /**
          * \brief Template function to handle variadic parameter pack expansion.
          *
@@ -216,6 +296,11 @@ namespace Instructions {
             this->operandTypes.push_back(typeid(First));
             // Fold expression to push all other types
             (this->operandTypes.push_back(typeid(Rest)), ...);
+
+            // Register operand types, so that DataHandlers can know array
+            // dimensions without parsing type names.
+            Data::OperandTypeRegistry::registerType<First>();
+            (Data::OperandTypeRegistry::registerType<Rest>(), ...);
         }
     };
 }; // namespace Instructions
@@ -80,6 +80,9 @@ namespace Instructions {
         double execute(
             const std::vector<Data::UntypedSharedPtr>& args) const override;
 
+        /// Inherited from Instruction
+        ScalarFunction getScalarFunction() const override;
+
       private:
         /**
          * \brief Function call in constructor to setup the operand
@@ -118,6 +121,20 @@ namespace Instructions {
                (double)constantValue;
     }
 
+    template <class T>
+    inline Instruction::ScalarFunction MultByConstant<T>::getScalarFunction()
+        const
+    {
+        if constexpr (std::is_same<T, double>::value) {
+            return [](const Instruction&, const double* operands) -> double {
+                return operands[0] * operands[1];
+            };
+        }
+        else {
+            return nullptr;
+        }
+    }
+
     template <class T> void MultByConstant<T>::setUpOperand()
     {
         this->operandTypes.push_back(typeid(T));
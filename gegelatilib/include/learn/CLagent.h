@@ -3,6 +3,7 @@
 
 #include <map>
 #include <queue>
+#include <vector>
 
 #include "archive.h"
 #include "environment.h"
@@ -14,47 +15,95 @@
 
 #include "learn/evaluationResult.h"
 #include "learn/job.h"
+#include "learn/learningAgent.h"
 #include "learn/learningEnvironment.h"
 #include "learn/learningParameters.h"
-#include "learn/learningAgent.h"
 
 namespace Learn {
 
     /**
-     * \brief Class used to control the learning steps of a TPGGraph within
-     * a given LearningEnvironment.
+     * \brief LearningAgent for continual learning.
+     *
+     * Contrary to the LearningAgent, the LearningEnvironment is not reset
+     * between the evaluation of two consecutive roots: for each iteration,
+     * the roots are evaluated one after the other, each one starting from the
+     * state in which the previous root left the LearningEnvironment. Only the
+     * first evaluated root of each iteration starts from a freshly reset
+     * LearningEnvironment.
+     *
+     * The chains of episodes of different iterations are independent. When
+     * several threads are allowed and the LearningEnvironment is copyable,
+     * these chains are evaluated in parallel, each with its own copy of the
+     * LearningEnvironment. Scores and Archive recordings are stored in
+     * preallocated tables indexed by root and iteration, and compiled in the
+     * same order whatever the number of threads, so that parallel and
+     * sequential evaluations give identical results.
      */
-    class CLagent: public LearningAgent
+    class CLagent : public LearningAgent
     {
-      private:
-//        uint64_t nbdel = 0;
-//        double prevOutcome = 0.0;
-
-
-      public :
-
+      protected:
+        /**
+         * \brief Evaluate the chain of episodes of one iteration.
+         *
+         * The roots of the given jobs are evaluated one after the other, in
+         * the order of the jobs, on the given LearningEnvironment. The
+         * LearningEnvironment is reset only before the first evaluated root.
+         * Jobs marked as skipped are not evaluated, and do not alter the
+         * state of the chain.
+         *
+         * \param[in] tee The TPGExecutionEngine to use.
+         * \param[in] iterationNumber the iteration of the chain.
+         * \param[in] jobs the jobs to evaluate.
+         * \param[in] skipped for each job, whether its evaluation is skipped.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the evaluation.
+         * \param[in] le the LearningEnvironment used for the chain.
+         * \param[out] scoreTable table of scores, with one row of
+         * nbIterationsPerPolicyEvaluation scores per job. Only the column of
+         * the iterationNumber is written.
+         * \param[in] archive the Archive used by the tee, if any. It is
+         * reseeded before each root with the archive seed of its job and the
+         * iterationNumber.
+         */
+        void evaluateChainCL(TPG::TPGExecutionEngine& tee,
+                             uint16_t iterationNumber,
+                             const std::vector<std::shared_ptr<Job>>& jobs,
+                             const std::vector<bool>& skipped,
+                             uint64_t generationNumber, LearningMode mode,
+                             LearningEnvironment& le,
+                             std::vector<double>& scoreTable,
+                             Archive* archive) const;
 
-                  /**
-         * \brief Constructor for LearningAgent.
+      public:
+        /**
+         * \brief Constructor for CLagent.
          *
          * \param[in] le The LearningEnvironment for the TPG.
          * \param[in] iSet Set of Instruction used to compose Programs in the
          *            learning process.
-         * \param[in] p The LearningParameters for the LearningAgent.
+         * \param[in] p The LearningParameters for the LearningAgent. The
+         * nbThreads parameter controls the maximum number of threads used to
+         * evaluate roots.
          * \param[in] factory The TPGFactory used to create the TPGGraph. A
          * default TPGFactory is used if none is provided.
          */
         CLagent(LearningEnvironment& le, const Instructions::Set& iSet,
                 const LearningParameters& p,
                 const TPG::TPGFactory& factory = TPG::TPGFactory())
-                : LearningAgent(le, iSet, p, factory){}
+            : LearningAgent(le, iSet, p, factory)
+        {
+            this->maxNbThreads = p.nbThreads;
+        }
+
         /**
-* \brief Calculator for the weight decay.
-*
-* \param[in] numScores the number of scores obtained
+         * \brief Calculator for the weight decay.
+         *
+         * \param[in] numScores the number of scores obtained
          */
         double calculateWeightDecay(double numScores) const;
-                        /**
+
+        /**
          * \brief Train the TPGGraph for a given number of generation.
          *
          * The method trains the TPGGraph for a given number of generation,
@@ -69,50 +118,73 @@ namespace Learn {
          * printed in the console. \return the number of completed generations.
          */
         uint64_t trainCL(volatile bool& altTraining, bool printProgressBar);
-                
+
+        /**
+         * \brief Evaluates the policy starting from the given root for one
+         * episode of a chain.
+         *
+         * If the episode starts a chain, the LearningEnvironment is reset
+         * with a seed computed from the generationNumber and the
+         * iterationNumber. Otherwise, the episode continues from the current
+         * state of the LearningEnvironment.
+         *
+         * The score of roots whose job index is not 0 is weighted with the
+         * calculateWeightDecay() method.
+         *
+         * \param[in] tee The TPGExecutionEngine to use.
+         * \param[in] job The job containing the root.
+         * \param[in] iterationNumber the iteration of the episode.
+         * \param[in] isChainStart whether the episode starts a chain.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] le Reference to the LearningEnvironment to use.
+         * \return the score of the episode.
+         */
+        double evaluateEpisodeCL(TPG::TPGExecutionEngine& tee, const Job& job,
+                                 uint16_t iterationNumber, bool isChainStart,
+                                 uint64_t generationNumber, LearningMode mode,
+                                 LearningEnvironment& le) const;
+
         /**
- * \brief Evaluates policy starting from the given root.
- *
- * The policy, that is, the TPGGraph execution starting from the given
- * TPGVertex is evaluated nbIteration times. The generationNumber is
- * combined with the current iteration number to generate a set of
- * seeds for evaluating the policy.
- *
- * The method is const to enable potential parallel calls to it.
- *
- * \param[in] tee The TPGExecutionEngine to use.
- * \param[in] job The job containing the root and archiveSeed for
- * the evaluation.
- * \param[in] previousJob The job containing the angles and vectors of previous job
- * \param[in] generationNumber the integer number of the current
- * generation.
- * \param[in] mode the LearningMode to use during the policy
- * evaluation.
- * \param[in] le Reference to the LearningEnvironment to use
- * during the policy evaluation (may be different from the attribute of
- * the class in child LearningAgentClass).
- *
- * \return a std::shared_ptr to the EvaluationResult for the root. If
- * this root was already evaluated more times then the limit in
- * params.maxNbEvaluationPerPolicy, then the EvaluationResult from the
- * resultsPerRoot map is returned, else the EvaluationResult of the
- * current generation is returned, already combined with the
- * resultsPerRoot for this root (if any).
- */
+         * \brief Evaluates policy starting from the given root.
+         *
+         * The policy, that is, the TPGGraph execution starting from the given
+         * TPGVertex is evaluated nbIteration times, each time starting from a
+         * reset LearningEnvironment. The generationNumber is combined with
+         * the current iteration number to generate a set of seeds for
+         * evaluating the policy.
+         *
+         * \param[in] tee The TPGExecutionEngine to use.
+         * \param[in] job The job containing the root and archiveSeed for
+         * the evaluation.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] le Reference to the LearningEnvironment to use
+         * during the policy evaluation.
+         *
+         * \return a std::shared_ptr to the EvaluationResult for the root. If
+         * this root was already evaluated more times then the limit in
+         * params.maxNbEvaluationPerPolicy, then the EvaluationResult from the
+         * resultsPerRoot map is returned, else the EvaluationResult of the
+         * current generation is returned, already combined with the
+         * resultsPerRoot for this root (if any).
+         */
         std::shared_ptr<EvaluationResult> evaluateJobCL(
             TPG::TPGExecutionEngine& tee, const Job& job,
-            const Job& previousJob,
             uint64_t generationNumber, LearningMode mode,
-            LearningEnvironment& le);
+            LearningEnvironment& le) const;
 
-                        /**
+        /**
          * \brief Train the TPGGraph for one agent.
          *
          * Training for one agent includes:
          * - Populating the TPGGraph according to given MutationParameters.
-         * - Evaluating all roots of the TPGGraph. (call to evaluateAllRoots and
-         * modified EvaluateJob)
-         * - Removing from the TPGGraph the worst root (after a while)
+         * - Evaluating all roots of the TPGGraph. (call to evaluateAllRootsCL)
+         * - Removing from the TPGGraph the worst root
          *
          * \param[in] generationNumber the integer number of the current
          * generation.
@@ -122,19 +194,23 @@ namespace Learn {
         /**
          * \brief Evaluate all root TPGVertex of the TPGGraph.
          *
-         * This method calls the evaluateJob method for every root TPGVertex
-         * of the TPGGraph. The method returns a sorted map associating each
-         * root vertex to its average score, in ascending order or score.
+         * For each iteration, the roots are evaluated one after the other
+         * with the evaluateChainCL() method. Chains of different iterations
+         * are evaluated in parallel if the maxNbThreads attribute is greater
+         * than one and the LearningEnvironment is copyable. In training mode,
+         * a dedicated Archive is used for each chain, and all Archive are
+         * merged in the order of iterations.
+         *
+         * The method returns a sorted map associating each root vertex to its
+         * average score, in ascending order or score.
          *
          * \param[in] generationNumber the integer number of the current
          * generation.
          * \param[in] mode the LearningMode to use during the policy
          * evaluation.
          */
-        std::multimap<std::shared_ptr<EvaluationResult>,
-                              const TPG::TPGVertex*>
+        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
         evaluateAllRootsCL(uint64_t generationNumber, LearningMode mode);
-
     };
 }; // namespace Learn
 #endif
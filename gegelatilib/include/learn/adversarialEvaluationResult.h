@@ -129,6 +129,14 @@ namespace Learn {
          * @return The size of the scores vector.
          */
         size_t getSize() const;
+
+        /**
+         * \brief Override from EvaluationResult
+         *
+         * \return a MemoryFootprint with the "object" itself, and its
+         * "scores" vector.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const override;
     };
 } // namespace Learn
 
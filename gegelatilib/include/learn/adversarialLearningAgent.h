@@ -41,6 +41,7 @@
 #include "learn/adversarialJob.h"
 #include "learn/adversarialLearningAgent.h"
 #include "learn/adversarialLearningEnvironment.h"
+#include "learn/matchTable.h"
 #include "learn/parallelLearningAgent.h"
 
 namespace Learn {
@@ -53,15 +54,15 @@ namespace Learn {
      * Globally the process of the adversarial learning agent normal training
      * can be summed up as follow :
      * 1-Initialize, create/populate the TPG.
-     * 2-Create jobs with makeJobs.
-     * Each job is a simulation configuration : it contains some IDs and more
-     * important the roots that will be evaluated, in their order of play.
+     * 2-Create matches with makeMatchTable.
+     * Each match is a simulation configuration : it contains some IDs and
+     * more important the roots that will be evaluated, in their order of play.
      * There will be agentsPerEvaluation roots in each one.
-     * There can the same roots several times in the same job, and each root
-     * can be in several jobs.
-     * 3-Evaluate each job nbIterationsPerJob times, getting as many results
-     * scores as there are roots in the job.
-     * 4-Browse the results of every job and accumulate them to compute the
+     * There can the same roots several times in the same match, and each root
+     * can be in several matches.
+     * 3-Evaluate each match nbIterationsPerJob times, getting as many results
+     * scores as there are roots in the match.
+     * 4-Browse the results of every match and accumulate them to compute the
      * results per root.
      * 5-Eliminate bad roots.
      * 6-Validate if params.doValidation is true.
@@ -94,30 +95,95 @@ namespace Learn {
          *
          * This method gathers results in a map linking root to result, and
          * then reverts the map to match the "results" argument.
-         * The archive will just be merged like in ParallelLearningAgent.
+         * The archive shards will just be merged like in
+         * ParallelLearningAgent.
          *
          * Note that if there is a "posOfStudiedRoot" different from -1 in the
          * jobs, only the EvaluationResult of the posOfStudiedRoot will be
-         * written to the results map. And the results of the other roots within
+         * written to the results table. And the results of the other roots within
          * the Job will be discarded.
          * The reason is that when roots face champions, the champions
          * shouldn't have their scores updated, or as they encounter many
          * unskilled roots they will always have a high score.
          *
-         * @param[in] resultsPerJobMap map linking the job number with its
-         * results and itself.
-         * @param[out] results map linking single results to their root vertex.
-         * @param[in,out] archiveMap map linking the job number with its
-         * gathered archive. These archives will later be merged with the ones
-         * of the other jobs.
+         * @param[in] jobs the evaluated jobs, in the order of their number.
+         * @param[in] jobTable EvaluationTable with one row per job, in the
+         * order of jobs, holding the AdversarialEvaluationResult of the job.
+         * @param[out] table EvaluationTable linking single results to their
+         * root vertex.
+         * @param[in,out] shardedArchive ShardedArchive with one shard per job,
+         * indexed by the job number.
          */
         void evaluateAllRootsInParallelCompileResults(
-            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                         std::shared_ptr<Job>>>&
-                resultsPerJobMap,
-            std::multimap<std::shared_ptr<EvaluationResult>,
-                          const TPG::TPGVertex*>& results,
-            std::map<uint64_t, Archive*>& archiveMap) override;
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const EvaluationTable& jobTable, EvaluationTable& table,
+            ShardedArchive& shardedArchive) override;
+
+        /**
+         * \brief Update the champions from the results of an evaluation.
+         *
+         * The best roots kept after the decimation of the evaluated roots
+         * become the champions for the next evaluation.
+         *
+         * Among roots with equal scores, the root with the last row in the
+         * table is considered the best.
+         *
+         * @param[in] table EvaluationTable linking results to their root
+         * vertex.
+         */
+        void updateChampions(const EvaluationTable& table);
+
+        /**
+         * \brief Evaluate all the matches of a MatchTable.
+         *
+         * The matches of the MatchTable built by makeMatchTable() are split
+         * into contiguous blocks of its schedule, and blocks are distributed
+         * among up to maxNbThreads threads. Each thread reuses its
+         * TPGExecutionEngine, and its copy of the LearningEnvironment, for all
+         * the matches it evaluates.
+         *
+         * The scores of each match are stored in a dense table indexed by
+         * match, and then accumulated into a dense table indexed by
+         * participant, in the order of matches. In training mode, each match
+         * records in a dedicated Archive, and archives are merged in the order
+         * of matches. Hence, results do not depend on the number of threads.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[out] table EvaluationTable filled with the result of each
+         * root, in the order of roots of the TPGGraph.
+         * \throw std::runtime_error if a root of the TPGGraph is evaluated in
+         * no match.
+         */
+        void evaluateAllMatches(uint64_t generationNumber, LearningMode mode,
+                                EvaluationTable& table);
+
+        /**
+         * \brief Evaluate the participants of a match.
+         *
+         * The participants play nbIterationsPerJob times, in their order of
+         * play, and the scores obtained at each iteration are accumulated into
+         * the given AdversarialEvaluationResult.
+         *
+         * \param[in] tee The TPGExecutionEngine to use.
+         * \param[in] participants the roots of the match, in their order of
+         * play.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] ale the AdversarialLearningEnvironment to use.
+         * \param[in,out] result the AdversarialEvaluationResult accumulating
+         * the scores of the participants.
+         */
+        void evaluateMatch(
+            TPG::TPGExecutionEngine& tee,
+            const std::vector<const TPG::TPGVertex*>& participants,
+            uint64_t generationNumber, LearningMode mode,
+            AdversarialLearningEnvironment& ale,
+            AdversarialEvaluationResult& result) const;
 
       public:
         /**
@@ -144,24 +210,25 @@ namespace Learn {
         }
 
         /**
-         * \brief Evaluate all root TPGVertex of the TPGGraph.
+         * \brief Evaluate all root TPGVertex of the TPGGraph into an
+         * EvaluationTable.
          *
          * **Replaces the function from the base class ParallelLearningAgent.**
          *
-         * This method calls the evaluateJob method for every root TPGVertex
-         * of the TPGGraph. The method returns a sorted map associating each
-         * root vertex to its average score, in ascending order of score.
+         * This method evaluates all the matches built by the makeMatchTable
+         * method, with the evaluateAllMatches method, and fills the given
+         * table with the average score of each root vertex.
          * Sequential or parallel, both situations should output the same
          * result.
          *
          * \param[in] generationNumber the integer number of the current
          * generation. \param[in] mode the LearningMode to use during the policy
-         * evaluation.
+         * evaluation. \param[out] table the EvaluationTable filled with the
+         * results.
          */
-        std::multimap<std::shared_ptr<Learn::EvaluationResult>,
-                      const TPG::TPGVertex*>
-        evaluateAllRoots(uint64_t generationNumber,
-                         Learn::LearningMode mode) override;
+        void evaluateAllRootsInTable(uint64_t generationNumber,
+                                     Learn::LearningMode mode,
+                                     EvaluationTable& table) override;
 
         /**
          * \brief Evaluates policy starting from the given root, taking
@@ -185,24 +252,24 @@ namespace Learn {
          * during the policy evaluation (may be different from the attribute of
          * the class in child LearningAgentClass).
          *
-         * \return a std::shared_ptr to the EvaluationResult for the root. This
-         * will be an AdversarialEvaluationResult that contains the score of
-         * each root of the job. The same root can appear in several jobs, so
-         * these scores are to be combined by the element that calls this
-         * method.
+         * \param[in,out] table the EvaluationTable to which one row is added
+         * for the first root of the job. The row holds an
+         * AdversarialEvaluationResult that contains the score of each root of
+         * the job. The same root can appear in several jobs, so these scores
+         * are to be combined by the element that calls this method.
          * AdversarialEvaluationResult will also contain the number of
          * iterations that have been done in this job, that could be useful to
          * combine results later.
          */
-        virtual std::shared_ptr<EvaluationResult> evaluateJob(
-            TPG::TPGExecutionEngine& tee, const Job& job,
-            uint64_t generationNumber, LearningMode mode,
-            LearningEnvironment& le)  const /*override*/;
+        void evaluateJobInTable(TPG::TPGExecutionEngine& tee, const Job& job,
+                                uint64_t generationNumber, LearningMode mode,
+                                LearningEnvironment& le,
+                                EvaluationTable& table) const override;
 
         /**
-         * \brief Puts all roots into AdversarialJob to be able to use them in
+         * \brief Puts all roots into a MatchTable to be able to use them in
          * simulation later. The difference with the base learning agent
-         * makeJobs is that here we make jobs containing several roots to
+         * makeJobs is that here we make matches containing several roots to
          * play together.
          *
          * To make jobs, this method used champions. If no champion exists,
@@ -218,6 +285,28 @@ namespace Learn {
          * The number of teams is calculated so that each root will be evaluated
          * nbIterationsPerPolicyEvaluation times.
          *
+         * Roots are the first participants of the MatchTable, in the order of
+         * the roots of the TPGGraph. Each team of champions is an opponent
+         * group of the MatchTable.
+         *
+         * \param[in] mode the mode of the training, determining for example
+         * if we generate values that we only need for training.
+         * \param[in] tpgGraph The TPG graph from which we will take the
+         * roots.
+         *
+         * @return the MatchTable containing the created matches.
+         */
+        virtual MatchTable makeMatchTable(Learn::LearningMode mode,
+                                          TPG::TPGGraph* tpgGraph = nullptr);
+
+        /**
+         * \brief Puts all roots into AdversarialJob to be able to use them in
+         * simulation later.
+         *
+         * This method creates one AdversarialJob for each match of the
+         * MatchTable built by the makeMatchTable method. The index of each job
+         * is the index of its match.
+         *
          * \param[in] mode the mode of the training, determining for example
          * if we generate values that we only need for training.
          * \param[in] tpgGraph The TPG graph from which we will take the
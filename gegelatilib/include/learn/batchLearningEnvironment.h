@@ -0,0 +1,193 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef BATCH_LEARNING_ENVIRONMENT_H
+#define BATCH_LEARNING_ENVIRONMENT_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "data/dataHandler.h"
+#include "learn/learningEnvironment.h"
+
+namespace Learn {
+
+    /**
+     * \brief Interface for learning environments running several episodes in
+     * lockstep.
+     *
+     * A BatchLearningEnvironment simulates nbLanes independent episodes of a
+     * LearningEnvironment. All lanes are reset together and perform one
+     * action per call to doActions(), which makes it possible to vectorize
+     * the simulation of the environment, and to interleave the inference of
+     * several TPG roots with the simulation.
+     *
+     * This interface is optional: the LearningAgent always relies on the
+     * scalar LearningEnvironment API unless a BatchLearningEnvironment is
+     * given to it with LearningAgent::setBatchLearningEnvironment(). The
+     * episodes simulated by each lane are expected to be identical to the
+     * ones of the associated LearningEnvironment, and the data sources of
+     * each lane must be copies of the data sources of this
+     * LearningEnvironment.
+     */
+    class BatchLearningEnvironment
+    {
+      protected:
+        /// Number of actions available for each lane.
+        const uint64_t nbActions;
+
+        /// Number of episodes simulated in lockstep.
+        const size_t nbLanes;
+
+        /// Make the default copy constructor protected.
+        BatchLearningEnvironment(const BatchLearningEnvironment& other) =
+            default;
+
+      public:
+        /// Delete the default constructor.
+        BatchLearningEnvironment() = delete;
+
+        /// Default virtual destructor.
+        virtual ~BatchLearningEnvironment() = default;
+
+        /**
+         * \brief Constructor for BatchLearningEnvironment.
+         *
+         * \param[in] nbAct number of actions available for each lane.
+         * \param[in] nbLanes number of episodes simulated in lockstep.
+         * \throws std::runtime_error if nbLanes is 0.
+         */
+        BatchLearningEnvironment(uint64_t nbAct, size_t nbLanes);
+
+        /**
+         * \brief Get a copy of the BatchLearningEnvironment.
+         *
+         * Default implementation returns a null pointer.
+         *
+         * \return a copy of the BatchLearningEnvironment if it is copyable,
+         * otherwise this method returns a NULL pointer.
+         */
+        virtual BatchLearningEnvironment* clone() const;
+
+        /**
+         * \brief Can the BatchLearningEnvironment be copy constructed to
+         * evaluate several batches of roots in parallel.
+         *
+         * \return true if the BatchLearningEnvironment can be copied. Default
+         * implementation returns false.
+         */
+        virtual bool isCopyable() const;
+
+        /// Get the number of actions available for each lane.
+        uint64_t getNbActions() const;
+
+        /// Get the number of episodes simulated in lockstep.
+        size_t getNbLanes() const;
+
+        /**
+         * \brief Reset several lanes of the BatchLearningEnvironment.
+         *
+         * Lane i is reset as the LearningEnvironment::reset() method would
+         * be, with seeds[i] as a seed. Lanes whose index is greater or equal
+         * to seeds.size() are frozen, that is, they are marked as terminal
+         * until their next reset.
+         *
+         * \param[in] seeds the seed of each reset lane.
+         * \param[in] mode LearningMode in which the lanes are reset.
+         * \param[in] iterationNumber the iteration number of the episodes.
+         * \param[in] generationNumber the generation number of the episodes.
+         * \throws std::runtime_error if more seeds than lanes are given.
+         */
+        virtual void resetAll(const std::vector<size_t>& seeds,
+                              LearningMode mode = LearningMode::TRAINING,
+                              uint16_t iterationNumber = 0,
+                              uint64_t generationNumber = 0) = 0;
+
+        /**
+         * \brief Execute one action on each non-terminal lane.
+         *
+         * It is the responsibility of this method to update the data sources
+         * of the lanes affected by the actions.
+         *
+         * \param[in] actionIDs one action ID per lane. The action IDs given to
+         * terminal lanes are ignored.
+         * \throws std::runtime_error if actionIDs.size() differs from the
+         * number of lanes.
+         */
+        virtual void doActions(const std::vector<uint64_t>& actionIDs) = 0;
+
+        /**
+         * \brief Get the terminal mask of the lanes.
+         *
+         * \return a vector containing one element per lane, whose value is
+         * non-zero if the lane is terminal or frozen.
+         */
+        virtual const std::vector<uint8_t>& getTerminalMask() const = 0;
+
+        /**
+         * \brief Are all lanes terminal or frozen.
+         *
+         * Default implementation scans the terminal mask.
+         */
+        virtual bool allTerminal() const;
+
+        /**
+         * \brief Get the current score of a lane.
+         *
+         * \param[in] lane the index of the lane.
+         * \return the score, as the LearningEnvironment::getScore() method
+         * would return it.
+         */
+        virtual double getScore(size_t lane) const = 0;
+
+        /**
+         * \brief Get the data sources of a lane.
+         *
+         * As for the LearningEnvironment::getDataSources() method, the
+         * referenced DataHandler are never replaced throughout the existence
+         * of the BatchLearningEnvironment, and their content is updated
+         * each time resetAll() or doActions() is called.
+         *
+         * \param[in] lane the index of the lane.
+         * \return a vector of references to the DataHandler of the lane.
+         */
+        virtual std::vector<std::reference_wrapper<const Data::DataHandler>>
+        getDataSources(size_t lane) = 0;
+    };
+}; // namespace Learn
+
+#endif
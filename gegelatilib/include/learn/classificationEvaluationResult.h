@@ -113,6 +113,14 @@ namespace Learn {
          */
         virtual EvaluationResult& operator+=(
             const EvaluationResult& other) override;
+
+        /**
+         * \brief Override from EvaluationResult
+         *
+         * \return a MemoryFootprint with the "object" itself, and its
+         * "scorePerClass" and "nbEvaluationPerClass" vectors.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const override;
     };
 }; // namespace Learn
 
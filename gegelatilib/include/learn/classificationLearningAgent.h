@@ -40,6 +40,7 @@
 #include <numeric>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include "learn/classificationEvaluationResult.h"
@@ -94,17 +95,18 @@ namespace Learn {
             : BaseLearningAgent(le, iSet, p, factory){};
 
         /**
-         * \brief Specialization of the evaluateJob method for classification
-         * purposes.
+         * \brief Specialization of the evaluateJobInTable method for
+         * classification purposes.
          *
-         * This method returns a ClassificationEvaluationResult for the
-         * evaluated root instead of the usual EvaluationResult. The score per
-         * root corresponds to the F1 score for this class.
+         * This method adds a row holding a ClassificationEvaluationResult for
+         * the evaluated root instead of the usual EvaluationResult, so that
+         * the scores per class are stored in the table. The score per class
+         * corresponds to the F1 score for this class.
          */
-        virtual std::shared_ptr<EvaluationResult> evaluateJob(
-            TPG::TPGExecutionEngine& tee, const Job& root,
-            uint64_t generationNumber, LearningMode mode,
-            LearningEnvironment& le) const /* override*/;
+        void evaluateJobInTable(TPG::TPGExecutionEngine& tee, const Job& job,
+                                uint64_t generationNumber, LearningMode mode,
+                                LearningEnvironment& le,
+                                EvaluationTable& table) const override;
 
         /**
          * \brief Specialization of the decimateWorstRoots method for
@@ -130,21 +132,24 @@ namespace Learn {
          * number of root is preserved during the decimation process, all roots
          * are preserved based on their general score.
          *
-         * The results map is updated by the method to keep only the results of
+         * The table is updated by the method to keep only the results of
          * non-decimated roots.
+         *
+         * \throw std::runtime_error if the table holds no scores per class,
+         * which is the case for results whose type is not
+         * ClassificationEvaluationResult.
          */
-        void decimateWorstRoots(
-            std::multimap<std::shared_ptr<EvaluationResult>,
-                          const TPG::TPGVertex*>& results) override;
+        void decimateWorstRoots(EvaluationTable& table) override;
+
+        using BaseLearningAgent::decimateWorstRoots;
     };
 
     template <class BaseLearningAgent>
-    inline std::shared_ptr<EvaluationResult> ClassificationLearningAgent<
-        BaseLearningAgent>::evaluateJob(TPG::TPGExecutionEngine& tee,
-                                        const Job& job,
-                                        uint64_t generationNumber,
-                                        LearningMode mode,
-                                        LearningEnvironment& le) const
+    inline void ClassificationLearningAgent<BaseLearningAgent>::
+        evaluateJobInTable(TPG::TPGExecutionEngine& tee, const Job& job,
+                           uint64_t generationNumber, LearningMode mode,
+                           LearningEnvironment& le,
+                           EvaluationTable& table) const
     {
         // Only consider the first root of jobs as we are not in adversarial
         // mode
@@ -155,7 +160,8 @@ namespace Learn {
         std::shared_ptr<Learn::EvaluationResult> previousEval;
         if (mode == LearningMode::TRAINING &&
             this->isRootEvalSkipped(*root, previousEval)) {
-            return previousEval;
+            table.addRow(previousEval, root);
+            return;
         }
 
         // Init results
@@ -163,6 +169,7 @@ namespace Learn {
                                    0.0);
         std::vector<size_t> nbEvalPerClass(
             this->learningEnvironment.getNbActions(), 0);
+        std::vector<double> f1Scores;
 
         // Evaluate nbIteration times
         for (auto i = 0; i < this->params.nbIterationsPerPolicyEvaluation;
@@ -188,43 +195,20 @@ namespace Learn {
             }
 
             // Update results
-            const auto& classificationTable =
-                ((ClassificationLearningEnvironment&)le)
-                    .getClassificationTable();
+            const ClassificationLearningEnvironment& classifLE =
+                (ClassificationLearningEnvironment&)le;
+            classifLE.getF1Scores(f1Scores);
+            const std::vector<uint64_t>& nbDataPerClass =
+                classifLE.getNbDataPerClass();
             // for each class
-            for (uint64_t classIdx = 0; classIdx < classificationTable.size();
+            for (uint64_t classIdx = 0; classIdx < f1Scores.size();
                  classIdx++) {
-                uint64_t truePositive =
-                    classificationTable.at(classIdx).at(classIdx);
-                uint64_t falseNegative =
-                    std::accumulate(classificationTable.at(classIdx).begin(),
-                                    classificationTable.at(classIdx).end(),
-                                    (uint64_t)0) -
-                    truePositive;
-                uint64_t falsePositive = 0;
-                std::for_each(
-                    classificationTable.begin(), classificationTable.end(),
-                    [&classIdx, &falsePositive](
-                        const std::vector<uint64_t>& classifForClass) {
-                        falsePositive += classifForClass.at(classIdx);
-                    });
-                falsePositive -= truePositive;
-
-                double recall = (double)truePositive /
-                                (double)(truePositive + falseNegative);
-                double precision = (double)truePositive /
-                                   (double)(truePositive + falsePositive);
-                // If true positive is 0, set score to 0.
-                double fScore = (truePositive != 0) ? 2 * (precision * recall) /
-                                                          (precision + recall)
-                                                    : 0.0;
-                result.at(classIdx) += fScore;
-
-                nbEvalPerClass.at(classIdx) += truePositive + falseNegative;
+                result.at(classIdx) += f1Scores.at(classIdx);
+                nbEvalPerClass.at(classIdx) += nbDataPerClass.at(classIdx);
             }
         }
 
-        // Before returning the EvaluationResult, divide the result per class by
+        // Before adding the EvaluationResult, divide the result per class by
         // the number of iteration
         const LearningParameters& p = this->params;
         std::for_each(result.begin(), result.end(), [p](double& val) {
@@ -239,18 +223,16 @@ namespace Learn {
         if (previousEval != nullptr) {
             *evaluationResult += *previousEval;
         }
-        return evaluationResult;
+        table.addRow(evaluationResult, root);
     }
 
     template <class BaseLearningAgent>
     void ClassificationLearningAgent<BaseLearningAgent>::decimateWorstRoots(
-        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
-            results)
+        EvaluationTable& table)
     {
         // Check that results are ClassificationEvaluationResults.
         // (also throws on empty results)
-        const EvaluationResult* result = results.begin()->first.get();
-        if (typeid(ClassificationEvaluationResult) != typeid(*result)) {
+        if (table.getNbClasses() == 0) {
             throw std::runtime_error(
                 "ClassificationLearningAgent can not decimate worst roots for "
                 "results whose type is not ClassificationEvaluationResult.");
@@ -272,89 +254,45 @@ namespace Learn {
             nbRootsToKeep -
             this->learningEnvironment.getNbActions() * nbRootsKeptPerClass;
 
-        // Build a list of roots to keep
-        std::vector<const TPG::TPGVertex*> rootsToKeep;
+        // Fill the decimation engine with the general and per class scores
+        // of the results.
+        this->decimationEngine.fill(table);
 
-        // Insert roots to keep per class
-        for (uint64_t classIdx = 0;
-             classIdx < this->learningEnvironment.getNbActions(); classIdx++) {
-            // Fill a map with the roots and the score of the specific class as
-            // ID.
-            std::multimap<double, const TPG::TPGVertex*> sortedRoot;
-            std::for_each(
-                results.begin(), results.end(),
-                [&sortedRoot,
-                 &classIdx](const std::pair<std::shared_ptr<EvaluationResult>,
-                                            const TPG::TPGVertex*>& res) {
-                    sortedRoot.emplace(
-                        ((ClassificationEvaluationResult*)res.first.get())
-                            ->getScorePerClass()
-                            .at(classIdx),
-                        res.second);
-                });
+        // Select the roots to keep.
+        // If a root scores well for several classes it is kept only once
+        // anyway, but additional roots will not be kept for any of the
+        // concerned class.
+        this->decimationEngine.keepBest(nbRootsKeptPerClass, nbRootsToKeep);
 
-            // Keep the best nbRootsKeptPerClass (or less for reasons explained
-            // in the loop)
-            auto iterator = sortedRoot.rbegin();
-            for (auto i = 0; i < nbRootsKeptPerClass; i++) {
-                // If the root is not already marked to be kept
-                if (std::find(rootsToKeep.begin(), rootsToKeep.end(),
-                              iterator->second) == rootsToKeep.end()) {
-                    rootsToKeep.push_back(iterator->second);
-                }
-                // Advance the iterator no matter what.
-                // This means that if a root scores well for several classes
-                // it is kept only once anyway, but additional roots will not
-                // be kept for any of the concerned class.
-                iterator++;
+        std::unordered_set<const TPG::TPGVertex*> rootsToKeep;
+        for (size_t row = 0; row < table.getNbRows(); row++) {
+            if (this->decimationEngine.isKept(row)) {
+                rootsToKeep.insert(table.getRoot(row));
             }
         }
 
-        // Insert remaining roots to keep
-        auto iterator = results.rbegin();
-        while (rootsToKeep.size() < nbRootsToKeep &&
-               iterator != results.rend()) {
-            // If the root is not already marked to be kept
-            if (std::find(rootsToKeep.begin(), rootsToKeep.end(),
-                          iterator->second) == rootsToKeep.end()) {
-                rootsToKeep.push_back(iterator->second);
-            }
-            // Advance the iterator no matter what.
-            iterator++;
-        }
-
         // Do the removal.
         // Because of potential root actions, the preserved number of roots
         // may be higher than the given ratio.
-        auto allRoots = this->tpg->getRootVertices();
-        auto& tpgRef = this->tpg;
-        auto& resultsPerRootRef = this->resultsPerRoot;
-        std::for_each(
-            allRoots.begin(), allRoots.end(),
-            [&rootsToKeep, &tpgRef, &resultsPerRootRef,
-             &results](const TPG::TPGVertex* vert) {
-                // Do not remove actions
-                if (dynamic_cast<const TPG::TPGAction*>(vert) == nullptr &&
-                    std::find(rootsToKeep.begin(), rootsToKeep.end(), vert) ==
-                        rootsToKeep.end()) {
-                    tpgRef->removeVertex(*vert);
+        std::unordered_set<const TPG::TPGVertex*> removedRoots;
+        for (const TPG::TPGVertex* vert : this->tpg->getRootVertices()) {
+            // Do not remove actions
+            if (dynamic_cast<const TPG::TPGAction*>(vert) == nullptr &&
+                rootsToKeep.count(vert) == 0) {
+                this->tpg->removeVertex(*vert);
 
-                    // Keep only results of non-decimated roots.
-                    resultsPerRootRef.erase(vert);
+                // Keep only results of non-decimated roots.
+                this->resultsPerRoot.erase(vert);
+                removedRoots.insert(vert);
+            }
+        }
 
-                    // Update results also
-                    std::multimap<std::shared_ptr<EvaluationResult>,
-                                  const TPG::TPGVertex*>::iterator iter =
-                        results.begin();
-                    while (iter != results.end()) {
-                        if (iter->second == vert) {
-                            results.erase(iter);
-                            break;
-                        }
-                        iter++;
-                    }
-                }
-            });
+        // Update results also
+        std::vector<bool> kept(table.getNbRows());
+        for (size_t row = 0; row < table.getNbRows(); row++) {
+            kept[row] = removedRoots.count(table.getRoot(row)) == 0;
+        }
+        table.keepRows(kept);
     }
 }; // namespace Learn
 
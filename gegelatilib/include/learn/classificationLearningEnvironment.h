@@ -49,14 +49,30 @@ namespace Learn {
     {
       protected:
         /**
-         * \brief 2D array storing for each class the guesses that were made by
-         * the LearningAgent.
+         * \brief Flattened 2D array storing for each class the guesses that
+         * were made by the LearningAgent.
          *
-         * For example classificationTable.at(x).at(y) represents the number of
-         * times a LearningAgent guessed class y, for a data from class x since
-         * the last reset.
+         * For example classificationTable.at(x * getNbActions() + y)
+         * represents the number of times a LearningAgent guessed class y, for
+         * a data from class x since the last reset.
          */
-        std::vector<std::vector<uint64_t>> classificationTable;
+        std::vector<uint64_t> classificationTable;
+
+        /**
+         * \brief Number of data from each class since the last reset.
+         *
+         * nbDataPerClass.at(x) is the sum of the x-th row of the
+         * classificationTable.
+         */
+        std::vector<uint64_t> nbDataPerClass;
+
+        /**
+         * \brief Number of guesses of each class since the last reset.
+         *
+         * nbGuessesPerClass.at(y) is the sum of the y-th column of the
+         * classificationTable.
+         */
+        std::vector<uint64_t> nbGuessesPerClass;
 
         /**
          * \brief Class of the current data.
@@ -75,21 +91,63 @@ namespace Learn {
          * underlying LearningEnvironment.
          */
         ClassificationLearningEnvironment(uint64_t nbClass)
-            : LearningEnvironment(nbClass), currentClass{0},
-              classificationTable(nbClass, std::vector<uint64_t>(nbClass, 0)){};
+            : LearningEnvironment(nbClass),
+              classificationTable(nbClass * nbClass, 0),
+              nbDataPerClass(nbClass, 0), nbGuessesPerClass(nbClass, 0),
+              currentClass{0} {};
+
+        /**
+         * \brief Get a const ref to the flattened classification table of the
+         * learning environment.
+         */
+        const std::vector<uint64_t>& getClassificationTable() const;
+
+        /**
+         * \brief Get a const ref to the number of data from each class since
+         * the last reset.
+         */
+        const std::vector<uint64_t>& getNbDataPerClass() const;
+
+        /**
+         * \brief Get a const ref to the number of guesses of each class since
+         * the last reset.
+         */
+        const std::vector<uint64_t>& getNbGuessesPerClass() const;
 
         /**
-         * \brief Get a const ref to the classification table of the learning
-         * environment.
+         * \brief Compute the F1 score of each class from a classification
+         * table.
+         *
+         * The F1 score of a class is the harmonic mean of the precision and
+         * recall for this class. If a class was never correctly guessed, its
+         * F1 score is 0.0.
+         *
+         * \param[in] table the flattened classification table.
+         * \param[in] nbDataPerClass the sums of the rows of the table.
+         * \param[in] nbGuessesPerClass the sums of the columns of the table.
+         * \param[out] f1Scores the F1 score of each class. The vector is
+         * resized to the number of classes.
+         */
+        static void computeF1Scores(
+            const std::vector<uint64_t>& table,
+            const std::vector<uint64_t>& nbDataPerClass,
+            const std::vector<uint64_t>& nbGuessesPerClass,
+            std::vector<double>& f1Scores);
+
+        /**
+         * \brief Get the F1 score of each class since the last reset.
+         *
+         * \param[out] f1Scores the F1 score of each class. The vector is
+         * resized to the number of classes.
          */
-        const std::vector<std::vector<uint64_t>>& getClassificationTable()
-            const;
+        void getF1Scores(std::vector<double>& f1Scores) const;
 
         /**
          * \brief Default implementation for the doAction method.
          *
-         * This implementation only increments the classificationTable based on
-         * the currentClass attribute. Refresh of the data should be implemented
+         * This implementation only increments the classificationTable, as well
+         * as the nbDataPerClass and nbGuessesPerClass attributes, based on the
+         * currentClass attribute. Refresh of the data should be implemented
          * by the child class, hence the pure virtual method.
          */
         virtual void doAction(uint64_t actionID) override = 0;
@@ -107,7 +165,8 @@ namespace Learn {
         /**
          * \brief Default implementation of the reset.
          *
-         * Resets to zero the classificationTable.
+         * Resets to zero the classificationTable, nbDataPerClass and
+         * nbGuessesPerClass.
          */
         virtual void reset(size_t seed = 0,
                            LearningMode mode = LearningMode::TRAINING,
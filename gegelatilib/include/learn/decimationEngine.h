@@ -0,0 +1,200 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef DECIMATION_ENGINE_H
+#define DECIMATION_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "learn/evaluationTable.h"
+
+namespace Learn {
+    /**
+     * \brief Class for selecting the entries preserved by a decimation
+     * process, based on their scores.
+     *
+     * The DecimationEngine stores one general score per entry and, optionally,
+     * a score per class for each entry, in flat arrays. Selections of the best
+     * or worst entries rely on partial selection with std::nth_element,
+     * instead of fully sorted containers.
+     *
+     * Entries with equal scores are ordered by their index: an entry with a
+     * greater index is considered better than an entry with a lower index and
+     * the same score. This mimics the order of equal keys in a std::multimap
+     * where entries were inserted by increasing index.
+     *
+     * Buffers of the DecimationEngine are reused when it is resized, so a
+     * single DecimationEngine should be kept throughout the training process.
+     */
+    class DecimationEngine
+    {
+      protected:
+        /// Number of entries currently stored in the DecimationEngine.
+        size_t nbEntries = 0;
+
+        /// Number of scores per class stored for each entry.
+        size_t nbClasses = 0;
+
+        /// General score of each entry.
+        std::vector<double> scores;
+
+        /**
+         * \brief Scores per class of the entries.
+         *
+         * The nbClasses scores of an entry are stored contiguously, starting
+         * at index entryIdx * nbClasses.
+         */
+        std::vector<double> classScores;
+
+        /// Entries that can not be decimated.
+        std::vector<bool> preserved;
+
+        /// Result of the last selection.
+        std::vector<bool> kept;
+
+        /// Buffer of entry indexes used during selections.
+        std::vector<size_t> candidates;
+
+      public:
+        /// Default constructor.
+        DecimationEngine() = default;
+
+        /**
+         * \brief Set the number of entries and classes of the
+         * DecimationEngine.
+         *
+         * All scores are reset to 0, and all entries are marked as not
+         * preserved and not kept.
+         *
+         * \param[in] nbEntries the number of entries.
+         * \param[in] nbClasses the number of scores per class for each
+         * entry.
+         */
+        void resize(size_t nbEntries, size_t nbClasses = 0);
+
+        /**
+         * \brief Set the entries of the DecimationEngine from the rows of an
+         * EvaluationTable.
+         *
+         * The DecimationEngine is resized to the number of rows and classes
+         * of the table, and the general scores and scores per class of its
+         * entries are copied from the table.
+         *
+         * \param[in] table the EvaluationTable whose rows are copied.
+         */
+        void fill(const EvaluationTable& table);
+
+        /// Get the number of entries of the DecimationEngine.
+        size_t getNbEntries() const;
+
+        /// Get the number of scores per class of the DecimationEngine.
+        size_t getNbClasses() const;
+
+        /**
+         * \brief Set the general score of an entry.
+         *
+         * \param[in] idx the index of the entry.
+         * \param[in] score the general score of the entry.
+         * \throw std::out_of_range if the index exceeds the number of entries.
+         */
+        void setScore(size_t idx, double score);
+
+        /**
+         * \brief Set the scores per class of an entry.
+         *
+         * \param[in] idx the index of the entry.
+         * \param[in] scorePerClass the scores of the entry for each class.
+         * \throw std::out_of_range if the index exceeds the number of entries.
+         * \throw std::runtime_error if the number of scores differs from the
+         * number of classes of the DecimationEngine.
+         */
+        void setClassScores(size_t idx,
+                            const std::vector<double>& scorePerClass);
+
+        /**
+         * \brief Mark an entry as preserved from decimation.
+         *
+         * Preserved entries are always kept by the selection methods.
+         *
+         * \param[in] idx the index of the entry.
+         * \param[in] isPreserved whether the entry is preserved.
+         * \throw std::out_of_range if the index exceeds the number of entries.
+         */
+        void setPreserved(size_t idx, bool isPreserved = true);
+
+        /**
+         * \brief Decimate the entries with the worst general scores.
+         *
+         * The nbDecimated non-preserved entries with the worst general scores
+         * are marked as not kept, all other entries are marked as kept. If
+         * there are less than nbDecimated non-preserved entries, all of them
+         * are decimated.
+         *
+         * \param[in] nbDecimated the number of entries to decimate.
+         */
+        void decimateWorst(uint64_t nbDecimated);
+
+        /**
+         * \brief Keep the entries with the best scores for each class and
+         * overall.
+         *
+         * For each class, the nbKeptPerClass entries with the best scores for
+         * this class are kept. An entry that is among the best for several
+         * classes is kept only once, and no additional entry is kept in its
+         * place. Then, entries with the best general scores are kept until
+         * nbKept entries are kept. Finally, preserved entries are also kept.
+         *
+         * \param[in] nbKeptPerClass the number of entries kept for each
+         * class.
+         * \param[in] nbKept the total number of entries kept, excluding
+         * preserved entries.
+         */
+        void keepBest(uint64_t nbKeptPerClass, uint64_t nbKept);
+
+        /**
+         * \brief Check whether an entry was kept by the last selection.
+         *
+         * \param[in] idx the index of the entry.
+         * \return true if the entry was kept, false otherwise.
+         * \throw std::out_of_range if the index exceeds the number of entries.
+         */
+        bool isKept(size_t idx) const;
+    };
+} // namespace Learn
+
+#endif
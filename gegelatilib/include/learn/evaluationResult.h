@@ -38,6 +38,8 @@
 
 #include <memory>
 
+#include "util/memoryFootprint.h"
+
 namespace Learn {
     /**
      * \brief Base class for storing all result of a policy evaluation within a
@@ -57,6 +59,9 @@ namespace Learn {
         /// Number of evaluation leading to this result.
         size_t nbEvaluation;
 
+        /// Variance of the scores of the evaluations leading to this result.
+        double variance;
+
       public:
         /**
          * \brief Deleted default constructor.
@@ -75,9 +80,12 @@ namespace Learn {
          * evaluation.
          * \param[in] nbEval Integer value representing the number of
          * evaluation leading to the recorded score.
+         * \param[in] var the variance of the scores of the evaluations leading
+         * to the recorded score.
          */
-        EvaluationResult(const double& res, const size_t& nbEval)
-            : result{res}, nbEvaluation{nbEval} {};
+        EvaluationResult(const double& res, const size_t& nbEval,
+                         const double& var = 0.0)
+            : result{res}, nbEvaluation{nbEval}, variance{var} {};
 
         /**
          * \brief Virtual method to get the default double equivalent of
@@ -91,6 +99,14 @@ namespace Learn {
          */
         virtual size_t getNbEvaluation() const;
 
+        /**
+         * \brief Virtual method to get the variance of the scores of the
+         * evaluations leading to the EvaluationResult.
+         *
+         * A variance of 0.0 is returned when it was not computed.
+         */
+        virtual double getVariance() const;
+
         /**
          * \brief Polymorphic addition assignement operator for
          * EvaluationResult.
@@ -99,6 +115,16 @@ namespace Learn {
          * this have a different typeid.
          */
         virtual EvaluationResult& operator+=(const EvaluationResult& other);
+
+        /**
+         * \brief Get the memory used by the EvaluationResult.
+         *
+         * Child classes must override this method to count their own object
+         * and the buffers they own.
+         *
+         * \return a MemoryFootprint with the "object" itself.
+         */
+        virtual Util::MemoryFootprint getMemoryFootprint() const;
     };
 
     /**
@@ -0,0 +1,305 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef EVALUATION_TABLE_H
+#define EVALUATION_TABLE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "learn/evaluationResult.h"
+#include "tpg/tpgVertex.h"
+#include "util/memoryFootprint.h"
+
+namespace Learn {
+    /**
+     * \brief Contiguous storage for the evaluation results of all roots
+     * evaluated during a generation.
+     *
+     * The EvaluationTable contains one row per evaluated root. Each row
+     * stores the score, the number of evaluations and the variance of the
+     * scores of the root. Optionally, the table also stores a slab of scores
+     * per class for each row, when the evaluated results are
+     * ClassificationEvaluationResult.
+     *
+     * Each column of the table is stored in a contiguous array. Clearing the
+     * table keeps the allocated memory, so a single EvaluationTable can be
+     * reused from one generation to the next without reallocation.
+     *
+     * Rows are stored in the order in which they were added. Rows are
+     * stored by value, so adding a row does not allocate any EvaluationResult.
+     * Only rows added with an existing std::shared_ptr to an EvaluationResult,
+     * for example a ClassificationEvaluationResult or the stored result of a
+     * root whose evaluation is skipped, also keep this shared result. The
+     * sorted map of results used by the LALogger can be built on demand with
+     * getResultsMap().
+     */
+    class EvaluationTable
+    {
+      protected:
+        /// Number of scores per class stored in each row.
+        size_t nbClasses = 0;
+
+        /// Root TPGVertex of each row.
+        std::vector<const TPG::TPGVertex*> roots;
+
+        /// Score of each row.
+        std::vector<double> scores;
+
+        /// Number of evaluations of each row.
+        std::vector<size_t> nbEvaluations;
+
+        /// Variance of the evaluations of each row.
+        std::vector<double> variances;
+
+        /// Shared EvaluationResult of each row, or nullptr for rows added by
+        /// value.
+        std::vector<std::shared_ptr<EvaluationResult>> sharedResults;
+
+        /**
+         * \brief Scores per class of each row.
+         *
+         * The nbClasses scores of a row are stored contiguously, starting at
+         * index row * nbClasses.
+         */
+        std::vector<double> classScores;
+
+      public:
+        /// Default constructor.
+        EvaluationTable() = default;
+
+        /**
+         * \brief Remove all rows of the table.
+         *
+         * Memory allocated for the rows is kept for future use.
+         *
+         * \param[in] nbClasses the number of scores per class stored in each
+         * row of the table.
+         */
+        void clear(size_t nbClasses = 0);
+
+        /**
+         * \brief Append a row to the table.
+         *
+         * Scores per class of the new row are initialized to 0.0.
+         *
+         * \param[in] root the root TPGVertex of the row.
+         * \param[in] score the score of the root.
+         * \param[in] nbEvaluation the number of evaluations of the root.
+         * \param[in] variance the variance of the evaluations of the root.
+         * \return the index of the new row.
+         */
+        size_t addRow(const TPG::TPGVertex* root, double score,
+                      size_t nbEvaluation, double variance = 0.0);
+
+        /**
+         * \brief Append a row to the table for an EvaluationResult.
+         *
+         * The score, number of evaluations and variance of the row are read
+         * from the result, and the shared result is kept in the table. When the
+         * first row of the table is a ClassificationEvaluationResult, the
+         * number of classes of the table is set accordingly, and the scores
+         * per class of each ClassificationEvaluationResult are stored.
+         *
+         * \param[in] result the EvaluationResult of the root.
+         * \param[in] root the root TPGVertex of the row.
+         * \return the index of the new row.
+         */
+        size_t addRow(const std::shared_ptr<EvaluationResult>& result,
+                      const TPG::TPGVertex* root);
+
+        /**
+         * \brief Append a copy of a row of another table to the table.
+         *
+         * When the table is empty, its number of classes is set to the one of
+         * the source table. Scores per class are copied only if both tables
+         * have the same number of classes.
+         *
+         * \param[in] source the EvaluationTable containing the copied row.
+         * \param[in] sourceRow the index of the row in the source table.
+         * \return the index of the new row.
+         * \throw std::out_of_range if the row does not exist in the source
+         * table.
+         */
+        size_t addRow(const EvaluationTable& source, size_t sourceRow);
+
+        /**
+         * \brief Set the scores per class of a row.
+         *
+         * \param[in] row the index of the row.
+         * \param[in] scorePerClass the scores of the row for each class.
+         * \throw std::out_of_range if the row does not exist.
+         * \throw std::runtime_error if the number of scores differs from the
+         * number of classes of the table.
+         */
+        void setClassScores(size_t row,
+                            const std::vector<double>& scorePerClass);
+
+        /**
+         * \brief Fill the table with the given results.
+         *
+         * The table is cleared before being filled with one row per result,
+         * in the iteration order of the given multimap. If results are
+         * ClassificationEvaluationResult, their scores per class are also
+         * stored in the table.
+         *
+         * \param[in] results the results to store in the table.
+         */
+        void fill(const std::multimap<std::shared_ptr<EvaluationResult>,
+                                      const TPG::TPGVertex*>& results);
+
+        /**
+         * \brief Keep only some rows of the table.
+         *
+         * Kept rows are moved to the beginning of the table, preserving their
+         * order.
+         *
+         * \param[in] kept whether each row of the table is kept.
+         * \throw std::runtime_error if the size of kept differs from the
+         * number of rows of the table.
+         */
+        void keepRows(const std::vector<bool>& kept);
+
+        /**
+         * \brief Build the sorted map of the results stored in the table.
+         *
+         * Results are inserted in the order of rows, so results with equal
+         * scores keep the order of their rows. An EvaluationResult is
+         * allocated for each row added by value, as in getResult().
+         *
+         * \return a map linking results to their root vertex, in ascending
+         * order of score.
+         */
+        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+        getResultsMap() const;
+
+        /**
+         * \brief Get the index of the row with the best score.
+         *
+         * Among rows with the best score, the last row is returned, as the
+         * last element of the map returned by getResultsMap().
+         *
+         * \throw std::out_of_range if the table is empty.
+         */
+        size_t getBestRow() const;
+
+        /// Get the number of rows of the table.
+        size_t getNbRows() const;
+
+        /// Get the number of scores per class of each row of the table.
+        size_t getNbClasses() const;
+
+        /**
+         * \brief Get the root TPGVertex of a row.
+         *
+         * \throw std::out_of_range if the row does not exist.
+         */
+        const TPG::TPGVertex* getRoot(size_t row) const;
+
+        /**
+         * \brief Get the score of a row.
+         *
+         * \throw std::out_of_range if the row does not exist.
+         */
+        double getScore(size_t row) const;
+
+        /**
+         * \brief Get the number of evaluations of a row.
+         *
+         * \throw std::out_of_range if the row does not exist.
+         */
+        size_t getNbEvaluation(size_t row) const;
+
+        /**
+         * \brief Get the variance of the evaluations of a row.
+         *
+         * \throw std::out_of_range if the row does not exist.
+         */
+        double getVariance(size_t row) const;
+
+        /**
+         * \brief Get the EvaluationResult of a row.
+         *
+         * \return the shared result of the row if any, or else a new
+         * EvaluationResult built from the values of the row.
+         * \throw std::out_of_range if the row does not exist.
+         */
+        std::shared_ptr<EvaluationResult> getResult(size_t row) const;
+
+        /**
+         * \brief Get the shared EvaluationResult of a row.
+         *
+         * \return the shared result given when the row was added, or nullptr
+         * if the row was added by value.
+         * \throw std::out_of_range if the row does not exist.
+         */
+        const std::shared_ptr<EvaluationResult>& getSharedResult(
+            size_t row) const;
+
+        /**
+         * \brief Get a pointer to the scores per class of a row.
+         *
+         * The returned pointer gives access to getNbClasses() contiguous
+         * values, and is valid as long as no row is added to the table.
+         *
+         * \throw std::out_of_range if the row does not exist.
+         */
+        const double* getClassScores(size_t row) const;
+
+        /// Get a const reference to the column of scores.
+        const std::vector<double>& getScores() const;
+
+        /// Get a const reference to the column of roots.
+        const std::vector<const TPG::TPGVertex*>& getRoots() const;
+
+        /**
+         * \brief Get the memory used by the EvaluationTable.
+         *
+         * Columns are counted with their capacity. The shared EvaluationResult
+         * of rows are not counted, as they are also referenced by the
+         * resultsPerRoot of the LearningAgent.
+         *
+         * \return a MemoryFootprint with the "roots", "scores",
+         * "nbEvaluations", "variances", "sharedResults" and "classScores"
+         * columns.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+    };
+} // namespace Learn
+
+#endif
@@ -41,11 +41,6 @@
 
 #include "tpg/tpgVertex.h"
 
-struct {
-    double angle;
-    double velocity;
-}typedef stateEOE;
-
 namespace Learn {
     /**
      * \brief This class embeds roots for the simulations.
@@ -72,13 +67,6 @@ namespace Learn {
          */
         const uint64_t archiveSeed;
 
-        /**
-         * Vector of previous end of state values
-         */
-        const std::vector<stateEOE> vecStateEOE;
-
-
-
       public:
         /// Deleted default constructor.
         Job() = delete;
@@ -122,18 +110,6 @@ namespace Learn {
          */
         virtual const TPG::TPGVertex* getRoot() const;
 
-        /**
-         * \brief Getter of the vector of pendulum states.
-         *
-         * @return the vector of pendulum states.
-         */
-        virtual std::vector<stateEOE> getVecStateEOE() const;
-
-        /**
-         * \brief Setter of the vector of pendulum states.
-         */
-        virtual void setVecStateEOE(const std::vector<stateEOE>& vecPrev) const;
-
         /**
          * \brief Setter of the index.
          */
@@ -47,10 +47,14 @@
 #include "instructions/set.h"
 #include "log/laLogger.h"
 #include "mutator/mutationParameters.h"
+#include "shardedArchive.h"
 #include "tpg/tpgExecutionEngine.h"
 #include "tpg/tpgGraph.h"
 
+#include "learn/batchLearningEnvironment.h"
+#include "learn/decimationEngine.h"
 #include "learn/evaluationResult.h"
+#include "learn/evaluationTable.h"
 #include "learn/job.h"
 #include "learn/learningEnvironment.h"
 #include "learn/learningParameters.h"
@@ -99,6 +103,19 @@ namespace Learn {
         std::map<const TPG::TPGVertex*, std::shared_ptr<EvaluationResult>>
             resultsPerRoot;
 
+        /**
+         * \brief EvaluationTable storing the results of the last evaluation
+         * of the roots in the training process.
+         *
+         * The table is filled by the evaluateAllRootsInTable() method called
+         * by trainOneGeneration(), and is reused from one generation to the
+         * next. After the decimation, it contains only the kept roots.
+         */
+        EvaluationTable evaluationTable;
+
+        /// DecimationEngine used to select the roots kept at each generation.
+        DecimationEngine decimationEngine;
+
         /// Random Number Generator for this Learning Agent
         Mutator::RNG rng;
 
@@ -118,6 +135,72 @@ namespace Learn {
         /// generation
         double bestScoreLastGen = 0.0;
 
+        /**
+         * \brief Optional BatchLearningEnvironment used to evaluate roots in
+         * lockstep.
+         *
+         * When this pointer is not null, the evaluateAllRoots() method
+         * evaluates the roots with the evaluateJobsInLockstep() method instead
+         * of the scalar evaluateJobInTable() method.
+         */
+        BatchLearningEnvironment* batchLearningEnvironment = nullptr;
+
+        /**
+         * \brief Method to merge the shards of a ShardedArchive filled
+         * independently.
+         *
+         * The purpose of this method is to merge several shards, each filled
+         * during the evaluation of a single Job, into the archive attribute of
+         * this LearningAgent. The last params.archiveSize recordings, in the
+         * order of the Job indexes, are kept. This method is the key to obtain
+         * deterministic Archive even in a parallel context.
+         *
+         * \param[in,out] shardedArchive the ShardedArchive whose shards are
+         * merged. Shards are removed by the method.
+         */
+        void mergeShardedArchive(ShardedArchive& shardedArchive);
+
+        /**
+         * \brief Evaluate all roots of the TPGGraph in lockstep with the
+         * batchLearningEnvironment.
+         *
+         * In training mode, each root records into a dedicated shard of a
+         * ShardedArchive, merged into the archive attribute of the
+         * LearningAgent with the mergeShardedArchive() method, as in parallel
+         * evaluations.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[out] table the EvaluationTable filled with one row per root,
+         * in the order of jobs.
+         */
+        void evaluateAllRootsInLockstep(uint64_t generationNumber,
+                                        LearningMode mode,
+                                        EvaluationTable& table);
+
+        /**
+         * \brief Distribute the given Jobs for their lockstep evaluation.
+         *
+         * Default implementation evaluates all Jobs in the calling thread
+         * with the batchLearningEnvironment.
+         *
+         * \param[in] jobs the Jobs to evaluate.
+         * \param[in] archives one Archive per Job, or an empty vector if no
+         * Archive is used.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in,out] table the EvaluationTable to which one row per Job is
+         * added, in the order of the jobs.
+         */
+        virtual void distributeLockstepJobs(
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const std::vector<Archive*>& archives, uint64_t generationNumber,
+            LearningMode mode, EvaluationTable& table);
+
       public:
         /**
          * \brief Constructor for LearningAgent.
@@ -135,7 +218,8 @@ namespace Learn {
             : learningEnvironment{le}, env(iSet, le.getDataSources(),
                                            p.nbRegisters, p.nbProgramConstant),
               tpg(factory.createTPGGraph(env)), params{p},
-              archive(p.archiveSize, p.archivingProbability)
+              archive(p.archiveSize, p.archivingProbability, 0,
+                      p.archiveDeltaSnapshots)
         {
             // override the number of actions from the parameters.
             this->params.mutation.tpg.nbActions =
@@ -159,6 +243,30 @@ namespace Learn {
          */
         const Archive& getArchive() const;
 
+        /**
+         * \brief Getter for the EvaluationTable filled by the LearningAgent.
+         *
+         * The table contains the results of the last evaluation of all roots
+         * during the training process. It can notably be used by LALogger
+         * to access the scores of the roots without copying them.
+         *
+         * \return a const reference to the EvaluationTable.
+         */
+        const EvaluationTable& getEvaluationTable() const;
+
+        /**
+         * \brief Get the memory used by the LearningAgent.
+         *
+         * The returned MemoryFootprint contains the "archive" and the "tpg"
+         * components, prefixing the components of the Archive and TPGGraph
+         * footprints, the "resultsPerRoot" map with the footprint of its
+         * EvaluationResult, and the "evaluationTable" components of the
+         * EvaluationTable footprint. The LearningEnvironment is not counted.
+         *
+         * \return the MemoryFootprint of the LearningAgent.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+
         /**
          * \brief Accessor to the Environment of the TPGGraph.
          *
@@ -166,6 +274,47 @@ namespace Learn {
          */
         const Environment& getEnvironment() const;
 
+        /**
+         * \brief Set the BatchLearningEnvironment used to evaluate roots in
+         * lockstep.
+         *
+         * Once set, the evaluateAllRoots() method evaluates roots with the
+         * given BatchLearningEnvironment instead of the LearningEnvironment
+         * given at construction. Lanes of the BatchLearningEnvironment must
+         * simulate the same episodes as the LearningEnvironment, and their
+         * data sources must be copies of the ones of the LearningEnvironment.
+         *
+         * \param[in] ble pointer to the BatchLearningEnvironment, or nullptr
+         * to go back to the scalar evaluation of roots.
+         * \throws std::runtime_error if the number of actions or the data
+         * sources of the BatchLearningEnvironment differ from the ones of the
+         * LearningEnvironment.
+         */
+        void setBatchLearningEnvironment(BatchLearningEnvironment* ble);
+
+        /// Get the BatchLearningEnvironment used for lockstep evaluations.
+        BatchLearningEnvironment* getBatchLearningEnvironment() const;
+
+        /**
+         * \brief Select the execution mode of Programs during the training.
+         *
+         * This method forwards the mode to the
+         * Environment::setBytecodeExecution() method of the Environment of
+         * the LearningAgent, and recompiles the Programs already in the
+         * TPGGraph with TPGGraph::optimizePrograms(). Programs created or
+         * mutated afterwards by the training process are compiled in the
+         * selected mode. Results of the training are identical in both modes.
+         *
+         * \param[in] enabled whether the bytecode execution is enabled.
+         * \param[in] superinstructions pairs of Instructions fused into a
+         * single handler when compiling Programs. No Instruction is fused if
+         * nullptr.
+         */
+        void setBytecodeExecution(
+            bool enabled,
+            std::shared_ptr<const Program::SuperinstructionSet>
+                superinstructions = nullptr);
+
         /**
          * \brief Getter for the RNG used by the LearningAgent.
          *
@@ -186,14 +335,16 @@ namespace Learn {
         void addLogger(Log::LALogger& logger);
 
         /**
-         * \brief Evaluates policy starting from the given root.
+         * \brief Evaluates policy starting from the given root, and adds its
+         * result to an EvaluationTable.
          *
          * The policy, that is, the TPGGraph execution starting from the given
          * TPGVertex is evaluated nbIteration times. The generationNumber is
          * combined with the current iteration number to generate a set of
          * seeds for evaluating the policy.
          *
-         * The method is const to enable potential parallel calls to it.
+         * The method is const to enable potential parallel calls to it, each
+         * with its own table.
          *
          * \param[in] tee The TPGExecutionEngine to use.
          * \param[in] job The job containing the root and archiveSeed for
@@ -205,18 +356,77 @@ namespace Learn {
          * \param[in] le Reference to the LearningEnvironment to use
          * during the policy evaluation (may be different from the attribute of
          * the class in child LearningAgentClass).
+         * \param[in,out] table the EvaluationTable to which one row is added
+         * for the root. If this root was already evaluated more times then the
+         * limit in params.maxNbEvaluationPerPolicy, the row holds the
+         * EvaluationResult from the resultsPerRoot map. Otherwise, the row
+         * stores by value the result of the current generation, already
+         * combined with the resultsPerRoot for this root (if any).
+         */
+        virtual void evaluateJobInTable(TPG::TPGExecutionEngine& tee,
+                                        const Job& job,
+                                        uint64_t generationNumber,
+                                        LearningMode mode,
+                                        LearningEnvironment& le,
+                                        EvaluationTable& table) const;
+
+        /**
+         * \brief Evaluates policy starting from the given root.
          *
-         * \return a std::shared_ptr to the EvaluationResult for the root. If
-         * this root was already evaluated more times then the limit in
-         * params.maxNbEvaluationPerPolicy, then the EvaluationResult from the
-         * resultsPerRoot map is returned, else the EvaluationResult of the
-         * current generation is returned, already combined with the
-         * resultsPerRoot for this root (if any).
+         * The root is evaluated with the evaluateJobInTable() method, which
+         * child classes must override instead of this one.
+         *
+         * \param[in] tee The TPGExecutionEngine to use.
+         * \param[in] job The job containing the root and archiveSeed for
+         * the evaluation.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] le Reference to the LearningEnvironment to use
+         * during the policy evaluation.
+         *
+         * \return a std::shared_ptr to the EvaluationResult for the root, as
+         * given by EvaluationTable::getResult() for the row added by
+         * evaluateJobInTable().
          */
         virtual std::shared_ptr<EvaluationResult> evaluateJob(
             TPG::TPGExecutionEngine& tee, const Job& job,
             uint64_t generationNumber, LearningMode mode,
-            LearningEnvironment& le) const;
+            LearningEnvironment& le) const final;
+
+        /**
+         * \brief Evaluates policies starting from the roots of several Jobs
+         * in lockstep.
+         *
+         * This method produces the same rows as the evaluateJobInTable()
+         * method, but runs up to ble.getNbLanes() roots together: for each
+         * iteration, the roots of consecutive Jobs are assigned to the lanes
+         * of the BatchLearningEnvironment, which are reset with the same seed
+         * as in evaluateJobInTable(). At each step, the TPG is executed from
+         * each root whose lane is not terminal, and the obtained actions are
+         * executed together with BatchLearningEnvironment::doActions().
+         *
+         * The method is const to enable potential parallel calls to it.
+         *
+         * \param[in] jobs the Jobs whose root are evaluated.
+         * \param[in] archives one Archive per Job, where results of Programs
+         * executed for the Job are recorded, or an empty vector if no Archive
+         * is used.
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[in] ble the BatchLearningEnvironment used for the
+         * evaluation.
+         * \param[in,out] table the EvaluationTable to which one row per Job is
+         * added, in the order of the jobs.
+         */
+        virtual void evaluateJobsInLockstep(
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const std::vector<Archive*>& archives, uint64_t generationNumber,
+            LearningMode mode, BatchLearningEnvironment& ble,
+            EvaluationTable& table) const;
 
         /**
          * \brief Method detecting whether a root should be evaluated again.
@@ -237,12 +447,35 @@ namespace Learn {
             const TPG::TPGVertex& root,
             std::shared_ptr<Learn::EvaluationResult>& previousResult) const;
 
+        /**
+         * \brief Evaluate all root TPGVertex of the TPGGraph into an
+         * EvaluationTable.
+         *
+         * This method calls the evaluateJobInTable method for every root
+         * TPGVertex of the TPGGraph, which adds one row per root to the given
+         * table, in the order of roots. The table is cleared first.
+         *
+         * If a BatchLearningEnvironment was set with
+         * setBatchLearningEnvironment(), roots are evaluated in lockstep with
+         * the evaluateJobsInLockstep() method instead.
+         *
+         * \param[in] generationNumber the integer number of the current
+         * generation.
+         * \param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * \param[out] table the EvaluationTable filled with the results.
+         */
+        virtual void evaluateAllRootsInTable(uint64_t generationNumber,
+                                             LearningMode mode,
+                                             EvaluationTable& table);
+
         /**
          * \brief Evaluate all root TPGVertex of the TPGGraph.
          *
-         * This method calls the evaluateJob method for every root TPGVertex
-         * of the TPGGraph. The method returns a sorted map associating each
-         * root vertex to its average score, in ascending order or score.
+         * This method evaluates all roots with the evaluateAllRootsInTable()
+         * method, which child classes must override instead of this one. The
+         * method returns a sorted map associating each root vertex to its
+         * average score, in ascending order or score.
          *
          * \param[in] generationNumber the integer number of the current
          * generation.
@@ -251,7 +484,7 @@ namespace Learn {
          */
         virtual std::multimap<std::shared_ptr<EvaluationResult>,
                               const TPG::TPGVertex*>
-        evaluateAllRoots(uint64_t generationNumber, LearningMode mode);
+        evaluateAllRoots(uint64_t generationNumber, LearningMode mode) final;
 
         /**
          * \brief Evaluate one root TPGVertex of the TPGGraph.
@@ -279,9 +512,13 @@ namespace Learn {
          *
          * Training for one generation includes:
          * - Populating the TPGGraph according to given MutationParameters.
-         * - Evaluating all roots of the TPGGraph. (call to evaluateAllRoots)
+         * - Evaluating all roots of the TPGGraph into the evaluationTable.
+         *   (call to evaluateAllRootsInTable)
          * - Removing from the TPGGraph the worst performing root TPGVertex.
          *
+         * The sorted map of results is built from the evaluationTable only
+         * if loggers are attached to the LearningAgent.
+         *
          * \param[in] generationNumber the integer number of the current
          * generation.
          */
@@ -292,18 +529,33 @@ namespace Learn {
          * \brief Removes from the TPGGraph the root TPGVertex with the worst
          * results.
          *
-         * The given multimap is updated by removing entries corresponding to
-         * decimated vertices.
+         * Rows of the given table corresponding to decimated vertices are
+         * removed from it.
          *
          * The resultsPerRoot attribute is updated to remove results associated
          * to removed vertices.
          *
+         * \param[in,out] table an EvaluationTable containing root TPGVertex
+         * associated to their score during an evaluation.
+         */
+        virtual void decimateWorstRoots(EvaluationTable& table);
+
+        /**
+         * \brief Removes from the TPGGraph the root TPGVertex with the worst
+         * results.
+         *
+         * The evaluationTable attribute is filled with the given results,
+         * before calling the decimateWorstRoots(EvaluationTable&) method,
+         * which child classes must override instead of this one. The given
+         * multimap is updated by removing entries corresponding to decimated
+         * vertices.
+         *
          * \param[in,out] results a multimap containing root TPGVertex
          * associated to their score during an evaluation.
          */
         virtual void decimateWorstRoots(
             std::multimap<std::shared_ptr<EvaluationResult>,
-                          const TPG::TPGVertex*>& results);
+                          const TPG::TPGVertex*>& results) final;
 
         /**
          * \brief Train the TPGGraph for a given number of generation.
@@ -339,6 +591,21 @@ namespace Learn {
          * was removed from the graph in a following generation, beaten by root
          * vertex with lower scores than the current record.
          *
+         * Stored results of roots evaluated again are updated in place when
+         * the rows of the table were added by value, and replaced by the
+         * shared result of the row otherwise.
+         *
+         * \param[in] table EvaluationTable from the evaluateAllRootsInTable
+         * method.
+         */
+        void updateEvaluationRecords(const EvaluationTable& table);
+
+        /**
+         * \brief Update the bestRoot and resultsPerRoot attributes.
+         *
+         * Same as updateEvaluationRecords(const EvaluationTable&), with the
+         * results of an evaluation stored in a map.
+         *
          * \param[in] results Map from the evaluateAllRoots method.
          */
         void updateEvaluationRecords(
@@ -355,6 +622,15 @@ namespace Learn {
          */
         void forgetPreviousResults();
 
+        /**
+         * \brief This method update the best score reached at the last
+         * generation trained.
+         *
+         * \param[in] table EvaluationTable from the evaluateAllRootsInTable
+         * method.
+         */
+        void updateBestScoreLastGen(const EvaluationTable& table);
+
         /**
          * \brief This method update the best score reached at the last
          * generation trained.
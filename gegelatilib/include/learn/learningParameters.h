@@ -70,6 +70,20 @@ namespace Learn {
         /// Probability of archiving the result of each Program execution.
         double archivingProbability = 0.05;
 
+        /// JSon comment
+        inline static const std::string archiveDeltaSnapshotsComment =
+            "// Store successive states of each data source in the Archive as\n"
+            "// differences with an earlier copy, to reduce its memory.\n"
+            "// \"archiveDeltaSnapshots\" : false, // Default value";
+        /**
+         * \brief Whether the Archive stores delta snapshots of DataHandler.
+         *
+         * When true, successive states of a DataHandler are stored as
+         * differences with an earlier copy of the same DataHandler, and are
+         * materialized only during the neutrality check of mutated Program.
+         */
+        bool archiveDeltaSnapshots = false;
+
         /// JSon comment
         inline static const std::string nbIterationsPerPolicyEvaluationComment =
             "// Number of evaluation of each root per generation.\n"
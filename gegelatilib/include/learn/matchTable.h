@@ -0,0 +1,205 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef MATCH_TABLE_H
+#define MATCH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "tpg/tpgVertex.h"
+
+namespace Learn {
+    /**
+     * \brief Class storing the matches played during the evaluation of an
+     * AdversarialLearningAgent.
+     *
+     * A match is the equivalent of an AdversarialJob: a list of participants,
+     * one per seat, in their order of play. Instead of allocating one
+     * AdversarialJob per match, the MatchTable stores all matches in flat
+     * arrays where participants are designated by a dense index.
+     *
+     * Each match is identified by its index, which is the order in which it
+     * was added to the MatchTable. This index is used to seed the Archive of
+     * the match and to combine results deterministically. Matches are also
+     * associated to an opponent group, typically the team of champions they
+     * involve, and the execution schedule returned by getSchedule() gathers
+     * the matches of a group, so that consecutive matches executed by a
+     * worker involve the same opponents.
+     */
+    class MatchTable
+    {
+      protected:
+        /// Number of seats in each match.
+        size_t nbSeats;
+
+        /// Participants of the matches.
+        std::vector<const TPG::TPGVertex*> participants;
+
+        /// Index of each participant in the participants vector.
+        std::unordered_map<const TPG::TPGVertex*, uint32_t> participantIdx;
+
+        /**
+         * \brief Participant indexes of the matches.
+         *
+         * The nbSeats participants of a match are stored contiguously,
+         * starting at index matchIdx * nbSeats.
+         */
+        std::vector<uint32_t> seats;
+
+        /**
+         * \brief Seat of the participant whose score is studied in each
+         * match.
+         *
+         * A value of -1 means that the scores of all participants of the
+         * match are studied.
+         */
+        std::vector<int16_t> studiedSeats;
+
+        /// Seed of the Archive used for each match.
+        std::vector<uint64_t> archiveSeeds;
+
+        /// Opponent group of each match.
+        std::vector<uint32_t> opponentGroups;
+
+        /// Number of opponent groups referenced by the matches.
+        uint32_t nbOpponentGroups = 0;
+
+      public:
+        /**
+         * \brief Constructor of the MatchTable.
+         *
+         * \param[in] nbSeats the number of participants in each match.
+         * \throw std::runtime_error if nbSeats is 0.
+         */
+        MatchTable(size_t nbSeats);
+
+        /**
+         * \brief Get the index of a participant, adding it to the
+         * participants of the MatchTable if needed.
+         *
+         * Participants are indexed in the order in which they are added.
+         *
+         * \param[in] vertex the participant.
+         * \return the index of the participant.
+         */
+        uint32_t addParticipant(const TPG::TPGVertex* vertex);
+
+        /**
+         * \brief Add a match to the MatchTable.
+         *
+         * \param[in] matchSeats the participant index for each seat.
+         * \param[in] studiedSeat the seat whose score is studied, or -1 if the
+         * scores of all seats are studied.
+         * \param[in] archiveSeed the seed of the Archive for the match.
+         * \param[in] opponentGroup the opponent group of the match.
+         * \return the index of the added match.
+         * \throw std::runtime_error if the number of seats is not nbSeats, if
+         * a participant index is unknown, or if the studiedSeat is invalid.
+         */
+        size_t addMatch(const std::vector<uint32_t>& matchSeats,
+                        int16_t studiedSeat, uint64_t archiveSeed,
+                        uint32_t opponentGroup = 0);
+
+        /// Get the number of seats of matches.
+        size_t getNbSeats() const;
+
+        /// Get the number of matches.
+        size_t getNbMatches() const;
+
+        /// Get the number of participants.
+        size_t getNbParticipants() const;
+
+        /**
+         * \brief Get a participant from its index.
+         *
+         * \throw std::out_of_range if the index is unknown.
+         */
+        const TPG::TPGVertex* getParticipant(uint32_t idx) const;
+
+        /**
+         * \brief Get the index of a participant.
+         *
+         * \param[in] vertex the participant.
+         * \return the index of the participant.
+         * \throw std::out_of_range if the vertex is not a participant.
+         */
+        uint32_t findParticipant(const TPG::TPGVertex* vertex) const;
+
+        /**
+         * \brief Get the participant index in a seat of a match.
+         *
+         * \throw std::out_of_range if the match or the seat is unknown.
+         */
+        uint32_t getParticipantIdx(size_t matchIdx, size_t seat) const;
+
+        /**
+         * \brief Fill a vector with the participants of a match, in their
+         * order of play.
+         *
+         * \param[in] matchIdx the index of the match.
+         * \param[out] matchParticipants the vector to fill.
+         * \throw std::out_of_range if the match is unknown.
+         */
+        void getMatchParticipants(
+            size_t matchIdx,
+            std::vector<const TPG::TPGVertex*>& matchParticipants) const;
+
+        /// Get the studied seat of a match, or -1 if all seats are studied.
+        int16_t getStudiedSeat(size_t matchIdx) const;
+
+        /// Get the Archive seed of a match.
+        uint64_t getArchiveSeed(size_t matchIdx) const;
+
+        /// Get the opponent group of a match.
+        uint32_t getOpponentGroup(size_t matchIdx) const;
+
+        /**
+         * \brief Get the execution order of the matches.
+         *
+         * Matches are ordered by opponent group and, within a group, by
+         * increasing index. The schedule is computed with a counting sort in
+         * linear time.
+         *
+         * \return a vector of all match indexes, in execution order.
+         */
+        std::vector<size_t> getSchedule() const;
+    };
+} // namespace Learn
+
+#endif
@@ -74,13 +74,12 @@ namespace Learn {
          *
          * \param[in] generationNumber the integer number of the current
          * generation. \param[in] mode the LearningMode to use during the policy
-         * evaluation. \param[in] results Map to store the resulting score of
-         * evaluated roots.
+         * evaluation. \param[out] table EvaluationTable to store the
+         * resulting score of evaluated roots.
          */
-        virtual void evaluateAllRootsInParallel(
-            uint64_t generationNumber, LearningMode mode,
-            std::multimap<std::shared_ptr<EvaluationResult>,
-                          const TPG::TPGVertex*>& results);
+        virtual void evaluateAllRootsInParallel(uint64_t generationNumber,
+                                                LearningMode mode,
+                                                EvaluationTable& table);
 
         /**
          * \brief Subfunction of evaluateAllRootsInParallel which handles the
@@ -90,41 +89,46 @@ namespace Learn {
          * generation.
          * @param[in] mode the LearningMode to use during the policy
          * evaluation.
-         * @param[out] resultsPerJobMap map linking the job number with its
-         * results and itself.
-         * @param[out] archiveMap map linking the job number with its gathered
-         * archive. These archive swill later be merged with the ones of the
-         * other jobs.
+         * Each thread adds the rows of the jobs it evaluates to its own
+         * EvaluationTable. Rows are then gathered in the order of the job
+         * numbers, so that results do not depend on the threads.
+         *
+         * @param[in] generationNumber the integer number of the current
+         * generation.
+         * @param[in] mode the LearningMode to use during the policy
+         * evaluation.
+         * @param[out] jobs the evaluated jobs, in the order of their number.
+         * @param[out] jobTable EvaluationTable filled with one row per job, in
+         * the order of jobs.
+         * @param[out] shardedArchive ShardedArchive with one shard per job,
+         * indexed by the job number. These shards will later be merged with
+         * the archive of the LearningAgent.
          */
         virtual void evaluateAllRootsInParallelExecute(
             uint64_t generationNumber, LearningMode mode,
-            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                         std::shared_ptr<Job>>>&
-                resultsPerJobMap,
-            std::map<uint64_t, Archive*>& archiveMap);
+            std::vector<std::shared_ptr<Job>>& jobs, EvaluationTable& jobTable,
+            ShardedArchive& shardedArchive);
 
         /**
          * \brief Subfunction of evaluateAllRootsInParallel which handles the
          * gathering of results and the merge of the archives.
          *
-         * This method just emplaces results from resultsPerJobMap, as each
-         * job only contains 1 root is is quite easy.
-         * The archive is merged with the mergeArchiveMap method.
+         * This method just copies each row of the jobTable to the table, in
+         * the order of jobs, as each job only contains 1 root.
+         * The archive is merged with the mergeShardedArchive method.
          *
-         * @param[in] resultsPerJobMap map linking the job number with its
-         * results and itself.
-         * @param[out] results map linking single results to their root vertex.
-         * @param[in,out] archiveMap map linking the job number with its
-         * gathered archive. These archive swill later be merged with the ones
-         * of the other jobs.
+         * @param[in] jobs the evaluated jobs, in the order of their number.
+         * @param[in] jobTable EvaluationTable with one row per job, in the
+         * order of jobs.
+         * @param[out] table EvaluationTable linking single results to their
+         * root vertex.
+         * @param[in,out] shardedArchive ShardedArchive with one shard per job,
+         * indexed by the job number.
          */
         virtual void evaluateAllRootsInParallelCompileResults(
-            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                         std::shared_ptr<Job>>>&
-                resultsPerJobMap,
-            std::multimap<std::shared_ptr<EvaluationResult>,
-                          const TPG::TPGVertex*>& results,
-            std::map<uint64_t, Archive*>& archiveMap);
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const EvaluationTable& jobTable, EvaluationTable& table,
+            ShardedArchive& shardedArchive);
 
         /**
          * \brief Function implementing the behavior of slave threads during
@@ -133,42 +137,40 @@ namespace Learn {
          * \param[in] generationNumber the integer number of the current
          * generation. \param[in] mode the LearningMode to use during the policy
          * evaluation. \param[in,out] jobsToProcess Ordered list of jobs of
-         * TPGVertex to process, stored as a pair with an id filling the
-         * archiveMap. The jobs are groups of roots that shall be agents in the
+         * TPGVertex to process, stored as a pair with an id identifying the
+         * archive shard. The jobs are groups of roots that shall be agents in the
          * same simulation, there is only 1 root if there is no adversarial
          * (e.g. if the environmnent is not multiplayer).
          * \param[in] rootsToProcessMutex Mutex protecting the
-         * rootsToProcess \param[in] resultsPerRootMap Map to store the
-         * resulting score of evaluated roots. \param[in] resultsPerRootMapMutex
-         * Mutex protecting the results. \param[in,out] archiveMap Map
-         * storing the exhaustiveArchive to be merged. \param[in]
-         * archiveMapMutex Mutex protecting the archiveMap.
-         * \param[in] useMainEnvironment Boolean that is true if we use the
+         * rootsToProcess \param[in,out] threadTable EvaluationTable of the
+         * thread, to which one row is added per processed job.
+         * \param[in,out] threadJobIdxs Number of the job of each row of the
+         * threadTable. \param[in,out] shardedArchive
+         * ShardedArchive into which each job records directly, in the shard
+         * of its index. \param[in] useMainEnvironment Boolean that is true if we use the
          * declared LearningEnvironment, otherwise the method will clone it.
          */
         void slaveEvalJobThread(
             uint64_t generationNumber, LearningMode mode,
             std::queue<std::shared_ptr<Learn::Job>>& jobsToProcess,
-            std::mutex& rootsToProcessMutex,
-            std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                         std::shared_ptr<Job>>>&
-                resultsPerRootMap,
-            std::mutex& resultsPerRootMapMutex,
-            std::map<uint64_t, Archive*>& archiveMap,
-            std::mutex& archiveMapMutex, bool useMainEnvironment);
+            std::mutex& rootsToProcessMutex, EvaluationTable& threadTable,
+            std::vector<uint64_t>& threadJobIdxs,
+            ShardedArchive& shardedArchive, bool useMainEnvironment);
 
         /**
-         * \brief Method to merge several Archive created in parallel
-         * threads.
-         *
-         * The purpose of this method is to merhe several Archive
-         * into the archive attribute of this ParallelLearningAgent. This
-         * method is the key to obtain deterministic Archive even in a parallel
-         * context.
+         * \brief Distribute the given Jobs among threads for their lockstep
+         * evaluation.
          *
-         * \param[in,out] archiveMap Map storing the Archive to be merged.
+         * If the batchLearningEnvironment is copyable and several threads
+         * are allowed, the Jobs are split into contiguous slices, each
+         * evaluated by a thread with its own copy of the
+         * batchLearningEnvironment. Otherwise, the LearningAgent
+         * implementation is used.
          */
-        void mergeArchiveMap(std::map<uint64_t, Archive*>& archiveMap);
+        void distributeLockstepJobs(
+            const std::vector<std::shared_ptr<Job>>& jobs,
+            const std::vector<Archive*>& archives, uint64_t generationNumber,
+            LearningMode mode, EvaluationTable& table) override;
 
       public:
         /**
@@ -194,24 +196,27 @@ namespace Learn {
         };
 
         /**
-         * \brief Evaluate all root TPGVertex of the TPGGraph.
+         * \brief Evaluate all root TPGVertex of the TPGGraph into an
+         * EvaluationTable.
          *
          * **Replaces the function from the base class LearningAgent.**
          *
-         * This method must always the same results as the evaluateAllRoots for
-         * a sequential execution. The Archive should also be updated in the
-         * exact same manner.
+         * This method must always the same results as the
+         * evaluateAllRootsInTable for a sequential execution. The Archive
+         * should also be updated in the exact same manner.
          *
-         * This method calls the evaluateJob method for every root TPGVertex
-         * of the TPGGraph. The method returns a sorted map associating each
-         * root vertex to its average score, in ascending order or score.
+         * This method calls the evaluateJobInTable method for every root
+         * TPGVertex of the TPGGraph, and adds one row per root to the given
+         * table, in the order of roots.
          *
          * \param[in] generationNumber the integer number of the current
          * generation. \param[in] mode the LearningMode to use during the policy
-         * evaluation.
+         * evaluation. \param[out] table the EvaluationTable filled with the
+         * results.
          */
-        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
-        evaluateAllRoots(uint64_t generationNumber, LearningMode mode) override;
+        void evaluateAllRootsInTable(uint64_t generationNumber,
+                                     LearningMode mode,
+                                     EvaluationTable& table) override;
     };
 } // namespace Learn
 #endif
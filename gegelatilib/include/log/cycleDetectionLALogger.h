@@ -33,6 +33,8 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <vector>
+
 #include "laLogger.h"
 
 namespace Log {
@@ -42,6 +44,18 @@ namespace Log {
      *
      * This utility class implement a depth-first search algorithm for detecting
      * the presence of directed cyclic paths in TPGs.
+     *
+     * The search is an iterative DFS where each vertex is colored white (not
+     * visited yet), grey (on the current DFS path), or black (fully explored).
+     * A cycle exists if and only if an edge leading to a grey vertex is
+     * encountered. Colors are stored in a hash map filled during the search,
+     * so that its complexity is linear with the number of vertices and edges
+     * reachable from the vertices where the search starts.
+     *
+     * In incremental mode, the logger enables the tracking of modified TPGEdge
+     * in the TPGGraph. Since any new cycle must go through a TPGEdge added or
+     * redirected since the previous check, the DFS is only started from the
+     * destinations of these TPGEdge during the following check.
      */
     class CycleDetectionLALogger : public LALogger
     {
@@ -49,6 +63,28 @@ namespace Log {
         /// Control whether a message is printed when no loop is detected.
         bool logOnSuccess;
 
+        /// Control whether only the modified part of the TPG is checked.
+        bool incremental;
+
+        /**
+         * \brief Whether the previous check searched the whole TPG, or its
+         * modified part, without detecting any cycle.
+         *
+         * When false, the next check searches the whole TPG.
+         */
+        bool previousCheckAcyclic = false;
+
+        /**
+         * \brief Search for a directed cycle reachable from a set of vertices.
+         *
+         * \param[in] vertices the TPGVertex pointers from which the DFS is
+         * started.
+         * \return true if a directed cycle can be reached from the given
+         * vertices, false otherwise.
+         */
+        static bool hasCycle(
+            const std::vector<const TPG::TPGVertex*>& vertices);
+
       public:
         /**
          * \brief Same constructor as LALogger. Default output is cerr.
@@ -59,13 +95,14 @@ namespace Log {
          * elements to.
          * \param[in] logOnSuccess When true, the logger will log the absence of
          * cycles.
+         * \param[in] incremental When true, each check only searches the
+         * subgraphs reachable from the edges modified since the previous
+         * check.
          */
         explicit CycleDetectionLALogger(Learn::LearningAgent& la,
                                         std::ostream& out = std::cerr,
-                                        bool logOnSuccess = false)
-            : LALogger(la, out), logOnSuccess(logOnSuccess)
-        {
-        }
+                                        bool logOnSuccess = false,
+                                        bool incremental = false);
 
         /**
          * Inherited via LALogger
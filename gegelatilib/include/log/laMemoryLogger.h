@@ -0,0 +1,124 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef LA_MEMORY_LOGGER_H
+#define LA_MEMORY_LOGGER_H
+
+#include <string>
+
+#include "log/laLogger.h"
+#include "util/memoryFootprint.h"
+
+namespace Log {
+
+    /**
+     * \brief LALogger reporting the memory used by the LearningAgent at the
+     * end of each generation.
+     *
+     * The logged columns are, in bytes, the archive recordings and indexes
+     * ("Archive"), the DataHandler copies of the archive ("Snapshots"), the
+     * TPGGraph "Vertices", "Edges" and "Programs", the "Results" kept for
+     * each root, and the "Total" of the LearningAgent::getMemoryFootprint().
+     */
+    class LAMemoryLogger : public LALogger
+    {
+      protected:
+        /// Width of columns when logging values.
+        int colWidth;
+
+        /// Separator between columns.
+        std::string separator;
+
+        /// Number of the current generation.
+        uint64_t generationNumber = 0;
+
+        /// Footprint of the LearningAgent at the end of the last generation.
+        Util::MemoryFootprint lastFootprint;
+
+      public:
+        /**
+         * \brief Same constructor as LALogger. Default output is cout.
+         *
+         * \param[in] la LearningAgent whose memory is logged.
+         * \param[in] out The output stream the logger will send elements to.
+         * \param[in] colWidth Width of the columns.
+         * \param[in] separator Separator between columns, e.g. for CSV files.
+         */
+        explicit LAMemoryLogger(Learn::LearningAgent& la,
+                                std::ostream& out = std::cout,
+                                int colWidth = 12,
+                                std::string separator = " ");
+
+        /// Get the footprint of the LearningAgent at the end of the last
+        /// generation.
+        const Util::MemoryFootprint& getLastFootprint() const;
+
+        /// Inherited via LALogger. Logs the column names.
+        virtual void logHeader() override;
+
+        /// Inherited via LALogger. Keeps the generation number.
+        virtual void logNewGeneration(uint64_t& generationNumber) override;
+
+        /// Inherited via LALogger. Does nothing in this logger.
+        virtual void logAfterPopulateTPG() override{
+            // nothing to log
+        };
+
+        /// Inherited via LALogger. Does nothing in this logger.
+        virtual void logAfterEvaluate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override{
+            // nothing to log
+        };
+
+        /// Inherited via LALogger. Does nothing in this logger.
+        virtual void logAfterDecimate() override{
+            // nothing to log
+        };
+
+        /// Inherited via LALogger. Does nothing in this logger.
+        virtual void logAfterValidate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override{
+            // nothing to log
+        };
+
+        /// Inherited via LALogger. Logs the memory used by the LearningAgent.
+        virtual void logEndOfTraining() override;
+    };
+} // namespace Log
+
+#endif
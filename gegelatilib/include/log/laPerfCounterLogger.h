@@ -0,0 +1,171 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef LA_PERF_COUNTER_LOGGER_H
+#define LA_PERF_COUNTER_LOGGER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "log/laLogger.h"
+#include "log/perfCounters.h"
+
+namespace Log {
+
+    /**
+     * \brief LALogger reporting the hardware performance counters of each
+     * phase of the training.
+     *
+     * For each generation, this logger counts the cycles, instructions, L1
+     * data cache read misses, last level cache misses and branch misses of
+     * the mutation (populateTPG), evaluation and, if any, validation phases.
+     * One row is logged for each phase and each thread: the "main" thread
+     * running the training, followed by one row per worker thread started
+     * during the phase, in their order of termination.
+     *
+     * The logger must be constructed by the thread running the training.
+     * While it exists, it activates the PerfCounterRegistry so that worker
+     * threads of the library count their events. A single
+     * LAPerfCounterLogger should exist at a time.
+     *
+     * Counters rely on the Linux perf_event_open system call. When hardware
+     * events are not permitted, the header explains why and no row is
+     * logged. Individual events unsupported by the processor are logged as
+     * "n/a".
+     */
+    class LAPerfCounterLogger : public LALogger
+    {
+      protected:
+        /// Width of columns when logging values.
+        int colWidth;
+
+        /// Separator between columns.
+        std::string separator;
+
+        /// Counters of the thread running the training.
+        PerfCounterGroup mainCounters;
+
+        /// Number of the current generation.
+        uint64_t generationNumber = 0;
+
+        /**
+         * \brief Counted values of the last occurrence of each phase.
+         *
+         * The first values of each phase are those of the main thread,
+         * followed by those of worker threads.
+         */
+        std::map<std::string, std::vector<PerfCounterValues>> phaseValues;
+
+        /// Start counting a phase.
+        void startPhase();
+
+        /**
+         * \brief Stop counting a phase, and log its rows.
+         *
+         * \param[in] phase the name of the phase.
+         */
+        void endPhase(const std::string& phase);
+
+        /// Log a value, or "n/a" if it is unavailable.
+        void logValue(const PerfCounterValues& values, PerfCounter counter);
+
+      public:
+        /**
+         * \brief Same constructor as LALogger. Default output is cout.
+         *
+         * \param[in] la LearningAgent whose training is logged.
+         * \param[in] out The output stream the logger will send elements to.
+         * \param[in] colWidth Width of the columns.
+         * \param[in] separator Separator between columns, e.g. for CSV files.
+         */
+        explicit LAPerfCounterLogger(Learn::LearningAgent& la,
+                                     std::ostream& out = std::cout,
+                                     int colWidth = 12,
+                                     std::string separator = " ");
+
+        /// Deactivate the PerfCounterRegistry.
+        virtual ~LAPerfCounterLogger();
+
+        /// Are hardware events counted.
+        bool isAvailable() const;
+
+        /**
+         * \brief Get the values counted during the last occurrence of a
+         * phase.
+         *
+         * \param[in] phase "mutation", "evaluation" or "validation".
+         * \return the values of the main thread followed by those of worker
+         * threads, or an empty vector if the phase was not counted.
+         */
+        const std::vector<PerfCounterValues>& getPhaseValues(
+            const std::string& phase) const;
+
+        /**
+         * Inherited via LALogger.
+         *
+         * \brief Logs the column names, or the reason why counters are
+         * unavailable.
+         */
+        virtual void logHeader() override;
+
+        /// Inherited via LALogger. Starts counting the mutation.
+        virtual void logNewGeneration(uint64_t& generationNumber) override;
+
+        /// Inherited via LALogger. Logs the mutation, counts the evaluation.
+        virtual void logAfterPopulateTPG() override;
+
+        /// Inherited via LALogger. Logs the evaluation.
+        virtual void logAfterEvaluate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /// Inherited via LALogger. Starts counting the validation, if any.
+        virtual void logAfterDecimate() override;
+
+        /// Inherited via LALogger. Logs the validation.
+        virtual void logAfterValidate(
+            std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                          const TPG::TPGVertex*>& results) override;
+
+        /// Inherited via LALogger. Does nothing in this logger.
+        virtual void logEndOfTraining() override{
+            // nothing to log
+        };
+    };
+} // namespace Log
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Log {
+
+    /// Hardware events counted by a PerfCounterGroup.
+    enum class PerfCounter : size_t
+    {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        L1D_READ_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+    };
+
+    /**
+     * \brief Values of the hardware events counted by a PerfCounterGroup.
+     *
+     * Events that could not be counted are marked as unavailable, and their
+     * value is zero.
+     */
+    struct PerfCounterValues
+    {
+        /// Number of counted events.
+        static constexpr size_t NB_COUNTERS = 5;
+
+        /// Short names of the counted events, in the PerfCounter order.
+        static const char* const NAMES[NB_COUNTERS];
+
+        /// Counted values, in the PerfCounter order.
+        std::array<uint64_t, NB_COUNTERS> values{};
+
+        /// Availability of the counted values, in the PerfCounter order.
+        std::array<bool, NB_COUNTERS> available{};
+
+        /// Get the value of an event.
+        inline uint64_t get(PerfCounter counter) const
+        {
+            return this->values[(size_t)counter];
+        }
+
+        /// Is the value of an event available.
+        inline bool isAvailable(PerfCounter counter) const
+        {
+            return this->available[(size_t)counter];
+        }
+
+        /// Is the value of at least one event available.
+        bool isAvailable() const;
+
+        /**
+         * \brief Accumulate the values of another PerfCounterValues.
+         *
+         * An event is available in the result if it is available in any of
+         * the two operands.
+         */
+        PerfCounterValues& operator+=(const PerfCounterValues& other);
+    };
+
+    /**
+     * \brief Hardware performance counters of the calling thread.
+     *
+     * On Linux, the PerfCounterGroup opens one perf_event_open counter for
+     * each PerfCounter, counting events of the user space code of the thread
+     * constructing the PerfCounterGroup only. Each counter is opened
+     * separately so that events unsupported by the processor, or refused by
+     * the kernel, do not prevent counting the other ones. When the kernel
+     * multiplexes counters, values are scaled by the ratio of enabled and
+     * running times.
+     *
+     * When no counter can be opened, for example because the
+     * perf_event_paranoid setting forbids it, or when the platform is not
+     * Linux, the PerfCounterGroup is unavailable and all its values are
+     * marked as such. No exception is thrown.
+     */
+    class PerfCounterGroup
+    {
+      protected:
+        /// File descriptors of the counters, or -1.
+        std::array<int, PerfCounterValues::NB_COUNTERS> fds;
+
+        /// Message explaining why the last unavailable counter failed.
+        std::string errorMessage;
+
+      public:
+        /// Open the counters of the calling thread.
+        PerfCounterGroup();
+
+        /// Deleted copy constructor.
+        PerfCounterGroup(const PerfCounterGroup& other) = delete;
+
+        /// Close the counters.
+        ~PerfCounterGroup();
+
+        /// Is at least one counter available.
+        bool isAvailable() const;
+
+        /// Get the message explaining why counters are unavailable.
+        const std::string& getErrorMessage() const;
+
+        /// Reset and start the counters.
+        void start();
+
+        /// Stop the counters and get their values.
+        PerfCounterValues stop();
+    };
+
+    /**
+     * \brief Collector of the counters of worker threads.
+     *
+     * While the PerfCounterRegistry is active, each PerfCounterScope
+     * constructed by a thread other than the one that activated the registry
+     * counts the hardware events of its thread, and stores them in the
+     * registry when destroyed. The thread owning the registry is expected to
+     * count its own events.
+     *
+     * When inactive, a PerfCounterScope costs a single atomic load.
+     */
+    class PerfCounterRegistry
+    {
+      protected:
+        /// Are worker threads counted.
+        std::atomic<bool> active{false};
+
+        /// Thread which activated the registry.
+        std::thread::id ownerThread;
+
+        /// Mutex protecting the samples.
+        std::mutex samplesMutex;
+
+        /// Values counted by worker threads since the last take.
+        std::vector<PerfCounterValues> workerSamples;
+
+        /// Private constructor of the singleton.
+        PerfCounterRegistry() = default;
+
+      public:
+        /// Deleted copy constructor.
+        PerfCounterRegistry(const PerfCounterRegistry& other) = delete;
+
+        /// Get the PerfCounterRegistry of the process.
+        static PerfCounterRegistry& getInstance();
+
+        /**
+         * \brief Start counting worker threads.
+         *
+         * The calling thread becomes the owner of the registry, and
+         * previously stored samples are discarded.
+         */
+        void activate();
+
+        /// Stop counting worker threads.
+        void deactivate();
+
+        /// Are worker threads counted.
+        inline bool isActive() const
+        {
+            return this->active.load(std::memory_order_relaxed);
+        }
+
+        /// Is the calling thread the owner of the registry.
+        bool isOwnerThread() const;
+
+        /// Store the values counted by a worker thread.
+        void addWorkerSample(const PerfCounterValues& values);
+
+        /**
+         * \brief Get and remove the stored samples.
+         *
+         * \return one PerfCounterValues per PerfCounterScope destroyed since
+         * the last call, in their order of destruction.
+         */
+        std::vector<PerfCounterValues> takeWorkerSamples();
+    };
+
+    /**
+     * \brief Scoped counting of the hardware events of a worker thread.
+     *
+     * The PerfCounterScope is placed at the beginning of functions executed
+     * by worker threads of the library. It does nothing if the
+     * PerfCounterRegistry is inactive when it is constructed, or if it is
+     * constructed by the thread owning the registry.
+     */
+    class PerfCounterScope
+    {
+      protected:
+        /// Counters of the thread, if any.
+        std::unique_ptr<PerfCounterGroup> group;
+
+      public:
+        /// Start counting the events of the calling thread.
+        PerfCounterScope();
+
+        /// Deleted copy constructor.
+        PerfCounterScope(const PerfCounterScope& other) = delete;
+
+        /// Store the counted events in the PerfCounterRegistry.
+        ~PerfCounterScope();
+    };
+} // namespace Log
+
+#endif
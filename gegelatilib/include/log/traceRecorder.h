@@ -0,0 +1,268 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Log {
+
+    /**
+     * \brief Span of time recorded by the TraceRecorder.
+     *
+     * Times are given in nanoseconds since the creation of the
+     * TraceRecorder.
+     */
+    struct TraceEvent
+    {
+        /// Name of the span. Must be a string literal.
+        const char* name;
+
+        /// Index of the Job processed during the span, or -1.
+        int64_t jobIdx;
+
+        /// Start of the span.
+        uint64_t start;
+
+        /// Duration of the span.
+        uint64_t duration;
+    };
+
+    /**
+     * \brief Recorder of the trace spans of the training process.
+     *
+     * The TraceRecorder collects the TraceEvent of all threads in per-thread
+     * buffers, so that recording a span never requires a lock, and exports
+     * them in the Chrome Trace Event format, which can be viewed with
+     * Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+     *
+     * Spans are placed in the library with the GEGELATI_TRACE_SPAN macro,
+     * which is compiled only when the GEGELATI_TRACE macro is defined (with
+     * the TRACE CMake option). Otherwise, the macro expands to nothing and
+     * tracing has no overhead. When compiled, spans are recorded only while
+     * the TraceRecorder is enabled.
+     *
+     * Buffers of terminated threads are reused by new threads. Hence, the
+     * thread index of exported events identifies a worker slot rather than
+     * an operating system thread.
+     */
+    class TraceRecorder
+    {
+      protected:
+        /// Buffer of the events of a thread.
+        struct ThreadBuffer
+        {
+            /// Index of the thread in the exported trace.
+            uint64_t threadIdx;
+
+            /// Recorded events.
+            std::vector<TraceEvent> events;
+        };
+
+        /// Handle releasing the buffer of a thread when it terminates.
+        struct ThreadBufferHandle
+        {
+            /// Buffer of the thread, if any.
+            ThreadBuffer* buffer = nullptr;
+
+            /// Release the buffer.
+            ~ThreadBufferHandle();
+        };
+
+        /// Are spans currently recorded.
+        std::atomic<bool> enabled{false};
+
+        /// Reference time of recorded events.
+        const std::chrono::steady_clock::time_point epoch;
+
+        /// Mutex protecting the buffers.
+        std::mutex buffersMutex;
+
+        /// Buffers of all threads that recorded events.
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        /// Buffers of terminated threads, available for new threads.
+        std::vector<ThreadBuffer*> freeBuffers;
+
+        /// Private constructor of the singleton.
+        TraceRecorder() : epoch{std::chrono::steady_clock::now()} {};
+
+        /// Get the buffer of the calling thread.
+        ThreadBuffer& getThreadBuffer();
+
+      public:
+        /// Deleted copy constructor.
+        TraceRecorder(const TraceRecorder& other) = delete;
+
+        /// Get the TraceRecorder of the process.
+        static TraceRecorder& getInstance();
+
+        /// Start recording spans.
+        void enable();
+
+        /// Stop recording spans.
+        void disable();
+
+        /// Are spans currently recorded.
+        inline bool isEnabled() const
+        {
+            return this->enabled.load(std::memory_order_relaxed);
+        }
+
+        /// Get the time since the creation of the TraceRecorder, in ns.
+        inline uint64_t now() const
+        {
+            return (uint64_t)std::chrono::duration_cast<
+                       std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - this->epoch)
+                .count();
+        }
+
+        /**
+         * \brief Record a span in the buffer of the calling thread.
+         *
+         * \param[in] name the name of the span. Must be a string literal.
+         * \param[in] jobIdx the index of the processed Job, or -1.
+         * \param[in] start the start of the span, given by now().
+         * \param[in] end the end of the span, given by now().
+         */
+        void record(const char* name, int64_t jobIdx, uint64_t start,
+                    uint64_t end);
+
+        /**
+         * \brief Remove all recorded events.
+         *
+         * This method must not be called while spans are recorded.
+         */
+        void clear();
+
+        /// Get the number of recorded events.
+        size_t getNbEvents();
+
+        /**
+         * \brief Write recorded events in the Chrome Trace Event format.
+         *
+         * Each event is written as a complete event ("ph": "X"), with the
+         * index of its thread as "tid" and, if any, the index of its Job as
+         * argument.
+         *
+         * This method must not be called while spans are recorded.
+         *
+         * \param[in] out the stream in which the JSON is written.
+         */
+        void writeChromeTrace(std::ostream& out);
+
+        /**
+         * \brief Write recorded events in a Chrome Trace Event file.
+         *
+         * \param[in] filePath the path of the written file.
+         * \throws std::runtime_error if the file cannot be opened.
+         */
+        void writeChromeTrace(const std::string& filePath);
+    };
+
+    /**
+     * \brief Scoped span recorded by the TraceRecorder.
+     *
+     * The span starts when the TraceSpan is constructed and ends when it is
+     * destroyed. Nothing is recorded if the TraceRecorder is disabled when
+     * the TraceSpan is constructed.
+     */
+    class TraceSpan
+    {
+      protected:
+        /// Name of the span.
+        const char* const name;
+
+        /// Index of the Job processed during the span, or -1.
+        const int64_t jobIdx;
+
+        /// Is the span recorded.
+        const bool active;
+
+        /// Start of the span.
+        const uint64_t start;
+
+      public:
+        /**
+         * \brief Start a span.
+         *
+         * \param[in] name the name of the span. Must be a string literal.
+         * \param[in] jobIdx the index of the processed Job, if any.
+         */
+        TraceSpan(const char* name, int64_t jobIdx = -1)
+            : name{name}, jobIdx{jobIdx},
+              active{TraceRecorder::getInstance().isEnabled()},
+              start{this->active ? TraceRecorder::getInstance().now() : 0}
+        {
+        }
+
+        /// Deleted copy constructor.
+        TraceSpan(const TraceSpan& other) = delete;
+
+        /// End the span.
+        ~TraceSpan()
+        {
+            if (this->active) {
+                TraceRecorder& recorder = TraceRecorder::getInstance();
+                recorder.record(this->name, this->jobIdx, this->start,
+                                recorder.now());
+            }
+        }
+    };
+} // namespace Log
+
+#define GEGELATI_TRACE_CONCAT2(a, b) a##b
+#define GEGELATI_TRACE_CONCAT(a, b) GEGELATI_TRACE_CONCAT2(a, b)
+
+#ifdef GEGELATI_TRACE
+/// Record a Log::TraceSpan until the end of the current scope.
+#define GEGELATI_TRACE_SPAN(...)                                               \
+    Log::TraceSpan GEGELATI_TRACE_CONCAT(gegelatiTraceSpan, __LINE__)(__VA_ARGS__)
+#else
+/// Tracing is compiled out.
+#define GEGELATI_TRACE_SPAN(...)
+#endif
+
+#endif
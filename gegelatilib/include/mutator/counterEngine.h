@@ -0,0 +1,200 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef COUNTER_ENGINE_H
+#define COUNTER_ENGINE_H
+
+#include <cstdint>
+
+namespace Mutator {
+
+    /**
+     * \brief Counter-based random bit generator.
+     *
+     * Each value produced by this engine is a pure function of a key, derived
+     * from a seed and a stream identifier, and of a counter incremented with
+     * each generated value. The mixing function is the finalizer of the
+     * SplitMix64 generator, applied to the counter scaled by the golden ratio
+     * and offset by the key.
+     *
+     * Contrary to state-based engines, such as the Mersenne twister, the
+     * whole state of the CounterEngine fits in two 64-bit integers. Copying
+     * it is thus cheap, and independent sub-streams can be derived with the
+     * split() method without consuming values from the original engine.
+     *
+     * The class satisfies the requirements of the C++
+     * UniformRandomBitGenerator, and can thus be used with the distributions
+     * of the deterministicRandom.h file.
+     */
+    class CounterEngine
+    {
+      public:
+        /// Type of the generated values.
+        typedef uint64_t result_type;
+
+        /// Increment of the SplitMix64 generator (golden ratio).
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+      protected:
+        /// Key of the stream of the engine.
+        uint64_t key;
+
+        /// Number of values generated since the last seeding.
+        uint64_t counter;
+
+      public:
+        /**
+         * \brief Mix the bits of a 64-bit integer.
+         *
+         * Finalizer of the SplitMix64 generator, which is a bijection of
+         * 64-bit integers with good avalanche properties.
+         *
+         * \param[in] value the integer to mix.
+         * \return the mixed integer.
+         */
+        static constexpr uint64_t mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        /**
+         * \brief Derive the key of a stream from a seed.
+         *
+         * \param[in] seed the seed of the engine.
+         * \param[in] stream the identifier of the stream.
+         * \return the key of the stream.
+         */
+        static constexpr uint64_t deriveKey(uint64_t seed, uint64_t stream)
+        {
+            return mix(mix(seed) ^ (stream * GOLDEN_GAMMA + GOLDEN_GAMMA));
+        }
+
+        /**
+         * \brief Constructor of the CounterEngine.
+         *
+         * \param[in] seed the seed for the engine.
+         * \param[in] stream the identifier of the stream of the engine.
+         */
+        explicit CounterEngine(uint64_t seed = 0, uint64_t stream = 0)
+            : key{deriveKey(seed, stream)}, counter{0}
+        {
+        }
+
+        /// Smallest value generated by the engine.
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /// Largest value generated by the engine.
+        static constexpr result_type max()
+        {
+            return UINT64_MAX;
+        }
+
+        /**
+         * \brief Reset the engine with a new seed.
+         *
+         * \param[in] seed the seed for the engine.
+         * \param[in] stream the identifier of the stream of the engine.
+         */
+        void seed(uint64_t seed, uint64_t stream = 0)
+        {
+            this->key = deriveKey(seed, stream);
+            this->counter = 0;
+        }
+
+        /**
+         * \brief Generate the next value of the engine.
+         *
+         * \return a pseudo-random 64-bit value.
+         */
+        result_type operator()()
+        {
+            this->counter++;
+            return mix(this->key + this->counter * GOLDEN_GAMMA);
+        }
+
+        /**
+         * \brief Skip values of the engine.
+         *
+         * Thanks to the counter-based nature of the engine, skipping values
+         * is done in constant time.
+         *
+         * \param[in] nbValues the number of values to skip.
+         */
+        void discard(uint64_t nbValues)
+        {
+            this->counter += nbValues;
+        }
+
+        /**
+         * \brief Derive an independent engine from the current one.
+         *
+         * The derived engine depends on the current key and counter of this
+         * engine and on the given stream identifier. No value is consumed
+         * from this engine, so that splitting it several times with different
+         * stream identifiers produces different engines, whatever the order
+         * in which they are created.
+         *
+         * \param[in] stream the identifier of the derived stream.
+         * \return the derived CounterEngine.
+         */
+        CounterEngine split(uint64_t stream) const
+        {
+            CounterEngine result;
+            result.key = deriveKey(this->key + this->counter * GOLDEN_GAMMA,
+                                   stream);
+            return result;
+        }
+
+        /// Equality operator of CounterEngine.
+        bool operator==(const CounterEngine& other) const
+        {
+            return this->key == other.key && this->counter == other.counter;
+        }
+
+        /// Inequality operator of CounterEngine.
+        bool operator!=(const CounterEngine& other) const
+        {
+            return !(*this == other);
+        }
+    };
+}; // namespace Mutator
+
+#endif
@@ -37,6 +37,9 @@
 #define DETERMINISTIC_RANDOM_H
 
 #include <assert.h>
+#include <limits>
+#include <random>
+#include <type_traits>
 
 #define _NODISCARD [[nodiscard]]
 
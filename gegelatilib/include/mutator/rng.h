@@ -36,8 +36,10 @@
 #ifndef RNG_H
 #define RNG_H
 
-#include <memory>
-#include <random>
+#include <cstdint>
+#include <vector>
+
+#include "mutator/counterEngine.h"
 
 namespace Mutator {
 
@@ -45,36 +47,47 @@ namespace Mutator {
      * Class containing the (pseudo) Random Number Generator facilities to be
      * used in the TPG framework.
      *
-     * This class currently provides a wrapper around the mt19937_64 engine
-     * and all methods generating random numbers adopt a uniform distribution.
+     * This class currently provides a wrapper around the counter-based
+     * CounterEngine and all methods generating random numbers adopt a
+     * uniform distribution.
+     *
+     * The state of the engine being small, RNG can be copied cheaply, and
+     * independent RNG can be derived with the split() method, for example to
+     * give each parallel job its own RNG. Since derived RNG only depend on
+     * the state of the original RNG and on the given stream identifier,
+     * results do not depend on the number of threads used.
      */
     class RNG
     {
       protected:
-        /// Mersenne twister MT19937 engine used for Random Number generation.
-        std::unique_ptr<std::mt19937_64> engine;
+        /// Counter-based engine used for Random Number generation.
+        CounterEngine engine;
 
-      public:
         /**
-         * \brief Default seeding constructor for RNG.
+         * \brief Constructor from an existing engine.
          *
-         * \param[in] seed the seed for the engine.
+         * \param[in] engine the CounterEngine of the RNG.
          */
-        RNG(uint64_t seed = 0) : engine(std::make_unique<std::mt19937_64>(seed))
+        RNG(const CounterEngine& engine) : engine(engine)
         {
         }
 
+      public:
         /**
-         * \brief Copy constructor.
+         * \brief Default seeding constructor for RNG.
          *
-         * The copy constructor does a deep copy.
-         * \param[in] other the RNG to copy.
+         * \param[in] seed the seed for the engine.
          */
-        RNG(const RNG& other)
-            : engine(std::make_unique<std::mt19937_64>(*(other.engine)))
+        RNG(uint64_t seed = 0) : engine(seed)
         {
         }
 
+        /// Default copy constructor.
+        RNG(const RNG& other) = default;
+
+        /// Default assignment operator.
+        RNG& operator=(const RNG& other) = default;
+
         /**
          * \brief Set the seed of the random number generator.
          *
@@ -82,6 +95,19 @@ namespace Mutator {
          */
         void setSeed(uint64_t seed);
 
+        /**
+         * \brief Derive an independent RNG from this one.
+         *
+         * No random number is consumed from this RNG. Calling split() with
+         * different stream identifiers on the same RNG yields different RNG,
+         * and calling it twice with the same identifier yields identical RNG.
+         *
+         * \param[in] stream identifier of the derived RNG, for example the
+         * index of a job.
+         * \return the derived RNG.
+         */
+        RNG split(uint64_t stream) const;
+
         /**
          * \brief Get a pseudo random int number between two bounds (included).
          *
@@ -91,6 +117,21 @@ namespace Mutator {
          */
         uint64_t getUnsignedInt64(uint64_t min, uint64_t max);
 
+        /**
+         * \brief Fill a vector with pseudo random int numbers between two
+         * bounds (included).
+         *
+         * The generated values are identical to the ones obtained by calling
+         * getUnsignedInt64() once for each element of the vector.
+         *
+         * \param[in] min the lower bound.
+         * \param[in] max the upper bound.
+         * \param[out] values the vector whose elements are all replaced with
+         * uniformely selected values between min and max included.
+         */
+        void fillUnsignedInt64(uint64_t min, uint64_t max,
+                               std::vector<uint64_t>& values);
+
         /**
          * \brief Get a pseudo random int number between two bounds (included).
          *
@@ -109,6 +150,20 @@ namespace Mutator {
          * \return an uniformely selected value between min and max includes.
          */
         double getDouble(double min, double max);
+
+        /**
+         * \brief Fill a vector with pseudo random double numbers between two
+         * bounds (included).
+         *
+         * The generated values are identical to the ones obtained by calling
+         * getDouble() once for each element of the vector.
+         *
+         * \param[in] min the lower bound.
+         * \param[in] max the upper bound.
+         * \param[out] values the vector whose elements are all replaced with
+         * uniformely selected values between min and max included.
+         */
+        void fillDouble(double min, double max, std::vector<double>& values);
     };
 }; // namespace Mutator
 
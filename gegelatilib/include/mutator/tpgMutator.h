@@ -36,7 +36,10 @@
 #ifndef TPG_MUTATOR_H
 #define TPG_MUTATOR_H
 
+#include <list>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "archive.h"
 #include "mutator/mutationParameters.h"
@@ -108,6 +111,25 @@ namespace Mutator {
             const std::list<const TPG::TPGEdge*>& preExistingEdges,
             Mutator::RNG& rng);
 
+        /**
+         * \brief Select a random destination for a TPGEdge.
+         *
+         * The function randomly choses between a TPGAction and a TPGTeam, with
+         * the probabilities within the given MutationParameters, and returns
+         * a random TPGVertex among the corresponding pre-existing TPGVertex.
+         *
+         * \param[in] preExistingTeams the TPGTeam candidates for destination.
+         * \param[in] preExistingActions the TPGAction candidates for
+         *            destination.
+         * \param[in] params Probability parameters for the mutation.
+         * \param[in] rng Random Number Generator used in the mutation process.
+         * \return a pointer to the selected TPGVertex.
+         */
+        const TPG::TPGVertex* pickEdgeDestination(
+            const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+            const std::vector<const TPG::TPGAction*>& preExistingActions,
+            const Mutator::MutationParameters& params, Mutator::RNG& rng);
+
         /**
          * \brief Change the destination of a TPGEdge to an randomly chosen
          * target.
@@ -205,6 +227,81 @@ namespace Mutator {
             std::list<std::shared_ptr<Program::Program>>& newPrograms,
             const Mutator::MutationParameters& params, Mutator::RNG& rng);
 
+        /**
+         * \brief Outgoing TPGEdge of a planned TPGTeam.
+         *
+         * The planned TPGEdge is a copy of a pre-existing TPGEdge of the
+         * TPGGraph, possibly with a new destination and a copy of the Program
+         * to mutate.
+         */
+        struct PlannedEdge
+        {
+            /// Pre-existing TPGEdge from which the Program is taken.
+            TPG::TPGEdge* model;
+
+            /// Destination of the planned TPGEdge.
+            const TPG::TPGVertex* destination;
+
+            /// Whether the Program of the model must be copied and mutated.
+            bool mutateProgram;
+        };
+
+        /**
+         * \brief Mutations planned for the clone of a root TPGTeam.
+         *
+         * Planning mutations only reads the TPGGraph, which makes it possible
+         * to plan several TPGTeam in parallel, before committing them in the
+         * TPGGraph in a deterministic order.
+         */
+        struct TeamMutationPlan
+        {
+            /// Root TPGTeam whose clone is mutated.
+            const TPG::TPGTeam* clonedRoot;
+
+            /// Outgoing TPGEdge of the new TPGTeam, in order.
+            std::vector<PlannedEdge> edges;
+        };
+
+        /**
+         * \brief Plan the mutations of the clone of a random root TPGTeam.
+         *
+         * This function selects a random root TPGTeam, and applies to a
+         * lightweight copy of its outgoing TPGEdge the same mutations as the
+         * mutateTPGTeam function: removal of edges, addition of copies of
+         * pre-existing edges, and selection of the Program to mutate and
+         * of new destinations. The TPGGraph is not modified, and no Program
+         * is copied.
+         *
+         * \param[in] rootTeams the candidate TPGTeam for cloning.
+         * \param[in] preExistingTeams the TPGTeam candidates for destination.
+         * \param[in] preExistingActions the TPGAction candidates for
+         *            destination.
+         * \param[in] preExistingEdges the TPGEdge candidates for addition.
+         * \param[in] params Probability parameters for the mutation.
+         * \param[in] rng Random Number Generator used in the mutation process.
+         * \return the planned mutations.
+         */
+        TeamMutationPlan planTPGTeamMutation(
+            const std::vector<const TPG::TPGTeam*>& rootTeams,
+            const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+            const std::vector<const TPG::TPGAction*>& preExistingActions,
+            const std::vector<TPG::TPGEdge*>& preExistingEdges,
+            const Mutator::MutationParameters& params, Mutator::RNG& rng);
+
+        /**
+         * \brief Create a new TPGTeam in the TPGGraph from planned mutations.
+         *
+         * \param[in,out] graph the TPGGraph in which the TPGTeam is created.
+         * \param[in] plan the planned mutations of the TPGTeam.
+         * \param[in,out] newPrograms List of new Program created for the
+         *                TPGTeam. The behavior of these Program must be
+         *                mutated to complete the mutation process.
+         * \return a reference to the new TPGTeam.
+         */
+        const TPG::TPGTeam& commitTPGTeamMutation(
+            TPG::TPGGraph& graph, const TeamMutationPlan& plan,
+            std::list<std::shared_ptr<Program::Program>>& newPrograms);
+
         /**
          * \brief Mutate the behavior of a Program and ensure its unicity
          * against the given Archive.
@@ -255,6 +352,15 @@ namespace Mutator {
          * If the given TPGGraph already has more root TPGVertex than the
          * targetted number of root teams, nothing happens.
          *
+         * New root TPGTeams are created by batches. The mutations of all the
+         * TPGTeams missing to reach the targetted number of roots are first
+         * planned in parallel with the planTPGTeamMutation function, each
+         * with its own RNG derived from the given one. Plans are then
+         * committed in the TPGGraph in a deterministic order. Since new roots
+         * may subsume pre-existing ones, this process is repeated until the
+         * targetted number of roots is reached. Results do not depend on the
+         * number of threads.
+         *
          * \param[in,out] graph the TPGGraph to mutate.
          * \param[in] archive Archive used to assess the uniqueness of the
          *            mutated Program behavior.
@@ -0,0 +1,195 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef BYTECODE_PROGRAM_H
+#define BYTECODE_PROGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "instructions/instruction.h"
+#include "util/memoryFootprint.h"
+
+namespace Program {
+    // Declarations to avoid circular includes.
+    class Program;
+    class OptimizedProgram;
+    class SuperinstructionSet;
+
+    /**
+     * \brief Bytecode compiled from an OptimizedProgram, executed by the
+     * threaded interpreter of the ProgramExecutionEngine.
+     *
+     * Each Operation of the OptimizedProgram is compiled into an Op:
+     * - Operations whose Instruction provides a ScalarFunction, and whose
+     *   operands are all double values or Program constants, are compiled
+     *   into CALL Ops. Their operands are read directly from the values,
+     *   the literals, or the native data of Data::ArrayWrapper<double> data
+     *   sources, and given to the ScalarFunction without building any
+     *   Data::UntypedSharedPtr. Program constants are compiled as literals.
+     * - Other Operations are compiled into GENERIC Ops, executed exactly as
+     *   in the OptimizedProgram.
+     * - Pairs of consecutive CALL Ops listed in a SuperinstructionSet, where
+     *   the second consumes the value of the first, are fused: the first Op
+     *   becomes a FUSED Op whose handler executes both.
+     *
+     * Operands of CALL Ops are (base, offset) pairs, where the base selects
+     * an array of double values: the values of the Operations
+     * (VALUES_BASE), the literals (LITERALS_BASE), or the data source of
+     * index i in the Program Lines (DATA_SOURCES_BASE + i).
+     */
+    class BytecodeProgram
+    {
+      public:
+        /// Operation codes of the bytecode.
+        enum class Opcode : uint8_t
+        {
+            /// Call of a ScalarFunction with any number of operands.
+            CALL,
+            /// Call of a ScalarFunction with two operands.
+            CALL_2,
+            /// Superinstruction executing this Op and the next CALL Op.
+            FUSED,
+            /// Execution of an OptimizedProgram::Operation.
+            GENERIC,
+            /// End of the bytecode, returning the result.
+            END
+        };
+
+        /// Maximum number of operands of CALL Ops.
+        static constexpr size_t MAX_NB_OPERANDS = 4;
+
+        /// Base of the values computed by the Ops.
+        static constexpr uint32_t VALUES_BASE = 0;
+
+        /// Base of the literals of the BytecodeProgram.
+        static constexpr uint32_t LITERALS_BASE = 1;
+
+        /// Base of the data source of index 0 in the Program Lines.
+        static constexpr uint32_t DATA_SOURCES_BASE = 2;
+
+        /// Operand of an Op, read at bases[base][offset].
+        struct Operand
+        {
+            /// Base of the array containing the operand.
+            uint32_t base;
+
+            /// Offset of the operand within its array.
+            uint32_t offset;
+        };
+
+        /// Op of the bytecode.
+        struct Op
+        {
+            /// Operation code.
+            Opcode opcode;
+
+            /// Number of operands of CALL Ops.
+            uint32_t nbOperands;
+
+            /// Index of the value written by the Op, which is also the index
+            /// of the corresponding OptimizedProgram::Operation.
+            uint32_t value;
+
+            /// ScalarFunction called by CALL Ops.
+            Instructions::Instruction::ScalarFunction function;
+
+            /// Instruction given to the ScalarFunction.
+            const Instructions::Instruction* instruction;
+
+            /// Operands of CALL Ops.
+            Operand operands[MAX_NB_OPERANDS];
+        };
+
+      protected:
+        /// Ops of the bytecode, terminated with an END Op.
+        std::vector<Op> ops;
+
+        /// Literals of the OptimizedProgram, followed by Program constants.
+        std::vector<double> literals;
+
+        /// Indexes of the data sources whose native data is read by Ops.
+        std::vector<uint64_t> nativeDataSources;
+
+        /// Operand whose value is the result of the Program.
+        Operand result;
+
+        /// Number of FUSED Ops.
+        uint64_t nbSuperinstructions;
+
+        /// Default constructor is deleted.
+        BytecodeProgram() = delete;
+
+      public:
+        /**
+         * \brief Compile an OptimizedProgram into bytecode.
+         *
+         * \param[in] optimized the OptimizedProgram to compile.
+         * \param[in] program the Program from which the OptimizedProgram was
+         * built, whose constants are compiled as literals.
+         * \param[in] superinstructions the pairs of Instructions to fuse, if
+         * any.
+         */
+        BytecodeProgram(const OptimizedProgram& optimized,
+                        const Program& program,
+                        const SuperinstructionSet* superinstructions);
+
+        /// Get the Ops of the bytecode, terminated with an END Op.
+        const std::vector<Op>& getOps() const;
+
+        /// Get the literals of the bytecode.
+        const std::vector<double>& getLiterals() const;
+
+        /// Get the indexes of the data sources whose native data is read.
+        const std::vector<uint64_t>& getNativeDataSources() const;
+
+        /// Get the Operand whose value is the result of the Program.
+        const Operand& getResult() const;
+
+        /// Get the number of FUSED Ops.
+        uint64_t getNbSuperinstructions() const;
+
+        /**
+         * \brief Get the memory used by the BytecodeProgram.
+         *
+         * \return a MemoryFootprint with the "object" itself, its "ops" and
+         * its "literals".
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+    };
+} // namespace Program
+
+#endif // BYTECODE_PROGRAM_H
@@ -0,0 +1,215 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef OPTIMIZED_PROGRAM_H
+#define OPTIMIZED_PROGRAM_H
+
+#include <cstdint>
+#include <memory>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "instructions/instruction.h"
+#include "util/memoryFootprint.h"
+
+namespace Program {
+    // Declarations to avoid circular includes.
+    class Program;
+    class BytecodeProgram;
+
+    /**
+     * \brief Executable form of the effective Lines of a Program.
+     *
+     * The OptimizedProgram is built from the non-intron Lines of a Program
+     * with a single forward pass followed by a liveness pass:
+     * - Lines whose operands are all known when the Program is built, that is
+     *   Program constants and registers holding a folded value (including the
+     *   zero value of registers at the beginning of the execution), are
+     *   executed once and replaced with their literal result.
+     * - Lines recomputing a value already computed earlier in the Program,
+     *   with the same Instruction and operands, are removed.
+     * - Registers are renamed so that each Operation writes its own value
+     *   slot. Hence, values moved from a register to another are read
+     *   directly where they were computed.
+     * - Operations whose value is not used by the result, once the previous
+     *   simplifications are applied, are removed.
+     *
+     * This optimization assumes that Instructions are pure functions of
+     * their operands, which is already the assumption made for identifying
+     * introns and comparing Program behaviors. The Lines of the Program are
+     * left untouched, so that mutations are not affected.
+     *
+     * If the bytecode execution is enabled in the Environment of the Program,
+     * the OptimizedProgram is also compiled into a BytecodeProgram.
+     */
+    class OptimizedProgram
+    {
+      public:
+        /// Kind of data accessed by an Operand.
+        enum class OperandKind : uint8_t
+        {
+            /// Data from a data source, indexed as in the Program Line.
+            DATA_SOURCE,
+            /// Value computed by a previous Operation.
+            VALUE,
+            /// Literal value folded when building the OptimizedProgram.
+            LITERAL
+        };
+
+        /**
+         * \brief Operand of an Operation.
+         *
+         * For DATA_SOURCE operands, the index is the index of the data source
+         * (0 for registers, 1 for constants if any) and the location is
+         * already scaled for the operand type. For VALUE and LITERAL operands
+         * the index is the index of the Operation or of the literal.
+         */
+        struct Operand
+        {
+            /// Kind of the Operand.
+            OperandKind kind;
+
+            /// Index of the data source, Operation, or literal.
+            uint64_t index;
+
+            /// Scaled location within a DATA_SOURCE.
+            uint64_t location;
+
+            /// Type of the operand, read from a DATA_SOURCE.
+            const std::type_info* type;
+        };
+
+        /**
+         * \brief Instruction executed by the OptimizedProgram.
+         *
+         * The value of the Operation is stored in a dedicated slot, whose
+         * index is the index of the Operation.
+         */
+        struct Operation
+        {
+            /// Instruction executed by the Operation.
+            const Instructions::Instruction* instruction;
+
+            /// Index of the Instruction in the Instructions::Set.
+            uint64_t instructionIndex;
+
+            /// Operands of the Instruction.
+            std::vector<Operand> operands;
+
+            /**
+             * \brief Register values needed by array operands.
+             *
+             * Registers accessed as arrays must hold, when the Operation is
+             * executed, the VALUE or LITERAL they would hold in the execution
+             * of the original Program.
+             */
+            std::vector<std::pair<uint64_t, Operand>> registerWrites;
+        };
+
+      protected:
+        /// Operations of the OptimizedProgram, in execution order.
+        std::vector<Operation> operations;
+
+        /// Literal values folded from the Program.
+        std::vector<double> literals;
+
+        /// Operand whose value is the result of the Program.
+        Operand result;
+
+        /// Number of non-intron Lines of the optimized Program.
+        uint64_t nbEffectiveLines;
+
+        /// BytecodeProgram compiled from the OptimizedProgram, if any.
+        std::shared_ptr<const BytecodeProgram> bytecode;
+
+        /// Default constructor is deleted.
+        OptimizedProgram() = delete;
+
+      public:
+        /**
+         * \brief Build the OptimizedProgram of the given Program.
+         *
+         * The intron flags of the Program are used to select its effective
+         * Lines, as is done by the ProgramExecutionEngine.
+         *
+         * \param[in] program the Program to optimize.
+         * \throws std::out_of_range if an effective Line references an
+         * Instruction, a data source or a register that does not exist.
+         * \throws std::invalid_argument if a data source does not provide the
+         * type of an operand.
+         */
+        OptimizedProgram(const Program& program);
+
+        /// Get the Operations, in execution order.
+        const std::vector<Operation>& getOperations() const;
+
+        /// Get the literal values.
+        const std::vector<double>& getLiterals() const;
+
+        /// Get the Operand whose value is the result of the Program.
+        const Operand& getResult() const;
+
+        /**
+         * \brief Get the number of non-intron Lines of the Program from which
+         * the OptimizedProgram was built.
+         *
+         * Comparing this number with the number of Operations gives the number
+         * of Lines saved at each execution.
+         */
+        uint64_t getNbEffectiveLines() const;
+
+        /**
+         * \brief Get the BytecodeProgram compiled from the OptimizedProgram.
+         *
+         * \return a pointer to the BytecodeProgram, or nullptr if the
+         * bytecode execution was not enabled in the Environment when the
+         * OptimizedProgram was built.
+         */
+        const BytecodeProgram* getBytecodeProgram() const;
+
+        /**
+         * \brief Get the memory used by the OptimizedProgram.
+         *
+         * \return a MemoryFootprint with the "object" itself, its
+         * "operations" with their operands, its "literals", and its
+         * "bytecode" if any.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+    };
+} // namespace Program
+
+#endif // OPTIMIZED_PROGRAM_H
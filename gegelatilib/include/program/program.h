@@ -38,11 +38,14 @@
 #define PROGRAM_H
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "data/constantHandler.h"
 #include "environment.h"
 #include "program/line.h"
+#include "program/optimizedProgram.h"
+#include "util/memoryFootprint.h"
 
 namespace Program {
     /**
@@ -76,6 +79,15 @@ namespace Program {
          **/
         Data::ConstantHandler constants;
 
+        /**
+         * \brief Executable form of the Program built by optimize().
+         *
+         * The OptimizedProgram is discarded by all methods giving non-const
+         * access to the Lines or constants of the Program, as well as by
+         * identifyIntrons(), so that a stale form is never executed.
+         */
+        std::shared_ptr<const OptimizedProgram> optimizedProgram;
+
         /// Delete the default constructor.
         Program() = delete;
 
@@ -102,7 +114,8 @@ namespace Program {
          */
         Program(const Program& other)
             : environment{other.environment}, lines{other.lines},
-              constants{other.constants}
+              constants{other.constants},
+              optimizedProgram{other.optimizedProgram}
         {
             // Replace lines with their copy
             // Keep intro info
@@ -160,6 +173,9 @@ namespace Program {
          *
          * Introns should have been identified before calling this methos, as
          * this method does NOT call the identifyIntrons method.
+         *
+         * Since the behavior of the Program is unchanged, its OptimizedProgram
+         * is preserved.
          */
         void clearIntrons();
 
@@ -199,6 +215,15 @@ namespace Program {
          */
         size_t getNbLines() const;
 
+        /**
+         * \brief Get the memory used by the Program.
+         *
+         * \return a MemoryFootprint with the "object" itself, its "lines"
+         * with their operands, the buffers of its "constants", and its
+         * "optimized" form if any.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+
         /**
          * \brief Get a const ref to a Line of the Program.
          *
@@ -237,6 +262,28 @@ namespace Program {
          */
         uint64_t identifyIntrons();
 
+        /**
+         * \brief Build the OptimizedProgram executed in place of the Lines of
+         * the Program.
+         *
+         * Introns should have been identified before calling this method, as
+         * only non-intron Lines are optimized.
+         *
+         * \return true if the OptimizedProgram could be built, false if a Line
+         * of the Program can not be executed, in which case the Program will
+         * be executed Line by Line.
+         */
+        bool optimize();
+
+        /**
+         * \brief Get the OptimizedProgram built by the last call to
+         * optimize().
+         *
+         * \return a pointer to the OptimizedProgram, or nullptr if the
+         * Program was not optimized or was modified since.
+         */
+        const OptimizedProgram* getOptimizedProgram() const;
+
         /**
          *  \brief get the constantHandler object of the Program
          *
@@ -39,9 +39,13 @@
 #define PROGRAM_EXECUTION_ENGINE_H
 
 #include <type_traits>
+#include <vector>
 
+#include "data/arrayWrapper.h"
 #include "data/primitiveTypeArray.h"
 #include "data/untypedSharedPtr.h"
+#include "program/bytecodeProgram.h"
+#include "program/optimizedProgram.h"
 #include "program/program.h"
 #include "program/programEngine.h"
 
@@ -55,6 +59,67 @@ namespace Program {
         /// Default constructor is deleted.
         ProgramExecutionEngine() = delete;
 
+        /// Values computed by the Operations of an OptimizedProgram.
+        std::vector<double> values;
+
+        /// Operands of the Operation being executed, reused between them.
+        std::vector<Data::UntypedSharedPtr> operands;
+
+        /**
+         * \brief Execute the OptimizedProgram of the current Program.
+         *
+         * \param[in] optimized the OptimizedProgram of the current Program.
+         * \return the value of the result of the Program.
+         * \throws any exception thrown by the executed Instructions.
+         */
+        double executeOptimizedProgram(const OptimizedProgram& optimized);
+
+        /**
+         * \brief Execute an Operation of the OptimizedProgram of the current
+         * Program.
+         *
+         * \param[in] operation the Operation to execute.
+         * \param[in] literals the literals of the OptimizedProgram.
+         * \param[in] idx the index of the Operation, and of its value.
+         * \throws any exception thrown by the executed Instruction.
+         */
+        void executeOperation(const OptimizedProgram::Operation& operation,
+                              const std::vector<double>& literals,
+                              size_t idx);
+
+        /// Base pointers of the arrays read by the Ops of a BytecodeProgram.
+        std::vector<const double*> bytecodeBases;
+
+        /**
+         * \brief Dynamic type of each data source, and whether it is a
+         * Data::ArrayWrapper<double> whose native data can be read by the
+         * Ops of a BytecodeProgram.
+         *
+         * This cache avoids a dynamic_cast of the data sources at each
+         * execution.
+         */
+        std::vector<std::pair<const std::type_info*, bool>>
+            nativeDataSources;
+
+        /**
+         * \brief Execute the BytecodeProgram of the current Program.
+         *
+         * Ops are executed by a threaded interpreter: with GCC and Clang,
+         * each handler jumps directly to the handler of the next Op through a
+         * computed goto. Other compilers use a switch-based dispatch.
+         *
+         * If a data source read by the BytecodeProgram is not a
+         * Data::ArrayWrapper<double> wrapping some data, the OptimizedProgram
+         * is executed instead.
+         *
+         * \param[in] optimized the OptimizedProgram of the current Program.
+         * \param[in] bytecode the BytecodeProgram of the OptimizedProgram.
+         * \return the value of the result of the Program.
+         * \throws any exception thrown by the executed Instructions.
+         */
+        double executeBytecode(const OptimizedProgram& optimized,
+                               const BytecodeProgram& bytecode);
+
       public:
         /**
          * \brief Constructor of the class.
@@ -111,6 +176,11 @@ namespace Program {
          * \brief Execute the program completely and returns the content of
          * register 0.
          *
+         * If the Program has an OptimizedProgram, it is executed instead of
+         * the Lines of the Program, with its BytecodeProgram if any. Since
+         * the OptimizedProgram only keeps the values needed by the result,
+         * the registers are not updated in this case.
+         *
          * \param[in] ignoreException When true, all exceptions thrown when
          *            fetching current instructions, operands are
          *            caught and the current program Line is simply ignored.
@@ -0,0 +1,123 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef SUPERINSTRUCTION_SET_H
+#define SUPERINSTRUCTION_SET_H
+
+#include <cstdint>
+#include <set>
+#include <utility>
+
+namespace TPG {
+    // Declaration to avoid circular includes.
+    class TPGGraph;
+} // namespace TPG
+
+namespace Program {
+    /**
+     * \brief Set of superinstructions used when compiling Programs into a
+     * BytecodeProgram.
+     *
+     * A superinstruction is a pair of Instructions, identified by their
+     * index in the Instructions::Set of the Environment, where the second
+     * Instruction consumes the value computed by the first. When such a pair
+     * of Operations is found in an OptimizedProgram, both are executed by a
+     * single handler of the bytecode interpreter, saving one dispatch.
+     *
+     * Since Instruction indexes are specific to an Instructions::Set, a
+     * SuperinstructionSet should only be used with the Environment of the
+     * Programs from which it was profiled.
+     */
+    class SuperinstructionSet
+    {
+      protected:
+        /// Pairs of Instruction indexes fused into superinstructions.
+        std::set<std::pair<uint64_t, uint64_t>> superinstructions;
+
+      public:
+        /// Default constructor, creating an empty SuperinstructionSet.
+        SuperinstructionSet() = default;
+
+        /**
+         * \brief Add a superinstruction to the set.
+         *
+         * \param[in] first index of the Instruction computing a value.
+         * \param[in] second index of the Instruction consuming this value.
+         * \return false if the superinstruction was already in the set.
+         */
+        bool add(uint64_t first, uint64_t second);
+
+        /**
+         * \brief Check whether a pair of Instructions is a superinstruction.
+         *
+         * \param[in] first index of the Instruction computing a value.
+         * \param[in] second index of the Instruction consuming this value.
+         */
+        bool contains(uint64_t first, uint64_t second) const;
+
+        /// Get the number of superinstructions in the set.
+        size_t getNbSuperinstructions() const;
+
+        /// Get the pairs of Instruction indexes of the superinstructions.
+        const std::set<std::pair<uint64_t, uint64_t>>& getSuperinstructions()
+            const;
+
+        /**
+         * \brief Profile the most frequent superinstructions in the Programs
+         * of a TPGGraph.
+         *
+         * Pairs of consecutive Operations of the OptimizedProgram of each
+         * Program, where the second consumes the value of the first, are
+         * counted if both Instructions provide a ScalarFunction. Programs
+         * that were not optimized are optimized for the profiling only.
+         *
+         * If the edges of the TPGGraph are instrumented, for example after
+         * executing it with a TPGExecutionEngineInstrumented, each pair is
+         * weighted with the number of visits of the edges executing the
+         * Program, so that the profile follows the execution statistics of
+         * the population. Otherwise, each Program counts once.
+         *
+         * \param[in] graph the TPGGraph whose Programs are profiled.
+         * \param[in] maxNbSuperinstructions the maximum number of
+         * superinstructions kept, in decreasing order of frequency.
+         * \return the SuperinstructionSet with the most frequent pairs.
+         */
+        static SuperinstructionSet profile(const TPG::TPGGraph& graph,
+                                           size_t maxNbSuperinstructions);
+    };
+} // namespace Program
+
+#endif // SUPERINSTRUCTION_SET_H
@@ -0,0 +1,129 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef SHARDED_ARCHIVE_H
+#define SHARDED_ARCHIVE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "archive.h"
+
+/**
+ * \brief Archive split into independent shards, for concurrent recordings.
+ *
+ * During parallel evaluations, each job records into its own shard of the
+ * ShardedArchive, identified by the index of the job. Since a shard is only
+ * accessed by the thread evaluating the corresponding job, recordings do not
+ * need any synchronization. Only the creation of shards is protected by a
+ * mutex.
+ *
+ * When all jobs are evaluated, the shards are merged into a main Archive with
+ * the mergeInto() method, in the order of their index. DataHandler copies
+ * stored in the shards are moved into the main Archive instead of being
+ * cloned again.
+ */
+class ShardedArchive
+{
+  protected:
+    /// Maximum number of recordings held in each shard.
+    const size_t shardSize;
+
+    /// Probability of adding any program execution to a shard.
+    const double archivingProbability;
+
+    /// Whether shards store delta snapshots of DataHandler.
+    const bool deltaSnapshots;
+
+    /// Shards of the ShardedArchive, ordered by index.
+    std::map<uint64_t, std::unique_ptr<Archive>> shards;
+
+    /// Mutex protecting the shards map.
+    mutable std::mutex shardsMutex;
+
+  public:
+    /**
+     * \brief Main constructor for ShardedArchive.
+     *
+     * \param[in] shardSize maximum number of recordings kept in each shard.
+     * \param[in] archivingProbability probability for each call to
+     * addRecording on a shard to actually lead to a new recording.
+     * \param[in] deltaSnapshots whether shards store delta snapshots of
+     * DataHandler, as in the Archive constructor.
+     */
+    ShardedArchive(size_t shardSize = 50, double archivingProbability = 1.0,
+                   bool deltaSnapshots = false)
+        : shardSize{shardSize}, archivingProbability{archivingProbability},
+          deltaSnapshots{deltaSnapshots} {};
+
+    /// Disable ShardedArchive copy construction.
+    ShardedArchive(const ShardedArchive& other) = delete;
+
+    /**
+     * \brief Get the shard with the given index, creating it if needed.
+     *
+     * This method can be called concurrently from several threads. The
+     * returned reference remains valid until the shards are merged.
+     *
+     * \param[in] idx the index of the shard.
+     * \param[in] seed the seed of the random engine of the shard, used only
+     * if the shard is created by this call.
+     * \return a reference to the shard.
+     */
+    Archive& getShard(uint64_t idx, size_t seed = 0);
+
+    /// Get the number of shards.
+    size_t getNbShards() const;
+
+    /// Get the total number of recordings held in all shards.
+    size_t getNbRecordings() const;
+
+    /**
+     * \brief Merge all shards into an Archive.
+     *
+     * Only the last archive.getMaxSize() recordings, in the order of shard
+     * indexes and of recordings within each shard, are added to the Archive.
+     * Recordings are adopted with the Archive::adoptRecordings() method, and
+     * all shards are removed from the ShardedArchive.
+     *
+     * \param[in,out] archive the Archive receiving the recordings.
+     */
+    void mergeInto(Archive& archive);
+};
+
+#endif
@@ -106,6 +106,9 @@ namespace TPG {
 
         /// Clear the trace history from all previous execution trace.
         void clearTraceHistory();
+
+        /// Get the memory used by the "traceHistory".
+        Util::MemoryFootprint getMemoryFootprint() const;
     };
 }; // namespace TPG
 
@@ -38,6 +38,7 @@
 #define TPG_GRAPH_H
 
 #include <list>
+#include <unordered_set>
 
 #include "environment.h"
 #include "tpg/tpgAction.h"
@@ -45,6 +46,7 @@
 #include "tpg/tpgFactory.h"
 #include "tpg/tpgTeam.h"
 #include "tpg/tpgVertex.h"
+#include "util/memoryFootprint.h"
 
 namespace TPG {
     /**
@@ -88,6 +90,8 @@ namespace TPG {
             using std::swap;
             swap(a.vertices, b.vertices);
             swap(a.edges, b.edges);
+            swap(a.edgeTracking, b.edgeTracking);
+            swap(a.modifiedEdges, b.modifiedEdges);
         }
 
         /**
@@ -240,6 +244,17 @@ namespace TPG {
          */
         const std::list<std::unique_ptr<TPGEdge>>& getEdges() const;
 
+        /**
+         * \brief Get the memory used by the TPGGraph.
+         *
+         * The returned MemoryFootprint contains the "vertices" with their
+         * lists of edges, the "edges", and the "programs" of the edges. Each
+         * Program is counted once, even if it is shared by several edges.
+         *
+         * \return the MemoryFootprint of the TPGGraph.
+         */
+        Util::MemoryFootprint getMemoryFootprint() const;
+
         /**
          * \brief Remove a TPGEdge from the TPGGraph.
          *
@@ -301,6 +316,44 @@ namespace TPG {
          */
         void clearProgramIntrons();
 
+        /**
+         * \brief Optimize all the Programs of the TPGGraph.
+         *
+         * This method calls the Program::Program::optimize() method of all the
+         * Programs associated to the TPGEdge of the TPGGraph. It can notably
+         * be used to compile the Programs into bytecode after enabling the
+         * bytecode execution in the Environment of the TPGGraph.
+         */
+        void optimizePrograms();
+
+        /**
+         * \brief Enable or disable the tracking of modified TPGEdge.
+         *
+         * When the tracking is enabled, the TPGGraph records the TPGEdge
+         * added to the graph, and the TPGEdge whose source or destination is
+         * changed, until the next call to clearModifiedEdges(). Removed
+         * TPGEdge are forgotten. Disabling the tracking clears the recorded
+         * TPGEdge.
+         *
+         * \param[in] enabled whether the modified TPGEdge are tracked.
+         */
+        void setEdgeTracking(bool enabled);
+
+        /// Check whether the modified TPGEdge are tracked.
+        bool isEdgeTracking() const;
+
+        /**
+         * \brief Get the TPGEdge modified since the last call to
+         * clearModifiedEdges().
+         *
+         * \return a const reference to the modifiedEdges attribute, which is
+         * empty if the tracking is disabled.
+         */
+        const std::unordered_set<const TPGEdge*>& getModifiedEdges() const;
+
+        /// Forget the TPGEdge recorded as modified.
+        void clearModifiedEdges();
+
       protected:
         /// Environment of the TPGGraph
         const Environment& env;
@@ -318,6 +371,17 @@ namespace TPG {
          */
         std::list<std::unique_ptr<TPGEdge>> edges;
 
+        /// Whether the modified TPGEdge are recorded in modifiedEdges.
+        bool edgeTracking = false;
+
+        /**
+         * \brief TPGEdge added, or whose source or destination changed, since
+         * the last call to clearModifiedEdges().
+         *
+         * This set is only filled when edgeTracking is true.
+         */
+        std::unordered_set<const TPGEdge*> modifiedEdges;
+
         /**
          * \brief Find the non-const iterator to a vertex of the graph from
          * its const pointer.
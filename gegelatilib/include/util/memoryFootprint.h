@@ -0,0 +1,169 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifndef MEMORY_FOOTPRINT_H
+#define MEMORY_FOOTPRINT_H
+
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Util {
+    /**
+     * \brief Breakdown of the memory used by an object, in bytes.
+     *
+     * A MemoryFootprint associates a number of bytes to named components.
+     * Components of nested objects are prefixed with the name of the object
+     * and a dot, so that the bytes of a group of components, such as
+     * "archive" for "archive.recordings" and "archive.snapshots.copies", can
+     * be obtained with the get() method.
+     *
+     * Footprints are estimates: the sizes of objects and of the buffers they
+     * own are counted exactly, but the overhead of the standard containers
+     * (e.g. the nodes of std::list and std::map) is estimated from their
+     * usual implementation, and allocator overheads are ignored.
+     */
+    class MemoryFootprint
+    {
+      protected:
+        /// Number of bytes of each component.
+        std::map<std::string, size_t> components;
+
+      public:
+        /// Default constructor, with no component.
+        MemoryFootprint() = default;
+
+        /**
+         * \brief Add bytes to a component.
+         *
+         * \param[in] component the name of the component, created if needed.
+         * \param[in] nbBytes the number of bytes added to the component.
+         */
+        void add(const std::string& component, size_t nbBytes);
+
+        /**
+         * \brief Add the components of another MemoryFootprint.
+         *
+         * \param[in] prefix the name of the group of added components. Each
+         * component of the other MemoryFootprint is added to the component
+         * "prefix.component".
+         * \param[in] other the added MemoryFootprint.
+         */
+        void add(const std::string& prefix, const MemoryFootprint& other);
+
+        /**
+         * \brief Set the bytes of a component.
+         *
+         * \param[in] component the name of the component, created if needed.
+         * \param[in] nbBytes the number of bytes of the component.
+         */
+        void set(const std::string& component, size_t nbBytes);
+
+        /**
+         * \brief Get the bytes of a component or of a group of components.
+         *
+         * \param[in] component the name of the component or group.
+         * \return the bytes of the component and of all the components
+         * prefixed with its name followed by a dot, or 0 if there is none.
+         */
+        size_t get(const std::string& component) const;
+
+        /// Get the total number of bytes of all components.
+        size_t getTotal() const;
+
+        /// Get the bytes of all components, sorted by name.
+        const std::map<std::string, size_t>& getComponents() const;
+
+        /// Get the estimated number of bytes allocated by a std::vector.
+        template <class T>
+        static size_t getHeapBytes(const std::vector<T>& container)
+        {
+            return container.capacity() * sizeof(T);
+        }
+
+        /// Get the estimated number of bytes allocated by a std::deque.
+        template <class T>
+        static size_t getHeapBytes(const std::deque<T>& container)
+        {
+            return container.size() * sizeof(T);
+        }
+
+        /// Get the estimated number of bytes allocated by a std::list.
+        template <class T>
+        static size_t getHeapBytes(const std::list<T>& container)
+        {
+            // Each node stores the previous and next node pointers.
+            return container.size() * (sizeof(T) + 2 * sizeof(void*));
+        }
+
+        /// Get the estimated number of bytes allocated by a std::map.
+        template <class K, class V, class C>
+        static size_t getHeapBytes(const std::map<K, V, C>& container)
+        {
+            // Each node stores a color and the parent, left and right nodes.
+            return container.size() *
+                   (sizeof(std::pair<const K, V>) + 4 * sizeof(void*));
+        }
+
+        /// Get the estimated number of bytes allocated by a std::unordered_map.
+        template <class K, class V, class H, class E>
+        static size_t getHeapBytes(
+            const std::unordered_map<K, V, H, E>& container)
+        {
+            // Each node stores the next node pointer and the cached hash.
+            return container.size() * (sizeof(std::pair<const K, V>) +
+                                        sizeof(void*) + sizeof(size_t)) +
+                   container.bucket_count() * sizeof(void*);
+        }
+
+        /// Get the estimated number of bytes allocated by a std::unordered_set.
+        template <class K, class H, class E>
+        static size_t getHeapBytes(const std::unordered_set<K, H, E>& container)
+        {
+            // Each node stores the next node pointer and the cached hash.
+            return container.size() *
+                       (sizeof(K) + sizeof(void*) + sizeof(size_t)) +
+                   container.bucket_count() * sizeof(void*);
+        }
+    };
+} // namespace Util
+
+#endif
@@ -33,20 +33,12 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
 #include <math.h>
+#include <stdexcept>
 
 #include "archive.h"
 
-Archive::~Archive()
-{
-    for (auto dHandlerAndHash : this->dataHandlers) {
-        for (auto dHandler : dHandlerAndHash.second) {
-            // Free memory of DataHandlers within the archive
-            delete &dHandler.get();
-        }
-    }
-}
-
 size_t Archive::getCombinedHash(
     const std::vector<std::reference_wrapper<const Data::DataHandler>>&
         dHandlers)
@@ -83,68 +75,107 @@ void Archive::addRecording(
 
         // Check if dataHandler copy is needed.
         if (this->dataHandlers.find(hash) == this->dataHandlers.end()) {
-            // Store a copy of data handlers.
-            std::vector<std::reference_wrapper<const Data::DataHandler>>
-                dHandlersCpy;
+            // Store a copy of data handlers, sharing unchanged ones.
+            std::vector<size_t> dHandlersCpy;
             for (std::reference_wrapper<const Data::DataHandler> dh :
                  dHandler) {
-                Data::DataHandler* dhCopy = dh.get().clone();
-                dHandlersCpy.push_back(*dhCopy);
+                dHandlersCpy.push_back(this->snapshots.acquire(dh.get()));
             }
             // Create the map entry
             this->dataHandlers.emplace(hash, std::move(dHandlersCpy));
         }
 
         // Create and stores the recording
-        ArchiveRecording recording{program, hash, result};
-        this->recordings.push_back(recording);
+        this->insertRecording(program, hash, result);
+    }
+}
+
+void Archive::insertRecording(const Program::Program* const program,
+                              size_t hash, double result)
+{
+    ArchiveRecording recording{program, hash, result};
+    this->recordings.push_back(recording);
+
+    // Update the recordings per Program
+    auto iterNbRecordings = this->recordingsPerProgram.find(program);
+    if (iterNbRecordings != this->recordingsPerProgram.end()) {
+        iterNbRecordings->second.push_back(recording);
+    }
+    else {
+        this->recordingsPerProgram.insert({program, {recording}});
+    }
 
-        // Update the recordings per Program
-        auto iterNbRecordings = this->recordingsPerProgram.find(program);
-        if (iterNbRecordings != this->recordingsPerProgram.end()) {
-            iterNbRecordings->second.push_back(recording);
+    // Check if Archive max size was reached (or exceeded)
+    while (this->recordings.size() > this->maxSize) {
+
+        // Get the recording (copy)
+        ArchiveRecording rec = this->recordings.front();
+        // Remove the first recording
+        this->recordings.pop_front();
+
+        // Check if this DataHandler (hash) is still used in other
+        // recordings
+        bool stillUsed =
+            (std::find_if(this->recordings.begin(), this->recordings.end(),
+                          [&rec](ArchiveRecording r) {
+                              return r.dataHash == rec.dataHash;
+                          })) != this->recordings.end();
+
+        // if not, remove it from the Archive also
+        if (!stillUsed) {
+            // Release the DataHandler copies
+            for (size_t toErase : this->dataHandlers.at(rec.dataHash)) {
+                this->snapshots.release(toErase);
+            }
+
+            // Remove the entry from the map
+            this->dataHandlers.erase(rec.dataHash);
         }
-        else {
-            this->recordingsPerProgram.insert({program, {recording}});
+
+        // Update the recordingsPerProgram of the corresponding Program,
+        // and remove it if it was the last.
+        auto iter = this->recordingsPerProgram.find(rec.prog);
+        iter->second.pop_front();
+        if (iter->second.size() == 0) {
+            this->recordingsPerProgram.erase(iter);
         }
+    }
+}
 
-        // Check if Archive max size was reached (or exceeded)
-        while (this->recordings.size() > this->maxSize) {
-
-            // Get the recording (copy)
-            ArchiveRecording rec = this->recordings.front();
-            // Remove the first recording
-            this->recordings.pop_front();
-
-            // Check if this DataHandler (hash) is still used in other
-            // recordings
-            bool stillUsed =
-                (std::find_if(this->recordings.begin(), this->recordings.end(),
-                              [&rec](ArchiveRecording r) {
-                                  return r.dataHash == rec.dataHash;
-                              })) != this->recordings.end();
-
-            // if not, remove it from the Archive also
-            if (!stillUsed) {
-                // Free memory of DataHandlers within the archive
-                for (std::reference_wrapper<const Data::DataHandler> toErase :
-                     this->dataHandlers.at(rec.dataHash)) {
-                    delete &toErase.get();
-                }
+void Archive::adoptRecordings(Archive& other, size_t firstRecording)
+{
+    if (&other == this) {
+        throw std::runtime_error("An Archive can not adopt its own recordings.");
+    }
 
-                // Remove the entry from the map
-                this->dataHandlers.erase(rec.dataHash);
-            }
+    // Adopted recordings are never removed while adopting the next ones, so
+    // DataHandler copies moved from the other Archive remain available.
+    if (other.recordings.size() > this->maxSize) {
+        firstRecording = std::max(firstRecording,
+                                  other.recordings.size() - this->maxSize);
+    }
+
+    for (size_t idx = firstRecording; idx < other.recordings.size(); idx++) {
+        const ArchiveRecording& recording = other.recordings.at(idx);
 
-            // Update the recordingsPerProgram of the corresponding Program,
-            // and remove it if it was the last.
-            auto iter = this->recordingsPerProgram.find(rec.prog);
-            iter->second.pop_front();
-            if (iter->second.size() == 0) {
-                this->recordingsPerProgram.erase(iter);
+        // Move the DataHandler copies if needed.
+        if (this->dataHandlers.find(recording.dataHash) ==
+            this->dataHandlers.end()) {
+            std::vector<size_t> dHandlersCpy;
+            for (size_t snapshot : other.dataHandlers.at(recording.dataHash)) {
+                this->snapshots.adopt(other.snapshots, snapshot);
+                dHandlersCpy.push_back(snapshot);
             }
+            this->dataHandlers.emplace(recording.dataHash,
+                                       std::move(dHandlersCpy));
         }
+
+        this->insertRecording(recording.prog, recording.dataHash,
+                              recording.result);
     }
+
+    // Free remaining DataHandler copies of the other archive.
+    other.clear();
 }
 
 bool Archive::hasDataHandlers(const size_t& hash) const
@@ -196,6 +227,11 @@ bool Archive::areProgramResultsUnique(
     return true;
 }
 
+size_t Archive::getMaxSize() const
+{
+    return this->maxSize;
+}
+
 size_t Archive::getNbRecordings() const
 {
     return this->recordings.size();
@@ -206,23 +242,80 @@ size_t Archive::getNbDataHandlers() const
     return this->dataHandlers.size();
 }
 
-const std::map<size_t,
-               std::vector<std::reference_wrapper<const Data::DataHandler>>>&
+size_t Archive::getNbSnapshots() const
+{
+    return this->snapshots.getNbSnapshots();
+}
+
+Util::MemoryFootprint Archive::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(Archive));
+    footprint.add("recordings",
+                  Util::MemoryFootprint::getHeapBytes(this->recordings));
+    footprint.add("recordingsPerProgram", Util::MemoryFootprint::getHeapBytes(
+                                              this->recordingsPerProgram));
+    for (const auto& programRecordings : this->recordingsPerProgram) {
+        footprint.add("recordingsPerProgram",
+                      Util::MemoryFootprint::getHeapBytes(
+                          programRecordings.second));
+    }
+    footprint.add("dataHandlers",
+                  Util::MemoryFootprint::getHeapBytes(this->dataHandlers));
+    for (const auto& dataHandlerSet : this->dataHandlers) {
+        footprint.add("dataHandlers", Util::MemoryFootprint::getHeapBytes(
+                                          dataHandlerSet.second));
+    }
+    footprint.add("snapshots", this->snapshots.getMemoryFootprint());
+    return footprint;
+}
+
+std::map<size_t, std::vector<std::reference_wrapper<const Data::DataHandler>>>
 Archive::getDataHandlers() const
 {
-    return this->dataHandlers;
+    std::map<size_t,
+             std::vector<std::reference_wrapper<const Data::DataHandler>>>
+        result;
+    for (const auto& dataHandlerSet : this->dataHandlers) {
+        std::vector<std::reference_wrapper<const Data::DataHandler>> dHandlers;
+        for (size_t snapshot : dataHandlerSet.second) {
+            const Data::DataHandler* copy = this->snapshots.get(snapshot);
+            if (copy == nullptr) {
+                throw std::runtime_error(
+                    "Delta snapshots can only be accessed with the "
+                    "forEachDataHandlers() method.");
+            }
+            dHandlers.push_back(*copy);
+        }
+        result.emplace(dataHandlerSet.first, std::move(dHandlers));
+    }
+    return result;
 }
 
-void Archive::clear()
+void Archive::forEachDataHandlers(
+    const std::function<
+        void(size_t,
+             const std::vector<std::reference_wrapper<const Data::DataHandler>>&)>&
+        function) const
 {
-    for (auto dHandlerAndHash : this->dataHandlers) {
-        for (auto dHandler : dHandlerAndHash.second) {
-            // Free memory of DataHandlers within the archive
-            delete &dHandler.get();
+    // Buffers owning the materialized delta snapshots of the current set.
+    std::vector<std::unique_ptr<Data::DataHandler>> buffers;
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dHandlers;
+    for (const auto& dataHandlerSet : this->dataHandlers) {
+        buffers.resize(dataHandlerSet.second.size());
+        dHandlers.clear();
+        for (size_t idx = 0; idx < dataHandlerSet.second.size(); idx++) {
+            dHandlers.push_back(this->snapshots.materialize(
+                dataHandlerSet.second.at(idx), buffers.at(idx)));
         }
+        function(dataHandlerSet.first, dHandlers);
     }
+}
 
+void Archive::clear()
+{
     this->dataHandlers.clear();
+    this->snapshots.clear();
     this->recordings.clear();
     this->recordingsPerProgram.clear();
 }
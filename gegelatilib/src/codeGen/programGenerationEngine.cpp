@@ -35,6 +35,11 @@
  */
 
 #ifdef CODE_GENERATION
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+
 #include "codeGen/programGenerationEngine.h"
 #include "util/timestamp.h"
 
@@ -43,6 +48,11 @@ const std::string CodeGen::ProgramGenerationEngine::nameRegVariable("reg");
 const std::string CodeGen::ProgramGenerationEngine::nameConstantVariable("cst");
 const std::string CodeGen::ProgramGenerationEngine::nameDataVariable("in");
 const std::string CodeGen::ProgramGenerationEngine::nameOperandVariable("op");
+const std::string CodeGen::ProgramGenerationEngine::nameValueVariable("val");
+const std::string CodeGen::ProgramGenerationEngine::nameNbLanesVariable("n");
+const std::string CodeGen::ProgramGenerationEngine::nameLaneVariable("l");
+const std::string CodeGen::ProgramGenerationEngine::nameSharedValueVariable(
+    "v");
 
 void CodeGen::ProgramGenerationEngine::generateCurrentLine()
 {
@@ -69,6 +79,228 @@ void CodeGen::ProgramGenerationEngine::generateProgram(
     fileC << "\ndouble P" << progID << "(){" << std::endl;
     fileH << "double P" << progID << "();" << std::endl;
 
+    std::string result = generateProgramBody(ignoreException);
+#ifdef DEBUG
+    fileC << "#ifdef DEBUG" << std::endl;
+    fileC << "\tprintf(\"P" << progID << " : reg[0] = %lf \\n\", " << result
+          << ");" << std::endl;
+    fileC << "#endif" << std::endl;
+#endif
+    fileC << "\treturn " << result << ";\n}" << std::endl;
+}
+
+void CodeGen::ProgramGenerationEngine::generateBatchProgram(
+    uint64_t progID, const bool ignoreException)
+{
+    if (!this->batch) {
+        throw std::runtime_error("The ProgramGenerationEngine is not in batch "
+                                 "mode, batch programs can not be generated.");
+    }
+
+    std::ostringstream declaration;
+    declaration << "void P" << progID << "Batch(int nb, const int* lanes, int "
+                << nameNbLanesVariable;
+    for (const std::pair<std::string, std::string>& variable :
+         this->getDataSourceVariables()) {
+        declaration << ", const " << variable.first << "* TPG_RESTRICT "
+                    << variable.second;
+    }
+    declaration << ", double* TPG_RESTRICT scores)";
+    fileC << "\n" << declaration.str() << "{" << std::endl;
+    fileH << declaration.str() << ";" << std::endl;
+
+    // Lanes are independent: each iteration executes the whole program.
+    fileC << "\tfor (int i = 0; i < nb; i++) {" << std::endl;
+    fileC << "\tconst int " << nameLaneVariable << " = lanes[i];" << std::endl;
+    std::string result = generateProgramBody(ignoreException);
+    fileC << "\tscores[i] = " << result << ";\n\t}\n}" << std::endl;
+}
+
+void CodeGen::ProgramGenerationEngine::generateTeamPrograms(
+    uint64_t teamID, const std::vector<const Program::Program*>& programs)
+{
+    fileC << "\nvoid T" << teamID << "Bids(double* scores){" << std::endl;
+    fileH << "void T" << teamID << "Bids(double* scores);" << std::endl;
+
+    generateTeamProgramsBody(programs, "");
+    fileC << "}" << std::endl;
+}
+
+void CodeGen::ProgramGenerationEngine::generateBatchTeamPrograms(
+    uint64_t teamID, const std::vector<const Program::Program*>& programs)
+{
+    if (!this->batch) {
+        throw std::runtime_error("The ProgramGenerationEngine is not in batch "
+                                 "mode, batch programs can not be generated.");
+    }
+
+    std::ostringstream declaration;
+    declaration << "void T" << teamID
+                << "BidsBatch(int nb, const int* lanes, int "
+                << nameNbLanesVariable;
+    for (const std::pair<std::string, std::string>& variable :
+         this->getDataSourceVariables()) {
+        declaration << ", const " << variable.first << "* TPG_RESTRICT "
+                    << variable.second;
+    }
+    declaration << ", double* TPG_RESTRICT scores, int stride)";
+    fileC << "\n" << declaration.str() << "{" << std::endl;
+    fileH << declaration.str() << ";" << std::endl;
+
+    // Lanes are independent: each iteration computes all the bids.
+    fileC << "\tfor (int i = 0; i < nb; i++) {" << std::endl;
+    fileC << "\tconst int " << nameLaneVariable << " = lanes[i];" << std::endl;
+    generateTeamProgramsBody(programs, " * stride + i");
+    fileC << "\t}\n}" << std::endl;
+}
+
+void CodeGen::ProgramGenerationEngine::generateTeamProgramsBody(
+    const std::vector<const Program::Program*>& programs,
+    const std::string& scoreOffset)
+{
+    // Shared value computed by each distinct Operation.
+    std::map<std::string, uint64_t> sharedValues;
+
+    for (size_t progIdx = 0; progIdx < programs.size(); progIdx++) {
+        const Program::Program& program = *programs.at(progIdx);
+        this->setProgram(program);
+
+        std::unique_ptr<Program::OptimizedProgram> localOptimized;
+        const Program::OptimizedProgram* optimized =
+            program.getOptimizedProgram();
+        if (optimized == nullptr) {
+            try {
+                localOptimized =
+                    std::make_unique<Program::OptimizedProgram>(program);
+                optimized = localOptimized.get();
+            }
+            catch (std::out_of_range&) {
+            }
+            catch (std::invalid_argument&) {
+            }
+        }
+
+        if (optimized == nullptr || !isMergeable(*optimized)) {
+            fileC << "\t{" << std::endl;
+            std::string result = generateProgramBody(false);
+            fileC << "\tscores[" << progIdx << scoreOffset << "] = " << result
+                  << ";\n\t}" << std::endl;
+            continue;
+        }
+
+        // Shared value of each Operation of the Program
+        const std::vector<Program::OptimizedProgram::Operation>& operations =
+            optimized->getOperations();
+        std::vector<uint64_t> values(operations.size());
+        auto printOperand =
+            [&](const Program::OptimizedProgram::Operand& operand) {
+                if (operand.kind ==
+                    Program::OptimizedProgram::OperandKind::VALUE) {
+                    return nameSharedValueVariable +
+                           std::to_string(values.at(operand.index));
+                }
+                return printValue(*optimized, operand);
+            };
+
+        for (size_t idx = 0; idx < operations.size(); idx++) {
+            const Program::OptimizedProgram::Operation& operation =
+                operations.at(idx);
+            const Instructions::Instruction& instruction =
+                *operation.instruction;
+            if (!instruction.isPrintable()) {
+                throw std::runtime_error("The instruction is not printable, "
+                                         "stop the generation of the "
+                                         "program.");
+            }
+
+            // The printed operands identify the Operation.
+            std::string operands;
+            for (size_t i = 0; i < operation.operands.size(); i++) {
+                const Program::OptimizedProgram::Operand& operand =
+                    operation.operands.at(i);
+                operands += "\t\t" +
+                            instruction.getPrintablePrimitiveOperandType(i) +
+                            " " + nameOperandVariable + std::to_string(i);
+                if (isScalarConstant(operand)) {
+                    // Literal constants make the Operation key independent
+                    // from the Program holding them.
+                    operands += " = " +
+                                std::to_string(program
+                                                   .getConstantAt(
+                                                       operand.location)
+                                                   .value) +
+                                ";";
+                }
+                else if (operand.kind == Program::OptimizedProgram::
+                                             OperandKind::DATA_SOURCE) {
+                    operands += printDataAt(operand.index, *operand.type,
+                                            operand.location);
+                }
+                else {
+                    operands += " = " + printOperand(operand) + ";";
+                }
+                operands += "\n";
+            }
+            std::string key =
+                std::to_string(operation.instructionIndex) + "\n" + operands;
+
+            auto shared = sharedValues.find(key);
+            if (shared != sharedValues.end()) {
+                values.at(idx) = shared->second;
+                continue;
+            }
+
+            values.at(idx) = sharedValues.size();
+            sharedValues.emplace(key, values.at(idx));
+            std::string value =
+                nameSharedValueVariable + std::to_string(values.at(idx));
+            fileC << "\tdouble " << value << ";\n"
+                  << "\t{\n"
+                  << operands << "\t\t" << completeFormat(instruction, value)
+                  << "\n"
+                  << "\t}" << std::endl;
+        }
+
+        fileC << "\tscores[" << progIdx << scoreOffset
+              << "] = " << printOperand(optimized->getResult()) << ";"
+              << std::endl;
+    }
+}
+
+bool CodeGen::ProgramGenerationEngine::isMergeable(
+    const Program::OptimizedProgram& optimized) const
+{
+    size_t firstIdx =
+        this->dataScsConstsAndRegs.size() - this->dataSources.size();
+    for (const Program::OptimizedProgram::Operation& operation :
+         optimized.getOperations()) {
+        for (const Program::OptimizedProgram::Operand& operand :
+             operation.operands) {
+            if (operand.kind ==
+                    Program::OptimizedProgram::OperandKind::DATA_SOURCE &&
+                operand.index < firstIdx && !isScalarConstant(operand)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CodeGen::ProgramGenerationEngine::isScalarConstant(
+    const Program::OptimizedProgram::Operand& operand) const
+{
+    return operand.kind ==
+               Program::OptimizedProgram::OperandKind::DATA_SOURCE &&
+           this->program->getEnvironment().getNbConstant() > 0 &&
+           operand.index == 1 &&
+           *operand.type ==
+               this->dataScsConstsAndRegs.at(operand.index).get()
+                   .getNativeType();
+}
+
+std::string CodeGen::ProgramGenerationEngine::generateProgramBody(
+    const bool ignoreException)
+{
     // instantiate register
     fileC << "\tdouble " << nameRegVariable << "["
           << program->getEnvironment().getNbRegisters() << "] = {";
@@ -92,22 +324,34 @@ void CodeGen::ProgramGenerationEngine::generateProgram(
         fileC << "};" << std::endl;
     }
 
-    iterateThroughtProgram(ignoreException);
-#ifdef DEBUG
-    fileC << "#ifdef DEBUG" << std::endl;
-    fileC << "\tprintf(\"P" << progID << " : reg[0] = %lf \\n\", reg[0]);"
-          << std::endl;
-    fileC << "#endif" << std::endl;
-#endif
-    fileC << "\treturn reg[0];\n}" << std::endl;
+    std::string result = nameRegVariable + "[0]";
+    const Program::OptimizedProgram* optimized =
+        this->program->getOptimizedProgram();
+    if (optimized != nullptr) {
+        result = generateOptimizedProgram(*optimized);
+    }
+    else {
+        iterateThroughtProgram(ignoreException);
+    }
+    return result;
 }
 
 std::string CodeGen::ProgramGenerationEngine::completeFormat(
     const Instructions::Instruction& instruction) const
 {
-    const std::string& printTemplate = instruction.getPrintTemplate();
     const Program::Line& line =
         this->getCurrentLine(); // throw std::out_of_range
+    return completeFormat(instruction,
+                          nameRegVariable + "[" +
+                              std::to_string(line.getDestinationIndex()) +
+                              "]");
+}
+
+std::string CodeGen::ProgramGenerationEngine::completeFormat(
+    const Instructions::Instruction& instruction,
+    const std::string& result) const
+{
+    const std::string& printTemplate = instruction.getPrintTemplate();
     std::string codeLine(printTemplate);
     std::string operandValue;
     for (auto itr = std::sregex_iterator(printTemplate.begin(),
@@ -118,20 +362,96 @@ std::string CodeGen::ProgramGenerationEngine::completeFormat(
         // get number after character '$'
         int idx = std::stoi(match.substr(1));
         if (idx > 0) {
-            const uint64_t operandLocation = this->getOperandLocation(idx - 1);
             std::string operandIdx(std::to_string(idx - 1));
             operandValue = nameOperandVariable + operandIdx;
         }
         else {
             // if number == 0 it corresponds to the result of the function
-            operandValue = nameRegVariable + "[" +
-                           std::to_string(line.getDestinationIndex()) + "]";
+            operandValue = result;
         }
         codeLine.replace(pos, match.size(), operandValue);
     }
     return codeLine;
 }
 
+std::string CodeGen::ProgramGenerationEngine::generateOptimizedProgram(
+    const Program::OptimizedProgram& optimized)
+{
+    const std::vector<Program::OptimizedProgram::Operation>& operations =
+        optimized.getOperations();
+    if (!operations.empty()) {
+        fileC << "\tdouble " << nameValueVariable << "[" << operations.size()
+              << "];" << std::endl;
+    }
+
+    for (size_t idx = 0; idx < operations.size(); idx++) {
+        const Program::OptimizedProgram::Operation& operation =
+            operations.at(idx);
+        const Instructions::Instruction& instruction = *operation.instruction;
+        if (!instruction.isPrintable()) {
+            throw std::runtime_error("The instruction is not printable, stop "
+                                     "the generation of the program.");
+        }
+
+        fileC << "\t{" << std::endl;
+        // Registers accessed as arrays
+        for (const std::pair<uint64_t, Program::OptimizedProgram::Operand>&
+                 write : operation.registerWrites) {
+            fileC << "\t\t" << nameRegVariable << "[" << write.first
+                  << "] = " << printValue(optimized, write.second) << ";"
+                  << std::endl;
+        }
+
+        for (size_t i = 0; i < operation.operands.size(); i++) {
+            const Program::OptimizedProgram::Operand& operand =
+                operation.operands.at(i);
+            fileC << "\t\t" << instruction.getPrintablePrimitiveOperandType(i)
+                  << " " << nameOperandVariable << i;
+            if (operand.kind ==
+                Program::OptimizedProgram::OperandKind::DATA_SOURCE) {
+                fileC << printDataAt(operand.index, *operand.type,
+                                     operand.location);
+            }
+            else {
+                fileC << " = " << printValue(optimized, operand) << ";";
+            }
+            fileC << std::endl;
+        }
+
+        fileC << "\t\t"
+              << completeFormat(instruction, nameValueVariable + "[" +
+                                                 std::to_string(idx) + "]")
+              << "\n"
+              << "\t}" << std::endl;
+    }
+
+    return printValue(optimized, optimized.getResult());
+}
+
+std::string CodeGen::ProgramGenerationEngine::printValue(
+    const Program::OptimizedProgram& optimized,
+    const Program::OptimizedProgram::Operand& operand) const
+{
+    if (operand.kind == Program::OptimizedProgram::OperandKind::VALUE) {
+        return nameValueVariable + "[" + std::to_string(operand.index) + "]";
+    }
+
+    return printLiteral(optimized.getLiterals().at(operand.index));
+}
+
+std::string CodeGen::ProgramGenerationEngine::printLiteral(double value) const
+{
+    if (std::isnan(value)) {
+        return "(0.0 / 0.0)";
+    }
+    if (std::isinf(value)) {
+        return (value > 0) ? "(1.0 / 0.0)" : "(-1.0 / 0.0)";
+    }
+    std::ostringstream literal;
+    literal << std::hexfloat << value;
+    return literal.str();
+}
+
 void CodeGen::ProgramGenerationEngine::initGlobalVar(size_t nbConstant)
 {
     int i;
@@ -143,6 +463,11 @@ void CodeGen::ProgramGenerationEngine::initGlobalVar(size_t nbConstant)
         i = 1;
     }
 
+    // Data sources are parameters of the generated functions in batch mode.
+    if (this->batch) {
+        return;
+    }
+
     for (int cpt = 1; i < this->dataScsConstsAndRegs.size(); ++i, ++cpt) {
 
         const Data::DataHandler& d = this->dataScsConstsAndRegs.at(i);
@@ -186,6 +511,17 @@ void CodeGen::ProgramGenerationEngine::openFile(const std::string& filename,
     fileC << "#include \"" << filename << ".h\"" << std::endl;
     fileH << "#ifndef C_" << filename << "_H" << std::endl;
     fileH << "#define C_" << filename << "_H\n" << std::endl;
+    if (this->batch) {
+        // Non-aliased pointers let compilers vectorize loops over lanes.
+        fileH << "#ifndef TPG_RESTRICT\n"
+              << "#if defined(__cplusplus) || defined(_MSC_VER)\n"
+              << "#define TPG_RESTRICT __restrict\n"
+              << "#else\n"
+              << "#define TPG_RESTRICT restrict\n"
+              << "#endif\n"
+              << "#endif\n"
+              << std::endl;
+    }
     fileC << "#include \"externHeader.h\"" << std::endl;
 #ifdef DEBUG
     fileC << "#include <stdio.h>" << std::endl;
@@ -204,13 +540,11 @@ void CodeGen::ProgramGenerationEngine::initOperandCurrentLine()
             instruction.getOperandTypes().at(i).get();
 
         opIdx = this->getOperandLocation(i);
-        const Data::DataHandler& dataSource = this->dataScsConstsAndRegs.at(
-            sourceIdx); // Throws std::out_of_range
 
         fileC << "\t\t" << instruction.getPrintablePrimitiveOperandType(i)
               << " " << nameOperandVariable << i
-              << dataPrinter.printDataAt(dataSource, operandType, opIdx,
-                                         getNameSourceData(sourceIdx))
+              << printDataAt(sourceIdx, operandType,
+                             opIdx) // Throws std::out_of_range
               << std::endl;
     }
 }
@@ -235,6 +569,35 @@ std::string CodeGen::ProgramGenerationEngine::getNameSourceData(
     return nameDataSource;
 }
 
+std::vector<std::pair<std::string, std::string>> CodeGen::
+    ProgramGenerationEngine::getDataSourceVariables() const
+{
+    std::vector<std::pair<std::string, std::string>> variables;
+    size_t firstIdx =
+        this->dataScsConstsAndRegs.size() - this->dataSources.size();
+    for (size_t i = firstIdx, cpt = 1; i < this->dataScsConstsAndRegs.size();
+         ++i, ++cpt) {
+        variables.emplace_back(
+            dataPrinter.getDemangleTemplateType(
+                this->dataScsConstsAndRegs.at(i)),
+            nameDataVariable + std::to_string(cpt));
+    }
+    return variables;
+}
+
+std::string CodeGen::ProgramGenerationEngine::printDataAt(
+    uint64_t sourceIdx, const std::type_info& type, size_t location)
+{
+    const Data::DataHandler& dataSource =
+        this->dataScsConstsAndRegs.at(sourceIdx);
+    bool isDataSource = sourceIdx >= (this->dataScsConstsAndRegs.size() -
+                                      this->dataSources.size());
+    const Data::DataHandlerPrinter& printer =
+        (this->batch && isDataSource) ? batchDataPrinter : dataPrinter;
+    return printer.printDataAt(dataSource, type, location,
+                               getNameSourceData(sourceIdx));
+}
+
 void CodeGen::ProgramGenerationEngine::processLine()
 {
     this->generateCurrentLine();
@@ -37,16 +37,19 @@
 
 #ifdef CODE_GENERATION
 
+#include <algorithm>
+
 #include "codeGen/tpgGenerationEngine.h"
 #include "data/demangle.h"
 #include "util/timestamp.h"
 
 CodeGen::TPGGenerationEngine::TPGGenerationEngine(const std::string& filename,
                                                   const TPG::TPGGraph& tpg,
-                                                  const std::string& path)
-    : TPGAbstractEngine(tpg), progGenerationEngine{filename + "_" +
-                                                       filenameProg,
-                                                   tpg.getEnvironment(), path}
+                                                  const std::string& path,
+                                                  bool batch)
+    : TPGAbstractEngine(tpg), batch{batch},
+      progGenerationEngine{filename + "_" + filenameProg, tpg.getEnvironment(),
+                           path, batch}
 {
     this->fileMain.open(path + filename + ".c", std::ofstream::out);
     this->fileMainH.open(path + filename + ".h", std::ofstream::out);
@@ -84,4 +87,173 @@ CodeGen::TPGGenerationEngine::~TPGGenerationEngine()
     fileMainH.close();
 }
 
+void CodeGen::TPGGenerationEngine::setMergeTeamPrograms(bool merge)
+{
+    this->mergeTeamPrograms = merge;
+}
+
+void CodeGen::TPGGenerationEngine::generateBatchTPGGraph()
+{
+    // Vertices are identified by their index in the generated tables.
+    std::vector<const TPG::TPGVertex*> vertices = this->tpg.getVertices();
+    for (const TPG::TPGVertex* vertex : vertices) {
+        findVertexID(*vertex);
+    }
+    const TPG::TPGVertex& root = *this->tpg.getRootVertices().at(0);
+
+    std::map<const TPG::TPGVertex*, bool> visited;
+    std::vector<const TPG::TPGTeam*> teams;
+    sortTeams(root, visited, teams);
+    std::reverse(teams.begin(), teams.end());
+
+    // Parameters of the generated functions
+    std::string parameters;
+    std::string arguments;
+    for (const std::pair<std::string, std::string>& variable :
+         progGenerationEngine.getDataSourceVariables()) {
+        parameters += ", const " + variable.first + "* " + variable.second;
+        arguments += ", " + variable.second + " + start";
+    }
+
+    fileMainH << "#include <stdlib.h>\n\n"
+              << "void inferenceTPGBatch(int n" << parameters
+              << ", int* actions);\n";
+
+    fileMain << "#include <math.h>\n\n"
+             << "#ifndef TPG_BATCH_SIZE\n"
+             << "#define TPG_BATCH_SIZE 64\n"
+             << "#endif\n\n";
+
+    // Action of each vertex, or -1 for teams.
+    fileMain << "static const int vertexActions[" << vertices.size()
+             << "] = {";
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const TPG::TPGAction* action =
+            dynamic_cast<const TPG::TPGAction*>(vertices.at(i));
+        fileMain << ((i > 0) ? ", " : "")
+                 << ((action != nullptr) ? (int64_t)action->getActionID() : -1);
+    }
+    fileMain << "};\n\n";
+
+    fileMain
+        << "static int bestProgramBatch(double (*scores)[TPG_BATCH_SIZE], int "
+           "nb, int i) {\n"
+        << "\tint bestProgram = 0;\n"
+        << "\tdouble bestScore = (isnan(scores[0][i]))? -INFINITY : "
+           "scores[0][i];\n"
+        << "\tfor (int e = 1; e < nb; e++) {\n"
+        << "\t\tdouble challengerScore = (isnan(scores[e][i]))? -INFINITY : "
+           "scores[e][i];\n"
+        << "\t\tif (challengerScore >= bestScore) {\n"
+        << "\t\t\tbestProgram = e;\n"
+        << "\t\t\tbestScore = challengerScore;\n"
+        << "\t\t}\n"
+        << "\t}\n"
+        << "\treturn bestProgram;\n"
+        << "}\n\n";
+
+    fileMain << "void inferenceTPGBatch(int n" << parameters
+             << ", int* actions) {\n"
+             << "\tfor (int start = 0; start < n; start += TPG_BATCH_SIZE) "
+                "{\n"
+             << "\t\tconst int nbLanes = (n - start < TPG_BATCH_SIZE) ? n - "
+                "start : TPG_BATCH_SIZE;\n"
+             << "\t\tint current[TPG_BATCH_SIZE];\n"
+             << "\t\tint lanes[TPG_BATCH_SIZE];\n"
+             << "\t\tint nb;\n"
+             << "\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+             << "\t\t\tcurrent[l] = " << findVertexID(root) << ";\n"
+             << "\t\t}\n";
+
+    for (const TPG::TPGTeam* team : teams) {
+        uint64_t id = findVertexID(*team);
+        const std::list<TPG::TPGEdge*>& edges = team->getOutgoingEdges();
+        if (edges.empty()) {
+            continue;
+        }
+
+        // Gather the lanes on the team
+        fileMain << "\n\t\t// T" << id << "\n"
+                 << "\t\tnb = 0;\n"
+                 << "\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+                 << "\t\t\tif (current[l] == " << id << ") {\n"
+                 << "\t\t\t\tlanes[nb++] = l;\n"
+                 << "\t\t\t}\n"
+                 << "\t\t}\n"
+                 << "\t\tif (nb > 0) {\n"
+                 << "\t\t\tstatic const int next[" << edges.size() << "] = {";
+        for (auto edge = edges.begin(); edge != edges.end(); edge++) {
+            fileMain << ((edge != edges.begin()) ? ", " : "")
+                     << findVertexID(*(*edge)->getDestination());
+        }
+        fileMain << "};\n"
+                 << "\t\t\tdouble scores[" << edges.size()
+                 << "][TPG_BATCH_SIZE];\n";
+
+        // Execute the programs of the edges on the gathered lanes
+        if (this->mergeTeamPrograms) {
+            std::vector<const Program::Program*> programs;
+            for (const TPG::TPGEdge* edge : edges) {
+                programs.push_back(&edge->getProgram());
+            }
+            progGenerationEngine.generateBatchTeamPrograms(id, programs);
+            fileMain << "\t\t\tT" << id << "BidsBatch(nb, lanes, n"
+                     << arguments << ", scores[0], TPG_BATCH_SIZE);\n";
+        }
+        else {
+            size_t idx = 0;
+            for (const TPG::TPGEdge* edge : edges) {
+                const Program::Program& p = edge->getProgram();
+                uint64_t progID;
+                progGenerationEngine.setProgram(p);
+                if (findProgramID(p, progID)) {
+                    progGenerationEngine.generateBatchProgram(progID);
+                }
+                fileMain << "\t\t\tP" << progID << "Batch(nb, lanes, n"
+                         << arguments << ", scores[" << idx++ << "]);\n";
+            }
+        }
+
+        fileMain << "\t\t\tfor (int i = 0; i < nb; i++) {\n"
+                 << "\t\t\t\tcurrent[lanes[i]] = next[bestProgramBatch("
+                 << "scores, " << edges.size() << ", i)];\n"
+                 << "\t\t\t}\n"
+                 << "\t\t}\n";
+    }
+
+    fileMain << "\n\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+             << "\t\t\tactions[start + l] = vertexActions[current[l]];\n"
+             << "\t\t}\n"
+             << "\t}\n"
+             << "}\n";
+}
+
+void CodeGen::TPGGenerationEngine::sortTeams(
+    const TPG::TPGVertex& vertex,
+    std::map<const TPG::TPGVertex*, bool>& visited,
+    std::vector<const TPG::TPGTeam*>& order)
+{
+    auto iter = visited.find(&vertex);
+    if (iter != visited.end()) {
+        if (!iter->second) {
+            throw std::runtime_error("The TPGGraph contains a cycle, batch "
+                                     "inference code can not be generated.");
+        }
+        return;
+    }
+
+    const TPG::TPGTeam* team = dynamic_cast<const TPG::TPGTeam*>(&vertex);
+    if (team == nullptr) {
+        visited.emplace(&vertex, true);
+        return;
+    }
+
+    visited.emplace(&vertex, false);
+    for (const TPG::TPGEdge* edge : team->getOutgoingEdges()) {
+        sortTeams(*edge->getDestination(), visited, order);
+    }
+    visited.at(&vertex) = true;
+    order.push_back(team);
+}
+
 #endif // CODE_GENERATION
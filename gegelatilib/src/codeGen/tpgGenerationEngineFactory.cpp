@@ -40,6 +40,7 @@
 #include "codeGen/tpgGenerationEngineFactory.h"
 #include "codeGen/tpgStackGenerationEngine.h"
 #include "codeGen/tpgSwitchGenerationEngine.h"
+#include "codeGen/tpgTableGenerationEngine.h"
 
 CodeGen::TPGGenerationEngineFactory::TPGGenerationEngineFactory()
     : TPGGenerationEngineFactory(switchMode){};
@@ -53,13 +54,20 @@ CodeGen::TPGGenerationEngineFactory::TPGGenerationEngineFactory(
 std::unique_ptr<CodeGen::TPGGenerationEngine> CodeGen::
     TPGGenerationEngineFactory::create(const std::string& filename,
                                        const TPG::TPGGraph& tpg,
-                                       const std::string& path)
+                                       const std::string& path,
+                                       bool batch)
 {
     if (this->mode == stackMode) {
-        return std::make_unique<TPGStackGenerationEngine>(filename, tpg, path);
+        return std::make_unique<TPGStackGenerationEngine>(filename, tpg, path,
+                                                          batch);
     }
     else if (this->mode == switchMode) {
-        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path);
+        return std::make_unique<TPGSwitchGenerationEngine>(filename, tpg, path,
+                                                           batch);
+    }
+    else if (this->mode == tableMode) {
+        return std::make_unique<TPGTableGenerationEngine>(filename, tpg, path,
+                                                          batch);
     }
     else {
         return nullptr;
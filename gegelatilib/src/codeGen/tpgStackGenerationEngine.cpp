@@ -42,8 +42,8 @@
 
 CodeGen::TPGStackGenerationEngine::TPGStackGenerationEngine(
     const std::string& filename, const TPG::TPGGraph& tpg,
-    const std::string& path)
-    : TPGGenerationEngine(filename, tpg, path)
+    const std::string& path, bool batch)
+    : TPGGenerationEngine(filename, tpg, path, batch)
 {
 }
 
@@ -56,13 +56,18 @@ CodeGen::TPGStackGenerationEngine::~TPGStackGenerationEngine()
 
 void CodeGen::TPGStackGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
 {
-    const Program::Program& p = edge.getProgram();
-    uint64_t progID;
+    // Programs of merged teams are generated by generateTeam.
+    std::string programName = "NULL";
+    if (!this->mergeTeamPrograms) {
+        const Program::Program& p = edge.getProgram();
+        uint64_t progID;
 
-    progGenerationEngine.setProgram(p);
+        progGenerationEngine.setProgram(p);
 
-    if (findProgramID(p, progID)) {
-        progGenerationEngine.generateProgram(progID);
+        if (findProgramID(p, progID)) {
+            progGenerationEngine.generateProgram(progID);
+        }
+        programName = "P" + std::to_string(progID);
     }
 
     std::string destinationName;
@@ -76,8 +81,8 @@ void CodeGen::TPGStackGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
         destinationName = 'A' + std::to_string(a->getActionID());
     }
 
-    fileMain << "\t\t\t{" << destinationName << "Vert, P" << progID << ", "
-             << destinationName << "}";
+    fileMain << "\t\t\t{" << destinationName << "Vert, " << programName
+             << ", " << destinationName << "}";
 }
 
 void CodeGen::TPGStackGenerationEngine::generateTeam(const TPG::TPGTeam& team)
@@ -103,6 +108,18 @@ void CodeGen::TPGStackGenerationEngine::generateTeam(const TPG::TPGTeam& team)
     // appel des fonction d'exécution
     fileMain << "\tint nbEdge = " << team.getOutgoingEdges().size() << ";"
              << std::endl;
+    if (this->mergeTeamPrograms) {
+        std::vector<const Program::Program*> programs;
+        for (const TPG::TPGEdge* edge : list) {
+            programs.push_back(&edge->getProgram());
+        }
+        progGenerationEngine.generateTeamPrograms(id, programs);
+        fileMain << "\tdouble scores[" << list.size() << "];" << std::endl;
+        fileMain << "\tT" << id << "Bids(scores);" << std::endl;
+        fileMain << "\treturn e[bestBid(scores, nbEdge)].ptr_vertex;\n}\n"
+                 << std::endl;
+        return;
+    }
     fileMain << "\treturn executeTeam(e,nbEdge);\n}\n" << std::endl;
 }
 
@@ -128,6 +145,11 @@ void CodeGen::TPGStackGenerationEngine::setRoot(const TPG::TPGVertex& team)
 
 void CodeGen::TPGStackGenerationEngine::generateTPGGraph()
 {
+    if (this->batch) {
+        generateBatchTPGGraph();
+        return;
+    }
+
     initTpgFile();
     initHeaderFile();
 
@@ -198,6 +220,24 @@ void CodeGen::TPGStackGenerationEngine::initTpgFile()
              << "\treturn idxNext;\n"
              << "}\n"
              << std::endl;
+
+    if (this->mergeTeamPrograms) {
+        fileMain << "int bestBid(double* scores, int nbEdge){\n"
+                 << "\tint idxNext = 0;\n"
+                 << "\tdouble bestResult = (isnan(scores[0])) ? -INFINITY : "
+                    "scores[0];\n"
+                 << "\tfor (int idx = 1; idx < nbEdge; idx++){\n"
+                 << "\t\tdouble r = (isnan(scores[idx])) ? -INFINITY : "
+                    "scores[idx];\n"
+                 << "\t\tif (r >= bestResult){\n"
+                 << "\t\t\tbestResult = r;\n"
+                 << "\t\t\tidxNext = idx;\n"
+                 << "\t\t}\n"
+                 << "\t}\n"
+                 << "\treturn idxNext;\n"
+                 << "}\n"
+                 << std::endl;
+    }
 }
 
 void CodeGen::TPGStackGenerationEngine::initHeaderFile()
@@ -221,8 +261,11 @@ void CodeGen::TPGStackGenerationEngine::initHeaderFile()
               << "int inferenceTPG();\n"
               << "int executeFromVertex(void*(*)(int*action));\n"
               << "void* executeTeam(Edge* e, int nbEdge);\n"
-              << "int execute(Edge* e, int nbEdge);\n"
-              << std::endl;
+              << "int execute(Edge* e, int nbEdge);\n";
+    if (this->mergeTeamPrograms) {
+        fileMainH << "int bestBid(double* scores, int nbEdge);\n";
+    }
+    fileMainH << std::endl;
 }
 
 std::string CodeGen::TPGStackGenerationEngine::vertexName(
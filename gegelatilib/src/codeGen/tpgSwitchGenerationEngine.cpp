@@ -74,12 +74,24 @@ void CodeGen::TPGSwitchGenerationEngine::generateTeam(const TPG::TPGTeam& team)
 
     fileMain << std::endl;
 
-    int i = 0;
-    for (const auto* edge : edges) {
-        fileMain << "\t\t\t" << teamName << "Scores[" << i << "] = ";
-        ++i;
-        generateEdge(*edge);
-        fileMain << ";" << std::endl;
+    if (this->mergeTeamPrograms) {
+        std::vector<const Program::Program*> programs;
+        for (const auto* edge : edges) {
+            programs.push_back(&edge->getProgram());
+        }
+        progGenerationEngine.generateTeamPrograms(findVertexID(team),
+                                                  programs);
+        fileMain << "\t\t\t" << teamName << "Bids(" << teamName << "Scores);"
+                 << std::endl;
+    }
+    else {
+        int i = 0;
+        for (const auto* edge : edges) {
+            fileMain << "\t\t\t" << teamName << "Scores[" << i << "] = ";
+            ++i;
+            generateEdge(*edge);
+            fileMain << ";" << std::endl;
+        }
     }
     fileMain << std::endl;
 
@@ -97,6 +109,11 @@ void CodeGen::TPGSwitchGenerationEngine::generateAction(
 
 void CodeGen::TPGSwitchGenerationEngine::generateTPGGraph()
 {
+    if (this->batch) {
+        generateBatchTPGGraph();
+        return;
+    }
+
     initTpgFile();
     initHeaderFile();
 
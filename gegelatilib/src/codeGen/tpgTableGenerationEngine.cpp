@@ -0,0 +1,397 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#ifdef CODE_GENERATION
+
+#include <algorithm>
+#include <map>
+
+#include "codeGen/tpgTableGenerationEngine.h"
+
+/**
+ * \brief Get the smallest C unsigned integer type able to hold a value.
+ *
+ * \param[in] max the largest value that must be represented.
+ * \return the name of the C type.
+ */
+static std::string indexType(uint64_t max)
+{
+    if (max <= UINT8_MAX) {
+        return "uint8_t";
+    }
+    else if (max <= UINT16_MAX) {
+        return "uint16_t";
+    }
+    else if (max <= UINT32_MAX) {
+        return "uint32_t";
+    }
+    else {
+        return "uint64_t";
+    }
+}
+
+void CodeGen::TPGTableGenerationEngine::generateEdge(const TPG::TPGEdge& edge)
+{
+    this->edgeDestinations.push_back(findVertexID(*edge.getDestination()));
+
+    // With merged team programs, bids are computed by the team function.
+    if (this->mergeTeamPrograms) {
+        return;
+    }
+
+    const Program::Program& p = edge.getProgram();
+    uint64_t progID;
+    if (findProgramID(p, progID)) {
+        progGenerationEngine.setProgram(p);
+        if (this->batch) {
+            progGenerationEngine.generateBatchProgram(progID);
+        }
+        else {
+            progGenerationEngine.generateProgram(progID);
+        }
+    }
+    this->edgePrograms.push_back(progID);
+}
+
+void CodeGen::TPGTableGenerationEngine::generateTeam(const TPG::TPGTeam& team)
+{
+    auto edges = team.getOutgoingEdges();
+
+    if (this->mergeTeamPrograms) {
+        std::vector<const Program::Program*> programs;
+        for (const auto* edge : edges) {
+            programs.push_back(&edge->getProgram());
+        }
+        if (this->batch) {
+            progGenerationEngine.generateBatchTeamPrograms(findVertexID(team),
+                                                           programs);
+        }
+        else {
+            progGenerationEngine.generateTeamPrograms(findVertexID(team),
+                                                      programs);
+        }
+    }
+
+    for (const auto* edge : edges) {
+        generateEdge(*edge);
+    }
+    this->teamEdges.push_back(this->edgeDestinations.size());
+}
+
+void CodeGen::TPGTableGenerationEngine::generateAction(
+    const TPG::TPGAction& action)
+{
+    this->vertexActions.push_back(action.getActionID());
+}
+
+void CodeGen::TPGTableGenerationEngine::generateTPGGraph()
+{
+    initTpgFile();
+    initHeaderFile();
+
+    // Number teams before actions, so that a vertex is a team if and only if
+    // its index is lower than the number of teams.
+    std::vector<const TPG::TPGTeam*> teams;
+    std::vector<const TPG::TPGAction*> actions;
+    std::map<const TPG::TPGVertex*, bool> visited;
+    if (this->batch) {
+        // Teams reachable from the root are numbered in topological order,
+        // so that lanes only move to teams with a higher index.
+        sortTeams(*this->tpg.getRootVertices().at(0), visited, teams);
+        std::reverse(teams.begin(), teams.end());
+    }
+    for (const auto* vertex : this->tpg.getVertices()) {
+        if (dynamic_cast<const TPG::TPGTeam*>(vertex) != nullptr) {
+            if (visited.count(vertex) == 0) {
+                teams.push_back((const TPG::TPGTeam*)vertex);
+            }
+        }
+        else if (dynamic_cast<const TPG::TPGAction*>(vertex) != nullptr) {
+            actions.push_back((const TPG::TPGAction*)vertex);
+        }
+    }
+    for (const auto* team : teams) {
+        findVertexID(*team);
+    }
+    for (const auto* action : actions) {
+        findVertexID(*action);
+    }
+    this->nbTeams = teams.size();
+
+    // Fill the tables
+    this->teamEdges.push_back(0);
+    uint64_t maxNbEdges = 0;
+    for (const auto* team : teams) {
+        generateTeam(*team);
+        maxNbEdges = std::max(maxNbEdges,
+                              (uint64_t)team->getOutgoingEdges().size());
+    }
+    for (const auto* action : actions) {
+        generateAction(*action);
+    }
+
+    printTable("teamEdges", this->teamEdges);
+    printTable("edgeDestinations", this->edgeDestinations);
+    if (!this->mergeTeamPrograms) {
+        printTable("edgePrograms", this->edgePrograms);
+    }
+    printTable("vertexActions", this->vertexActions);
+
+    if (this->batch) {
+        generateBatchInference(maxNbEdges);
+        return;
+    }
+
+    // Table of the functions computing the bids
+    if (this->nbTeams > 0) {
+        if (this->mergeTeamPrograms) {
+            fileMain << "static void (*const teamBids[" << this->nbTeams
+                     << "])(double*) = {";
+            for (uint64_t i = 0; i < this->nbTeams; i++) {
+                fileMain << ((i % 8 == 0) ? "\n\t" : " ") << "T" << i
+                         << "Bids,";
+            }
+        }
+        else {
+            fileMain << "static double (*const programs[" << this->nbPrograms
+                     << "])() = {";
+            for (uint64_t i = 0; i < this->nbPrograms; i++) {
+                fileMain << ((i % 8 == 0) ? "\n\t" : " ") << "P" << i << ",";
+            }
+        }
+        fileMain << "\n};" << std::endl << std::endl;
+    }
+
+    // generate inference function
+    const std::string type = indexType(
+        std::max(this->nbVertex, (uint64_t)this->edgeDestinations.size()));
+    fileMain << "int inferenceTPG() {" << std::endl;
+    fileMain << "\t" << type << " currentVertex = "
+             << findVertexID(*tpg.getRootVertices().at(0)) << ";" << std::endl;
+    if (this->nbTeams > 0) {
+        fileMain << "\twhile (currentVertex < " << this->nbTeams << ") {"
+                 << std::endl;
+        fileMain << "\t\tconst " << type
+                 << " first = teamEdges[currentVertex];" << std::endl;
+        fileMain << "\t\tconst " << type
+                 << " last = teamEdges[currentVertex + 1];" << std::endl;
+        if (this->mergeTeamPrograms) {
+            fileMain << "\t\tdouble scores[" << maxNbEdges << "];" << std::endl;
+            fileMain << "\t\tteamBids[currentVertex](scores);" << std::endl;
+        }
+        fileMain << "\t\t" << type << " best = first;" << std::endl;
+        fileMain << "\t\tdouble bestScore = -INFINITY;" << std::endl;
+        fileMain << "\t\tfor (" << type << " e = first; e < last; e++) {"
+                 << std::endl;
+        if (this->mergeTeamPrograms) {
+            fileMain << "\t\t\tdouble score = scores[e - first];" << std::endl;
+        }
+        else {
+            fileMain << "\t\t\tdouble score = programs[edgePrograms[e]]();"
+                     << std::endl;
+        }
+        fileMain << "\t\t\tscore = (isnan(score)) ? -INFINITY : score;"
+                 << std::endl;
+        fileMain << "\t\t\tif (score >= bestScore) {" << std::endl;
+        fileMain << "\t\t\t\tbest = e;" << std::endl;
+        fileMain << "\t\t\t\tbestScore = score;" << std::endl;
+        fileMain << "\t\t\t}" << std::endl;
+        fileMain << "\t\t}" << std::endl;
+        fileMain << "\t\tcurrentVertex = edgeDestinations[best];" << std::endl;
+        fileMain << "\t}" << std::endl;
+    }
+    fileMain << "\treturn vertexActions[currentVertex - " << this->nbTeams
+             << "];" << std::endl;
+    fileMain << "}" << std::endl;
+}
+
+void CodeGen::TPGTableGenerationEngine::generateBatchInference(
+    uint64_t maxNbEdges)
+{
+    // Parameters of the generated functions
+    std::string parameters;
+    std::string parameterTypes;
+    std::string arguments;
+    for (const std::pair<std::string, std::string>& variable :
+         progGenerationEngine.getDataSourceVariables()) {
+        parameters += ", const " + variable.first + "* " + variable.second;
+        parameterTypes += ", const " + variable.first + "*";
+        arguments += ", " + variable.second + " + start";
+    }
+
+    // Table of the functions computing the bids
+    if (this->nbTeams > 0) {
+        if (this->mergeTeamPrograms) {
+            fileMain << "static void (*const teamBids[" << this->nbTeams
+                     << "])(int, const int*, int" << parameterTypes
+                     << ", double*, int) = {";
+            for (uint64_t i = 0; i < this->nbTeams; i++) {
+                fileMain << ((i % 8 == 0) ? "\n\t" : " ") << "T" << i
+                         << "BidsBatch,";
+            }
+        }
+        else {
+            fileMain << "static void (*const programs[" << this->nbPrograms
+                     << "])(int, const int*, int" << parameterTypes
+                     << ", double*) = {";
+            for (uint64_t i = 0; i < this->nbPrograms; i++) {
+                fileMain << ((i % 8 == 0) ? "\n\t" : " ") << "P" << i
+                         << "Batch,";
+            }
+        }
+        fileMain << "\n};" << std::endl << std::endl;
+    }
+
+    // generate inference function
+    const std::string type = indexType(
+        std::max(this->nbVertex, (uint64_t)this->edgeDestinations.size()));
+    fileMain << "void inferenceTPGBatch(int n" << parameters
+             << ", int* actions) {\n"
+             << "\tfor (int start = 0; start < n; start += TPG_BATCH_SIZE) "
+                "{\n"
+             << "\t\tconst int nbLanes = (n - start < TPG_BATCH_SIZE) ? n - "
+                "start : TPG_BATCH_SIZE;\n"
+             << "\t\t" << type << " current[TPG_BATCH_SIZE];\n"
+             << "\t\tint lanes[TPG_BATCH_SIZE];\n"
+             << "\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+             << "\t\t\tcurrent[l] = "
+             << findVertexID(*tpg.getRootVertices().at(0)) << ";\n"
+             << "\t\t}\n";
+    if (this->nbTeams > 0) {
+        // Gather the lanes on each team, compute their bids and move them
+        // to the destination of their best edge.
+        fileMain << "\t\tfor (" << type << " t = 0; t < " << this->nbTeams
+                 << "; t++) {\n"
+                 << "\t\t\tint nb = 0;\n"
+                 << "\t\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+                 << "\t\t\t\tif (current[l] == t) {\n"
+                 << "\t\t\t\t\tlanes[nb++] = l;\n"
+                 << "\t\t\t\t}\n"
+                 << "\t\t\t}\n"
+                 << "\t\t\tif (nb == 0) {\n"
+                 << "\t\t\t\tcontinue;\n"
+                 << "\t\t\t}\n"
+                 << "\t\t\tconst " << type << " first = teamEdges[t];\n"
+                 << "\t\t\tconst " << type << " last = teamEdges[t + 1];\n"
+                 << "\t\t\tdouble scores["
+                 << std::max(maxNbEdges, (uint64_t)1)
+                 << "][TPG_BATCH_SIZE];\n";
+        if (this->mergeTeamPrograms) {
+            fileMain << "\t\t\tteamBids[t](nb, lanes, n" << arguments
+                     << ", scores[0], TPG_BATCH_SIZE);\n";
+        }
+        else {
+            fileMain << "\t\t\tfor (" << type
+                     << " e = first; e < last; e++) {\n"
+                     << "\t\t\t\tprograms[edgePrograms[e]](nb, lanes, n"
+                     << arguments << ", scores[e - first]);\n"
+                     << "\t\t\t}\n";
+        }
+        fileMain << "\t\t\tfor (int i = 0; i < nb; i++) {\n"
+                 << "\t\t\t\t" << type << " best = first;\n"
+                 << "\t\t\t\tdouble bestScore = -INFINITY;\n"
+                 << "\t\t\t\tfor (" << type
+                 << " e = first; e < last; e++) {\n"
+                 << "\t\t\t\t\tdouble score = scores[e - first][i];\n"
+                 << "\t\t\t\t\tscore = (isnan(score)) ? -INFINITY : "
+                    "score;\n"
+                 << "\t\t\t\t\tif (score >= bestScore) {\n"
+                 << "\t\t\t\t\t\tbest = e;\n"
+                 << "\t\t\t\t\t\tbestScore = score;\n"
+                 << "\t\t\t\t\t}\n"
+                 << "\t\t\t\t}\n"
+                 << "\t\t\t\tcurrent[lanes[i]] = edgeDestinations[best];\n"
+                 << "\t\t\t}\n"
+                 << "\t\t}\n";
+    }
+    fileMain << "\t\tfor (int l = 0; l < nbLanes; l++) {\n"
+             << "\t\t\tactions[start + l] = vertexActions[current[l] - "
+             << this->nbTeams << "];\n"
+             << "\t\t}\n"
+             << "\t}\n"
+             << "}" << std::endl;
+}
+
+void CodeGen::TPGTableGenerationEngine::printTable(
+    const std::string& name, const std::vector<uint64_t>& values)
+{
+    uint64_t max = 0;
+    for (auto value : values) {
+        max = std::max(max, value);
+    }
+
+    fileMain << "static const " << indexType(max) << " " << name << "["
+             << std::max(values.size(), (size_t)1) << "] = {";
+    if (values.empty()) {
+        fileMain << "0";
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+        fileMain << ((i % 16 == 0) ? "\n\t" : " ") << values.at(i) << ",";
+    }
+    fileMain << "\n};" << std::endl << std::endl;
+}
+
+void CodeGen::TPGTableGenerationEngine::initTpgFile()
+{
+    fileMain << "#include <math.h>\n"
+             << "#include <stdint.h>\n"
+             << std::endl;
+    if (this->batch) {
+        fileMain << "#ifndef TPG_BATCH_SIZE\n"
+                 << "#define TPG_BATCH_SIZE 64\n"
+                 << "#endif\n"
+                 << std::endl;
+    }
+}
+
+void CodeGen::TPGTableGenerationEngine::initHeaderFile()
+{
+    fileMainH << "#include <stdlib.h>\n\n";
+    if (this->batch) {
+        fileMainH << "void inferenceTPGBatch(int n";
+        for (const std::pair<std::string, std::string>& variable :
+             progGenerationEngine.getDataSourceVariables()) {
+            fileMainH << ", const " << variable.first << "* "
+                      << variable.second;
+        }
+        fileMainH << ", int* actions);\n";
+    }
+    else {
+        fileMainH << "int inferenceTPG();\n";
+    }
+}
+
+#endif // CODE_GENERATION
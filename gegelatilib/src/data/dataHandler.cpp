@@ -36,6 +36,7 @@
  */
 
 #include <algorithm>
+#include <stdexcept>
 
 #include "data/dataHandler.h"
 
@@ -58,6 +59,24 @@ size_t Data::DataHandler::getHash() const
     return this->cachedHash;
 }
 
+Util::MemoryFootprint Data::DataHandler::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(DataHandler));
+    return footprint;
+}
+
+std::unique_ptr<Data::DataDelta> Data::DataHandler::getDelta(
+    const DataHandler& base) const
+{
+    return nullptr;
+}
+
+void Data::DataHandler::applyDelta(const DataDelta& delta)
+{
+    throw std::runtime_error("DataHandler does not support delta encoding.");
+}
+
 uint64_t Data::DataHandler::scaleLocation(const uint64_t rawLocation,
                                           const std::type_info& type) const
 {
@@ -48,8 +48,7 @@ std::string Data::DataHandlerPrinter::printDataAt(
 
     // Check if the operand need only one value
     if (type == templateType) {
-        return std::string{" = " + nameVar + "[" + std::to_string(address) +
-                           "];"};
+        return std::string{" = " + printElement(address, nameVar) + ";"};
     }
 
     std::vector<size_t> opDimension{getOperandSizes(type)};
@@ -97,6 +96,16 @@ std::string Data::DataHandlerPrinter::printDataAt(
     return operandInit;
 }
 
+std::string Data::DataHandlerPrinter::printElement(
+    const size_t& idx, const std::string& nameVar) const
+{
+    if (this->nbLanes.empty()) {
+        return nameVar + "[" + std::to_string(idx) + "]";
+    }
+    return nameVar + "[" + std::to_string(idx) + " * " + this->nbLanes +
+           " + " + this->lane + "]";
+}
+
 std::string Data::DataHandlerPrinter::getDemangleTemplateType(
     const Data::DataHandler& dataHandler) const
 {
@@ -110,7 +119,7 @@ std::string Data::DataHandlerPrinter::print1DArray(
     std::string array{"{"};
     size_t end = start + size;
     for (size_t idx = start; idx < end; ++idx) {
-        array += (nameVar + "[" + std::to_string(idx) + "]");
+        array += printElement(idx, nameVar);
         if (idx < (end - 1)) {
             array += ", ";
         }
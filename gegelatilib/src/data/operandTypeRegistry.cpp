@@ -0,0 +1,107 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <regex>
+
+#include "data/operandTypeRegistry.h"
+
+std::atomic<const Data::OperandType*> Data::OperandTypeRegistry::head{
+    nullptr};
+
+std::mutex Data::OperandTypeRegistry::registrationMutex;
+
+const Data::OperandType* Data::OperandTypeRegistry::find(
+    const std::type_info& type)
+{
+    const OperandType* description = head.load(std::memory_order_acquire);
+    while (description != nullptr) {
+        if (&description->type == &type || description->type == type) {
+            return description;
+        }
+        description = description->next;
+    }
+    return nullptr;
+}
+
+const Data::OperandType& Data::OperandTypeRegistry::add(
+    const std::type_info& type, const std::string& elementName,
+    size_t nbDimensions, size_t dim1, size_t dim2)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex);
+
+    // The type may have been registered by another thread in the meantime.
+    const OperandType* existing = find(type);
+    if (existing != nullptr) {
+        return *existing;
+    }
+
+    // Descriptions live until the end of the program.
+    const OperandType* description =
+        new OperandType{type, elementName, nbDimensions, dim1, dim2,
+                        head.load(std::memory_order_relaxed)};
+    head.store(description, std::memory_order_release);
+    return *description;
+}
+
+const Data::OperandType& Data::OperandTypeRegistry::parse(
+    const std::type_info& type)
+{
+    std::string typeName = DEMANGLE_TYPEID_NAME(type.name());
+    std::regex arrayType("(.*?)\\s*(const\\s*)?\\[([0-9]+)\\](\\[([0-9]+)\\])?");
+    std::smatch cm;
+    if (std::regex_match(typeName, cm, arrayType)) {
+        size_t dim1 = std::stoul(cm[3].str());
+        if (cm[5].matched) {
+            // 2D array
+            return add(type, cm[1].str(), 2, dim1, std::stoul(cm[5].str()));
+        }
+        // 1D array
+        return add(type, cm[1].str(), 1, dim1, 0);
+    }
+
+    // Non-array type
+    return add(type, typeName, 0, 0, 0);
+}
+
+const Data::OperandType& Data::OperandTypeRegistry::get(
+    const std::type_info& type)
+{
+    const OperandType* description = find(type);
+    if (description != nullptr) {
+        return *description;
+    }
+    return parse(type);
+}
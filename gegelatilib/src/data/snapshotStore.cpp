@@ -0,0 +1,202 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <stdexcept>
+
+#include "data/snapshotStore.h"
+
+size_t Data::SnapshotStore::acquire(const DataHandler& dataHandler)
+{
+    size_t hash = dataHandler.getHash();
+    auto iter = this->snapshots.find(hash);
+    if (iter == this->snapshots.end()) {
+        Snapshot snapshot{nullptr, nullptr, 0, 0};
+
+        // Encode the state against the base of its source, if any.
+        auto base = (this->deltaEncoding)
+                        ? this->bases.find(dataHandler.getId())
+                        : this->bases.end();
+        if (base != this->bases.end()) {
+            Snapshot& baseSnapshot = this->snapshots.at(base->second);
+            std::unique_ptr<DataDelta> delta =
+                dataHandler.getDelta(*baseSnapshot.copy);
+            if (delta != nullptr &&
+                2 * delta->getMemoryFootprint().getTotal() <=
+                    baseSnapshot.copy->getMemoryFootprint().getTotal()) {
+                snapshot.delta = std::move(delta);
+                snapshot.baseHash = base->second;
+                baseSnapshot.nbReferences++;
+            }
+        }
+
+        if (snapshot.delta == nullptr) {
+            snapshot.copy.reset(dataHandler.clone());
+            if (this->deltaEncoding) {
+                this->bases[dataHandler.getId()] = hash;
+            }
+        }
+        iter = this->snapshots.emplace(hash, std::move(snapshot)).first;
+    }
+    iter->second.nbReferences++;
+    return hash;
+}
+
+void Data::SnapshotStore::adopt(SnapshotStore& other, size_t hash)
+{
+    auto iter = this->snapshots.find(hash);
+    if (iter == this->snapshots.end()) {
+        auto otherIter = other.snapshots.find(hash);
+        if (otherIter == other.snapshots.end() ||
+            (otherIter->second.copy == nullptr &&
+             otherIter->second.delta == nullptr)) {
+            throw std::out_of_range(
+                "Adopted snapshot is not owned by the other SnapshotStore.");
+        }
+        Snapshot snapshot{std::move(otherIter->second.copy),
+                          std::move(otherIter->second.delta),
+                          otherIter->second.baseHash, 0};
+
+        // The base of a delta-encoded snapshot is adopted with it.
+        if (snapshot.delta != nullptr) {
+            this->adopt(other, snapshot.baseHash);
+        }
+        else if (this->deltaEncoding) {
+            this->bases.emplace(snapshot.copy->getId(), hash);
+        }
+        iter = this->snapshots.emplace(hash, std::move(snapshot)).first;
+    }
+    iter->second.nbReferences++;
+}
+
+void Data::SnapshotStore::release(size_t hash)
+{
+    auto iter = this->snapshots.find(hash);
+    if (iter == this->snapshots.end()) {
+        throw std::out_of_range("Released snapshot is not in the store.");
+    }
+
+    iter->second.nbReferences--;
+    if (iter->second.nbReferences == 0) {
+        if (iter->second.delta != nullptr) {
+            size_t baseHash = iter->second.baseHash;
+            this->snapshots.erase(iter);
+            this->release(baseHash);
+        }
+        else {
+            auto base = this->bases.find(iter->second.copy->getId());
+            if (base != this->bases.end() && base->second == hash) {
+                this->bases.erase(base);
+            }
+            this->snapshots.erase(iter);
+        }
+    }
+}
+
+const Data::DataHandler* Data::SnapshotStore::get(size_t hash) const
+{
+    return this->snapshots.at(hash).copy.get();
+}
+
+const Data::DataHandler& Data::SnapshotStore::materialize(
+    size_t hash, std::unique_ptr<DataHandler>& buffer) const
+{
+    const Snapshot& snapshot = this->snapshots.at(hash);
+    if (snapshot.copy != nullptr) {
+        return *snapshot.copy;
+    }
+
+    // The base of an adopted snapshot may itself be delta-encoded.
+    const DataHandler& base = this->materialize(snapshot.baseHash, buffer);
+    if (&base != buffer.get()) {
+        buffer.reset(base.clone());
+    }
+    buffer->applyDelta(*snapshot.delta);
+    return *buffer;
+}
+
+bool Data::SnapshotStore::isDeltaEncoding() const
+{
+    return this->deltaEncoding;
+}
+
+size_t Data::SnapshotStore::getNbSnapshots() const
+{
+    return this->snapshots.size();
+}
+
+size_t Data::SnapshotStore::getNbDeltas() const
+{
+    size_t nbDeltas = 0;
+    for (const auto& snapshot : this->snapshots) {
+        nbDeltas += (snapshot.second.delta != nullptr) ? 1 : 0;
+    }
+    return nbDeltas;
+}
+
+size_t Data::SnapshotStore::getNbReferences(size_t hash) const
+{
+    auto iter = this->snapshots.find(hash);
+    return (iter != this->snapshots.end()) ? iter->second.nbReferences : 0;
+}
+
+Util::MemoryFootprint Data::SnapshotStore::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("index",
+                  Util::MemoryFootprint::getHeapBytes(this->snapshots) +
+                      Util::MemoryFootprint::getHeapBytes(this->bases));
+    footprint.add("copies", 0);
+    footprint.add("deltas", 0);
+    for (const auto& snapshot : this->snapshots) {
+        if (snapshot.second.copy != nullptr) {
+            footprint.add(
+                "copies",
+                snapshot.second.copy->getMemoryFootprint().getTotal());
+        }
+        if (snapshot.second.delta != nullptr) {
+            footprint.add(
+                "deltas",
+                snapshot.second.delta->getMemoryFootprint().getTotal());
+        }
+    }
+    return footprint;
+}
+
+void Data::SnapshotStore::clear()
+{
+    this->snapshots.clear();
+    this->bases.clear();
+}
@@ -164,6 +164,39 @@ const LineSize Environment::computeLineSize(const Environment& env)
     return result;
 }
 
+void Environment::computeOperandTables()
+{
+    for (uint64_t idxInstruction = 0; idxInstruction < this->nbInstructions;
+         idxInstruction++) {
+        const Instructions::Instruction& instruction =
+            this->instructionSet.getInstruction(idxInstruction);
+        this->operandAddressSpaces.emplace_back();
+        this->operandDataSources.emplace_back();
+        for (const std::type_info& type : instruction.getOperandTypes()) {
+            std::vector<size_t> addressSpaces;
+            std::vector<uint64_t> validDataSources;
+            for (uint64_t idxDataSource = 0;
+                 idxDataSource < this->fakeDataSources.size();
+                 idxDataSource++) {
+                const Data::DataHandler& dataSource =
+                    this->fakeDataSources.at(idxDataSource).get();
+                size_t addressSpace =
+                    dataSource.canHandle(type)
+                        ? dataSource.getAddressSpace(type)
+                        : 0;
+                addressSpaces.push_back(addressSpace);
+                if (addressSpace > 0) {
+                    validDataSources.push_back(idxDataSource);
+                }
+            }
+            this->operandAddressSpaces.back().push_back(
+                std::move(addressSpaces));
+            this->operandDataSources.back().push_back(
+                std::move(validDataSources));
+        }
+    }
+}
+
 size_t Environment::getNbRegisters() const
 {
     return this->nbRegisters;
@@ -215,3 +248,36 @@ const Instructions::Set& Environment::getInstructionSet() const
 {
     return this->instructionSet;
 }
+
+void Environment::setBytecodeExecution(
+    bool enabled,
+    std::shared_ptr<const Program::SuperinstructionSet> superinstructions)
+{
+    this->bytecodeExecution = enabled;
+    this->superinstructions = superinstructions;
+}
+
+bool Environment::isBytecodeExecution() const
+{
+    return this->bytecodeExecution;
+}
+
+const Program::SuperinstructionSet* Environment::getSuperinstructions() const
+{
+    return this->superinstructions.get();
+}
+
+const std::vector<uint64_t>& Environment::getOperandDataSources(
+    uint64_t instructionIndex, uint64_t operandIndex) const
+{
+    return this->operandDataSources.at(instructionIndex).at(operandIndex);
+}
+
+size_t Environment::getOperandAddressSpace(uint64_t instructionIndex,
+                                           uint64_t operandIndex,
+                                           uint64_t dataSourceIndex) const
+{
+    return this->operandAddressSpaces.at(instructionIndex)
+        .at(operandIndex)
+        .at(dataSourceIndex);
+}
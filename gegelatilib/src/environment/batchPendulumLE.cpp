@@ -0,0 +1,245 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <cmath>
+#include <stdexcept>
+
+#include "data/hash.h"
+#include "environment/batchPendulumLE.h"
+
+BatchPendulumLE::BatchPendulumLE(const std::vector<double>& actions,
+                                 size_t nbLanes)
+    : BatchLearningEnvironment(actions.size() * 2 + 1, nbLanes),
+      actionTorques(actions.size() * 2 + 1, 0.0),
+      angles(nbLanes, 0.0), velocities(nbLanes, 0.0), torques(nbLanes, 0.0),
+      rewards(nbLanes, 0.0), totalRewards(nbLanes, 0.0),
+      rewardWindowSums(nbLanes, 0.0),
+      rewardHistories(nbLanes * PendulumLE::REWARD_HISTORY_SIZE, 0.0),
+      nbActionsExecuted(nbLanes, 0), terminalMask(nbLanes, 1),
+      laneStates(nbLanes, Data::PrimitiveTypeArray<double>(2))
+{
+    // Precompute the torque associated to each action ID, as in the
+    // PendulumLE::getActionFromID() method.
+    for (size_t actionID = 1; actionID < this->actionTorques.size();
+         actionID++) {
+        double torque = actions.at((actionID - 1) % actions.size());
+        torque = (actionID <= actions.size()) ? torque : -torque;
+        this->actionTorques.at(actionID) = torque * PendulumLE::MAX_TORQUE;
+    }
+}
+
+BatchPendulumLE::BatchPendulumLE(PendulumLE& le, size_t nbLanes)
+    : BatchPendulumLE(le.getAvailableActions(), nbLanes)
+{
+    // Lane states are copies of the PendulumLE state to share its id.
+    const Data::PrimitiveTypeArray<double>& state =
+        (const Data::PrimitiveTypeArray<double>&)le.getDataSources().at(0)
+            .get();
+    this->laneStates.clear();
+    this->laneStates.resize(nbLanes, state);
+}
+
+bool BatchPendulumLE::isCopyable() const
+{
+    return true;
+}
+
+Learn::BatchLearningEnvironment* BatchPendulumLE::clone() const
+{
+    return new BatchPendulumLE(*this);
+}
+
+void BatchPendulumLE::updateLaneState(size_t lane)
+{
+    Data::PrimitiveTypeArray<double>& state = this->laneStates[lane];
+    state.setDataAt(typeid(double), 0, this->angles[lane]);
+    state.setDataAt(typeid(double), 1, this->velocities[lane]);
+}
+
+void BatchPendulumLE::reset(size_t lane, size_t seed, Learn::LearningMode mode,
+                            uint16_t iterationNumber, uint64_t generationNumber)
+{
+    // Same initialization as the PendulumLE
+    size_t hashSeed = Data::Hash<size_t>()(seed) ^
+                      Data::Hash<Learn::LearningMode>()(mode);
+    this->rng.setSeed(hashSeed);
+
+    this->angles.at(lane) =
+        this->rng.getDouble(-PendulumLE::PI, PendulumLE::PI);
+    this->velocities.at(lane) = this->rng.getDouble(-1.0, 1.0);
+    this->totalRewards.at(lane) = 0.0;
+    this->rewardWindowSums.at(lane) = 0.0;
+    this->nbActionsExecuted.at(lane) = 0;
+    this->terminalMask.at(lane) = 0;
+    this->updateLaneState(lane);
+}
+
+void BatchPendulumLE::resetAll(const std::vector<size_t>& seeds,
+                               Learn::LearningMode mode,
+                               uint16_t iterationNumber,
+                               uint64_t generationNumber)
+{
+    if (seeds.size() > this->nbLanes) {
+        throw std::runtime_error("More seeds than lanes were given to reset "
+                                 "the BatchPendulumLE.");
+    }
+
+    for (size_t lane = 0; lane < seeds.size(); lane++) {
+        this->reset(lane, seeds[lane], mode, iterationNumber,
+                    generationNumber);
+    }
+
+    // Freeze remaining lanes
+    for (size_t lane = seeds.size(); lane < this->nbLanes; lane++) {
+        this->terminalMask[lane] = 1;
+    }
+}
+
+void BatchPendulumLE::doActions(const std::vector<uint64_t>& actionIDs)
+{
+    if (actionIDs.size() != this->nbLanes) {
+        throw std::runtime_error("The number of action IDs does not match the "
+                                 "number of lanes of the BatchPendulumLE.");
+    }
+
+    // Gather the torques of all lanes.
+    for (size_t lane = 0; lane < this->nbLanes; lane++) {
+        this->torques[lane] = (this->terminalMask[lane] != 0)
+                                  ? 0.0
+                                  : this->actionTorques.at(actionIDs[lane]);
+    }
+
+    // Update the state of all lanes.
+    // The loop is branchless: the state of all lanes is computed, and only
+    // non-frozen lanes are updated, to ease its vectorization.
+    double* angle = this->angles.data();
+    double* velocity = this->velocities.data();
+    double* reward = this->rewards.data();
+    const double* torque = this->torques.data();
+    const uint8_t* frozen = this->terminalMask.data();
+    for (size_t lane = 0; lane < this->nbLanes; lane++) {
+        double newAngle = angle[lane];
+        double newVelocity = velocity[lane];
+        reward[lane] =
+            PendulumLE::computeReward(newAngle, newVelocity, torque[lane]);
+        PendulumLE::computeNextState(newAngle, newVelocity, torque[lane]);
+        angle[lane] = (frozen[lane] != 0) ? angle[lane] : newAngle;
+        velocity[lane] = (frozen[lane] != 0) ? velocity[lane] : newVelocity;
+    }
+
+    // Accumulate rewards and update the terminal mask.
+    const size_t historySize = PendulumLE::REWARD_HISTORY_SIZE;
+    for (size_t lane = 0; lane < this->nbLanes; lane++) {
+        if (this->terminalMask[lane] != 0) {
+            continue;
+        }
+
+        double* history = this->rewardHistories.data() + lane * historySize;
+        uint64_t& nbActions = this->nbActionsExecuted[lane];
+        double& windowSum = this->rewardWindowSums[lane];
+
+        size_t historyIdx = nbActions % historySize;
+        if (nbActions >= historySize) {
+            windowSum -= history[historyIdx];
+        }
+        history[historyIdx] = reward[lane];
+        windowSum += reward[lane];
+        nbActions++;
+        this->totalRewards[lane] += reward[lane];
+
+        // Recompute the window sum from scratch when the history wraps
+        // around, as in the PendulumLE.
+        if (nbActions % historySize == 0) {
+            windowSum = 0.0;
+            for (size_t idx = 0; idx < historySize; idx++) {
+                windowSum += history[idx];
+            }
+        }
+
+        this->terminalMask[lane] = this->isTerminal(lane) ? 1 : 0;
+        this->updateLaneState(lane);
+    }
+}
+
+const std::vector<uint8_t>& BatchPendulumLE::getTerminalMask() const
+{
+    return this->terminalMask;
+}
+
+bool BatchPendulumLE::isTerminal(size_t lane) const
+{
+    return this->nbActionsExecuted.at(lane) >=
+               PendulumLE::REWARD_HISTORY_SIZE &&
+           fabs(this->rewardWindowSums[lane] /
+                (double)PendulumLE::REWARD_HISTORY_SIZE) <
+               PendulumLE::STABILITY_THRESHOLD;
+}
+
+double BatchPendulumLE::getScore(size_t lane) const
+{
+    if (this->isTerminal(lane)) {
+        return 10.0 / std::log(((double)this->nbActionsExecuted[lane] -
+                                (double)PendulumLE::REWARD_HISTORY_SIZE +
+                                2.0));
+    }
+    else {
+        return this->totalRewards[lane] /
+               (double)this->nbActionsExecuted[lane];
+    }
+}
+
+double BatchPendulumLE::getAngle(size_t lane) const
+{
+    return this->angles.at(lane);
+}
+
+double BatchPendulumLE::getVelocity(size_t lane) const
+{
+    return this->velocities.at(lane);
+}
+
+uint64_t BatchPendulumLE::getNbActionsExecuted(size_t lane) const
+{
+    return this->nbActionsExecuted.at(lane);
+}
+
+std::vector<std::reference_wrapper<const Data::DataHandler>> BatchPendulumLE::
+    getDataSources(size_t lane)
+{
+    std::vector<std::reference_wrapper<const Data::DataHandler>> result;
+    result.push_back(this->laneStates.at(lane));
+    return result;
+}
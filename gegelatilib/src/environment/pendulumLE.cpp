@@ -1,17 +1,7 @@
-#define _USE_MATH_DEFINES // To get M_PI
-#include <math.h>
+#include <cmath>
 
 #include "environment/pendulumLE.h"
 
-const double PendulumLE::MAX_SPEED = 8.0;
-const double PendulumLE::MAX_TORQUE = 2.0;
-const double PendulumLE::TIME_DELTA = 0.05;
-const double PendulumLE::G = 9.81;
-const double PendulumLE::MASS = 1.0;
-const double PendulumLE::LENGTH = 1.0;
-const double PendulumLE::STABILITY_THRESHOLD = 0.1;
-
-
 void PendulumLE::setAngle(double newValue)
 {
     this->currentState.setDataAt(typeid(double), 0, newValue);
@@ -24,12 +14,22 @@ void PendulumLE::setVelocity(double newValue)
 
 double PendulumLE::getAngle() const
 {
-    return *this->currentState.getDataAt(typeid(const double), 0).getSharedPointer<const double>();
+    return this->currentState.getNativeDataAt(0);
 }
 
 double PendulumLE::getVelocity() const
 {
-    return *this->currentState.getDataAt(typeid(const double), 1).getSharedPointer<const double>();;
+    return this->currentState.getNativeDataAt(1);
+}
+
+uint64_t PendulumLE::getNbActionsExecuted() const
+{
+    return this->nbActionsExecuted;
+}
+
+const std::vector<double>& PendulumLE::getAvailableActions() const
+{
+    return this->availableActions;
 }
 
 std::vector<std::reference_wrapper<const Data::DataHandler>> PendulumLE::getDataSources()
@@ -54,10 +54,11 @@ void PendulumLE::reset(size_t seed, Learn::LearningMode mode, uint16_t iteration
        }*/
 
     // Set initial state
-    this->setAngle(this->rng.getDouble(-M_PI, M_PI));
+    this->setAngle(this->rng.getDouble(-PendulumLE::PI, PendulumLE::PI));
     this->setVelocity(this->rng.getDouble(-1.0, 1.0));
     this->nbActionsExecuted = 0;
     this->totalReward = 0.0;
+    this->rewardWindowSum = 0.0;
 }
 
 void PendulumLE::reset(double initialAngle, double initialVelocity){
@@ -82,21 +83,28 @@ void PendulumLE::doAction(uint64_t actionID)
     double velocity = this->getVelocity();
 
     // Compute current reward
-    double angleToUpward = fmod((angle + M_PI), (2.f * M_PI)) - M_PI;
-    double reward = -((angleToUpward * angleToUpward) + 0.1f * (velocity * velocity) + 0.001f * (currentAction * currentAction));
+    double reward = PendulumLE::computeReward(angle, velocity, currentAction);
 
     // Store and accumulate reward
-    this->rewardHistory[this->nbActionsExecuted % REWARD_HISTORY_SIZE] = reward;
+    size_t historyIdx = this->nbActionsExecuted % REWARD_HISTORY_SIZE;
+    if (this->nbActionsExecuted >= REWARD_HISTORY_SIZE) {
+        this->rewardWindowSum -= this->rewardHistory[historyIdx];
+    }
+    this->rewardHistory[historyIdx] = reward;
+    this->rewardWindowSum += reward;
     this->nbActionsExecuted++;
     this->totalReward += reward;
 
-    // Update angular velocity
-    velocity = velocity + ((-3.0) * G / (2.0 * LENGTH) * (sin(angle + M_PI)) +
-                           (3.f / (MASS * LENGTH * LENGTH)) * currentAction) * TIME_DELTA;
-    velocity = std::fmin(std::fmax(velocity, -MAX_SPEED), MAX_SPEED);
+    // Recompute the window sum from scratch when the history wraps around.
+    if (this->nbActionsExecuted % REWARD_HISTORY_SIZE == 0) {
+        this->rewardWindowSum = 0.0;
+        for (size_t idx = 0; idx < PendulumLE::REWARD_HISTORY_SIZE; idx++) {
+            this->rewardWindowSum += this->rewardHistory[idx];
+        }
+    }
 
-    // Update angle
-    angle = angle + velocity * TIME_DELTA;
+    // Update angular velocity and angle
+    PendulumLE::computeNextState(angle, velocity, currentAction);
 
     // Save new pendulum state
     this->setAngle(angle);
@@ -127,21 +135,10 @@ double PendulumLE::getScore() const
 
 bool PendulumLE::isTerminal() const
 {
-    bool result = false;
-
-    // Is the history long enough to check stability
-    if (this->nbActionsExecuted >= PendulumLE::REWARD_HISTORY_SIZE) {
-        // Compute mean reward
-        double accumulatedReward = 0.0;
-        for (auto idx = 0; idx < PendulumLE::REWARD_HISTORY_SIZE; idx++) {
-            accumulatedReward += this->rewardHistory[idx];
-        }
-        accumulatedReward /= (double)PendulumLE::REWARD_HISTORY_SIZE;
-
-        // Check stability
-        result = (fabs(accumulatedReward) < PendulumLE::STABILITY_THRESHOLD);
-    }
-
-    // The history is too short, or the pendulum was not stabilized.
-    return result;
+    // Is the history long enough to check stability, and is the mean reward
+    // of the window below the threshold.
+    return this->nbActionsExecuted >= PendulumLE::REWARD_HISTORY_SIZE &&
+           fabs(this->rewardWindowSum /
+                (double)PendulumLE::REWARD_HISTORY_SIZE) <
+               PendulumLE::STABILITY_THRESHOLD;
 }
@@ -186,6 +186,10 @@ void File::ParametersParser::setParameterFromString(
         params.archivingProbability = value.asDouble();
         return;
     }
+    if (param == "archiveDeltaSnapshots") {
+        params.archiveDeltaSnapshots = value.asBool();
+        return;
+    }
     if (param == "nbIterationsPerPolicyEvaluation") {
         params.nbIterationsPerPolicyEvaluation = value.asUInt64();
         return;
@@ -265,6 +269,11 @@ void File::ParametersParser::writeParametersToJson(
         Learn::LearningParameters::archivingProbabilityComment,
         Json::commentBefore);
 
+    root["archiveDeltaSnapshots"] = params.archiveDeltaSnapshots;
+    root["archiveDeltaSnapshots"].setComment(
+        Learn::LearningParameters::archiveDeltaSnapshotsComment,
+        Json::commentBefore);
+
     root["doValidation"] = params.doValidation;
     root["doValidation"].setComment(
         Learn::LearningParameters::doValidationComment, Json::commentBefore);
@@ -144,6 +144,7 @@ void File::TPGGraphDotImporter::readLine(std::smatch& matches)
                 }
             }
             p->identifyIntrons();
+            p->optimize();
         }
     }
 }
@@ -93,6 +93,11 @@ double Instruction::execute(
 #endif
 }
 
+Instruction::ScalarFunction Instruction::getScalarFunction() const
+{
+    return nullptr;
+}
+
 #ifdef CODE_GENERATION
 
 Instruction::Instruction(std::string printTemplate)
@@ -1,16 +1,17 @@
+#include <algorithm>
+#include <atomic>
 #include <inttypes.h>
-#include <queue>
 #include <map>
+#include <queue>
+#include <thread>
 
 #include "data/hash.h"
-#include "environment/pendulumLE.h"
 #include "learn/evaluationResult.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
 #include "tpg/tpgExecutionEngine.h"
 
 #include "learn/CLagent.h"
-#define DECAY_THRESHOLD 0
 
 double Learn::CLagent::calculateWeightDecay(double numScores) const
 {
@@ -24,190 +25,229 @@ double Learn::CLagent::calculateWeightDecay(double numScores) const
     }
 }
 
-std::shared_ptr<Learn::EvaluationResult> Learn::CLagent::evaluateJobCL(
-    TPG::TPGExecutionEngine& tee, const Job& job, const Job& previousJob, uint64_t generationNumber,
-    Learn::LearningMode mode, LearningEnvironment& le)
+double Learn::CLagent::evaluateEpisodeCL(TPG::TPGExecutionEngine& tee,
+                                         const Job& job,
+                                         uint16_t iterationNumber,
+                                         bool isChainStart,
+                                         uint64_t generationNumber,
+                                         Learn::LearningMode mode,
+                                         LearningEnvironment& le) const
 {
     // Only consider the first root of jobs as we are not in adversarial mode
     const TPG::TPGVertex* root = job.getRoot();
 
+    // Reset the learning Environment at the beginning of a chain only.
+    // Otherwise, the root starts from the state left by the previous one.
+    if (isChainStart) {
+        Data::Hash<uint64_t> hasher;
+        uint64_t hash = hasher(generationNumber) ^ hasher(iterationNumber);
+        le.reset(hash, mode, iterationNumber, generationNumber);
+    }
+
+    uint64_t nbActions = 0;
+    while (!le.isTerminal() && nbActions < this->params.maxNbActionsPerEval) {
+        // Get the action
+        uint64_t actionID =
+            ((const TPG::TPGAction*)tee.executeFromRoot(*root).back())
+                ->getActionID();
+        // Do it
+        le.doAction(actionID);
+        // Count actions
+        nbActions++;
+    }
+
+    // Weight the score of roots continuing the episode of another one.
+    double score = le.getScore();
+    if (job.getIdx() != 0) {
+        score *= 1.0 - this->calculateWeightDecay(
+                           (double)this->params.maxNbActionsPerEval);
+    }
+    return score;
+}
+
+std::shared_ptr<Learn::EvaluationResult> Learn::CLagent::evaluateJobCL(
+    TPG::TPGExecutionEngine& tee, const Job& job, uint64_t generationNumber,
+    Learn::LearningMode mode, LearningEnvironment& le) const
+{
     // Skip the root evaluation process if enough evaluations were already
     // performed. In the evaluation mode only.
     std::shared_ptr<Learn::EvaluationResult> previousEval;
     if (mode == LearningMode::TRAINING &&
-        this->isRootEvalSkipped(*root, previousEval)) {
+        this->isRootEvalSkipped(*job.getRoot(), previousEval)) {
         return previousEval;
     }
 
-    // Init
+    // Evaluate nbIteration times, each from a reset LearningEnvironment
     double result = 0.0;
-    double prevOutcome;
-    std::vector<double> previousScores;
-    std::vector<double> earlyScores;
-    double numScores = 0.0;
-    static double angleSet;
-    static double veloSet;
-    double scoreFromLast = 0.0;
-    double earlyRes;
-
-
-    // Initialize vars
+    double squaredResult = 0.0;
+    for (uint16_t iterationNumber = 0;
+         iterationNumber < this->params.nbIterationsPerPolicyEvaluation;
+         iterationNumber++) {
+        double score = this->evaluateEpisodeCL(tee, job, iterationNumber, true,
+                                               generationNumber, mode, le);
+        result += score;
+        squaredResult += score * score;
+    }
 
-    double sum;
+    // Compute the average score and its variance
+    double mean = result / (double)params.nbIterationsPerPolicyEvaluation;
+    double variance = std::max(
+        0.0, squaredResult / (double)params.nbIterationsPerPolicyEvaluation -
+                 mean * mean);
 
-    for (auto iterationNumber = 0; iterationNumber < this->params.nbIterationsPerPolicyEvaluation; iterationNumber++) {
-        prevOutcome = 0.0;
-        if (job.getIdx() == 0){
-            // Compute a Hash
-            Data::Hash<uint64_t> hasher;
-            uint64_t hash = hasher(generationNumber) ^ hasher(iterationNumber); //le.init(seed) en gros
+    // Create the EvaluationResult
+    auto evaluationResult = std::shared_ptr<EvaluationResult>(
+        new EvaluationResult(mean, params.nbIterationsPerPolicyEvaluation,
+                             variance));
 
-            // Reset the learning Environment
-            le.reset(hash, mode, iterationNumber, generationNumber);
-        }
+    // Combine it with previous one if any
+    if (previousEval != nullptr) {
+        *evaluationResult += *previousEval;
+    }
+    return evaluationResult;
+}
 
-        else {
-            std::vector<stateEOE> retrievedVec;
-            retrievedVec.reserve(this->params.nbIterationsPerPolicyEvaluation);
-            retrievedVec = previousJob.getVecStateEOE();
-            double resetAngle = retrievedVec[iterationNumber].angle;
-            double resetVelocity = retrievedVec[iterationNumber].velocity;
+void Learn::CLagent::evaluateChainCL(
+    TPG::TPGExecutionEngine& tee, uint16_t iterationNumber,
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const std::vector<bool>& skipped, uint64_t generationNumber,
+    Learn::LearningMode mode, LearningEnvironment& le,
+    std::vector<double>& scoreTable, Archive* archive) const
+{
+    const uint16_t nbIterations = this->params.nbIterationsPerPolicyEvaluation;
+    Data::Hash<uint64_t> hasher;
 
-            ((PendulumLE &) le).reset(resetAngle, resetVelocity);
+    bool isChainStart = true;
+    for (size_t jobIdx = 0; jobIdx < jobs.size(); jobIdx++) {
+        if (skipped.at(jobIdx)) {
+            continue;
         }
-        uint64_t nbActions = 0;
-        while (!le.isTerminal() &&
-               nbActions < this->params.maxNbActionsPerEval) {
-            // Get the action
-            uint64_t actionID =
-                ((const TPG::TPGAction*)tee.executeFromRoot(*root).back())
-                    ->getActionID();
-
-            le.doAction(actionID);
-            nbActions++;
-#ifdef DECAY_THRESHOLD
-            if (nbActions < this->params.decayThreshold){
-                earlyScores.push_back(le.getScore());
 
-            }
-#endif
+        const Job& job = *jobs.at(jobIdx);
+        if (archive != NULL) {
+            archive->setRandomSeed(job.getArchiveSeed() ^
+                                   hasher(iterationNumber));
         }
-#ifdef DECAY_THRESHOLD
-        if (job.getIdx() == 0){
-            prevOutcome += le.getScore();
-            previousScores.push_back(prevOutcome);
-            if (!previousScores.empty()) {
-                scoreFromLast = previousScores.back();
-            } else {
-                std::cerr << "problem with previous score : empty" << std::endl;
-            }
-        }
-#else
-        prevOutcome += le.getScore();
-        previousScores.push_back(prevOutcome);
-#endif
-#ifdef DECAY_THRESHOLD
-        else {
 
-            numScores = this->params.maxNbActionsPerEval;
-            double lastScoreInf = calculateWeightDecay(numScores);
-            double lastScoreWeighted = scoreFromLast * lastScoreInf;
-            prevOutcome = le.getScore() * (1-lastScoreInf) + lastScoreWeighted;
-            previousScores.push_back(prevOutcome);
-            double sumEarly = 0.0;
+        scoreTable.at(jobIdx * nbIterations + iterationNumber) =
+            this->evaluateEpisodeCL(tee, job, iterationNumber, isChainStart,
+                                    generationNumber, mode, le);
+        isChainStart = false;
+    }
+}
 
-            for (int i = 0; i < earlyScores.size(); ++i) {
-                sumEarly += earlyScores[i] * (1-lastScoreInf) + lastScoreWeighted;
-            }
-            double avgEarly = sumEarly/earlyScores.size();
+std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
+Learn::CLagent::evaluateAllRootsCL(uint64_t generationNumber,
+                                   Learn::LearningMode mode)
+{
+    const uint16_t nbIterations = this->params.nbIterationsPerPolicyEvaluation;
+
+    // Create the jobs, in the order of roots, and identify the roots whose
+    // evaluation is skipped.
+    auto roots = this->tpg->getRootVertices();
+    std::vector<std::shared_ptr<Job>> jobs;
+    std::vector<bool> skipped(roots.size(), false);
+    std::vector<std::shared_ptr<EvaluationResult>> previousEvals(roots.size());
+    for (size_t i = 0; i < roots.size(); i++) {
+        jobs.push_back(this->makeJob(roots.at(i), mode, (int)i));
+        if (mode == LearningMode::TRAINING) {
+            skipped.at(i) =
+                this->isRootEvalSkipped(*roots.at(i), previousEvals.at(i));
+        }
+    }
 
-            earlyRes = avgEarly;
+    // Preallocated table of scores, and one Archive shard per chain in
+    // training mode.
+    std::vector<double> scoreTable(jobs.size() * nbIterations, 0.0);
+    ShardedArchive shardedArchive(params.archiveSize,
+                                  params.archivingProbability,
+                                  params.archiveDeltaSnapshots);
+    std::vector<Archive*> archives;
+    if (mode == LearningMode::TRAINING) {
+        for (uint16_t i = 0; i < nbIterations; i++) {
+            archives.push_back(&shardedArchive.getShard(i));
         }
-#endif
+    }
 
-        std::vector<stateEOE> vecPrev(this->params.nbIterationsPerPolicyEvaluation);
-        vecPrev[iterationNumber].angle = ((PendulumLE &) le).getAngle();
-        vecPrev[iterationNumber].velocity = ((PendulumLE &) le).getVelocity();
-        job.setVecStateEOE(vecPrev);
+    // Chains are handed out to threads in increasing iteration order.
+    std::atomic<uint16_t> nextChain(0);
+    auto evaluateChains = [&](LearningEnvironment& le, Environment& env) {
+        std::unique_ptr<TPG::TPGExecutionEngine> tee =
+            this->tpg->getFactory().createTPGExecutionEngine(env, NULL);
+        uint16_t iterationNumber;
+        while ((iterationNumber = nextChain++) < nbIterations) {
+            Archive* archive =
+                archives.empty() ? NULL : archives.at(iterationNumber);
+            tee->setArchive(archive);
+            this->evaluateChainCL(*tee, iterationNumber, jobs, skipped,
+                                  generationNumber, mode, le, scoreTable,
+                                  archive);
+        }
+    };
 
-        //        rootRes.push_back(result);
-    }
-    sum = 0.0;
-    for (int i = 0; i < previousScores.size(); ++i) {
-        sum += previousScores[i];
+    uint64_t nbThreads =
+        std::min(this->maxNbThreads, (uint64_t)nbIterations);
+    if (nbThreads <= 1 || !this->learningEnvironment.isCopyable()) {
+        evaluateChains(this->learningEnvironment, this->env);
     }
-    result = sum;
+    else {
+        // Each thread works with its own copy of the LearningEnvironment.
+        std::vector<std::unique_ptr<LearningEnvironment>> privateLEs;
+        std::vector<std::unique_ptr<Environment>> privateEnvs;
+        for (uint64_t i = 1; i < nbThreads; i++) {
+            privateLEs.emplace_back(this->learningEnvironment.clone());
+            privateEnvs.emplace_back(new Environment(
+                this->env.getInstructionSet(),
+                privateLEs.back()->getDataSources(),
+                this->env.getNbRegisters(), this->env.getNbConstant()));
+        }
 
-    /*
-    // Create the EvaluationResult
-    auto evaluationResult =
-        std::shared_ptr<EvaluationResult>(new EvaluationResult(
-            result / (double)params.nbIterationsPerPolicyEvaluation,
-            params.nbIterationsPerPolicyEvaluation));
+        std::vector<std::thread> threads;
+        for (uint64_t i = 0; i < nbThreads - 1; i++) {
+            threads.emplace_back(evaluateChains, std::ref(*privateLEs.at(i)),
+                                 std::ref(*privateEnvs.at(i)));
+        }
 
-    // Combine it with previous one if any
-    if (previousEval != nullptr) {
-        *evaluationResult += *previousEval;
-    }
-    return evaluationResult;
-    */
+        // Work in the main thread also, using the main environment
+        evaluateChains(this->learningEnvironment, this->env);
 
-    //    }
-    // Create the EvaluationResult
-    //    if(!evalPassed) {
-    auto evaluationResult = std::shared_ptr<EvaluationResult>(
-        new EvaluationResult(result/ (double)previousScores.size(), params.nbIterationsPerPolicyEvaluation));
-    // Combine it with previous one if any
-    if (previousEval != nullptr) {
-        *evaluationResult += *previousEval;
+        // Join the threads
+        for (auto& thread : threads) {
+            thread.join();
+        }
     }
 
-    return evaluationResult;
-    //  }
-    /*   else{
-         auto evaluationResult = std::shared_ptr<EvaluationResult>(
-             new EvaluationResult(rootRes.end()[-1]/ (double)params.nbIterationsPerPolicyEvaluation, params.nbIterationsPerPolicyEvaluation));
-         // Combine it with previous one if any
-         if (previousEval != nullptr) {
-             *evaluationResult += *previousEval;
-         }
-         evalPassed = true;
-         return evaluationResult;
-     }*/
-}
-
-std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
-Learn::CLagent::evaluateAllRootsCL(uint64_t generationNumber,
-                                   Learn::LearningMode mode)
-{
+    // Compile the results of each root in the order of jobs.
     std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
         result;
+    for (size_t jobIdx = 0; jobIdx < jobs.size(); jobIdx++) {
+        if (skipped.at(jobIdx)) {
+            result.emplace(previousEvals.at(jobIdx), roots.at(jobIdx));
+            continue;
+        }
 
-    // Create the TPGExecutionEngine for this evaluation.
-    // The engine uses the Archive only in training mode.
-    std::unique_ptr<TPG::TPGExecutionEngine> tee =
-        this->tpg->getFactory().createTPGExecutionEngine(
-            this->env,
-            (mode == LearningMode::TRAINING) ? &this->archive : NULL);
-
-    auto roots = tpg->getRootVertices();
-
-
-    std::map<int, const TPG::TPGVertex*> rootIndexMap; // or std::unordered_map<int, TPGVertex*> if order doesn't matter
-
-    // Associate each root vertex with an integer index
-    std::shared_ptr<Learn::Job> previousJob=nullptr;
-    for (int i = 0; i < roots.size(); i++) {
-        rootIndexMap[i] = roots[i];
-        int index = i;
-        auto job = makeJob(roots.at(i), mode, index);
-        this->archive.setRandomSeed(job->getArchiveSeed());
-        std::shared_ptr<EvaluationResult> avgScore = this->evaluateJobCL(
-            *tee, *job, *previousJob, generationNumber, mode, this->learningEnvironment);
-        result.emplace(avgScore, (*job).getRoot());
-        previousJob = job;
+        double sum = 0.0;
+        double squaredSum = 0.0;
+        for (uint16_t i = 0; i < nbIterations; i++) {
+            double score = scoreTable.at(jobIdx * nbIterations + i);
+            sum += score;
+            squaredSum += score * score;
+        }
+        double mean = sum / (double)nbIterations;
+        double variance =
+            std::max(0.0, squaredSum / (double)nbIterations - mean * mean);
+
+        auto evaluationResult = std::shared_ptr<EvaluationResult>(
+            new EvaluationResult(mean, nbIterations, variance));
+        if (previousEvals.at(jobIdx) != nullptr) {
+            *evaluationResult += *previousEvals.at(jobIdx);
+        }
+        result.emplace(evaluationResult, roots.at(jobIdx));
     }
 
+    // Merge the archives of chains in the order of iterations.
+    this->mergeShardedArchive(shardedArchive);
+
     return result;
 }
 
@@ -97,3 +97,12 @@ size_t Learn::AdversarialEvaluationResult::getSize() const
 {
     return scores.size();
 }
+
+Util::MemoryFootprint Learn::AdversarialEvaluationResult::getMemoryFootprint()
+    const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(AdversarialEvaluationResult));
+    footprint.add("scores", Util::MemoryFootprint::getHeapBytes(this->scores));
+    return footprint;
+}
@@ -34,46 +34,199 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
+#include <numeric>
+#include <thread>
 
 #include "learn/adversarialLearningAgent.h"
+#include "log/perfCounters.h"
+#include "log/traceRecorder.h"
 
-std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
-Learn::AdversarialLearningAgent::evaluateAllRoots(uint64_t generationNumber,
-                                                  Learn::LearningMode mode)
+void Learn::AdversarialLearningAgent::evaluateAllRootsInTable(
+    uint64_t generationNumber, Learn::LearningMode mode,
+    EvaluationTable& table)
 {
     // exception if LE is not cloneable and if there are several threads to use
     if (!this->learningEnvironment.isCopyable() && this->maxNbThreads > 1) {
         throw std::runtime_error(
             "Max number of threads for a non copyable environment is 1.");
     }
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
-        results;
-    evaluateAllRootsInParallel(generationNumber, mode, results);
-    return results;
+    table.clear();
+    evaluateAllMatches(generationNumber, mode, table);
+}
+
+void Learn::AdversarialLearningAgent::updateChampions(
+    const EvaluationTable& table)
+{
+    // Rows by decreasing score, the last row first among equal scores.
+    std::vector<size_t> rows(table.getNbRows());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::sort(rows.begin(), rows.end(), [&table](size_t a, size_t b) {
+        if (table.getScore(a) != table.getScore(b)) {
+            return table.getScore(b) < table.getScore(a);
+        }
+        return b < a;
+    });
+
+    champions.clear();
+    for (int i = 0; i <= (1.0 - params.ratioDeletedRoots) *
+                             (double)tpg->getNbRootVertices() -
+                         1.0 &&
+                    i < rows.size();
+         i++) {
+        champions.emplace_back(table.getRoot(rows.at(i)));
+    }
+}
+
+void Learn::AdversarialLearningAgent::evaluateAllMatches(
+    uint64_t generationNumber, Learn::LearningMode mode,
+    EvaluationTable& table)
+{
+    MatchTable matchTable = this->makeMatchTable(mode);
+    const size_t nbMatches = matchTable.getNbMatches();
+    const size_t nbSeats = matchTable.getNbSeats();
+
+    // Dense storage of the average score of each seat of each match, and of
+    // the number of evaluations of each match.
+    std::vector<double> matchScores(nbMatches * nbSeats, 0.0);
+    std::vector<size_t> matchNbEvaluations(nbMatches, 0);
+
+    // Dedicated archive shard for each match, in training mode only.
+    ShardedArchive shardedArchive(params.archiveSize,
+                                  params.archivingProbability,
+                                  params.archiveDeltaSnapshots);
+
+    // Contiguous blocks of the schedule are distributed among threads, so
+    // that consecutive matches of a thread involve the same opponents.
+    const std::vector<size_t> schedule = matchTable.getSchedule();
+    const uint64_t nbThreads = std::max(
+        (uint64_t)1, std::min(this->maxNbThreads, (uint64_t)nbMatches));
+    const size_t blockSize =
+        std::max((size_t)1, nbMatches / (size_t)(nbThreads * 4));
+    std::atomic<size_t> nextBlock(0);
+
+    auto playMatches = [&](LearningEnvironment& le, Environment& env) {
+        Log::PerfCounterScope perfCounterScope;
+        std::unique_ptr<TPG::TPGExecutionEngine> tee =
+            this->tpg->getFactory().createTPGExecutionEngine(env, NULL);
+        auto& ale = (AdversarialLearningEnvironment&)le;
+        std::vector<const TPG::TPGVertex*> participants;
+
+        size_t first;
+        while ((first = (nextBlock++) * blockSize) < nbMatches) {
+            size_t last = std::min(first + blockSize, nbMatches);
+            GEGELATI_TRACE_SPAN("evaluateMatchBlock", (int64_t)first);
+            for (size_t pos = first; pos < last; pos++) {
+                size_t matchIdx = schedule[pos];
+
+                tee->setArchive((mode == LearningMode::TRAINING)
+                                    ? &shardedArchive.getShard(
+                                          matchIdx,
+                                          matchTable.getArchiveSeed(matchIdx))
+                                    : NULL);
+
+                matchTable.getMatchParticipants(matchIdx, participants);
+                AdversarialEvaluationResult result(nbSeats);
+                this->evaluateMatch(*tee, participants, generationNumber,
+                                    mode, ale, result);
+
+                for (size_t seat = 0; seat < nbSeats; seat++) {
+                    matchScores[matchIdx * nbSeats + seat] =
+                        result.getScoreOf(seat);
+                }
+                matchNbEvaluations[matchIdx] = result.getNbEvaluation();
+            }
+        }
+    };
+
+    if (nbThreads <= 1) {
+        playMatches(this->learningEnvironment, this->env);
+    }
+    else {
+        // Each thread works with its own copy of the LearningEnvironment.
+        std::vector<std::unique_ptr<LearningEnvironment>> privateLEs;
+        std::vector<std::unique_ptr<Environment>> privateEnvs;
+        for (uint64_t i = 1; i < nbThreads; i++) {
+            privateLEs.emplace_back(this->learningEnvironment.clone());
+            privateEnvs.emplace_back(new Environment(
+                this->env.getInstructionSet(),
+                privateLEs.back()->getDataSources(),
+                this->env.getNbRegisters(), this->env.getNbConstant()));
+        }
+
+        std::vector<std::thread> threads;
+        for (uint64_t i = 0; i < nbThreads - 1; i++) {
+            threads.emplace_back(playMatches, std::ref(*privateLEs.at(i)),
+                                 std::ref(*privateEnvs.at(i)));
+        }
+
+        // Work in the main thread also, using the main environment
+        playMatches(this->learningEnvironment, this->env);
+
+        // Join the threads
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Accumulate the scores of matches per participant, in the order of
+    // matches. If there is a studied seat in a match, only the score of this
+    // seat is accumulated. The reason is that when roots face champions, the
+    // champions shouldn't have their scores updated, or as they encounter
+    // many unskilled roots they will always have a high score.
+    std::vector<double> scoreSums(matchTable.getNbParticipants(), 0.0);
+    std::vector<size_t> nbEvaluations(matchTable.getNbParticipants(), 0);
+    for (size_t matchIdx = 0; matchIdx < nbMatches; matchIdx++) {
+        int16_t studiedSeat = matchTable.getStudiedSeat(matchIdx);
+        size_t firstSeat = (studiedSeat == -1) ? 0 : (size_t)studiedSeat;
+        size_t lastSeat = (studiedSeat == -1) ? nbSeats : firstSeat + 1;
+        for (size_t seat = firstSeat; seat < lastSeat; seat++) {
+            uint32_t participant = matchTable.getParticipantIdx(matchIdx, seat);
+            scoreSums[participant] += matchScores[matchIdx * nbSeats + seat] *
+                                      (double)matchNbEvaluations[matchIdx];
+            nbEvaluations[participant] += matchNbEvaluations[matchIdx];
+        }
+    }
+
+    // Fill the results in the order of roots of the TPGGraph.
+    for (auto root : tpg->getRootVertices()) {
+        uint32_t participant = matchTable.findParticipant(root);
+        if (nbEvaluations[participant] == 0) {
+            throw std::runtime_error(
+                "A root of the TPGGraph was evaluated in no match.");
+        }
+        table.addRow(root,
+                     scoreSums[participant] /
+                         (double)nbEvaluations[participant],
+                     nbEvaluations[participant]);
+    }
+
+    this->updateChampions(table);
+
+    // Merge the archives in the order of matches
+    this->mergeShardedArchive(shardedArchive);
 }
 
 void Learn::AdversarialLearningAgent::evaluateAllRootsInParallelCompileResults(
-    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-        std::shared_ptr<Job>>>& resultsPerJobMap,
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
-    results,
-    std::map<uint64_t, Archive*>& archiveMap)
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const EvaluationTable& jobTable, EvaluationTable& table,
+    ShardedArchive& shardedArchive)
 {
     // Create temporary map to gather results per root
-    std::map<const TPG::TPGVertex*, std::shared_ptr<EvaluationResult>>
-        resultsPerRootMap;
+    std::map<const TPG::TPGVertex*, EvaluationResult> resultsPerRootMap;
 
     // Gather the results
-    for (const auto& resultPerJob : resultsPerJobMap) {
-        // Getting the AdversarialEvaluationResult that should be in this pair
+    for (size_t row = 0; row < jobTable.getNbRows(); row++) {
+        // Getting the AdversarialEvaluationResult that should be in this row
         std::shared_ptr<AdversarialEvaluationResult> res =
             std::dynamic_pointer_cast<AdversarialEvaluationResult>(
-                resultPerJob.second.first);
+                jobTable.getSharedResult(row));
 
-        auto advJob = std::dynamic_pointer_cast<Learn::AdversarialJob>(
-            resultPerJob.second.second);
+        auto advJob =
+            std::dynamic_pointer_cast<Learn::AdversarialJob>(jobs.at(row));
         // We browse the roots contained in the jobs to update their respective
         // scores, unless posOfStudiedRoot is defined. In this case, we will
         // only take 1 root in consideration.
@@ -84,13 +237,13 @@ void Learn::AdversarialLearningAgent::evaluateAllRootsInParallelCompileResults(
             if (iterator == resultsPerRootMap.end()) {
                 // first time we encounter the results of this root
                 resultsPerRootMap.emplace(
-                    root, std::make_shared<EvaluationResult>(EvaluationResult(
-                        res->getScoreOf(i), res->getNbEvaluation())));
+                    root, EvaluationResult(res->getScoreOf(i),
+                                           res->getNbEvaluation()));
             }
             else {
                 // there is already a score for this root, let's do an addition
-                (*iterator->second) += EvaluationResult(res->getScoreOf(i),
-                                                        res->getNbEvaluation());
+                iterator->second += EvaluationResult(res->getScoreOf(i),
+                                                     res->getNbEvaluation());
             }
 
             // if there is a specific root to read the score we skip the others
@@ -101,38 +254,46 @@ void Learn::AdversarialLearningAgent::evaluateAllRootsInParallelCompileResults(
         }
     }
 
-    // Swaps the results for the final map
+    // Swaps the results for the final table
     // It is important to iterate on tpg.getRootVertices : it ensures
     // the order of the roots iteration remains the same no matter
     // the order of resultsPerRootMap which depends on addresses.
     for (auto root : tpg->getRootVertices()) {
-        auto& resultPerRoot = *resultsPerRootMap.find(root);
-        results.emplace(resultPerRoot.second, resultPerRoot.first);
+        const EvaluationResult& resultPerRoot = resultsPerRootMap.at(root);
+        table.addRow(root, resultPerRoot.getResult(),
+                     resultPerRoot.getNbEvaluation(),
+                     resultPerRoot.getVariance());
     }
 
-    champions.clear();
-    auto iterator = results.end();
-    for (int i = 0; i <= (1.0 - params.ratioDeletedRoots) *
-                         (double)tpg->getNbRootVertices() -
-                         1.0;
-         i++) {
-        champions.emplace_back((--iterator)->second);
-    }
+    this->updateChampions(table);
+
     // Merge the archives
-    this->mergeArchiveMap(archiveMap);
+    this->mergeShardedArchive(shardedArchive);
 }
 
-std::shared_ptr<Learn::EvaluationResult> Learn::AdversarialLearningAgent::
-evaluateJob(TPG::TPGExecutionEngine& tee, const Job& job,
-            uint64_t generationNumber, Learn::LearningMode mode,
-            LearningEnvironment& le) const
+void Learn::AdversarialLearningAgent::evaluateJobInTable(
+    TPG::TPGExecutionEngine& tee, const Job& job, uint64_t generationNumber,
+    Learn::LearningMode mode, LearningEnvironment& le,
+    EvaluationTable& table) const
 {
-    auto& ale = (AdversarialLearningEnvironment&)le;
-
     // Init results
     auto results = std::make_shared<AdversarialEvaluationResult>(
         this->agentsPerEvaluation);
 
+    this->evaluateMatch(tee, ((AdversarialJob&)job).getRoots(),
+                        generationNumber, mode,
+                        (AdversarialLearningEnvironment&)le, *results);
+
+    table.addRow(results, job.getRoot());
+}
+
+void Learn::AdversarialLearningAgent::evaluateMatch(
+    TPG::TPGExecutionEngine& tee,
+    const std::vector<const TPG::TPGVertex*>& participants,
+    uint64_t generationNumber, Learn::LearningMode mode,
+    AdversarialLearningEnvironment& ale,
+    AdversarialEvaluationResult& result) const
+{
     // Evaluate nbIteration times
     for (auto i = 0; i < this->params.nbIterationsPerJob; i++) {
         // Compute a Hash
@@ -144,9 +305,7 @@ evaluateJob(TPG::TPGExecutionEngine& tee, const Job& job,
 
         uint64_t nbActions = 0;
 
-        auto roots = ((AdversarialJob&)job).getRoots();
-
-        auto rootsIterator = roots.begin();
+        auto rootsIterator = participants.begin();
 
         while (!ale.isTerminal() &&
                nbActions < this->params.maxNbActionsPerEval) {
@@ -160,9 +319,9 @@ evaluateJob(TPG::TPGExecutionEngine& tee, const Job& job,
             ale.doAction(actionID);
 
             rootsIterator++;
-            if (rootsIterator == roots.end()) {
+            if (rootsIterator == participants.end()) {
                 // All the roots have played, let's go back to the first one
-                rootsIterator = roots.begin();
+                rootsIterator = participants.begin();
                 // Count actions : we have finished the turn
                 nbActions++;
             }
@@ -171,23 +330,23 @@ evaluateJob(TPG::TPGExecutionEngine& tee, const Job& job,
         auto scores = ale.getScores();
 
         // Update results
-        *results += *std::dynamic_pointer_cast<EvaluationResult>(scores);
+        result += *std::dynamic_pointer_cast<EvaluationResult>(scores);
     }
-
-    return results;
 }
 
-std::queue<std::shared_ptr<Learn::Job>> Learn::AdversarialLearningAgent::
-makeJobs(Learn::LearningMode mode, TPG::TPGGraph* tpgGraph)
+Learn::MatchTable Learn::AdversarialLearningAgent::makeMatchTable(
+    Learn::LearningMode mode, TPG::TPGGraph* tpgGraph)
 {
     // sets the tpg to the Learning Agent's one if no one was specified
     tpgGraph = tpgGraph == nullptr ? tpg.get() : tpgGraph;
 
-    std::queue<std::shared_ptr<Learn::Job>> jobs;
-
-    size_t index = 0;
+    MatchTable table(agentsPerEvaluation);
 
+    // Roots are the first participants, in their order in the graph
     auto roots = tpgGraph->getRootVertices();
+    for (auto root : roots) {
+        table.addParticipant(root);
+    }
 
     // if champions is empty fills it with the first roots come
     if (champions.size() == 0) {
@@ -201,55 +360,71 @@ makeJobs(Learn::LearningMode mode, TPG::TPGGraph* tpgGraph)
     // Creates a list of teams of champion to compete with other roots.
     // We have to make enough teams to have nbIterationsPerPolicyEvaluation
     // iterations per root.
+    // Teams are stored contiguously, with agentsPerEvaluation - 1 participant
+    // indexes per team.
     int16_t nbChampionsTeams = (int16_t)std::ceil(
         (double)params.nbIterationsPerPolicyEvaluation /
         (double)(agentsPerEvaluation * params.nbIterationsPerJob));
-    auto championsTeams =
-        std::vector<std::vector<const TPG::TPGVertex*>>(nbChampionsTeams);
+    const size_t teamSize = agentsPerEvaluation - 1;
+    std::vector<uint32_t> championsTeams(nbChampionsTeams * teamSize);
 
     // rng used to make champions teams
     Mutator::RNG rngChampions;
-    for (auto& team : championsTeams) {
+    for (auto& member : championsTeams) {
         // If the environment needs n agents, we will make lists of n-1
         // agents that will incorporate other roots.
-        team = std::vector<const TPG::TPGVertex*>(agentsPerEvaluation - 1);
-        for (int i = 0; i < agentsPerEvaluation - 1; i++) {
-            auto it = champions.begin();
-            std::advance(
-                it, rngChampions.getUnsignedInt64(0, champions.size() - 1));
-            team[i] = *it;
-        }
+        auto it = champions.begin();
+        std::advance(it,
+                     rngChampions.getUnsignedInt64(0, champions.size() - 1));
+        member = table.addParticipant(*it);
     }
 
     // Each root is put at every possible location in champions teams
     // for example, let's say the champions team is A-B.
     // A root R will fulfill the list as follow :
-    // -> 1 job with R-A-B
-    // -> 1 job with A-R-B
-    // -> 1 job with A-B-R
-    for (auto root : roots) {
-        uint64_t archiveSeed;
+    // -> 1 match with R-A-B
+    // -> 1 match with A-R-B
+    // -> 1 match with A-B-R
+    std::vector<uint32_t> seats(agentsPerEvaluation);
+    for (uint32_t rootIdx = 0; rootIdx < roots.size(); rootIdx++) {
         // browses champions teams
-        for (auto& team : championsTeams) {
+        for (int16_t team = 0; team < nbChampionsTeams; team++) {
+            const uint32_t* members = championsTeams.data() + team * teamSize;
             // puts the root at each possible location in the team
             for (int16_t i = 0; i < agentsPerEvaluation; i++) {
-                archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
-                auto job = std::make_shared<Learn::AdversarialJob>(
-                    Learn::AdversarialJob({}, archiveSeed, index++, i));
+                uint64_t archiveSeed =
+                    this->rng.getUnsignedInt64(0, UINT64_MAX);
 
-                for (int16_t j = 0; j < i; j++) {
-                    job->addRoot(team[j]);
-                }
-                job->addRoot(root);
-                for (int16_t j = i; j < agentsPerEvaluation - 1; j++) {
-                    job->addRoot(team[j]);
-                }
+                std::copy(members, members + i, seats.begin());
+                seats[i] = rootIdx;
+                std::copy(members + i, members + teamSize,
+                          seats.begin() + i + 1);
 
-                jobs.push(job);
+                table.addMatch(seats, i, archiveSeed, team);
             }
         }
     }
 
+    return table;
+}
+
+std::queue<std::shared_ptr<Learn::Job>> Learn::AdversarialLearningAgent::
+makeJobs(Learn::LearningMode mode, TPG::TPGGraph* tpgGraph)
+{
+    MatchTable table = this->makeMatchTable(mode, tpgGraph);
+
+    std::queue<std::shared_ptr<Learn::Job>> jobs;
+    for (size_t matchIdx = 0; matchIdx < table.getNbMatches(); matchIdx++) {
+        auto job = std::make_shared<Learn::AdversarialJob>(
+            Learn::AdversarialJob({}, table.getArchiveSeed(matchIdx),
+                                  matchIdx, table.getStudiedSeat(matchIdx)));
+        for (size_t seat = 0; seat < table.getNbSeats(); seat++) {
+            job->addRoot(table.getParticipant(
+                table.getParticipantIdx(matchIdx, seat)));
+        }
+        jobs.push(job);
+    }
+
     return jobs;
 }
 
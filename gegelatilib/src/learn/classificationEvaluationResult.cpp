@@ -92,3 +92,16 @@ Learn::EvaluationResult& Learn::ClassificationEvaluationResult::operator+=(
 
     return *this;
 }
+
+Util::MemoryFootprint Learn::ClassificationEvaluationResult::
+    getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(ClassificationEvaluationResult));
+    footprint.add("scorePerClass",
+                  Util::MemoryFootprint::getHeapBytes(this->scorePerClass));
+    footprint.add(
+        "nbEvaluationPerClass",
+        Util::MemoryFootprint::getHeapBytes(this->nbEvaluationPerClass));
+    return footprint;
+}
@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 #include "learn/classificationLearningEnvironment.h"
 
@@ -44,52 +45,79 @@ void Learn::ClassificationLearningEnvironment::doAction(uint64_t actionID)
     LearningEnvironment::doAction(actionID);
 
     // Classification table update
-    this->classificationTable.at(this->currentClass).at(actionID)++;
+    this->classificationTable.at(this->currentClass * this->nbActions +
+                                 actionID)++;
+    this->nbDataPerClass.at(this->currentClass)++;
+    this->nbGuessesPerClass.at(actionID)++;
 }
 
-const std::vector<std::vector<uint64_t>>& Learn::
-    ClassificationLearningEnvironment::getClassificationTable() const
+const std::vector<uint64_t>& Learn::ClassificationLearningEnvironment::
+    getClassificationTable() const
 {
     return this->classificationTable;
 }
 
+const std::vector<uint64_t>& Learn::ClassificationLearningEnvironment::
+    getNbDataPerClass() const
+{
+    return this->nbDataPerClass;
+}
+
+const std::vector<uint64_t>& Learn::ClassificationLearningEnvironment::
+    getNbGuessesPerClass() const
+{
+    return this->nbGuessesPerClass;
+}
+
+void Learn::ClassificationLearningEnvironment::computeF1Scores(
+    const std::vector<uint64_t>& table,
+    const std::vector<uint64_t>& nbDataPerClass,
+    const std::vector<uint64_t>& nbGuessesPerClass,
+    std::vector<double>& f1Scores)
+{
+    const size_t nbClasses = nbDataPerClass.size();
+    if (table.size() != nbClasses * nbClasses ||
+        nbGuessesPerClass.size() != nbClasses) {
+        throw std::runtime_error("Size mismatch between the classification "
+                                 "table and the number of classes.");
+    }
+    f1Scores.resize(nbClasses);
+
+    // Branchless loop over classes, to ease its vectorization.
+    const uint64_t* truePositives = table.data();
+    const uint64_t* nbData = nbDataPerClass.data();
+    const uint64_t* nbGuesses = nbGuessesPerClass.data();
+    double* scores = f1Scores.data();
+    for (size_t classIdx = 0; classIdx < nbClasses; classIdx++) {
+        // Number of true positives is on the diagonal of the table
+        double truePositive = (double)truePositives[classIdx * (nbClasses + 1)];
+        double recall = truePositive / (double)nbData[classIdx];
+        double precision = truePositive / (double)nbGuesses[classIdx];
+        double fScore = 2 * (precision * recall) / (precision + recall);
+        // If true positive is 0, set score to 0.
+        scores[classIdx] = (truePositive != 0.0) ? fScore : 0.0;
+    }
+}
+
+void Learn::ClassificationLearningEnvironment::getF1Scores(
+    std::vector<double>& f1Scores) const
+{
+    computeF1Scores(this->classificationTable, this->nbDataPerClass,
+                    this->nbGuessesPerClass, f1Scores);
+}
+
 double Learn::ClassificationLearningEnvironment::getScore() const
 {
     // Compute the average f1 score over all classes
     // (chosen instead of the global f1 score as it gives an equal weight to
     // the f1 score of each class, no matter its ratio within the observed
     // population)
-    double averageF1Score = 0.0;
+    std::vector<double> f1Scores;
+    this->getF1Scores(f1Scores);
 
-    // for each class
-    for (uint64_t classIdx = 0; classIdx < classificationTable.size();
-         classIdx++) {
-        uint64_t truePositive = classificationTable.at(classIdx).at(classIdx);
-        uint64_t falseNegative =
-            std::accumulate(classificationTable.at(classIdx).begin(),
-                            classificationTable.at(classIdx).end(),
-                            (uint64_t)0) -
-            truePositive;
-        uint64_t falsePositive = 0;
-        std::for_each(classificationTable.begin(), classificationTable.end(),
-                      [&classIdx, &falsePositive](
-                          const std::vector<uint64_t>& classifForClass) {
-                          falsePositive += classifForClass.at(classIdx);
-                      });
-        falsePositive -= truePositive;
-
-        double recall =
-            (double)truePositive / (double)(truePositive + falseNegative);
-        double precision =
-            (double)truePositive / (double)(truePositive + falsePositive);
-        // If true positive is 0, set score to 0.
-        double fScore = (truePositive != 0)
-                            ? 2 * (precision * recall) / (precision + recall)
-                            : 0.0;
-        averageF1Score += fScore;
-    }
-
-    averageF1Score /= (double)this->classificationTable.size();
+    double averageF1Score =
+        std::accumulate(f1Scores.begin(), f1Scores.end(), 0.0);
+    averageF1Score /= (double)f1Scores.size();
 
     return averageF1Score;
 }
@@ -100,9 +128,9 @@ void Learn::ClassificationLearningEnvironment::reset(size_t seed,
                                                      uint64_t generationNumber)
 {
     // reset scores to 0 in classification table
-    for (std::vector<uint64_t>& perClass : this->classificationTable) {
-        for (uint64_t& score : perClass) {
-            score = 0;
-        }
-    }
+    std::fill(this->classificationTable.begin(),
+              this->classificationTable.end(), 0);
+    std::fill(this->nbDataPerClass.begin(), this->nbDataPerClass.end(), 0);
+    std::fill(this->nbGuessesPerClass.begin(), this->nbGuessesPerClass.end(),
+              0);
 }
@@ -0,0 +1,202 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "learn/decimationEngine.h"
+
+void Learn::DecimationEngine::resize(size_t nbEntries, size_t nbClasses)
+{
+    this->nbEntries = nbEntries;
+    this->nbClasses = nbClasses;
+    this->scores.assign(nbEntries, 0.0);
+    this->classScores.assign(nbEntries * nbClasses, 0.0);
+    this->preserved.assign(nbEntries, false);
+    this->kept.assign(nbEntries, false);
+}
+
+void Learn::DecimationEngine::fill(const EvaluationTable& table)
+{
+    this->resize(table.getNbRows(), table.getNbClasses());
+    std::copy(table.getScores().begin(), table.getScores().end(),
+              this->scores.begin());
+    if (this->nbClasses > 0 && this->nbEntries > 0) {
+        const double* tableClassScores = table.getClassScores(0);
+        std::copy(tableClassScores,
+                  tableClassScores + this->nbEntries * this->nbClasses,
+                  this->classScores.begin());
+    }
+}
+
+size_t Learn::DecimationEngine::getNbEntries() const
+{
+    return this->nbEntries;
+}
+
+size_t Learn::DecimationEngine::getNbClasses() const
+{
+    return this->nbClasses;
+}
+
+void Learn::DecimationEngine::setScore(size_t idx, double score)
+{
+    this->scores.at(idx) = score;
+}
+
+void Learn::DecimationEngine::setClassScores(
+    size_t idx, const std::vector<double>& scorePerClass)
+{
+    if (idx >= this->nbEntries) {
+        throw std::out_of_range("Entry index exceeds the number of entries of "
+                                "the DecimationEngine.");
+    }
+
+    if (scorePerClass.size() != this->nbClasses) {
+        throw std::runtime_error("Number of scores per class differs from "
+                                 "the number of classes of the "
+                                 "DecimationEngine.");
+    }
+
+    std::copy(scorePerClass.begin(), scorePerClass.end(),
+              this->classScores.begin() + idx * this->nbClasses);
+}
+
+void Learn::DecimationEngine::setPreserved(size_t idx, bool isPreserved)
+{
+    this->preserved.at(idx) = isPreserved;
+}
+
+void Learn::DecimationEngine::decimateWorst(uint64_t nbDecimated)
+{
+    this->kept.assign(this->nbEntries, true);
+
+    // Only non-preserved entries can be decimated
+    this->candidates.clear();
+    for (size_t idx = 0; idx < this->nbEntries; idx++) {
+        if (!this->preserved.at(idx)) {
+            this->candidates.push_back(idx);
+        }
+    }
+
+    size_t nbSelected =
+        (size_t)std::min<uint64_t>(nbDecimated, this->candidates.size());
+
+    // Move the nbSelected worst entries at the beginning of candidates.
+    const std::vector<double>& s = this->scores;
+    std::nth_element(this->candidates.begin(),
+                     this->candidates.begin() + nbSelected,
+                     this->candidates.end(), [&s](size_t a, size_t b) {
+                         return s[a] < s[b] || (s[a] == s[b] && a < b);
+                     });
+
+    for (size_t i = 0; i < nbSelected; i++) {
+        this->kept.at(this->candidates.at(i)) = false;
+    }
+}
+
+void Learn::DecimationEngine::keepBest(uint64_t nbKeptPerClass,
+                                       uint64_t nbKept)
+{
+    this->kept.assign(this->nbEntries, false);
+    uint64_t nbAlreadyKept = 0;
+
+    // Keep the best entries for each class
+    size_t nbSelectedPerClass =
+        (size_t)std::min<uint64_t>(nbKeptPerClass, this->nbEntries);
+    if (nbSelectedPerClass > 0) {
+        this->candidates.resize(this->nbEntries);
+        for (size_t classIdx = 0; classIdx < this->nbClasses; classIdx++) {
+            std::iota(this->candidates.begin(), this->candidates.end(), 0);
+
+            // Move the nbSelectedPerClass best entries for this class at the
+            // beginning of candidates.
+            const double* s = this->classScores.data() + classIdx;
+            const size_t stride = this->nbClasses;
+            std::nth_element(this->candidates.begin(),
+                             this->candidates.begin() + nbSelectedPerClass,
+                             this->candidates.end(),
+                             [s, stride](size_t a, size_t b) {
+                                 const double sA = s[a * stride];
+                                 const double sB = s[b * stride];
+                                 return sA > sB || (sA == sB && a > b);
+                             });
+
+            for (size_t i = 0; i < nbSelectedPerClass; i++) {
+                if (!this->kept.at(this->candidates.at(i))) {
+                    this->kept.at(this->candidates.at(i)) = true;
+                    nbAlreadyKept++;
+                }
+            }
+        }
+    }
+
+    // Keep the entries with the best general score among remaining ones.
+    if (nbAlreadyKept < nbKept) {
+        this->candidates.clear();
+        for (size_t idx = 0; idx < this->nbEntries; idx++) {
+            if (!this->kept.at(idx)) {
+                this->candidates.push_back(idx);
+            }
+        }
+
+        size_t nbSelected = (size_t)std::min<uint64_t>(
+            nbKept - nbAlreadyKept, this->candidates.size());
+        const std::vector<double>& s = this->scores;
+        std::nth_element(this->candidates.begin(),
+                         this->candidates.begin() + nbSelected,
+                         this->candidates.end(), [&s](size_t a, size_t b) {
+                             return s[a] > s[b] || (s[a] == s[b] && a > b);
+                         });
+
+        for (size_t i = 0; i < nbSelected; i++) {
+            this->kept.at(this->candidates.at(i)) = true;
+        }
+    }
+
+    // Preserved entries are always kept
+    for (size_t idx = 0; idx < this->nbEntries; idx++) {
+        if (this->preserved.at(idx)) {
+            this->kept.at(idx) = true;
+        }
+    }
+}
+
+bool Learn::DecimationEngine::isKept(size_t idx) const
+{
+    return this->kept.at(idx);
+}
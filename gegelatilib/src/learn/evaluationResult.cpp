@@ -46,6 +46,11 @@ size_t Learn::EvaluationResult::getNbEvaluation() const
     return this->nbEvaluation;
 }
 
+double Learn::EvaluationResult::getVariance() const
+{
+    return this->variance;
+}
+
 Learn::EvaluationResult& Learn::EvaluationResult::operator+=(
     const Learn::EvaluationResult& other)
 {
@@ -59,10 +64,22 @@ Learn::EvaluationResult& Learn::EvaluationResult::operator+=(
     // If the added type is Learn::EvaluationResult
     if (thisType == typeid(Learn::EvaluationResult)) {
         // Weighted addition of results
+        const double mean = this->result;
         this->result = this->result * (double)this->nbEvaluation +
                        other.result * (double)other.nbEvaluation;
         this->result /= (double)this->nbEvaluation + (double)other.nbEvaluation;
 
+        // Pooled variance of the two sets of evaluations
+        this->variance =
+            (double)this->nbEvaluation *
+                (this->variance +
+                 (mean - this->result) * (mean - this->result)) +
+            (double)other.nbEvaluation *
+                (other.variance +
+                 (other.result - this->result) * (other.result - this->result));
+        this->variance /=
+            (double)this->nbEvaluation + (double)other.nbEvaluation;
+
         // Addition ot nbEvaluation
         this->nbEvaluation += other.nbEvaluation;
     }
@@ -70,6 +87,13 @@ Learn::EvaluationResult& Learn::EvaluationResult::operator+=(
     return *this;
 }
 
+Util::MemoryFootprint Learn::EvaluationResult::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(EvaluationResult));
+    return footprint;
+}
+
 bool Learn::operator<(const EvaluationResult& a, const EvaluationResult& b)
 {
     return a.getResult() < b.getResult();
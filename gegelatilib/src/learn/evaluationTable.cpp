@@ -0,0 +1,285 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "learn/classificationEvaluationResult.h"
+
+#include "learn/evaluationTable.h"
+
+void Learn::EvaluationTable::clear(size_t nbClasses)
+{
+    this->nbClasses = nbClasses;
+    this->roots.clear();
+    this->scores.clear();
+    this->nbEvaluations.clear();
+    this->variances.clear();
+    this->sharedResults.clear();
+    this->classScores.clear();
+}
+
+size_t Learn::EvaluationTable::addRow(const TPG::TPGVertex* root, double score,
+                                      size_t nbEvaluation, double variance)
+{
+    this->roots.push_back(root);
+    this->scores.push_back(score);
+    this->nbEvaluations.push_back(nbEvaluation);
+    this->variances.push_back(variance);
+    this->sharedResults.push_back(nullptr);
+    this->classScores.resize(this->classScores.size() + this->nbClasses, 0.0);
+
+    return this->roots.size() - 1;
+}
+
+size_t Learn::EvaluationTable::addRow(
+    const std::shared_ptr<EvaluationResult>& result, const TPG::TPGVertex* root)
+{
+    const auto* classifResult =
+        dynamic_cast<const ClassificationEvaluationResult*>(result.get());
+
+    // The first row sets the number of classes of the table.
+    if (this->roots.empty()) {
+        this->nbClasses = (classifResult != nullptr)
+                              ? classifResult->getScorePerClass().size()
+                              : 0;
+    }
+
+    size_t row = this->addRow(root, result->getResult(),
+                              result->getNbEvaluation(), result->getVariance());
+    this->sharedResults.back() = result;
+    if (this->nbClasses != 0 && classifResult != nullptr) {
+        this->setClassScores(row, classifResult->getScorePerClass());
+    }
+
+    return row;
+}
+
+size_t Learn::EvaluationTable::addRow(const EvaluationTable& source,
+                                      size_t sourceRow)
+{
+    // The first row sets the number of classes of the table.
+    if (this->roots.empty()) {
+        this->nbClasses = source.nbClasses;
+    }
+
+    size_t row = this->addRow(source.getRoot(sourceRow),
+                              source.scores[sourceRow],
+                              source.nbEvaluations[sourceRow],
+                              source.variances[sourceRow]);
+    this->sharedResults.back() = source.sharedResults[sourceRow];
+    if (this->nbClasses != 0 && this->nbClasses == source.nbClasses) {
+        std::copy_n(source.classScores.begin() + sourceRow * this->nbClasses,
+                    this->nbClasses,
+                    this->classScores.begin() + row * this->nbClasses);
+    }
+
+    return row;
+}
+
+void Learn::EvaluationTable::setClassScores(
+    size_t row, const std::vector<double>& scorePerClass)
+{
+    if (row >= this->roots.size()) {
+        throw std::out_of_range("Row index exceeds the number of rows of the "
+                                "EvaluationTable.");
+    }
+
+    if (scorePerClass.size() != this->nbClasses) {
+        throw std::runtime_error("Number of scores per class differs from the "
+                                 "number of classes of the EvaluationTable.");
+    }
+
+    std::copy(scorePerClass.begin(), scorePerClass.end(),
+              this->classScores.begin() + row * this->nbClasses);
+}
+
+void Learn::EvaluationTable::fill(
+    const std::multimap<std::shared_ptr<EvaluationResult>,
+                        const TPG::TPGVertex*>& results)
+{
+    this->clear();
+    for (const auto& result : results) {
+        this->addRow(result.first, result.second);
+    }
+}
+
+void Learn::EvaluationTable::keepRows(const std::vector<bool>& kept)
+{
+    if (kept.size() != this->roots.size()) {
+        throw std::runtime_error("Number of kept flags differs from the "
+                                 "number of rows of the EvaluationTable.");
+    }
+
+    size_t nbKept = 0;
+    for (size_t row = 0; row < kept.size(); row++) {
+        if (!kept[row]) {
+            continue;
+        }
+        if (nbKept != row) {
+            this->roots[nbKept] = this->roots[row];
+            this->scores[nbKept] = this->scores[row];
+            this->nbEvaluations[nbKept] = this->nbEvaluations[row];
+            this->variances[nbKept] = this->variances[row];
+            this->sharedResults[nbKept] = std::move(this->sharedResults[row]);
+            std::copy_n(this->classScores.begin() + row * this->nbClasses,
+                        this->nbClasses,
+                        this->classScores.begin() + nbKept * this->nbClasses);
+        }
+        nbKept++;
+    }
+
+    this->roots.resize(nbKept);
+    this->scores.resize(nbKept);
+    this->nbEvaluations.resize(nbKept);
+    this->variances.resize(nbKept);
+    this->sharedResults.resize(nbKept);
+    this->classScores.resize(nbKept * this->nbClasses);
+}
+
+std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
+Learn::EvaluationTable::getResultsMap() const
+{
+    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+        resultsMap;
+    for (size_t row = 0; row < this->roots.size(); row++) {
+        resultsMap.emplace(this->getResult(row), this->roots[row]);
+    }
+
+    return resultsMap;
+}
+
+size_t Learn::EvaluationTable::getBestRow() const
+{
+    if (this->roots.empty()) {
+        throw std::out_of_range("No best row in an empty EvaluationTable.");
+    }
+
+    size_t bestRow = 0;
+    for (size_t row = 1; row < this->scores.size(); row++) {
+        if (!(this->scores[row] < this->scores[bestRow])) {
+            bestRow = row;
+        }
+    }
+
+    return bestRow;
+}
+
+size_t Learn::EvaluationTable::getNbRows() const
+{
+    return this->roots.size();
+}
+
+size_t Learn::EvaluationTable::getNbClasses() const
+{
+    return this->nbClasses;
+}
+
+const TPG::TPGVertex* Learn::EvaluationTable::getRoot(size_t row) const
+{
+    return this->roots.at(row);
+}
+
+double Learn::EvaluationTable::getScore(size_t row) const
+{
+    return this->scores.at(row);
+}
+
+size_t Learn::EvaluationTable::getNbEvaluation(size_t row) const
+{
+    return this->nbEvaluations.at(row);
+}
+
+double Learn::EvaluationTable::getVariance(size_t row) const
+{
+    return this->variances.at(row);
+}
+
+std::shared_ptr<Learn::EvaluationResult> Learn::EvaluationTable::getResult(
+    size_t row) const
+{
+    const std::shared_ptr<EvaluationResult>& sharedResult =
+        this->sharedResults.at(row);
+    if (sharedResult != nullptr) {
+        return sharedResult;
+    }
+
+    return std::make_shared<EvaluationResult>(
+        this->scores[row], this->nbEvaluations[row], this->variances[row]);
+}
+
+const std::shared_ptr<Learn::EvaluationResult>& Learn::EvaluationTable::
+    getSharedResult(size_t row) const
+{
+    return this->sharedResults.at(row);
+}
+
+const double* Learn::EvaluationTable::getClassScores(size_t row) const
+{
+    if (row >= this->roots.size()) {
+        throw std::out_of_range("Row index exceeds the number of rows of the "
+                                "EvaluationTable.");
+    }
+
+    return this->classScores.data() + row * this->nbClasses;
+}
+
+const std::vector<double>& Learn::EvaluationTable::getScores() const
+{
+    return this->scores;
+}
+
+const std::vector<const TPG::TPGVertex*>& Learn::EvaluationTable::getRoots()
+    const
+{
+    return this->roots;
+}
+
+Util::MemoryFootprint Learn::EvaluationTable::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("roots", Util::MemoryFootprint::getHeapBytes(this->roots));
+    footprint.add("scores", Util::MemoryFootprint::getHeapBytes(this->scores));
+    footprint.add("nbEvaluations",
+                  Util::MemoryFootprint::getHeapBytes(this->nbEvaluations));
+    footprint.add("variances",
+                  Util::MemoryFootprint::getHeapBytes(this->variances));
+    footprint.add("sharedResults",
+                  Util::MemoryFootprint::getHeapBytes(this->sharedResults));
+    footprint.add("classScores",
+                  Util::MemoryFootprint::getHeapBytes(this->classScores));
+    return footprint;
+}
@@ -51,16 +51,6 @@ const TPG::TPGVertex* Learn::Job::getRoot() const
     return root;
 }
 
-std::vector<stateEOE> Learn::Job::getVecStateEOE() const
-{
-    return vecStateEOE;
-}
-
-void Learn::Job::setVecStateEOE(const std::vector<stateEOE>& vecPrev) const
-{
-    const_cast<std::vector<stateEOE>&>(this->vecStateEOE) = vecPrev;
-}
-
 void Learn::Job::setIdx(uint64_t newIdx) const
 {
     const_cast<uint64_t&>(this->idx) = newIdx;
@@ -36,11 +36,16 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
+#include <algorithm>
 #include <inttypes.h>
 #include <queue>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_set>
 
 #include "data/hash.h"
 #include "learn/evaluationResult.h"
+#include "log/traceRecorder.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
 #include "tpg/tpgExecutionEngine.h"
@@ -57,11 +62,85 @@ const Archive& Learn::LearningAgent::getArchive() const
     return this->archive;
 }
 
+const Learn::EvaluationTable& Learn::LearningAgent::getEvaluationTable() const
+{
+    return this->evaluationTable;
+}
+
+Util::MemoryFootprint Learn::LearningAgent::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("archive", this->archive.getMemoryFootprint());
+    if (this->tpg != nullptr) {
+        footprint.add("tpg", this->tpg->getMemoryFootprint());
+    }
+
+    // Results are counted with their own footprint, which includes the
+    // buffers of child classes, such as the scores per class.
+    size_t resultsBytes =
+        Util::MemoryFootprint::getHeapBytes(this->resultsPerRoot);
+    for (const auto& resultPerRoot : this->resultsPerRoot) {
+        resultsBytes += resultPerRoot.second->getMemoryFootprint().getTotal();
+    }
+    footprint.add("resultsPerRoot", resultsBytes);
+    footprint.add("evaluationTable",
+                  this->evaluationTable.getMemoryFootprint());
+    return footprint;
+}
+
 const Environment& Learn::LearningAgent::getEnvironment() const
 {
     return this->env;
 }
 
+void Learn::LearningAgent::setBatchLearningEnvironment(
+    BatchLearningEnvironment* ble)
+{
+    if (ble != nullptr) {
+        if (ble->getNbActions() != this->learningEnvironment.getNbActions()) {
+            throw std::runtime_error(
+                "The number of actions of the BatchLearningEnvironment differs "
+                "from the one of the LearningEnvironment.");
+        }
+
+        // Data sources of each lane must be copies of the ones used to
+        // build the Programs of the TPGGraph.
+        const auto& dataSources = this->env.getDataSources();
+        for (size_t lane = 0; lane < ble->getNbLanes(); lane++) {
+            auto laneDataSources = ble->getDataSources(lane);
+            bool isValid = laneDataSources.size() == dataSources.size();
+            for (size_t i = 0; isValid && i < dataSources.size(); i++) {
+                isValid = laneDataSources.at(i).get().getId() ==
+                          dataSources.at(i).get().getId();
+            }
+            if (!isValid) {
+                throw std::runtime_error(
+                    "Data sources of the BatchLearningEnvironment lanes "
+                    "differ from the data sources of the "
+                    "LearningEnvironment.");
+            }
+        }
+    }
+
+    this->batchLearningEnvironment = ble;
+}
+
+Learn::BatchLearningEnvironment* Learn::LearningAgent::
+    getBatchLearningEnvironment() const
+{
+    return this->batchLearningEnvironment;
+}
+
+void Learn::LearningAgent::setBytecodeExecution(
+    bool enabled,
+    std::shared_ptr<const Program::SuperinstructionSet> superinstructions)
+{
+    this->env.setBytecodeExecution(enabled, superinstructions);
+
+    // Programs already in the graph were optimized in the previous mode.
+    this->tpg->optimizePrograms();
+}
+
 Mutator::RNG& Learn::LearningAgent::getRNG()
 {
     return this->rng;
@@ -108,9 +187,12 @@ bool Learn::LearningAgent::isRootEvalSkipped(
     }
 }
 
-std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
-    TPG::TPGExecutionEngine& tee, const Job& job, uint64_t generationNumber,
-    Learn::LearningMode mode, LearningEnvironment& le) const
+void Learn::LearningAgent::evaluateJobInTable(TPG::TPGExecutionEngine& tee,
+                                              const Job& job,
+                                              uint64_t generationNumber,
+                                              Learn::LearningMode mode,
+                                              LearningEnvironment& le,
+                                              EvaluationTable& table) const
 {
     // Only consider the first root of jobs as we are not in adversarial mode
     const TPG::TPGVertex* root = job.getRoot();
@@ -120,11 +202,13 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
     std::shared_ptr<Learn::EvaluationResult> previousEval;
     if (mode == LearningMode::TRAINING &&
         this->isRootEvalSkipped(*root, previousEval)) {
-        return previousEval;
+        table.addRow(previousEval, root);
+        return;
     }
 
     // Init results
     double result = 0.0;
+    double squaredResult = 0.0;
 
     // Evaluate nbIteration times
     for (auto iterationNumber = 0;
@@ -151,28 +235,223 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
         }
 
         // Update results
-        result += le.getScore();
+        double score = le.getScore();
+        result += score;
+        squaredResult += score * score;
     }
 
+    // Compute the average score and its variance
+    double mean = result / (double)params.nbIterationsPerPolicyEvaluation;
+    double variance = std::max(
+        0.0, squaredResult / (double)params.nbIterationsPerPolicyEvaluation -
+                 mean * mean);
+
     // Create the EvaluationResult
-    auto evaluationResult =
-        std::shared_ptr<EvaluationResult>(new EvaluationResult(
-            result / (double)params.nbIterationsPerPolicyEvaluation,
-            params.nbIterationsPerPolicyEvaluation));
+    EvaluationResult evaluationResult(
+        mean, params.nbIterationsPerPolicyEvaluation, variance);
 
     // Combine it with previous one if any
     if (previousEval != nullptr) {
-        *evaluationResult += *previousEval;
+        evaluationResult += *previousEval;
+    }
+    table.addRow(root, evaluationResult.getResult(),
+                 evaluationResult.getNbEvaluation(),
+                 evaluationResult.getVariance());
+}
+
+std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateJob(
+    TPG::TPGExecutionEngine& tee, const Job& job, uint64_t generationNumber,
+    Learn::LearningMode mode, LearningEnvironment& le) const
+{
+    EvaluationTable table;
+    this->evaluateJobInTable(tee, job, generationNumber, mode, le, table);
+    return table.getResult(0);
+}
+
+void Learn::LearningAgent::mergeShardedArchive(
+    ShardedArchive& shardedArchive)
+{
+    GEGELATI_TRACE_SPAN("mergeShardedArchive");
+    shardedArchive.mergeInto(this->archive);
+}
+
+void Learn::LearningAgent::evaluateJobsInLockstep(
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const std::vector<Archive*>& archives, uint64_t generationNumber,
+    LearningMode mode, BatchLearningEnvironment& ble,
+    EvaluationTable& table) const
+{
+    // Skip the evaluation of roots already evaluated enough times.
+    // In the evaluation mode only.
+    std::vector<std::shared_ptr<EvaluationResult>> previousEvals(jobs.size());
+    std::vector<bool> skippedJobs(jobs.size(), false);
+    std::vector<size_t> evaluatedJobs;
+    for (size_t jobIdx = 0; jobIdx < jobs.size(); jobIdx++) {
+        if (mode == LearningMode::TRAINING &&
+            this->isRootEvalSkipped(*jobs.at(jobIdx)->getRoot(),
+                                    previousEvals.at(jobIdx))) {
+            skippedJobs.at(jobIdx) = true;
+        }
+        else {
+            evaluatedJobs.push_back(jobIdx);
+        }
+    }
+
+    // Create an Environment and a TPGExecutionEngine for each lane.
+    const size_t nbLanes = ble.getNbLanes();
+    std::vector<std::unique_ptr<Environment>> laneEnvironments;
+    std::vector<std::unique_ptr<TPG::TPGExecutionEngine>> tees;
+    for (size_t lane = 0; lane < nbLanes; lane++) {
+        laneEnvironments.emplace_back(new Environment(
+            this->env.getInstructionSet(), ble.getDataSources(lane),
+            this->env.getNbRegisters(), this->env.getNbConstant()));
+        tees.push_back(this->tpg->getFactory().createTPGExecutionEngine(
+            *laneEnvironments.back(), NULL));
+    }
+
+    // Init results
+    std::vector<double> results(jobs.size(), 0.0);
+    std::vector<double> squaredResults(jobs.size(), 0.0);
+    std::vector<size_t> seeds;
+    std::vector<uint64_t> actionIDs(nbLanes, 0);
+    const std::vector<uint8_t>& terminalMask = ble.getTerminalMask();
+
+    // Evaluate nbIteration times
+    for (auto iterationNumber = 0;
+         iterationNumber < this->params.nbIterationsPerPolicyEvaluation;
+         iterationNumber++) {
+        // Compute a Hash
+        Data::Hash<uint64_t> hasher;
+        uint64_t hash = hasher(generationNumber) ^ hasher(iterationNumber);
+
+        // Evaluate the roots by groups of nbLanes
+        for (size_t firstJob = 0; firstJob < evaluatedJobs.size();
+             firstJob += nbLanes) {
+            size_t nbUsedLanes =
+                std::min(nbLanes, evaluatedJobs.size() - firstJob);
+
+            // Reset the lanes
+            seeds.assign(nbUsedLanes, hash);
+            ble.resetAll(seeds, mode, iterationNumber, generationNumber);
+            for (size_t lane = 0; lane < nbUsedLanes; lane++) {
+                size_t jobIdx = evaluatedJobs.at(firstJob + lane);
+                tees.at(lane)->setArchive(
+                    archives.empty() ? NULL : archives.at(jobIdx));
+            }
+
+            uint64_t nbActions = 0;
+            while (!ble.allTerminal() &&
+                   nbActions < this->params.maxNbActionsPerEval) {
+                // Get the action of each active lane
+                for (size_t lane = 0; lane < nbUsedLanes; lane++) {
+                    if (terminalMask.at(lane) == 0) {
+                        const TPG::TPGVertex* root =
+                            jobs.at(evaluatedJobs.at(firstJob + lane))
+                                ->getRoot();
+                        actionIDs.at(lane) =
+                            ((const TPG::TPGAction*)tees.at(lane)
+                                 ->executeFromRoot(*root)
+                                 .back())
+                                ->getActionID();
+                    }
+                }
+                // Do them
+                ble.doActions(actionIDs);
+                // Count actions
+                nbActions++;
+            }
+
+            // Update results
+            for (size_t lane = 0; lane < nbUsedLanes; lane++) {
+                size_t jobIdx = evaluatedJobs.at(firstJob + lane);
+                double score = ble.getScore(lane);
+                results.at(jobIdx) += score;
+                squaredResults.at(jobIdx) += score * score;
+            }
+        }
+    }
+
+    // Add the rows in the order of jobs, as in evaluateJobInTable()
+    for (size_t jobIdx = 0; jobIdx < jobs.size(); jobIdx++) {
+        if (skippedJobs.at(jobIdx)) {
+            table.addRow(previousEvals.at(jobIdx), jobs.at(jobIdx)->getRoot());
+            continue;
+        }
+
+        double mean = results.at(jobIdx) /
+                      (double)params.nbIterationsPerPolicyEvaluation;
+        double variance = std::max(
+            0.0, squaredResults.at(jobIdx) /
+                         (double)params.nbIterationsPerPolicyEvaluation -
+                     mean * mean);
+        EvaluationResult evaluationResult(
+            mean, params.nbIterationsPerPolicyEvaluation, variance);
+
+        // Combine it with previous one if any
+        if (previousEvals.at(jobIdx) != nullptr) {
+            evaluationResult += *previousEvals.at(jobIdx);
+        }
+        table.addRow(jobs.at(jobIdx)->getRoot(), evaluationResult.getResult(),
+                     evaluationResult.getNbEvaluation(),
+                     evaluationResult.getVariance());
+    }
+}
+
+void Learn::LearningAgent::distributeLockstepJobs(
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const std::vector<Archive*>& archives, uint64_t generationNumber,
+    LearningMode mode, EvaluationTable& table)
+{
+    this->evaluateJobsInLockstep(jobs, archives, generationNumber, mode,
+                                 *this->batchLearningEnvironment, table);
+}
+
+void Learn::LearningAgent::evaluateAllRootsInLockstep(
+    uint64_t generationNumber, LearningMode mode, EvaluationTable& table)
+{
+    // Create the jobs, and a dedicated archive shard for each of them in
+    // training mode.
+    std::vector<std::shared_ptr<Job>> jobs;
+    std::vector<Archive*> archives;
+    ShardedArchive shardedArchive(params.archiveSize,
+                                  params.archivingProbability,
+                                  params.archiveDeltaSnapshots);
+    auto jobQueue = this->makeJobs(mode);
+    while (!jobQueue.empty()) {
+        jobs.push_back(jobQueue.front());
+        jobQueue.pop();
+        if (mode == LearningMode::TRAINING) {
+            archives.push_back(&shardedArchive.getShard(
+                jobs.back()->getIdx(), jobs.back()->getArchiveSeed()));
+        }
     }
-    return evaluationResult;
+
+    // Rows are added and archives merged in the order of jobs.
+    this->distributeLockstepJobs(jobs, archives, generationNumber, mode,
+                                 table);
+    this->mergeShardedArchive(shardedArchive);
 }
 
 std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
 Learn::LearningAgent::evaluateAllRoots(uint64_t generationNumber,
                                        Learn::LearningMode mode)
 {
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
-        result;
+    EvaluationTable table;
+    this->evaluateAllRootsInTable(generationNumber, mode, table);
+    return table.getResultsMap();
+}
+
+void Learn::LearningAgent::evaluateAllRootsInTable(uint64_t generationNumber,
+                                                   Learn::LearningMode mode,
+                                                   EvaluationTable& table)
+{
+    table.clear();
+
+    // Lockstep evaluation
+    if (this->batchLearningEnvironment != nullptr) {
+        this->evaluateAllRootsInLockstep(generationNumber, mode, table);
+        return;
+    }
 
     // Create the TPGExecutionEngine for this evaluation.
     // The engine uses the Archive only in training mode.
@@ -184,13 +463,11 @@ Learn::LearningAgent::evaluateAllRoots(uint64_t generationNumber,
     auto roots = tpg->getRootVertices();
     for (int i = 0; i < roots.size(); i++) {
         auto job = makeJob(roots.at(i), mode);
+        GEGELATI_TRACE_SPAN("evaluateJob", (int64_t)job->getIdx());
         this->archive.setRandomSeed(job->getArchiveSeed());
-        std::shared_ptr<EvaluationResult> avgScore = this->evaluateJob(
-            *tee, *job, generationNumber, mode, this->learningEnvironment);
-        result.emplace(avgScore, (*job).getRoot());
+        this->evaluateJobInTable(*tee, *job, generationNumber, mode,
+                                 this->learningEnvironment, table);
     }
-
-    return result;
 }
 
 std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateOneRoot(
@@ -225,84 +502,130 @@ std::shared_ptr<Learn::EvaluationResult> Learn::LearningAgent::evaluateOneRoot(
 
 void Learn::LearningAgent::trainOneGeneration(uint64_t generationNumber)
 {
-    for (auto logger : loggers) {
-        logger.get().logNewGeneration(generationNumber);
+    {
+        GEGELATI_TRACE_SPAN("logNewGeneration");
+        for (auto logger : loggers) {
+            logger.get().logNewGeneration(generationNumber);
+        }
     }
 
     // Populate Sequentially
-    Mutator::TPGMutator::populateTPG(*this->tpg, this->archive,
-                                     this->params.mutation, this->rng,
-                                     maxNbThreads);
-    for (auto logger : loggers) {
-        logger.get().logAfterPopulateTPG();
+    {
+        GEGELATI_TRACE_SPAN("populateTPG");
+        Mutator::TPGMutator::populateTPG(*this->tpg, this->archive,
+                                         this->params.mutation, this->rng,
+                                         maxNbThreads);
+    }
+    {
+        GEGELATI_TRACE_SPAN("logAfterPopulateTPG");
+        for (auto logger : loggers) {
+            logger.get().logAfterPopulateTPG();
+        }
     }
 
     // Evaluate
-    auto results =
-        this->evaluateAllRoots(generationNumber, LearningMode::TRAINING);
-    for (auto logger : loggers) {
-        logger.get().logAfterEvaluate(results);
+    {
+        GEGELATI_TRACE_SPAN("evaluateAllRoots");
+        this->evaluateAllRootsInTable(generationNumber, LearningMode::TRAINING,
+                                      this->evaluationTable);
+    }
+    if (!loggers.empty()) {
+        GEGELATI_TRACE_SPAN("logAfterEvaluate");
+        // Loggers expect the sorted map of results.
+        auto results = this->evaluationTable.getResultsMap();
+        for (auto logger : loggers) {
+            logger.get().logAfterEvaluate(results);
+        }
     }
 
     // Save the best score of this generation
-    this->updateBestScoreLastGen(results);
+    this->updateBestScoreLastGen(this->evaluationTable);
 
     // Remove worst performing roots
-    decimateWorstRoots(results);
+    {
+        GEGELATI_TRACE_SPAN("decimateWorstRoots");
+        decimateWorstRoots(this->evaluationTable);
+    }
     // Update the best
-    this->updateEvaluationRecords(results);
+    this->updateEvaluationRecords(this->evaluationTable);
 
-    for (auto logger : loggers) {
-        logger.get().logAfterDecimate();
+    {
+        GEGELATI_TRACE_SPAN("logAfterDecimate");
+        for (auto logger : loggers) {
+            logger.get().logAfterDecimate();
+        }
     }
 
     // Does a validation or not according to the parameter doValidation
     if (params.doValidation) {
-        auto validationResults =
-            evaluateAllRoots(generationNumber, Learn::LearningMode::VALIDATION);
+        std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
+            validationResults;
+        {
+            GEGELATI_TRACE_SPAN("validation");
+            validationResults = evaluateAllRoots(
+                generationNumber, Learn::LearningMode::VALIDATION);
+        }
+        GEGELATI_TRACE_SPAN("logAfterValidate");
         for (auto logger : loggers) {
             logger.get().logAfterValidate(validationResults);
         }
     }
 
-    for (auto logger : loggers) {
-        logger.get().logEndOfTraining();
+    {
+        GEGELATI_TRACE_SPAN("logEndOfTraining");
+        for (auto logger : loggers) {
+            logger.get().logEndOfTraining();
+        }
+    }
+}
+
+void Learn::LearningAgent::decimateWorstRoots(EvaluationTable& table)
+{
+    // Fill the decimation engine with the results. Roots that are actions
+    // must not be removed.
+    this->decimationEngine.fill(table);
+    for (size_t row = 0; row < table.getNbRows(); row++) {
+        this->decimationEngine.setPreserved(
+            row, dynamic_cast<const TPG::TPGAction*>(table.getRoot(row)) !=
+                     nullptr);
+    }
+
+    this->decimationEngine.decimateWorst((uint64_t)floor(
+        this->params.ratioDeletedRoots * (double)params.mutation.tpg.nbRoots));
+
+    // Remove decimated roots from the graph and from the table.
+    std::vector<bool> kept(table.getNbRows());
+    for (size_t row = 0; row < table.getNbRows(); row++) {
+        kept[row] = this->decimationEngine.isKept(row);
+        if (!kept[row]) {
+            tpg->removeVertex(*table.getRoot(row));
+            // Removed stored result (if any)
+            this->resultsPerRoot.erase(table.getRoot(row));
+        }
     }
+    table.keepRows(kept);
 }
 
 void Learn::LearningAgent::decimateWorstRoots(
     std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
         results)
 {
-    // Some actions may be encountered but not removed while scanning the
-    // results map they should be re-inserted to the list before leaving the
-    // method.
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
-        preservedActionRoots;
-
-    auto i = 0;
-    while (i < floor(this->params.ratioDeletedRoots *
-                     (double)params.mutation.tpg.nbRoots) &&
-           results.size() > 0) {
-        // If the root is an action, do not remove it!
-        const TPG::TPGVertex* root = results.begin()->second;
-        if (dynamic_cast<const TPG::TPGAction*>(root) == nullptr) {
-            tpg->removeVertex(*results.begin()->second);
-            // Removed stored result (if any)
-            this->resultsPerRoot.erase(results.begin()->second);
+    this->evaluationTable.fill(results);
+    this->decimateWorstRoots(this->evaluationTable);
+
+    // Remove results of decimated roots from the map.
+    std::unordered_set<const TPG::TPGVertex*> keptRoots(
+        this->evaluationTable.getRoots().begin(),
+        this->evaluationTable.getRoots().end());
+    auto iter = results.begin();
+    while (iter != results.end()) {
+        if (keptRoots.count(iter->second) == 0) {
+            iter = results.erase(iter);
         }
         else {
-            preservedActionRoots.insert(*results.begin());
-            i--; // no vertex was actually removed
+            iter++;
         }
-        results.erase(results.begin());
-
-        // Increment loop counter
-        i++;
     }
-
-    // Restore root actions
-    results.insert(preservedActionRoots.begin(), preservedActionRoots.end());
 }
 
 uint64_t Learn::LearningAgent::train(volatile bool& altTraining,
@@ -350,36 +673,52 @@ uint64_t Learn::LearningAgent::train(volatile bool& altTraining,
 }
 
 void Learn::LearningAgent::updateEvaluationRecords(
-    const std::multimap<std::shared_ptr<EvaluationResult>,
-                        const TPG::TPGVertex*>& results)
+    const EvaluationTable& table)
 {
     { // Update resultsPerRoot
-        for (auto result : results) {
-            auto mapIterator = this->resultsPerRoot.find(result.second);
+        for (size_t row = 0; row < table.getNbRows(); row++) {
+            const TPG::TPGVertex* root = table.getRoot(row);
+            const std::shared_ptr<EvaluationResult>& result =
+                table.getSharedResult(row);
+            auto mapIterator = this->resultsPerRoot.find(root);
             if (mapIterator == this->resultsPerRoot.end()) {
                 // First time this root is evaluated
-                this->resultsPerRoot.emplace(result.second, result.first);
+                this->resultsPerRoot.emplace(root, table.getResult(row));
             }
-            else if (result.first != mapIterator->second) {
+            else if (result == nullptr &&
+                     typeid(*mapIterator->second) == typeid(EvaluationResult)) {
+                // This root has already been evaluated, and the row stores by
+                // value the new result, combined with the pre-existing one in
+                // evaluateJobInTable. Update the stored result in place, which
+                // also updates the bestRoot if it is associated to this root.
+                *mapIterator->second =
+                    EvaluationResult(table.getScore(row),
+                                     table.getNbEvaluation(row),
+                                     table.getVariance(row));
+            }
+            else if (result != mapIterator->second) {
                 // This root has already been evaluated.
                 // If the received result pointer is different from the one
                 // stored in the map, update the one in the map by replacing it
                 // with the new one (which was combined with the pre-existing
                 // one in evalRoot)
-                mapIterator->second = result.first;
+                mapIterator->second =
+                    (result != nullptr) ? result : table.getResult(row);
                 // If the received result is associated to the current bestRoot,
                 // update it.
-                if (result.second == this->bestRoot.first) {
-                    this->bestRoot.second = result.first;
+                if (root == this->bestRoot.first) {
+                    this->bestRoot.second = mapIterator->second;
                 }
             }
         }
     }
 
     { // Update bestRoot
-        auto iterator = --results.end();
-        const std::shared_ptr<EvaluationResult> evaluation = iterator->first;
-        const TPG::TPGVertex* candidate = iterator->second;
+        size_t bestRow = table.getBestRow();
+        const TPG::TPGVertex* candidate = table.getRoot(bestRow);
+        // Stored result of the candidate, updated above.
+        const std::shared_ptr<EvaluationResult>& evaluation =
+            this->resultsPerRoot.at(candidate);
         // Test the three replacement cases
         // from the simpler to the most complex to test
         if (this->bestRoot.first == nullptr         // NULL case
@@ -395,6 +734,15 @@ void Learn::LearningAgent::updateEvaluationRecords(
     }
 }
 
+void Learn::LearningAgent::updateEvaluationRecords(
+    const std::multimap<std::shared_ptr<EvaluationResult>,
+                        const TPG::TPGVertex*>& results)
+{
+    EvaluationTable table;
+    table.fill(results);
+    this->updateEvaluationRecords(table);
+}
+
 const std::pair<const TPG::TPGVertex*,
                 std::shared_ptr<Learn::EvaluationResult>>&
 Learn::LearningAgent::getBestRoot() const
@@ -402,6 +750,12 @@ Learn::LearningAgent::getBestRoot() const
     return this->bestRoot;
 }
 
+void Learn::LearningAgent::updateBestScoreLastGen(
+    const EvaluationTable& table)
+{
+    bestScoreLastGen = table.getScore(table.getBestRow());
+}
+
 void Learn::LearningAgent::updateBestScoreLastGen(
     std::multimap<std::shared_ptr<Learn::EvaluationResult>,
                   const TPG::TPGVertex*>& results)
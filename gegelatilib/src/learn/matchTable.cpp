@@ -0,0 +1,167 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "learn/matchTable.h"
+
+Learn::MatchTable::MatchTable(size_t nbSeats) : nbSeats(nbSeats)
+{
+    if (nbSeats == 0) {
+        throw std::runtime_error("A MatchTable needs at least one seat.");
+    }
+}
+
+uint32_t Learn::MatchTable::addParticipant(const TPG::TPGVertex* vertex)
+{
+    auto inserted =
+        this->participantIdx.emplace(vertex, this->participants.size());
+    if (inserted.second) {
+        this->participants.push_back(vertex);
+    }
+    return inserted.first->second;
+}
+
+size_t Learn::MatchTable::addMatch(const std::vector<uint32_t>& matchSeats,
+                                   int16_t studiedSeat, uint64_t archiveSeed,
+                                   uint32_t opponentGroup)
+{
+    if (matchSeats.size() != this->nbSeats) {
+        throw std::runtime_error(
+            "Number of seats of the match differs from the MatchTable.");
+    }
+    for (uint32_t idx : matchSeats) {
+        if (idx >= this->participants.size()) {
+            throw std::runtime_error("Unknown participant in the match.");
+        }
+    }
+    if (studiedSeat < -1 || studiedSeat >= (int64_t)this->nbSeats) {
+        throw std::runtime_error("Invalid studied seat for the match.");
+    }
+
+    this->seats.insert(this->seats.end(), matchSeats.begin(),
+                       matchSeats.end());
+    this->studiedSeats.push_back(studiedSeat);
+    this->archiveSeeds.push_back(archiveSeed);
+    this->opponentGroups.push_back(opponentGroup);
+    this->nbOpponentGroups =
+        std::max(this->nbOpponentGroups, opponentGroup + 1);
+
+    return this->studiedSeats.size() - 1;
+}
+
+size_t Learn::MatchTable::getNbSeats() const
+{
+    return this->nbSeats;
+}
+
+size_t Learn::MatchTable::getNbMatches() const
+{
+    return this->studiedSeats.size();
+}
+
+size_t Learn::MatchTable::getNbParticipants() const
+{
+    return this->participants.size();
+}
+
+const TPG::TPGVertex* Learn::MatchTable::getParticipant(uint32_t idx) const
+{
+    return this->participants.at(idx);
+}
+
+uint32_t Learn::MatchTable::findParticipant(
+    const TPG::TPGVertex* vertex) const
+{
+    return this->participantIdx.at(vertex);
+}
+
+uint32_t Learn::MatchTable::getParticipantIdx(size_t matchIdx,
+                                              size_t seat) const
+{
+    if (seat >= this->nbSeats) {
+        throw std::out_of_range("Seat exceeds the number of seats.");
+    }
+    return this->seats.at(matchIdx * this->nbSeats + seat);
+}
+
+void Learn::MatchTable::getMatchParticipants(
+    size_t matchIdx,
+    std::vector<const TPG::TPGVertex*>& matchParticipants) const
+{
+    if (matchIdx >= this->getNbMatches()) {
+        throw std::out_of_range("Match index exceeds the number of matches.");
+    }
+    matchParticipants.resize(this->nbSeats);
+    const uint32_t* matchSeats = this->seats.data() + matchIdx * this->nbSeats;
+    for (size_t seat = 0; seat < this->nbSeats; seat++) {
+        matchParticipants[seat] = this->participants[matchSeats[seat]];
+    }
+}
+
+int16_t Learn::MatchTable::getStudiedSeat(size_t matchIdx) const
+{
+    return this->studiedSeats.at(matchIdx);
+}
+
+uint64_t Learn::MatchTable::getArchiveSeed(size_t matchIdx) const
+{
+    return this->archiveSeeds.at(matchIdx);
+}
+
+uint32_t Learn::MatchTable::getOpponentGroup(size_t matchIdx) const
+{
+    return this->opponentGroups.at(matchIdx);
+}
+
+std::vector<size_t> Learn::MatchTable::getSchedule() const
+{
+    // Counting sort of matches by opponent group.
+    std::vector<size_t> groupStart(this->nbOpponentGroups + 1, 0);
+    for (uint32_t group : this->opponentGroups) {
+        groupStart[group + 1]++;
+    }
+    for (size_t group = 1; group < groupStart.size(); group++) {
+        groupStart[group] += groupStart[group - 1];
+    }
+
+    std::vector<size_t> schedule(this->getNbMatches());
+    for (size_t matchIdx = 0; matchIdx < this->getNbMatches(); matchIdx++) {
+        schedule[groupStart[this->opponentGroups[matchIdx]]++] = matchIdx;
+    }
+    return schedule;
+}
@@ -47,15 +47,21 @@
 
 #include "learn/evaluationResult.h"
 #include "learn/parallelLearningAgent.h"
+#include "log/perfCounters.h"
+#include "log/traceRecorder.h"
 
-std::multimap<std::shared_ptr<Learn::EvaluationResult>, const TPG::TPGVertex*>
-Learn::ParallelLearningAgent::evaluateAllRoots(uint64_t generationNumber,
-                                               Learn::LearningMode mode)
+void Learn::ParallelLearningAgent::evaluateAllRootsInTable(
+    uint64_t generationNumber, Learn::LearningMode mode,
+    EvaluationTable& table)
 {
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>
-        results;
+    table.clear();
 
-    if (this->maxNbThreads <= 1 || !this->learningEnvironment.isCopyable()) {
+    if (this->batchLearningEnvironment != nullptr) {
+        // Lockstep mode (possibly parallel)
+        this->evaluateAllRootsInLockstep(generationNumber, mode, table);
+    }
+    else if (this->maxNbThreads <= 1 ||
+             !this->learningEnvironment.isCopyable()) {
         // Sequential mode
 
         // Create the TPGExecutionEngine
@@ -68,32 +74,90 @@ Learn::ParallelLearningAgent::evaluateAllRoots(uint64_t generationNumber,
         auto roots = this->tpg->getRootVertices();
         for (int i = 0; i < roots.size(); i++) {
             auto job = makeJob(roots.at(i), mode);
+            GEGELATI_TRACE_SPAN("evaluateJob", (int64_t)job->getIdx());
 
             this->archive.setRandomSeed(job->getArchiveSeed());
 
-            std::shared_ptr<EvaluationResult> avgScore = this->evaluateJob(
-                *tee, *job, generationNumber, mode, this->learningEnvironment);
-            results.emplace(avgScore, (*job).getRoot());
+            this->evaluateJobInTable(*tee, *job, generationNumber, mode,
+                                     this->learningEnvironment, table);
         }
     }
     else {
         // Parallel mode
-        evaluateAllRootsInParallel(generationNumber, mode, results);
+        evaluateAllRootsInParallel(generationNumber, mode, table);
+    }
+}
+
+void Learn::ParallelLearningAgent::distributeLockstepJobs(
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const std::vector<Archive*>& archives, uint64_t generationNumber,
+    LearningMode mode, EvaluationTable& table)
+{
+    if (this->maxNbThreads <= 1 ||
+        !this->batchLearningEnvironment->isCopyable() || jobs.size() <= 1) {
+        LearningAgent::distributeLockstepJobs(jobs, archives, generationNumber,
+                                              mode, table);
+        return;
+    }
+
+    // Split jobs into contiguous slices, one per thread.
+    uint64_t nbThreads = std::min((uint64_t)jobs.size(), this->maxNbThreads);
+    size_t sliceSize = (jobs.size() + nbThreads - 1) / nbThreads;
+
+    // Each slice is evaluated into its own table.
+    std::vector<EvaluationTable> sliceTables(nbThreads);
+    auto evaluateSlice = [&](size_t sliceIdx, BatchLearningEnvironment* ble) {
+        Log::PerfCounterScope perfCounterScope;
+        size_t first = sliceIdx * sliceSize;
+        size_t last = std::min(first + sliceSize, jobs.size());
+        if (first >= last) {
+            return;
+        }
+
+        std::vector<std::shared_ptr<Job>> sliceJobs(jobs.begin() + first,
+                                                    jobs.begin() + last);
+        std::vector<Archive*> sliceArchives;
+        if (!archives.empty()) {
+            sliceArchives.assign(archives.begin() + first,
+                                 archives.begin() + last);
+        }
+        this->evaluateJobsInLockstep(sliceJobs, sliceArchives,
+                                     generationNumber, mode, *ble,
+                                     sliceTables.at(sliceIdx));
+    };
+
+    // Each thread works with its own copy of the BatchLearningEnvironment.
+    std::vector<std::unique_ptr<BatchLearningEnvironment>> privateBLEs;
+    std::vector<std::thread> threads;
+    for (size_t sliceIdx = 1; sliceIdx < nbThreads; sliceIdx++) {
+        privateBLEs.emplace_back(this->batchLearningEnvironment->clone());
+        threads.emplace_back(evaluateSlice, sliceIdx, privateBLEs.back().get());
     }
 
-    return results;
+    // Work in the main thread also, using the main environment
+    evaluateSlice(0, this->batchLearningEnvironment);
+
+    // Join the threads
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Gather the rows in the order of slices
+    for (const EvaluationTable& sliceTable : sliceTables) {
+        for (size_t row = 0; row < sliceTable.getNbRows(); row++) {
+            table.addRow(sliceTable, row);
+        }
+    }
 }
 
 void Learn::ParallelLearningAgent::slaveEvalJobThread(
     uint64_t generationNumber, Learn::LearningMode mode,
     std::queue<std::shared_ptr<Learn::Job>>& jobsToProcess,
-    std::mutex& rootsToProcessMutex,
-    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                 std::shared_ptr<Job>>>& resultsPerRootMap,
-    std::mutex& resultsPerRootMapMutex,
-    std::map<uint64_t, Archive*>& archiveMap, std::mutex& archiveMapMutex,
+    std::mutex& rootsToProcessMutex, EvaluationTable& threadTable,
+    std::vector<uint64_t>& threadJobIdxs, ShardedArchive& shardedArchive,
     bool useMainEnvironment)
 {
+    Log::PerfCounterScope perfCounterScope;
 
     // Clone learningEnvironment
     LearningEnvironment* privateLearningEnvironment =
@@ -126,33 +190,19 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
         // Processing to do?
         if (doProcess) {
             doProcess = false;
-            // Dedicated archive for the root
-            Archive* temporaryArchive = NULL;
-            if (mode == LearningMode::TRAINING) {
-                temporaryArchive =
-                    new Archive(params.archiveSize, params.archivingProbability,
-                                jobToProcess->getArchiveSeed());
-            }
-            tee->setArchive(temporaryArchive);
-
-            std::shared_ptr<EvaluationResult> avgScore =
-                this->evaluateJob(*tee, *jobToProcess, generationNumber, mode,
-                                  *privateLearningEnvironment);
-
-            { // Store result Mutual exclusion zone
-                std::lock_guard<std::mutex> lock(resultsPerRootMapMutex);
-                resultsPerRootMap.emplace(
-                    jobToProcess->getIdx(),
-                    std::make_pair(avgScore, jobToProcess));
-            }
-
-            if (mode == LearningMode::TRAINING) {
-                { // Insertion archiveMap update mutual exclusion zone
-                    std::lock_guard<std::mutex> lock(archiveMapMutex);
-                    archiveMap.insert(
-                        {jobToProcess->getIdx(), temporaryArchive});
-                }
-            }
+            GEGELATI_TRACE_SPAN("evaluateJob", (int64_t)jobToProcess->getIdx());
+            // Dedicated archive shard for the root
+            tee->setArchive((mode == LearningMode::TRAINING)
+                                ? &shardedArchive.getShard(
+                                      jobToProcess->getIdx(),
+                                      jobToProcess->getArchiveSeed())
+                                : NULL);
+
+            // The table is private to the thread, no mutex needed.
+            this->evaluateJobInTable(*tee, *jobToProcess, generationNumber,
+                                     mode, *privateLearningEnvironment,
+                                     threadTable);
+            threadJobIdxs.push_back(jobToProcess->getIdx());
         }
     }
 
@@ -162,125 +212,101 @@ void Learn::ParallelLearningAgent::slaveEvalJobThread(
     }
 }
 
-void Learn::ParallelLearningAgent::mergeArchiveMap(
-    std::map<uint64_t, Archive*>& archiveMap)
-{
-    // Scan the archives backward, starting from the last to identify the
-    // last params.archiveSize recordings to keep (or less).
-    auto reverseIterator = archiveMap.rbegin();
-
-    uint64_t nbRecordings = 0;
-    while (nbRecordings < this->params.archiveSize &&
-           reverseIterator != archiveMap.rend()) {
-        nbRecordings += reverseIterator->second->getNbRecordings();
-        reverseIterator++;
-    }
-
-    // Insert identified recordings into this->archive
-    while (reverseIterator != archiveMap.rbegin()) {
-        reverseIterator--;
-
-        auto i = reverseIterator->first;
-
-        // Skip recordings in the first archive if needed
-        uint64_t recordingIdx = 0;
-        while (nbRecordings > this->params.archiveSize) {
-            recordingIdx++;
-            nbRecordings--;
-        }
-
-        // Insert remaining recordings
-        while (recordingIdx < reverseIterator->second->getNbRecordings()) {
-            // Access in reverse order
-            const ArchiveRecording& recording =
-                reverseIterator->second->at(recordingIdx);
-            // forced Insertion
-            this->archive.addRecording(
-                recording.prog,
-                reverseIterator->second->getDataHandlers().at(
-                    recording.dataHash),
-                recording.result, true);
-            recordingIdx++;
-        }
-    }
-
-    // delete all archives
-    reverseIterator = archiveMap.rbegin();
-    while (reverseIterator != archiveMap.rend()) {
-        delete reverseIterator->second;
-        reverseIterator++;
-    }
-}
-
 void Learn::ParallelLearningAgent::evaluateAllRootsInParallel(
-    uint64_t generationNumber, LearningMode mode,
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
-        results)
+    uint64_t generationNumber, LearningMode mode, EvaluationTable& table)
 {
-    // Create Archive Map
-    std::map<uint64_t, Archive*> archiveMap;
-    // Create Map for results
-    std::map<uint64_t,
-             std::pair<std::shared_ptr<EvaluationResult>, std::shared_ptr<Job>>>
-        resultsPerJobMap;
-
-    evaluateAllRootsInParallelExecute(generationNumber, mode, resultsPerJobMap,
-                                      archiveMap);
-
-    evaluateAllRootsInParallelCompileResults(resultsPerJobMap, results,
-                                             archiveMap);
+    // Create the ShardedArchive
+    ShardedArchive shardedArchive(params.archiveSize,
+                                  params.archivingProbability,
+                                  params.archiveDeltaSnapshots);
+    // Create the jobs and their table of results
+    std::vector<std::shared_ptr<Job>> jobs;
+    EvaluationTable jobTable;
+
+    evaluateAllRootsInParallelExecute(generationNumber, mode, jobs, jobTable,
+                                      shardedArchive);
+
+    evaluateAllRootsInParallelCompileResults(jobs, jobTable, table,
+                                             shardedArchive);
 }
 void Learn::ParallelLearningAgent::evaluateAllRootsInParallelExecute(
     uint64_t generationNumber, LearningMode mode,
-    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                 std::shared_ptr<Job>>>& resultsPerJobMap,
-    std::map<uint64_t, Archive*>& archiveMap)
+    std::vector<std::shared_ptr<Job>>& jobs, EvaluationTable& jobTable,
+    ShardedArchive& shardedArchive)
 {
     // Create and fill the queue for distributing work among threads
     // each root is associated to its number in the list for enabling the
     // determinism of stochastic archive storage.
     auto jobsToProcess = makeJobs(mode);
 
-    // Create mutexes
+    // Keep the jobs, in the order of their number.
+    jobs.clear();
+    auto jobsCopy = jobsToProcess;
+    while (!jobsCopy.empty()) {
+        jobs.push_back(jobsCopy.front());
+        jobsCopy.pop();
+    }
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const std::shared_ptr<Job>& a,
+                        const std::shared_ptr<Job>& b) {
+                         return a->getIdx() < b->getIdx();
+                     });
+
+    // Create mutex
     std::mutex rootsToProcessMutex;
-    std::mutex resultsPerRootMutex;
-    std::mutex archiveMapMutex;
+
+    // Each thread adds its rows to its own table.
+    std::vector<EvaluationTable> threadTables(this->maxNbThreads);
+    std::vector<std::vector<uint64_t>> threadJobIdxs(this->maxNbThreads);
 
     // Create the threads
     std::vector<std::thread> threads;
-    for (auto i = 0; i < (this->maxNbThreads - 1); i++) {
+    for (uint64_t i = 1; i < this->maxNbThreads; i++) {
         threads.emplace_back(std::thread(
             &ParallelLearningAgent::slaveEvalJobThread, this, generationNumber,
             mode, std::ref(jobsToProcess), std::ref(rootsToProcessMutex),
-            std::ref(resultsPerJobMap), std::ref(resultsPerRootMutex),
-            std::ref(archiveMap), std::ref(archiveMapMutex), false));
+            std::ref(threadTables.at(i)), std::ref(threadJobIdxs.at(i)),
+            std::ref(shardedArchive), false));
     }
 
     // Work in the main thread also, using the main environment
     this->slaveEvalJobThread(generationNumber, mode, jobsToProcess,
-                             rootsToProcessMutex, resultsPerJobMap,
-                             resultsPerRootMutex, archiveMap, archiveMapMutex,
-                             true);
+                             rootsToProcessMutex, threadTables.at(0),
+                             threadJobIdxs.at(0), shardedArchive, true);
 
     // Join the threads
     for (auto& thread : threads) {
         thread.join();
     }
+
+    // Gather the rows of all threads in the order of job numbers.
+    std::vector<std::pair<uint64_t, std::pair<size_t, size_t>>> rowPerJob;
+    rowPerJob.reserve(jobs.size());
+    for (size_t thread = 0; thread < threadTables.size(); thread++) {
+        for (size_t row = 0; row < threadJobIdxs.at(thread).size(); row++) {
+            rowPerJob.push_back(
+                {threadJobIdxs.at(thread).at(row), {thread, row}});
+        }
+    }
+    std::sort(rowPerJob.begin(), rowPerJob.end());
+
+    jobTable.clear();
+    for (const auto& jobRow : rowPerJob) {
+        jobTable.addRow(threadTables.at(jobRow.second.first),
+                        jobRow.second.second);
+    }
 }
 
 void Learn::ParallelLearningAgent::evaluateAllRootsInParallelCompileResults(
-    std::map<uint64_t, std::pair<std::shared_ptr<EvaluationResult>,
-                                 std::shared_ptr<Job>>>& resultsPerJobMap,
-    std::multimap<std::shared_ptr<EvaluationResult>, const TPG::TPGVertex*>&
-        results,
-    std::map<uint64_t, Archive*>& archiveMap)
+    const std::vector<std::shared_ptr<Job>>& jobs,
+    const EvaluationTable& jobTable, EvaluationTable& table,
+    ShardedArchive& shardedArchive)
 {
     // Merge the results
-    for (auto& resultPerRoot : resultsPerJobMap) {
-        results.emplace(resultPerRoot.second.first,
-                        (*resultPerRoot.second.second).getRoot());
+    for (size_t row = 0; row < jobTable.getNbRows(); row++) {
+        table.addRow(jobTable, row);
     }
 
     // Merge the archives
-    this->mergeArchiveMap(archiveMap);
+    this->mergeShardedArchive(shardedArchive);
 }
@@ -33,13 +33,25 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
-#include <deque>
-#include <set>
-#include <vector>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
 
 #include "learn/learningAgent.h"
 #include "log/cycleDetectionLALogger.h"
 
+Log::CycleDetectionLALogger::CycleDetectionLALogger(Learn::LearningAgent& la,
+                                                   std::ostream& out,
+                                                   bool logOnSuccess,
+                                                   bool incremental)
+    : LALogger(la, out), logOnSuccess(logOnSuccess), incremental(incremental)
+{
+    if (this->incremental) {
+        this->learningAgent.getTPGGraph()->setEdgeTracking(true);
+    }
+}
+
 void Log::CycleDetectionLALogger::logHeader()
 {
     // nothing to log
@@ -50,72 +62,103 @@ void Log::CycleDetectionLALogger::logNewGeneration(uint64_t& generationNumber)
     // nothing to log
 }
 
-void Log::CycleDetectionLALogger::logAfterPopulateTPG()
+bool Log::CycleDetectionLALogger::hasCycle(
+    const std::vector<const TPG::TPGVertex*>& vertices)
 {
-    // Do a Depth First Search of the TPG from all roots.
-    std::set<const TPG::TPGVertex*> visitedVertices;
-    std::vector<const TPG::TPGVertex*> lifoToVisit;
-    std::vector<const TPG::TPGVertex*> currentPath;
-
-    // Add all roots to the set of vertex to visit
-    const auto tpg = this->learningAgent.getTPGGraph();
-    auto roots = tpg->getRootVertices();
-    std::copy(roots.begin(), roots.end(), std::back_inserter(lifoToVisit));
-
-    // Iterate on the stack
-    while (!lifoToVisit.empty()) {
-        // Pop first vertex
-        const TPG::TPGVertex* vertex = lifoToVisit.back();
-        lifoToVisit.pop_back();
-
-        // If vertex is null pointer, this means we need to unstack a vertex
-        // from the current path.
-        if (vertex == nullptr) {
-            currentPath.pop_back();
-            // Go to the next iteration of the DFS while loop.
+    // Colors of the vertices:
+    // - WHITE: not visited yet (absent from the map).
+    // - GREY: on the current path of the DFS.
+    // - BLACK: all successors were explored.
+    enum class Color : uint8_t
+    {
+        WHITE,
+        GREY,
+        BLACK
+    };
+    std::unordered_map<const TPG::TPGVertex*, Color> colors;
+    colors.reserve(vertices.size());
+
+    // Stack of the DFS. Each element contains a vertex of the current path,
+    // and the iterator on its next outgoing edge to explore.
+    std::vector<std::pair<const TPG::TPGVertex*,
+                          std::list<TPG::TPGEdge*>::const_iterator>>
+        stack;
+
+    // Start a DFS from each vertex that was not visited yet.
+    // Starting only from root vertices would not be sufficient, as subgraphs
+    // with no root may exist if they contain a cycle.
+    for (const TPG::TPGVertex* start : vertices) {
+        if (!colors.emplace(start, Color::GREY).second) {
             continue;
         }
+        stack.emplace_back(start, start->getOutgoingEdges().cbegin());
+
+        while (!stack.empty()) {
+            const TPG::TPGVertex* vertex = stack.back().first;
+            auto& edgeIter = stack.back().second;
 
-        // Mark vertex as visited
-        visitedVertices.insert(vertex);
+            // All outgoing edges were explored: leave the current path.
+            if (edgeIter == vertex->getOutgoingEdges().cend()) {
+                colors.at(vertex) = Color::BLACK;
+                stack.pop_back();
+                continue;
+            }
 
-        // Scan outgoing edges
-        const TPG::TPGTeam* team = dynamic_cast<const TPG::TPGTeam*>(vertex);
-        if (team != nullptr) {
-            // Push vertex in path
-            currentPath.push_back(vertex);
+            const TPG::TPGVertex* destination = (*edgeIter)->getDestination();
+            edgeIter++;
 
-            // Push a nullptr to lifo to visit. When this pointer is
-            // encountered, the vertex will be popped from the current path.
-            lifoToVisit.push_back(nullptr);
+            auto colorIter = colors.emplace(destination, Color::GREY);
+            if (colorIter.second) {
+                // The destination was not visited yet: push it on the
+                // current path.
+                stack.emplace_back(destination,
+                                   destination->getOutgoingEdges().cbegin());
+            }
+            else if (colorIter.first->second == Color::GREY) {
+                // The destination is on the current path: A cycle was
+                // detected!
+                return true;
+            }
+        }
+    }
 
-            for (auto edge : team->getOutgoingEdges()) {
-                // Check if the destination is in the path
-                if (std::find(currentPath.begin(), currentPath.end(),
-                              edge->getDestination()) != currentPath.end()) {
-                    // A cycle was detected !
-                    *this << "A cycle was detected in the TPG.";
+    return false;
+}
 
-                    // Early termination
-                    return;
-                }
+void Log::CycleDetectionLALogger::logAfterPopulateTPG()
+{
+    const auto tpg = this->learningAgent.getTPGGraph();
 
-                // Put the destination on the lifo
-                lifoToVisit.push_back(edge->getDestination());
-            }
+    bool cycleDetected = false;
+    if (!this->incremental || !this->previousCheckAcyclic ||
+        !tpg->isEdgeTracking()) {
+        // Search the whole TPG.
+        cycleDetected = hasCycle(tpg->getVertices());
+    }
+    else {
+        // The TPG was acyclic at the previous check. Any new cycle goes
+        // through an edge added or redirected since then, and hence through
+        // its destination.
+        std::vector<const TPG::TPGVertex*> destinations;
+        destinations.reserve(tpg->getModifiedEdges().size());
+        for (const TPG::TPGEdge* edge : tpg->getModifiedEdges()) {
+            destinations.push_back(edge->getDestination());
         }
+        cycleDetected = hasCycle(destinations);
     }
 
-    // Check that all vertices were visited.
-    if (visitedVertices.size() != tpg->getNbVertices()) {
-        // Not all vertices were visited: A connected sub-graph was not visited.
-        // This happens when a connected sub-graph has no root, which indicates
-        // that the subgraph has a cycle.
-        *this << "A cycle was detected in the TPG.";
+    if (this->incremental) {
+        // After a detected cycle, the next check searches the whole TPG
+        // again.
+        this->previousCheckAcyclic = !cycleDetected;
+        tpg->setEdgeTracking(true);
+        tpg->clearModifiedEdges();
     }
 
-    // If this point of the algorithm is reached, no cycle were detected
-    if (this->logOnSuccess) {
+    if (cycleDetected) {
+        *this << "A cycle was detected in the TPG.";
+    }
+    else if (this->logOnSuccess) {
         *this << "No cycle detected in this TPG.";
     }
 }
@@ -0,0 +1,85 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <iomanip>
+
+#include "learn/learningAgent.h"
+#include "log/laMemoryLogger.h"
+
+Log::LAMemoryLogger::LAMemoryLogger(Learn::LearningAgent& la,
+                                    std::ostream& out, int colWidth,
+                                    std::string separator)
+    : LALogger(la, out), colWidth{colWidth}, separator{separator}
+{
+    *this << std::right;
+    this->logHeader();
+}
+
+const Util::MemoryFootprint& Log::LAMemoryLogger::getLastFootprint() const
+{
+    return this->lastFootprint;
+}
+
+void Log::LAMemoryLogger::logHeader()
+{
+    *this << std::setw(colWidth) << "Gen";
+    for (const char* column : {"Archive", "Snapshots", "Vertices", "Edges",
+                               "Programs", "Results", "Total"}) {
+        *this << this->separator << std::setw(colWidth) << column;
+    }
+    *this << std::endl;
+}
+
+void Log::LAMemoryLogger::logNewGeneration(uint64_t& generationNumber)
+{
+    this->generationNumber = generationNumber;
+}
+
+void Log::LAMemoryLogger::logEndOfTraining()
+{
+    this->lastFootprint = this->learningAgent.getMemoryFootprint();
+    const Util::MemoryFootprint& fp = this->lastFootprint;
+
+    *this << std::setw(colWidth) << this->generationNumber;
+    for (size_t nbBytes :
+         {fp.get("archive") - fp.get("archive.snapshots"),
+          fp.get("archive.snapshots"), fp.get("tpg.vertices"),
+          fp.get("tpg.edges"), fp.get("tpg.programs"),
+          fp.get("resultsPerRoot"), fp.getTotal()}) {
+        *this << this->separator << std::setw(colWidth) << nbBytes;
+    }
+    *this << std::endl;
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <iomanip>
+
+#include "log/laPerfCounterLogger.h"
+
+Log::LAPerfCounterLogger::LAPerfCounterLogger(Learn::LearningAgent& la,
+                                              std::ostream& out, int colWidth,
+                                              std::string separator)
+    : LALogger(la, out), colWidth{colWidth}, separator{separator}
+{
+    *this << std::setprecision(2) << std::fixed << std::right;
+    if (this->mainCounters.isAvailable()) {
+        PerfCounterRegistry::getInstance().activate();
+    }
+    this->logHeader();
+}
+
+Log::LAPerfCounterLogger::~LAPerfCounterLogger()
+{
+    if (this->mainCounters.isAvailable()) {
+        PerfCounterRegistry::getInstance().deactivate();
+    }
+}
+
+bool Log::LAPerfCounterLogger::isAvailable() const
+{
+    return this->mainCounters.isAvailable();
+}
+
+const std::vector<Log::PerfCounterValues>& Log::LAPerfCounterLogger::
+    getPhaseValues(const std::string& phase) const
+{
+    static const std::vector<PerfCounterValues> noValues;
+    auto iter = this->phaseValues.find(phase);
+    return (iter != this->phaseValues.end()) ? iter->second : noValues;
+}
+
+void Log::LAPerfCounterLogger::startPhase()
+{
+    if (!this->isAvailable()) {
+        return;
+    }
+    // Discard samples of workers from outside the phase.
+    PerfCounterRegistry::getInstance().takeWorkerSamples();
+    this->mainCounters.start();
+}
+
+void Log::LAPerfCounterLogger::endPhase(const std::string& phase)
+{
+    if (!this->isAvailable()) {
+        return;
+    }
+    std::vector<PerfCounterValues>& values = this->phaseValues[phase];
+    values.clear();
+    values.push_back(this->mainCounters.stop());
+    std::vector<PerfCounterValues> workerSamples =
+        PerfCounterRegistry::getInstance().takeWorkerSamples();
+    values.insert(values.end(), workerSamples.begin(), workerSamples.end());
+
+    for (size_t idx = 0; idx < values.size(); idx++) {
+        *this << std::setw(colWidth) << this->generationNumber
+              << this->separator << std::setw(colWidth) << phase
+              << this->separator << std::setw(colWidth)
+              << ((idx == 0) ? "main" : std::to_string(idx));
+        for (size_t counter = 0; counter < PerfCounterValues::NB_COUNTERS;
+             counter++) {
+            this->logValue(values.at(idx), (PerfCounter)counter);
+            if ((PerfCounter)counter == PerfCounter::INSTRUCTIONS) {
+                // Instructions per cycle
+                *this << this->separator << std::setw(colWidth);
+                const PerfCounterValues& val = values.at(idx);
+                if (val.isAvailable(PerfCounter::CYCLES) &&
+                    val.isAvailable(PerfCounter::INSTRUCTIONS) &&
+                    val.get(PerfCounter::CYCLES) > 0) {
+                    *this << (double)val.get(PerfCounter::INSTRUCTIONS) /
+                                 (double)val.get(PerfCounter::CYCLES);
+                }
+                else {
+                    *this << "n/a";
+                }
+            }
+        }
+        *this << std::endl;
+    }
+}
+
+void Log::LAPerfCounterLogger::logValue(const PerfCounterValues& values,
+                                        PerfCounter counter)
+{
+    *this << this->separator << std::setw(colWidth);
+    if (values.isAvailable(counter)) {
+        *this << values.get(counter);
+    }
+    else {
+        *this << "n/a";
+    }
+}
+
+void Log::LAPerfCounterLogger::logHeader()
+{
+    if (!this->isAvailable()) {
+        *this << "# Hardware performance counters are not available ("
+              << this->mainCounters.getErrorMessage() << ")." << std::endl;
+        return;
+    }
+
+    *this << std::setw(colWidth) << "Gen" << this->separator
+          << std::setw(colWidth) << "Phase" << this->separator
+          << std::setw(colWidth) << "Worker";
+    for (size_t counter = 0; counter < PerfCounterValues::NB_COUNTERS;
+         counter++) {
+        *this << this->separator << std::setw(colWidth)
+              << PerfCounterValues::NAMES[counter];
+        if ((PerfCounter)counter == PerfCounter::INSTRUCTIONS) {
+            *this << this->separator << std::setw(colWidth) << "IPC";
+        }
+    }
+    *this << std::endl;
+}
+
+void Log::LAPerfCounterLogger::logNewGeneration(uint64_t& generationNumber)
+{
+    this->generationNumber = generationNumber;
+    this->startPhase();
+}
+
+void Log::LAPerfCounterLogger::logAfterPopulateTPG()
+{
+    this->endPhase("mutation");
+    this->startPhase();
+}
+
+void Log::LAPerfCounterLogger::logAfterEvaluate(
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>& results)
+{
+    this->endPhase("evaluation");
+}
+
+void Log::LAPerfCounterLogger::logAfterDecimate()
+{
+    if (this->doValidation) {
+        this->startPhase();
+    }
+}
+
+void Log::LAPerfCounterLogger::logAfterValidate(
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>& results)
+{
+    this->endPhase("validation");
+}
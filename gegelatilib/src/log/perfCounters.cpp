@@ -0,0 +1,242 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "log/perfCounters.h"
+
+const char* const Log::PerfCounterValues::NAMES[NB_COUNTERS] = {
+    "Cycles", "Instrs", "L1DMiss", "LLCMiss", "BrMiss"};
+
+bool Log::PerfCounterValues::isAvailable() const
+{
+    for (bool isCounted : this->available) {
+        if (isCounted) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Log::PerfCounterValues& Log::PerfCounterValues::operator+=(
+    const PerfCounterValues& other)
+{
+    for (size_t idx = 0; idx < NB_COUNTERS; idx++) {
+        this->values[idx] += other.values[idx];
+        this->available[idx] = this->available[idx] || other.available[idx];
+    }
+    return *this;
+}
+
+Log::PerfCounterGroup::PerfCounterGroup()
+{
+    this->fds.fill(-1);
+#ifdef __linux__
+    // Type and config of each PerfCounter
+    const std::array<std::pair<uint32_t, uint64_t>,
+                     PerfCounterValues::NB_COUNTERS>
+        events{{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+    for (size_t idx = 0; idx < PerfCounterValues::NB_COUNTERS; idx++) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[idx].first;
+        attr.config = events[idx].second;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Count the calling thread, on any CPU.
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            this->errorMessage = std::string("perf_event_open failed for ") +
+                                 PerfCounterValues::NAMES[idx] + ": " +
+                                 std::strerror(errno);
+        }
+        this->fds[idx] = fd;
+    }
+#else
+    this->errorMessage = "perf_event_open is only available on Linux";
+#endif
+}
+
+Log::PerfCounterGroup::~PerfCounterGroup()
+{
+#ifdef __linux__
+    for (int fd : this->fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool Log::PerfCounterGroup::isAvailable() const
+{
+    for (int fd : this->fds) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string& Log::PerfCounterGroup::getErrorMessage() const
+{
+    return this->errorMessage;
+}
+
+void Log::PerfCounterGroup::start()
+{
+#ifdef __linux__
+    for (int fd : this->fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+Log::PerfCounterValues Log::PerfCounterGroup::stop()
+{
+    PerfCounterValues result;
+#ifdef __linux__
+    for (size_t idx = 0; idx < PerfCounterValues::NB_COUNTERS; idx++) {
+        int fd = this->fds[idx];
+        if (fd < 0) {
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+        // Value, time enabled and time running.
+        uint64_t data[3];
+        if (read(fd, data, sizeof(data)) != sizeof(data)) {
+            continue;
+        }
+
+        // Scale multiplexed counters.
+        uint64_t value = data[0];
+        if (data[2] > 0 && data[2] < data[1]) {
+            value = (uint64_t)((double)value * (double)data[1] /
+                               (double)data[2]);
+        }
+        result.values[idx] = value;
+        result.available[idx] = true;
+    }
+#endif
+    return result;
+}
+
+Log::PerfCounterRegistry& Log::PerfCounterRegistry::getInstance()
+{
+    static PerfCounterRegistry instance;
+    return instance;
+}
+
+void Log::PerfCounterRegistry::activate()
+{
+    std::lock_guard<std::mutex> lock(this->samplesMutex);
+    this->ownerThread = std::this_thread::get_id();
+    this->workerSamples.clear();
+    this->active.store(true, std::memory_order_relaxed);
+}
+
+void Log::PerfCounterRegistry::deactivate()
+{
+    this->active.store(false, std::memory_order_relaxed);
+}
+
+bool Log::PerfCounterRegistry::isOwnerThread() const
+{
+    return this->ownerThread == std::this_thread::get_id();
+}
+
+void Log::PerfCounterRegistry::addWorkerSample(const PerfCounterValues& values)
+{
+    std::lock_guard<std::mutex> lock(this->samplesMutex);
+    this->workerSamples.push_back(values);
+}
+
+std::vector<Log::PerfCounterValues> Log::PerfCounterRegistry::
+    takeWorkerSamples()
+{
+    std::lock_guard<std::mutex> lock(this->samplesMutex);
+    std::vector<PerfCounterValues> samples;
+    samples.swap(this->workerSamples);
+    return samples;
+}
+
+Log::PerfCounterScope::PerfCounterScope()
+{
+    PerfCounterRegistry& registry = PerfCounterRegistry::getInstance();
+    if (registry.isActive() && !registry.isOwnerThread()) {
+        this->group = std::make_unique<PerfCounterGroup>();
+        if (this->group->isAvailable()) {
+            this->group->start();
+        }
+        else {
+            this->group.reset();
+        }
+    }
+}
+
+Log::PerfCounterScope::~PerfCounterScope()
+{
+    if (this->group != nullptr) {
+        PerfCounterRegistry::getInstance().addWorkerSample(
+            this->group->stop());
+    }
+}
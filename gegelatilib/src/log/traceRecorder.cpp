@@ -0,0 +1,148 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <fstream>
+#include <stdexcept>
+
+#include "log/traceRecorder.h"
+
+Log::TraceRecorder::ThreadBufferHandle::~ThreadBufferHandle()
+{
+    if (this->buffer != nullptr) {
+        TraceRecorder& recorder = TraceRecorder::getInstance();
+        std::lock_guard<std::mutex> lock(recorder.buffersMutex);
+        recorder.freeBuffers.push_back(this->buffer);
+    }
+}
+
+Log::TraceRecorder& Log::TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+Log::TraceRecorder::ThreadBuffer& Log::TraceRecorder::getThreadBuffer()
+{
+    thread_local ThreadBufferHandle handle;
+    if (handle.buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(this->buffersMutex);
+        if (!this->freeBuffers.empty()) {
+            // Reuse the buffer of a terminated thread
+            handle.buffer = this->freeBuffers.back();
+            this->freeBuffers.pop_back();
+        }
+        else {
+            this->buffers.emplace_back(
+                new ThreadBuffer{this->buffers.size(), {}});
+            handle.buffer = this->buffers.back().get();
+        }
+    }
+    return *handle.buffer;
+}
+
+void Log::TraceRecorder::enable()
+{
+    this->enabled.store(true, std::memory_order_relaxed);
+}
+
+void Log::TraceRecorder::disable()
+{
+    this->enabled.store(false, std::memory_order_relaxed);
+}
+
+void Log::TraceRecorder::record(const char* name, int64_t jobIdx,
+                                uint64_t start, uint64_t end)
+{
+    this->getThreadBuffer().events.push_back(
+        {name, jobIdx, start, end - start});
+}
+
+void Log::TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(this->buffersMutex);
+    for (auto& buffer : this->buffers) {
+        buffer->events.clear();
+    }
+}
+
+size_t Log::TraceRecorder::getNbEvents()
+{
+    std::lock_guard<std::mutex> lock(this->buffersMutex);
+    size_t nbEvents = 0;
+    for (auto& buffer : this->buffers) {
+        nbEvents += buffer->events.size();
+    }
+    return nbEvents;
+}
+
+void Log::TraceRecorder::writeChromeTrace(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock(this->buffersMutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto& buffer : this->buffers) {
+        // Name the thread
+        out << (first ? "\n" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+            << buffer->threadIdx << ",\"args\":{\"name\":\"thread "
+            << buffer->threadIdx << "\"}}";
+        first = false;
+
+        // Timestamps are in microseconds.
+        for (const TraceEvent& event : buffer->events) {
+            out << ",\n{\"name\":\"" << event.name
+                << "\",\"cat\":\"gegelati\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                << buffer->threadIdx << ",\"ts\":" << event.start / 1000
+                << "." << (event.start % 1000) / 100
+                << ",\"dur\":" << event.duration / 1000 << "."
+                << (event.duration % 1000) / 100;
+            if (event.jobIdx >= 0) {
+                out << ",\"args\":{\"job\":" << event.jobIdx << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Log::TraceRecorder::writeChromeTrace(const std::string& filePath)
+{
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + filePath);
+    }
+    this->writeChromeTrace(file);
+}
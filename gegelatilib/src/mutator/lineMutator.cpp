@@ -34,7 +34,7 @@
  * knowledge of the CeCILL-C license and that you accept its terms.
  */
 
-#include <set>
+#include <algorithm>
 #include <stdexcept>
 
 #include "environment.h"
@@ -68,39 +68,31 @@ static bool initRandomCorrectLineOperand(
 
     // Is the operand constrained in type?
     if (initOperandDataSource && operandIdx < instruction.getNbOperands()) {
-        // Select an operand
-        // The type of operand needed
-        const std::type_info& operandType =
-            instruction.getOperandTypes().at(operandIdx).get();
-
-        // keep a record of tested indexes
-        std::set<uint64_t> operandDataSourceIndexes;
-        if (forceChange) {
-            operandDataSourceIndexes.insert(operandDataSourceIndex);
-        }
-
-        while (!operandFound &&
-               operandDataSourceIndexes.size() < env.getNbDataSources()) {
-            // Select an operandDataSourceIndex
-            operandDataSourceIndex =
-                rng.getUnsignedInt64(0, (env.getNbDataSources() - 1) -
-                                            operandDataSourceIndexes.size());
-            // Correct the index with the number of already tested ones inferior
-            // to it. This works because the set is ordered
-            std::for_each(operandDataSourceIndexes.begin(),
-                          operandDataSourceIndexes.end(),
-                          [&operandDataSourceIndex](uint64_t index) {
-                              if (index <= operandDataSourceIndex)
-                                  operandDataSourceIndex++;
-                          });
-            // Add the index to the set
-            operandDataSourceIndexes.insert(operandDataSourceIndex);
-            // check if the selected dataSource can provide the type requested
-            // by the instruction
-            operandFound = env.getFakeDataSources()
-                               .at(operandDataSourceIndex)
-                               .get()
-                               .canHandle(operandType);
+        // Data sources able to provide the type of operand needed, as
+        // precomputed by the Environment.
+        const std::vector<uint64_t>& validDataSources =
+            env.getOperandDataSources(line.getInstructionIndex(), operandIdx);
+
+        // When forcing a change, exclude the current data source (if valid).
+        auto currentIter =
+            std::lower_bound(validDataSources.begin(), validDataSources.end(),
+                             operandDataSourceIndex);
+        const bool excludeCurrent = forceChange &&
+                                    currentIter != validDataSources.end() &&
+                                    *currentIter == operandDataSourceIndex;
+        const uint64_t nbCandidates =
+            validDataSources.size() - ((excludeCurrent) ? 1 : 0);
+
+        if (nbCandidates > 0) {
+            // Select an operandDataSourceIndex among valid ones
+            uint64_t candidateIdx = rng.getUnsignedInt64(0, nbCandidates - 1);
+            if (excludeCurrent &&
+                candidateIdx >= (uint64_t)(currentIter -
+                                           validDataSources.begin())) {
+                candidateIdx++;
+            }
+            operandDataSourceIndex = validDataSources.at(candidateIdx);
+            operandFound = true;
         }
     }
     else if (initOperandDataSource) {
@@ -196,15 +188,9 @@ void Mutator::LineMutator::alterCorrectLine(Program::Line& line,
             line.getEnvironment().getInstructionSet().getInstruction(
                 newInstructionIndex);
         for (uint64_t i = 0; i < instruction.getNbOperands(); i++) {
-            const std::type_info& type =
-                instruction.getOperandTypes().at(i).get();
             uint64_t dataSourceIndex = line.getOperand(i).first;
-            bool isValid = false;
-            const Data::DataHandler& dataSource = line.getEnvironment()
-                                                      .getFakeDataSources()
-                                                      .at(dataSourceIndex)
-                                                      .get();
-            isValid = dataSource.canHandle(type);
+            bool isValid = line.getEnvironment().getOperandAddressSpace(
+                               newInstructionIndex, i, dataSourceIndex) > 0;
             // Alter the operand if needed
             if (!isValid) {
                 // Force only the change of data source (location can remain
@@ -63,6 +63,7 @@ void Mutator::ProgramMutator::initRandomProgram(
 
     // Identify Introns
     p.identifyIntrons();
+    p.optimize();
 }
 
 bool Mutator::ProgramMutator::deleteRandomLine(Program::Program& p,
@@ -161,6 +162,7 @@ bool Mutator::ProgramMutator::mutateProgram(Program::Program& p,
     // Identify introns
     if (anyMutation) {
         p.identifyIntrons();
+        p.optimize();
     }
 
     return anyMutation;
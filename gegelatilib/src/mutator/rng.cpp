@@ -38,23 +38,46 @@
 
 void Mutator::RNG::setSeed(uint64_t seed)
 {
-    engine->seed(seed);
+    engine.seed(seed);
+}
+
+Mutator::RNG Mutator::RNG::split(uint64_t stream) const
+{
+    return RNG(engine.split(stream));
 }
 
 uint64_t Mutator::RNG::getUnsignedInt64(uint64_t min, uint64_t max)
 {
     Mutator::uniform_int_distribution<uint64_t> distribution(min, max);
-    return distribution(*engine);
+    return distribution(engine);
+}
+
+void Mutator::RNG::fillUnsignedInt64(uint64_t min, uint64_t max,
+                                     std::vector<uint64_t>& values)
+{
+    Mutator::uniform_int_distribution<uint64_t> distribution(min, max);
+    for (uint64_t& value : values) {
+        value = distribution(engine);
+    }
 }
 
 int32_t Mutator::RNG::getInt32(int32_t min, int32_t max)
 {
     Mutator::uniform_int_distribution<int32_t> distribution(min, max);
-    return distribution(*engine);
+    return distribution(engine);
 }
 
 double Mutator::RNG::getDouble(double min, double max)
 {
     Mutator::uniform_real_distribution<double> distribution(min, max);
-    return distribution(*engine);
+    return distribution(engine);
+}
+
+void Mutator::RNG::fillDouble(double min, double max,
+                              std::vector<double>& values)
+{
+    Mutator::uniform_real_distribution<double> distribution(min, max);
+    for (double& value : values) {
+        value = distribution(engine);
+    }
 }
@@ -35,6 +35,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <numeric>
 #include <queue>
@@ -43,6 +44,8 @@
 #include <vector>
 
 #include "archive.h"
+#include "log/perfCounters.h"
+#include "log/traceRecorder.h"
 
 #include "program/programExecutionEngine.h"
 #include "tpg/tpgAction.h"
@@ -211,8 +214,19 @@ void Mutator::TPGMutator::mutateEdgeDestination(
     const Mutator::MutationParameters& params, Mutator::RNG& rng)
 {
     // Pick an edge among preexisting vertices
-    const TPG::TPGVertex* target = NULL;
+    const TPG::TPGVertex* target =
+        pickEdgeDestination(preExistingTeams, preExistingActions, params, rng);
 
+    // Change the target
+    // Changing the target should not fail.
+    graph.setEdgeDestination(*edge, *target);
+}
+
+const TPG::TPGVertex* Mutator::TPGMutator::pickEdgeDestination(
+    const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+    const std::vector<const TPG::TPGAction*>& preExistingActions,
+    const Mutator::MutationParameters& params, Mutator::RNG& rng)
+{
     // Should the new target be an action or a team
     bool targetAction =
         rng.getDouble(0, 1) < params.tpg.pEdgeDestinationIsAction;
@@ -222,17 +236,13 @@ void Mutator::TPGMutator::mutateEdgeDestination(
     // as the presence of cycle in TPGs is not possible according to the current
     // mutation process.
     if (targetAction) {
-        target = preExistingTeams.at(
+        return preExistingTeams.at(
             rng.getUnsignedInt64(0, preExistingActions.size() - 1));
     }
     else {
-        target = preExistingTeams.at(
+        return preExistingTeams.at(
             rng.getUnsignedInt64(0, preExistingTeams.size() - 1));
     }
-
-    // Change the target
-    // Changing the target should not fail.
-    graph.setEdgeDestination(*edge, *target);
 }
 
 void Mutator::TPGMutator::mutateOutgoingEdge(
@@ -315,6 +325,97 @@ void Mutator::TPGMutator::mutateTPGTeam(
     }
 }
 
+Mutator::TPGMutator::TeamMutationPlan Mutator::TPGMutator::
+    planTPGTeamMutation(
+        const std::vector<const TPG::TPGTeam*>& rootTeams,
+        const std::vector<const TPG::TPGTeam*>& preExistingTeams,
+        const std::vector<const TPG::TPGAction*>& preExistingActions,
+        const std::vector<TPG::TPGEdge*>& preExistingEdges,
+        const Mutator::MutationParameters& params, Mutator::RNG& rng)
+{
+    TeamMutationPlan plan;
+
+    // Select a random existing root and copy its outgoing edges
+    plan.clonedRoot =
+        rootTeams.at(rng.getUnsignedInt64(0, rootTeams.size() - 1));
+    for (TPG::TPGEdge* edge : plan.clonedRoot->getOutgoingEdges()) {
+        plan.edges.push_back({edge, edge->getDestination(), false});
+    }
+
+    // 1. Remove randomly selected edges
+    {
+        // Keep at least two edges (otherwise the team is useless)
+        double proba = 1.0;
+        while (plan.edges.size() > 2 && proba > rng.getDouble(0.0, 1.0)) {
+            plan.edges.erase(plan.edges.begin() +
+                             rng.getUnsignedInt64(0, plan.edges.size() - 1));
+
+            // Decrement the proba of removing another edge
+            proba *= params.tpg.pEdgeDeletion;
+        }
+    }
+
+    // 2. Add random duplicated edge with the team as its source
+    // Since the planned team is new, no pre-existing edge is connected to it
+    // and all of them are candidates.
+    {
+        double proba = 1.0;
+        while (plan.edges.size() < params.tpg.maxOutgoingEdges &&
+               proba > rng.getDouble(0.0, 1.0)) {
+            TPG::TPGEdge* pickedEdge = preExistingEdges.at(
+                rng.getUnsignedInt64(0, preExistingEdges.size() - 1));
+            plan.edges.push_back(
+                {pickedEdge, pickedEdge->getDestination(), false});
+
+            // Decrement the proba of adding another edge
+            proba *= params.tpg.pEdgeAddition;
+        }
+    }
+
+    // 3. Mutate edges of the team
+    {
+        bool anyMutationDone = false;
+        do {
+            for (PlannedEdge& edge : plan.edges) {
+                // Edge->Program bid modification
+                if (rng.getDouble(0.0, 1.0) < params.tpg.pProgramMutation) {
+                    // A Program selected twice is copied only once.
+                    edge.mutateProgram = true;
+                    if (rng.getDouble(0.0, 1.0) <
+                        params.tpg.pEdgeDestinationChange) {
+                        edge.destination = pickEdgeDestination(
+                            preExistingTeams, preExistingActions, params, rng);
+                    }
+                    anyMutationDone = true;
+                }
+            }
+        } while (!anyMutationDone);
+    }
+
+    return plan;
+}
+
+const TPG::TPGTeam& Mutator::TPGMutator::commitTPGTeamMutation(
+    TPG::TPGGraph& graph, const TeamMutationPlan& plan,
+    std::list<std::shared_ptr<Program::Program>>& newPrograms)
+{
+    const TPG::TPGTeam& newTeam = graph.addNewTeam();
+    for (const PlannedEdge& edge : plan.edges) {
+        std::shared_ptr<Program::Program> program;
+        if (edge.mutateProgram) {
+            program = std::make_shared<Program::Program>(
+                edge.model->getProgram());
+            newPrograms.push_back(program);
+        }
+        else {
+            program = edge.model->getProgramSharedPointer();
+        }
+        graph.addNewEdge(newTeam, *edge.destination, program);
+    }
+
+    return newTeam;
+}
+
 void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
     std::shared_ptr<Program::Program>& newProg,
     const Mutator::MutationParameters& params, const Archive& archive,
@@ -340,18 +441,18 @@ void Mutator::TPGMutator::mutateProgramBehaviorAgainstArchive(
                 newProg->hasIdenticalBehavior(*newProgCopy))))
             ;
         // Check for uniqueness in archive
-        auto archivedDataHandlers = archive.getDataHandlers();
         std::map<size_t, double> hashesAndResults;
         Program::ProgramExecutionEngine pee(*newProg);
-        for (std::pair<
-                 size_t,
-                 std::vector<std::reference_wrapper<const Data::DataHandler>>>
-                 archiveDatahandler : archivedDataHandlers) {
-            // Execute the mutated program on the archive data handlers
-            pee.setDataSources(archiveDatahandler.second);
-            double result = pee.executeProgram();
-            hashesAndResults.insert({archiveDatahandler.first, result});
-        }
+        archive.forEachDataHandlers(
+            [&pee, &hashesAndResults](
+                size_t hash,
+                const std::vector<std::reference_wrapper<
+                    const Data::DataHandler>>& dataHandlers) {
+                // Execute the mutated program on the archive data handlers
+                pee.setDataSources(dataHandlers);
+                double result = pee.executeProgram();
+                hashesAndResults.insert({hash, result});
+            });
 
         // If the result is not unique, do another mutation.
         allUnique = archive.areProgramResultsUnique(hashesAndResults);
@@ -364,32 +465,41 @@ void Mutator::TPGMutator::mutateNewProgramBehaviors(
     Mutator::RNG& rng, const Mutator::MutationParameters& params,
     const Archive& archive)
 {
+    // Each Program is mutated with its own RNG, derived from a single draw
+    // in the given RNG and from the index of the Program. Hence, results do
+    // not depend on the number of threads.
+    const Mutator::RNG jobsRNG =
+        rng.split(rng.getUnsignedInt64(0, UINT64_MAX));
+
     // This is a computing intensive part of the mutation process
     // Hence the parallelization.
     if (maxNbThreads <= 1) {
         // Sequential (kept for determinism check mostly)
+        GEGELATI_TRACE_SPAN("mutateNewProgramBehaviors");
+        uint64_t idx = 0;
         for (std::shared_ptr<Program::Program> newProg : newPrograms) {
-            Mutator::RNG privateRNG(rng.getUnsignedInt64(0, UINT64_MAX));
+            Mutator::RNG privateRNG = jobsRNG.split(idx++);
             mutateProgramBehaviorAgainstArchive(newProg, params, archive,
                                                 privateRNG);
         }
     }
     else {
         // Parallel
-        // Create job list with Program pointers and seed
+        // Create job list with Program pointers and index
         std::queue<std::pair<std::shared_ptr<Program::Program>, uint64_t>>
             programsToMutate;
+        uint64_t idx = 0;
         for (std::shared_ptr<Program::Program> newProg : newPrograms) {
-            programsToMutate.push(
-                {newProg, rng.getUnsignedInt64(0, UINT64_MAX)});
+            programsToMutate.push({newProg, idx++});
         }
 
         std::mutex mutexMutation;
 
         // Function executed in threads
         auto parallelWorker = [&programsToMutate, &mutexMutation, &params,
-                               &archive]() {
-            Mutator::RNG privateRNG;
+                               &archive, &jobsRNG]() {
+            Log::PerfCounterScope perfCounterScope;
+            GEGELATI_TRACE_SPAN("mutateNewProgramBehaviors");
             // While there is work to be done
             bool jobDone;
             do {
@@ -406,7 +516,7 @@ void Mutator::TPGMutator::mutateNewProgramBehaviors(
 
                 //  Do the job (if any)
                 if (jobDone) {
-                    privateRNG.setSeed(job.second);
+                    Mutator::RNG privateRNG = jobsRNG.split(job.second);
                     mutateProgramBehaviorAgainstArchive(job.first, params,
                                                         archive, privateRNG);
                 }
@@ -477,13 +587,13 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
             }
         });
 
-    // Get a list of pre existing edges before mutations (copy)
-    std::list<const TPG::TPGEdge*> preExistingEdges;
-    std::for_each(
-        graph.getEdges().begin(), graph.getEdges().end(),
-        [&preExistingEdges](const std::unique_ptr<TPG::TPGEdge>& edge) {
-            preExistingEdges.push_back(edge.get());
-        });
+    // Get a vector of pre existing edges before mutations (copy), for
+    // constant-time random picks.
+    std::vector<TPG::TPGEdge*> preExistingEdges;
+    preExistingEdges.reserve(graph.getEdges().size());
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : graph.getEdges()) {
+        preExistingEdges.push_back(edge.get());
+    }
 
     // Create an empty list to store Programs to mutate.
     std::list<std::shared_ptr<Program::Program>> newPrograms;
@@ -491,16 +601,41 @@ void Mutator::TPGMutator::populateTPG(TPG::TPGGraph& graph,
     // While the target is not reached, add new teams
     uint64_t currentNumberOfRoot = rootVertices.size();
     while (params.tpg.nbRoots > currentNumberOfRoot) {
-        // Select a random existing root
-        uint64_t clonedRootIndex =
-            rng.getUnsignedInt64(0, rootTeams.size() - 1);
-        // clone it (the vertex and all its outgoing edges)
-        const TPG::TPGTeam& newRoot = (const TPG::TPGTeam&)graph.cloneVertex(
-            *rootTeams.at(clonedRootIndex));
-        // Apply mutations to the root
-        mutateTPGTeam(graph, archive, newRoot, preExistingTeams,
-                      preExistingActions, preExistingEdges, newPrograms, params,
-                      rng);
+        // Plan all missing roots, each with its own RNG.
+        const uint64_t nbPlans = params.tpg.nbRoots - currentNumberOfRoot;
+        const Mutator::RNG plansRNG =
+            rng.split(rng.getUnsignedInt64(0, UINT64_MAX));
+        std::vector<TeamMutationPlan> plans(nbPlans);
+
+        // Planning only reads the graph, hence the parallelization.
+        std::atomic<uint64_t> nextPlan{0};
+        auto planWorker = [&]() {
+            Log::PerfCounterScope perfCounterScope;
+            GEGELATI_TRACE_SPAN("planTPGTeamMutation");
+            uint64_t planIdx;
+            while ((planIdx = nextPlan++) < nbPlans) {
+                Mutator::RNG planRNG = plansRNG.split(planIdx);
+                plans.at(planIdx) = planTPGTeamMutation(
+                    rootTeams, preExistingTeams, preExistingActions,
+                    preExistingEdges, params, planRNG);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (uint64_t idx = 1; idx < std::min(maxNbThreads, nbPlans); idx++) {
+            threads.emplace_back(planWorker);
+        }
+        planWorker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Commit the plans in a deterministic order
+        GEGELATI_TRACE_SPAN("commitTPGTeamMutation");
+        for (const TeamMutationPlan& plan : plans) {
+            commitTPGTeamMutation(graph, plan, newPrograms);
+        }
+
         // Check the new number of roots
         // Needed since preExisting root may be subsumed by new ones.
         currentNumberOfRoot = graph.getNbRootVertices();
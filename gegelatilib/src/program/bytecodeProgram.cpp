@@ -0,0 +1,207 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <stdexcept>
+
+#include "data/arrayWrapper.h"
+#include "data/constant.h"
+#include "program/bytecodeProgram.h"
+#include "program/optimizedProgram.h"
+#include "program/program.h"
+#include "program/superinstructionSet.h"
+
+Program::BytecodeProgram::BytecodeProgram(
+    const OptimizedProgram& optimized, const Program& program,
+    const SuperinstructionSet* superinstructions)
+    : literals{optimized.getLiterals()}, result{LITERALS_BASE, 0},
+      nbSuperinstructions{0}
+{
+    const Environment& env = program.getEnvironment();
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        dataSources = env.getFakeDataSources();
+    const bool hasConstants = env.getNbConstant() > 0;
+    const uint64_t firstDataSource = (hasConstants) ? 2 : 1;
+
+    // Data sources whose native data can be read. (0: unknown, 1: yes, 2: no)
+    std::vector<uint8_t> isNative(dataSources.size(), 0);
+    auto isNativeDataSource = [&](uint64_t dataSourceIdx) {
+        if (isNative.at(dataSourceIdx) == 0) {
+            isNative.at(dataSourceIdx) =
+                (dataSourceIdx >= firstDataSource &&
+                 dynamic_cast<const Data::ArrayWrapper<double>*>(
+                     &dataSources.at(dataSourceIdx).get()) != nullptr)
+                    ? 1
+                    : 2;
+        }
+        return isNative.at(dataSourceIdx) == 1;
+    };
+
+    const std::vector<OptimizedProgram::Operation>& operations =
+        optimized.getOperations();
+    for (size_t idx = 0; idx < operations.size(); idx++) {
+        const OptimizedProgram::Operation& operation = operations.at(idx);
+        Op op{Opcode::GENERIC, 0, (uint32_t)idx, nullptr,
+              operation.instruction, {}};
+
+        // Check whether the Operation can be executed with a CALL.
+        op.function = operation.instruction->getScalarFunction();
+        bool isCall = op.function != nullptr &&
+                      operation.registerWrites.empty() &&
+                      operation.operands.size() <= MAX_NB_OPERANDS;
+        for (size_t opIdx = 0; isCall && opIdx < operation.operands.size();
+             opIdx++) {
+            const OptimizedProgram::Operand& operand =
+                operation.operands.at(opIdx);
+            Operand& bytecodeOperand = op.operands[opIdx];
+            switch (operand.kind) {
+            case OptimizedProgram::OperandKind::VALUE:
+                bytecodeOperand = {VALUES_BASE, (uint32_t)operand.index};
+                break;
+            case OptimizedProgram::OperandKind::LITERAL:
+                bytecodeOperand = {LITERALS_BASE, (uint32_t)operand.index};
+                break;
+            case OptimizedProgram::OperandKind::DATA_SOURCE:
+                if (hasConstants && operand.index == 1 &&
+                    *operand.type == typeid(Data::Constant)) {
+                    bytecodeOperand = {LITERALS_BASE,
+                                       (uint32_t)this->literals.size()};
+                    this->literals.push_back(
+                        (double)program.getConstantAt(operand.location));
+                }
+                else if (*operand.type == typeid(double) &&
+                         isNativeDataSource(operand.index)) {
+                    bytecodeOperand = {
+                        (uint32_t)(DATA_SOURCES_BASE + operand.index),
+                        (uint32_t)operand.location};
+                }
+                else {
+                    isCall = false;
+                }
+                break;
+            }
+        }
+
+        if (isCall) {
+            op.nbOperands = (uint32_t)operation.operands.size();
+            op.opcode = (op.nbOperands == 2) ? Opcode::CALL_2 : Opcode::CALL;
+        }
+        else {
+            op.function = nullptr;
+        }
+        this->ops.push_back(op);
+    }
+
+    // Fuse superinstructions
+    if (superinstructions != nullptr) {
+        for (size_t idx = 1; idx < this->ops.size(); idx++) {
+            Op& first = this->ops.at(idx - 1);
+            const Op& second = this->ops.at(idx);
+            if (first.function == nullptr || second.function == nullptr ||
+                !superinstructions->contains(
+                    operations.at(idx - 1).instructionIndex,
+                    operations.at(idx).instructionIndex)) {
+                continue;
+            }
+            bool isDependent = false;
+            for (uint32_t opIdx = 0; opIdx < second.nbOperands; opIdx++) {
+                isDependent |= second.operands[opIdx].base == VALUES_BASE &&
+                               second.operands[opIdx].offset == first.value;
+            }
+            if (isDependent) {
+                first.opcode = Opcode::FUSED;
+                this->nbSuperinstructions++;
+                idx++; // The second Op can not start another fusion.
+            }
+        }
+    }
+
+    // Terminate the bytecode
+    this->ops.push_back({Opcode::END, 0, 0, nullptr, nullptr, {}});
+
+    // Result
+    const OptimizedProgram::Operand& optimizedResult = optimized.getResult();
+    this->result = {(optimizedResult.kind ==
+                     OptimizedProgram::OperandKind::VALUE)
+                        ? VALUES_BASE
+                        : LITERALS_BASE,
+                    (uint32_t)optimizedResult.index};
+
+    // Native data sources
+    for (uint64_t dataSourceIdx = 0; dataSourceIdx < isNative.size();
+         dataSourceIdx++) {
+        if (isNative.at(dataSourceIdx) == 1) {
+            this->nativeDataSources.push_back(dataSourceIdx);
+        }
+    }
+}
+
+const std::vector<Program::BytecodeProgram::Op>& Program::BytecodeProgram::
+    getOps() const
+{
+    return this->ops;
+}
+
+const std::vector<double>& Program::BytecodeProgram::getLiterals() const
+{
+    return this->literals;
+}
+
+const std::vector<uint64_t>& Program::BytecodeProgram::getNativeDataSources()
+    const
+{
+    return this->nativeDataSources;
+}
+
+const Program::BytecodeProgram::Operand& Program::BytecodeProgram::getResult()
+    const
+{
+    return this->result;
+}
+
+uint64_t Program::BytecodeProgram::getNbSuperinstructions() const
+{
+    return this->nbSuperinstructions;
+}
+
+Util::MemoryFootprint Program::BytecodeProgram::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(BytecodeProgram));
+    footprint.add("ops", Util::MemoryFootprint::getHeapBytes(this->ops));
+    footprint.add("literals",
+                  Util::MemoryFootprint::getHeapBytes(this->literals));
+    return footprint;
+}
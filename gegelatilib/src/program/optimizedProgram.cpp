@@ -0,0 +1,302 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include "data/primitiveTypeArray.h"
+#include "data/untypedSharedPtr.h"
+#include "program/bytecodeProgram.h"
+#include "program/optimizedProgram.h"
+#include "program/program.h"
+
+Program::OptimizedProgram::OptimizedProgram(const Program& program)
+    : result{OperandKind::LITERAL, 0, 0, nullptr}, nbEffectiveLines{0}
+{
+    const Environment& env = program.getEnvironment();
+    const std::vector<std::reference_wrapper<const Data::DataHandler>>&
+        dataSources = env.getFakeDataSources();
+    const Data::DataHandler& fakeRegisters = dataSources.at(0);
+    const bool hasConstants = env.getNbConstant() > 0;
+
+    std::map<uint64_t, uint64_t> literalIndexes;
+    auto getLiteral = [this, &literalIndexes](double value) -> Operand {
+        // Literals are compared bitwise so that -0.0 and NaNs are preserved.
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        auto found = literalIndexes.find(bits);
+        if (found == literalIndexes.end()) {
+            found =
+                literalIndexes.insert({bits, this->literals.size()}).first;
+            this->literals.push_back(value);
+        }
+        return {OperandKind::LITERAL, found->second, 0, nullptr};
+    };
+    // Value held by each register in the execution of the Program.
+    // Registers are reset to 0 before each execution.
+    std::vector<Operand> registerValues(env.getNbRegisters(),
+                                        getLiteral(0.0));
+
+    // Values already computed, identified by their instruction and operands.
+    std::map<std::vector<uint64_t>, Operand> computedValues;
+
+    // Registers used to fold lines accessing registers as arrays.
+    Data::PrimitiveTypeArray<double> knownRegisters(env.getNbRegisters());
+
+    for (uint64_t lineIdx = 0; lineIdx < program.getNbLines(); lineIdx++) {
+        if (program.isIntron(lineIdx)) {
+            continue;
+        }
+        this->nbEffectiveLines++;
+
+        const Line& line = program.getLine(lineIdx);
+        const Instructions::Instruction& instruction =
+            env.getInstructionSet().getInstruction(
+                line.getInstructionIndex()); // throws std::out_of_range
+        const uint64_t destinationIndex = line.getDestinationIndex();
+        if (destinationIndex >= env.getNbRegisters()) {
+            throw std::out_of_range("Destination register of a Program Line "
+                                    "does not exist.");
+        }
+
+        Operation operation{&instruction, line.getInstructionIndex(), {}, {}};
+        std::vector<uint64_t> key{line.getInstructionIndex()};
+        bool isKnown = true;
+
+        for (uint64_t idxOp = 0; idxOp < instruction.getNbOperands();
+             idxOp++) {
+            const std::pair<uint64_t, uint64_t>& operandIndexes =
+                line.getOperand(idxOp);
+            const std::type_info& operandType =
+                instruction.getOperandTypes().at(idxOp).get();
+            const Data::DataHandler& dataSource =
+                dataSources.at(operandIndexes.first); // throws out_of_range
+            if (!dataSource.canHandle(operandType)) {
+                throw std::invalid_argument(
+                    "Data source of a Program Line does not provide the type "
+                    "of its operand.");
+            }
+            const uint64_t location =
+                dataSource.scaleLocation(operandIndexes.second, operandType);
+
+            if (operandIndexes.first == 0 && operandType == typeid(double)) {
+                // Read the value held by the register.
+                const Operand& value = registerValues.at(location);
+                operation.operands.push_back(value);
+                key.insert(key.end(), {(uint64_t)value.kind, value.index});
+                isKnown &= (value.kind == OperandKind::LITERAL);
+                continue;
+            }
+
+            operation.operands.push_back({OperandKind::DATA_SOURCE,
+                                          operandIndexes.first, location,
+                                          &operandType});
+            key.insert(key.end(), {(uint64_t)OperandKind::DATA_SOURCE,
+                                   operandIndexes.first, location});
+            if (operandIndexes.first == 0) {
+                // Registers accessed as an array.
+                for (uint64_t address :
+                     fakeRegisters.getAddressesAccessed(operandType,
+                                                        location)) {
+                    const Operand& value = registerValues.at(address);
+                    operation.registerWrites.push_back({address, value});
+                    key.insert(key.end(),
+                               {(uint64_t)value.kind, value.index});
+                    isKnown &= (value.kind == OperandKind::LITERAL);
+                }
+            }
+            else {
+                isKnown &= (hasConstants && operandIndexes.first == 1);
+            }
+        }
+
+        // Constant folding
+        if (isKnown) {
+            try {
+                for (const std::pair<uint64_t, Operand>& write :
+                     operation.registerWrites) {
+                    knownRegisters.setDataAt(
+                        typeid(double), write.first,
+                        this->literals.at(write.second.index));
+                }
+                std::vector<Data::UntypedSharedPtr> operands;
+                for (const Operand& operand : operation.operands) {
+                    if (operand.kind == OperandKind::LITERAL) {
+                        operands.emplace_back(
+                            &this->literals.at(operand.index),
+                            Data::UntypedSharedPtr::emptyDestructor<
+                                const double>());
+                    }
+                    else if (operand.index == 0) {
+                        operands.push_back(knownRegisters.getDataAt(
+                            *operand.type, operand.location));
+                    }
+                    else {
+                        operands.push_back(
+                            program.cGetConstantHandler().getDataAt(
+                                *operand.type, operand.location));
+                    }
+                }
+                registerValues.at(destinationIndex) =
+                    getLiteral(instruction.execute(operands));
+                continue;
+            }
+            catch (std::exception&) {
+                // The line is kept and will be executed as usual.
+            }
+        }
+
+        // Common-subexpression elimination
+        auto computedValue = computedValues.find(key);
+        if (computedValue != computedValues.end()) {
+            registerValues.at(destinationIndex) = computedValue->second;
+            continue;
+        }
+
+        const Operand value{OperandKind::VALUE, this->operations.size(), 0,
+                            nullptr};
+        this->operations.push_back(std::move(operation));
+        computedValues.insert({std::move(key), value});
+        registerValues.at(destinationIndex) = value;
+    }
+    this->result = registerValues.at(0);
+
+    // Dead-store elimination: keep only operations used by the result.
+    std::vector<bool> isUseful(this->operations.size(), false);
+    if (this->result.kind == OperandKind::VALUE) {
+        isUseful.at(this->result.index) = true;
+    }
+    for (size_t idx = this->operations.size(); idx-- > 0;) {
+        if (!isUseful.at(idx)) {
+            continue;
+        }
+        const Operation& operation = this->operations.at(idx);
+        for (const Operand& operand : operation.operands) {
+            if (operand.kind == OperandKind::VALUE) {
+                isUseful.at(operand.index) = true;
+            }
+        }
+        for (const std::pair<uint64_t, Operand>& write :
+             operation.registerWrites) {
+            if (write.second.kind == OperandKind::VALUE) {
+                isUseful.at(write.second.index) = true;
+            }
+        }
+    }
+
+    // Renumber the remaining operations.
+    std::vector<uint64_t> newIndexes(this->operations.size(), 0);
+    auto renumber = [&newIndexes](Operand& operand) {
+        if (operand.kind == OperandKind::VALUE) {
+            operand.index = newIndexes.at(operand.index);
+        }
+    };
+    size_t nbUseful = 0;
+    for (size_t idx = 0; idx < this->operations.size(); idx++) {
+        if (!isUseful.at(idx)) {
+            continue;
+        }
+        newIndexes.at(idx) = nbUseful;
+        Operation& operation = this->operations.at(idx);
+        for (Operand& operand : operation.operands) {
+            renumber(operand);
+        }
+        for (std::pair<uint64_t, Operand>& write : operation.registerWrites) {
+            renumber(write.second);
+        }
+        if (idx != nbUseful) {
+            this->operations.at(nbUseful) = std::move(operation);
+        }
+        nbUseful++;
+    }
+    this->operations.resize(nbUseful);
+    renumber(this->result);
+
+    if (env.isBytecodeExecution()) {
+        this->bytecode = std::make_shared<const BytecodeProgram>(
+            *this, program, env.getSuperinstructions());
+    }
+}
+
+const std::vector<Program::OptimizedProgram::Operation>& Program::
+    OptimizedProgram::getOperations() const
+{
+    return this->operations;
+}
+
+const std::vector<double>& Program::OptimizedProgram::getLiterals() const
+{
+    return this->literals;
+}
+
+const Program::OptimizedProgram::Operand& Program::OptimizedProgram::
+    getResult() const
+{
+    return this->result;
+}
+
+uint64_t Program::OptimizedProgram::getNbEffectiveLines() const
+{
+    return this->nbEffectiveLines;
+}
+
+const Program::BytecodeProgram* Program::OptimizedProgram::
+    getBytecodeProgram() const
+{
+    return this->bytecode.get();
+}
+
+Util::MemoryFootprint Program::OptimizedProgram::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(OptimizedProgram));
+
+    size_t operationsBytes =
+        Util::MemoryFootprint::getHeapBytes(this->operations);
+    for (const Operation& operation : this->operations) {
+        operationsBytes +=
+            Util::MemoryFootprint::getHeapBytes(operation.operands) +
+            Util::MemoryFootprint::getHeapBytes(operation.registerWrites);
+    }
+    footprint.add("operations", operationsBytes);
+    footprint.add("literals",
+                  Util::MemoryFootprint::getHeapBytes(this->literals));
+    if (this->bytecode != nullptr) {
+        footprint.add("bytecode", this->bytecode->getMemoryFootprint());
+    }
+    return footprint;
+}
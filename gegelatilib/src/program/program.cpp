@@ -64,6 +64,8 @@ Program::Line& Program::Program::addNewLine(const uint64_t idx)
         throw std::out_of_range(
             "Attempting to insert a line beyond the program end.");
     }
+    this->optimizedProgram.reset();
+
     // Allocate the zero-filled memory
     Line* newLine = new Line(this->environment);
     // new line is not marked as an intron by default
@@ -74,6 +76,8 @@ Program::Line& Program::Program::addNewLine(const uint64_t idx)
 
 void Program::Program::clearIntrons()
 {
+    // Removing introns does not change the behavior of the Program.
+    std::shared_ptr<const OptimizedProgram> optimized = this->optimizedProgram;
     size_t index = 0;
 
     // Scan the lines of the Program.
@@ -89,10 +93,12 @@ void Program::Program::clearIntrons()
             index++;
         }
     }
+    this->optimizedProgram = optimized;
 }
 
 void Program::Program::removeLine(const uint64_t idx)
 {
+    this->optimizedProgram.reset();
     delete this->lines.at(idx).first; // throws std::out_of_range on bad index.
     this->lines.erase(this->lines.begin() + idx);
 }
@@ -103,6 +109,7 @@ void Program::Program::swapLines(const uint64_t idx0, const uint64_t idx1)
         throw std::out_of_range(
             "Attempting to swap a line beyond the program end.");
     }
+    this->optimizedProgram.reset();
 
     std::iter_swap(this->lines.begin() + idx0, this->lines.begin() + idx1);
 }
@@ -117,6 +124,33 @@ size_t Program::Program::getNbLines() const
     return this->lines.size();
 }
 
+Util::MemoryFootprint Program::Program::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(Program));
+
+    // Each Line owns an array of operands.
+    footprint.add(
+        "lines",
+        Util::MemoryFootprint::getHeapBytes(this->lines) +
+            this->lines.size() *
+                (sizeof(Line) + this->environment.getMaxNbOperands() *
+                                    sizeof(std::pair<uint64_t, uint64_t>)));
+
+    // The constants object is already counted in the Program object.
+    Util::MemoryFootprint constantsFootprint =
+        this->constants.getMemoryFootprint();
+    footprint.add("constants",
+                  constantsFootprint.getTotal() -
+                      constantsFootprint.get("object"));
+
+    if (this->optimizedProgram != nullptr) {
+        footprint.add("optimized",
+                      this->optimizedProgram->getMemoryFootprint());
+    }
+    return footprint;
+}
+
 const Program::Line& Program::Program::getLine(uint64_t index) const
 {
     return *this->lines.at(index)
@@ -125,6 +159,7 @@ const Program::Line& Program::Program::getLine(uint64_t index) const
 
 Program::Line& Program::Program::getLine(uint64_t index)
 {
+    this->optimizedProgram.reset();
     return *this->lines.at(index)
                 .first; // throws std::out_of_range on bad index.
 }
@@ -137,6 +172,8 @@ bool Program::Program::isIntron(uint64_t index) const
 
 uint64_t Program::Program::identifyIntrons()
 {
+    this->optimizedProgram.reset();
+
     // Create fake registers to identify accessed addresses.
     const Data::DataHandler& fakeRegisters =
         this->environment.getFakeDataSources().at(0);
@@ -205,8 +242,28 @@ const Data::ConstantHandler& Program::Program::cGetConstantHandler() const
     return this->constants;
 }
 
+bool Program::Program::optimize()
+{
+    try {
+        this->optimizedProgram =
+            std::make_shared<const OptimizedProgram>(*this);
+    }
+    catch (std::exception&) {
+        // Lines that can not be executed are handled by the
+        // ProgramExecutionEngine.
+        this->optimizedProgram.reset();
+    }
+    return this->optimizedProgram != nullptr;
+}
+
+const Program::OptimizedProgram* Program::Program::getOptimizedProgram() const
+{
+    return this->optimizedProgram.get();
+}
+
 Data::ConstantHandler& Program::Program::getConstantHandler()
 {
+    this->optimizedProgram.reset();
     return this->constants;
 }
 
@@ -60,6 +60,24 @@ double Program::ProgramExecutionEngine::executeProgram(
     // Reset registers and programCounter
     this->registers.resetData();
 
+    const OptimizedProgram* optimized = this->program->getOptimizedProgram();
+    if (optimized != nullptr) {
+        try {
+            const BytecodeProgram* bytecode = optimized->getBytecodeProgram();
+            return (bytecode != nullptr)
+                       ? this->executeBytecode(*optimized, *bytecode)
+                       : this->executeOptimizedProgram(*optimized);
+        }
+        catch (std::out_of_range& e) {
+            if (!ignoreException) {
+                throw e; // rethrow
+            }
+            // Instructions are pure, so executing the Lines of the Program
+            // gives the result with the faulty Lines ignored.
+            this->registers.resetData();
+        }
+    }
+
     iterateThroughtProgram(ignoreException);
 
     // Returns the 0-indexed register.
@@ -68,6 +86,176 @@ double Program::ProgramExecutionEngine::executeProgram(
                  .getSharedPointer<const double>());
 }
 
+double Program::ProgramExecutionEngine::executeOptimizedProgram(
+    const OptimizedProgram& optimized)
+{
+    const std::vector<OptimizedProgram::Operation>& operations =
+        optimized.getOperations();
+    const std::vector<double>& literals = optimized.getLiterals();
+    if (this->values.size() < operations.size()) {
+        this->values.resize(operations.size());
+    }
+
+    for (size_t idx = 0; idx < operations.size(); idx++) {
+        this->executeOperation(operations[idx], literals, idx);
+    }
+
+    const OptimizedProgram::Operand& result = optimized.getResult();
+    return (result.kind == OptimizedProgram::OperandKind::VALUE)
+               ? this->values[result.index]
+               : literals[result.index];
+}
+
+void Program::ProgramExecutionEngine::executeOperation(
+    const OptimizedProgram::Operation& operation,
+    const std::vector<double>& literals, size_t idx)
+{
+    auto getValue = [this, &literals](const OptimizedProgram::Operand& operand)
+        -> const double& {
+        return (operand.kind == OptimizedProgram::OperandKind::VALUE)
+                   ? this->values[operand.index]
+                   : literals[operand.index];
+    };
+
+    // Registers accessed as arrays
+    for (const std::pair<uint64_t, OptimizedProgram::Operand>& write :
+         operation.registerWrites) {
+        this->registers.setDataAt(typeid(double), write.first,
+                                  getValue(write.second));
+    }
+
+    this->operands.clear();
+    for (const OptimizedProgram::Operand& operand : operation.operands) {
+        if (operand.kind == OptimizedProgram::OperandKind::DATA_SOURCE) {
+            this->operands.push_back(
+                this->dataScsConstsAndRegs[operand.index].get().getDataAt(
+                    *operand.type, operand.location));
+        }
+        else {
+            this->operands.emplace_back(
+                &getValue(operand),
+                Data::UntypedSharedPtr::emptyDestructor<const double>());
+        }
+    }
+
+    this->values[idx] = operation.instruction->execute(this->operands);
+}
+
+double Program::ProgramExecutionEngine::executeBytecode(
+    const OptimizedProgram& optimized, const BytecodeProgram& bytecode)
+{
+    const std::vector<OptimizedProgram::Operation>& operations =
+        optimized.getOperations();
+    const std::vector<double>& literals = optimized.getLiterals();
+    if (this->values.size() < operations.size()) {
+        this->values.resize(operations.size());
+    }
+
+    // Base pointers of the arrays read by the Ops
+    const size_t nbDataSources = this->dataScsConstsAndRegs.size();
+    this->bytecodeBases.resize(BytecodeProgram::DATA_SOURCES_BASE +
+                               nbDataSources);
+    this->nativeDataSources.resize(nbDataSources, {nullptr, false});
+    this->bytecodeBases[BytecodeProgram::VALUES_BASE] = this->values.data();
+    this->bytecodeBases[BytecodeProgram::LITERALS_BASE] =
+        bytecode.getLiterals().data();
+    for (uint64_t dataSourceIdx : bytecode.getNativeDataSources()) {
+        const Data::DataHandler& dataSource =
+            this->dataScsConstsAndRegs.at(dataSourceIdx).get();
+        std::pair<const std::type_info*, bool>& nativeDataSource =
+            this->nativeDataSources[dataSourceIdx];
+        if (nativeDataSource.first != &typeid(dataSource)) {
+            nativeDataSource = {
+                &typeid(dataSource),
+                dynamic_cast<const Data::ArrayWrapper<double>*>(
+                    &dataSource) != nullptr};
+        }
+        const double* data =
+            (nativeDataSource.second)
+                ? static_cast<const Data::ArrayWrapper<double>&>(dataSource)
+                      .getNativeData()
+                : nullptr;
+        if (data == nullptr) {
+            return this->executeOptimizedProgram(optimized);
+        }
+        this->bytecodeBases[BytecodeProgram::DATA_SOURCES_BASE +
+                            dataSourceIdx] = data;
+    }
+
+    const double* const* bases = this->bytecodeBases.data();
+    double* values = this->values.data();
+    const BytecodeProgram::Op* op = bytecode.getOps().data();
+    const BytecodeProgram::Operand& result = bytecode.getResult();
+    double args[BytecodeProgram::MAX_NB_OPERANDS];
+
+#define BYTECODE_OPERAND(op, idx)                                              \
+    bases[(op)->operands[idx].base][(op)->operands[idx].offset]
+
+#define BYTECODE_CALL(op)                                                      \
+    for (uint32_t argIdx = 0; argIdx < (op)->nbOperands; argIdx++) {           \
+        args[argIdx] = BYTECODE_OPERAND(op, argIdx);                           \
+    }                                                                          \
+    values[(op)->value] = (op)->function(*(op)->instruction, args)
+
+#ifdef __GNUC__
+    // Threaded dispatch: each handler jumps to the handler of the next Op.
+    // The order of handlers follows the BytecodeProgram::Opcode enum.
+    static const void* const handlers[] = {&&call, &&call2, &&fused,
+                                           &&generic, &&end};
+#define BYTECODE_DISPATCH() goto* handlers[static_cast<size_t>(op->opcode)]
+#else
+#define BYTECODE_DISPATCH() goto dispatch
+#endif
+
+    BYTECODE_DISPATCH();
+
+#ifndef __GNUC__
+dispatch:
+    switch (op->opcode) {
+    case BytecodeProgram::Opcode::CALL:
+        goto call;
+    case BytecodeProgram::Opcode::CALL_2:
+        goto call2;
+    case BytecodeProgram::Opcode::FUSED:
+        goto fused;
+    case BytecodeProgram::Opcode::GENERIC:
+        goto generic;
+    case BytecodeProgram::Opcode::END:
+        goto end;
+    }
+#endif
+
+call:
+    BYTECODE_CALL(op);
+    op++;
+    BYTECODE_DISPATCH();
+
+call2:
+    args[0] = BYTECODE_OPERAND(op, 0);
+    args[1] = BYTECODE_OPERAND(op, 1);
+    values[op->value] = op->function(*op->instruction, args);
+    op++;
+    BYTECODE_DISPATCH();
+
+fused:
+    BYTECODE_CALL(op);
+    BYTECODE_CALL(op + 1);
+    op += 2;
+    BYTECODE_DISPATCH();
+
+generic:
+    this->executeOperation(operations[op->value], literals, op->value);
+    op++;
+    BYTECODE_DISPATCH();
+
+end:
+    return bases[result.base][result.offset];
+
+#undef BYTECODE_OPERAND
+#undef BYTECODE_CALL
+#undef BYTECODE_DISPATCH
+}
+
 void Program::ProgramExecutionEngine::processLine()
 {
     this->executeCurrentLine();
@@ -0,0 +1,149 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "program/optimizedProgram.h"
+#include "program/program.h"
+#include "program/superinstructionSet.h"
+#include "tpg/instrumented/tpgEdgeInstrumented.h"
+#include "tpg/tpgGraph.h"
+
+bool Program::SuperinstructionSet::add(uint64_t first, uint64_t second)
+{
+    return this->superinstructions.insert({first, second}).second;
+}
+
+bool Program::SuperinstructionSet::contains(uint64_t first,
+                                            uint64_t second) const
+{
+    return this->superinstructions.count({first, second}) != 0;
+}
+
+size_t Program::SuperinstructionSet::getNbSuperinstructions() const
+{
+    return this->superinstructions.size();
+}
+
+const std::set<std::pair<uint64_t, uint64_t>>& Program::SuperinstructionSet::
+    getSuperinstructions() const
+{
+    return this->superinstructions;
+}
+
+Program::SuperinstructionSet Program::SuperinstructionSet::profile(
+    const TPG::TPGGraph& graph, size_t maxNbSuperinstructions)
+{
+    std::map<std::pair<uint64_t, uint64_t>, uint64_t> counts;
+    std::unordered_set<const Program*> profiledPrograms;
+
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : graph.getEdges()) {
+        const Program& program = edge->getProgram();
+
+        // Weight of the pairs of the Program
+        uint64_t weight = 1;
+        const TPG::TPGEdgeInstrumented* instrumentedEdge =
+            dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge.get());
+        if (instrumentedEdge != nullptr) {
+            weight = instrumentedEdge->getNbVisits();
+        }
+        else if (!profiledPrograms.insert(&program).second) {
+            // Programs shared by several edges count once.
+            continue;
+        }
+        if (weight == 0) {
+            continue;
+        }
+
+        // Get the OptimizedProgram
+        std::unique_ptr<const OptimizedProgram> localOptimized;
+        const OptimizedProgram* optimized = program.getOptimizedProgram();
+        if (optimized == nullptr) {
+            try {
+                localOptimized =
+                    std::make_unique<const OptimizedProgram>(program);
+            }
+            catch (std::exception&) {
+                continue;
+            }
+            optimized = localOptimized.get();
+        }
+
+        // Count pairs of dependent Operations
+        const std::vector<OptimizedProgram::Operation>& operations =
+            optimized->getOperations();
+        for (size_t idx = 1; idx < operations.size(); idx++) {
+            const OptimizedProgram::Operation& first = operations.at(idx - 1);
+            const OptimizedProgram::Operation& second = operations.at(idx);
+            if (first.instruction->getScalarFunction() == nullptr ||
+                second.instruction->getScalarFunction() == nullptr) {
+                continue;
+            }
+            bool isDependent = std::any_of(
+                second.operands.begin(), second.operands.end(),
+                [idx](const OptimizedProgram::Operand& operand) {
+                    return operand.kind ==
+                               OptimizedProgram::OperandKind::VALUE &&
+                           operand.index == idx - 1;
+                });
+            if (isDependent) {
+                counts[{first.instructionIndex, second.instructionIndex}] +=
+                    weight;
+            }
+        }
+    }
+
+    // Keep the most frequent pairs (in a deterministic order for ties).
+    std::vector<std::pair<std::pair<uint64_t, uint64_t>, uint64_t>>
+        sortedCounts(counts.begin(), counts.end());
+    std::stable_sort(sortedCounts.begin(), sortedCounts.end(),
+                     [](const auto& a, const auto& b) {
+                         return a.second > b.second;
+                     });
+
+    SuperinstructionSet result;
+    for (size_t idx = 0;
+         idx < sortedCounts.size() && idx < maxNbSuperinstructions; idx++) {
+        result.add(sortedCounts.at(idx).first.first,
+                   sortedCounts.at(idx).first.second);
+    }
+    return result;
+}
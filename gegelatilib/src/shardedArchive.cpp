@@ -0,0 +1,97 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include "shardedArchive.h"
+
+Archive& ShardedArchive::getShard(uint64_t idx, size_t seed)
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+    auto iter = this->shards.find(idx);
+    if (iter == this->shards.end()) {
+        iter = this->shards
+                   .emplace(idx, std::make_unique<Archive>(
+                                     this->shardSize,
+                                     this->archivingProbability, seed,
+                                     this->deltaSnapshots))
+                   .first;
+    }
+    return *iter->second;
+}
+
+size_t ShardedArchive::getNbShards() const
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+    return this->shards.size();
+}
+
+size_t ShardedArchive::getNbRecordings() const
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+    size_t nbRecordings = 0;
+    for (const auto& shard : this->shards) {
+        nbRecordings += shard.second->getNbRecordings();
+    }
+    return nbRecordings;
+}
+
+void ShardedArchive::mergeInto(Archive& archive)
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+
+    // Scan the shards backward, starting from the last to identify the
+    // last archive.getMaxSize() recordings to keep (or less).
+    auto reverseIterator = this->shards.rbegin();
+    uint64_t nbRecordings = 0;
+    while (nbRecordings < archive.getMaxSize() &&
+           reverseIterator != this->shards.rend()) {
+        nbRecordings += reverseIterator->second->getNbRecordings();
+        reverseIterator++;
+    }
+
+    // Adopt identified recordings, skipping recordings in the first shard if
+    // needed.
+    while (reverseIterator != this->shards.rbegin()) {
+        reverseIterator--;
+        uint64_t firstRecording = 0;
+        if (nbRecordings > archive.getMaxSize()) {
+            firstRecording = nbRecordings - archive.getMaxSize();
+            nbRecordings = archive.getMaxSize();
+        }
+        archive.adoptRecordings(*reverseIterator->second, firstRecording);
+    }
+
+    this->shards.clear();
+}
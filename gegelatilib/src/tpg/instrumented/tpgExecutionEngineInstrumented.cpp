@@ -81,3 +81,16 @@ void TPG::TPGExecutionEngineInstrumented::clearTraceHistory()
 {
     this->traceHistory.clear();
 }
+
+Util::MemoryFootprint TPG::TPGExecutionEngineInstrumented::getMemoryFootprint()
+    const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("traceHistory",
+                  Util::MemoryFootprint::getHeapBytes(this->traceHistory));
+    for (const std::vector<const TPGVertex*>& trace : this->traceHistory) {
+        footprint.add("traceHistory",
+                      Util::MemoryFootprint::getHeapBytes(trace));
+    }
+    return footprint;
+}
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
 
 #include "tpg/tpgGraph.h"
 
@@ -208,6 +209,10 @@ const TPG::TPGEdge& TPG::TPGGraph::addNewEdge(
     }
     (*dstVertex)->addIncomingEdge(&newEdge);
 
+    if (this->edgeTracking) {
+        this->modifiedEdges.insert(&newEdge);
+    }
+
     // return the new edge
     return newEdge;
 }
@@ -217,6 +222,40 @@ const std::list<std::unique_ptr<TPG::TPGEdge>>& TPG::TPGGraph::getEdges() const
     return this->edges;
 }
 
+Util::MemoryFootprint TPG::TPGGraph::getMemoryFootprint() const
+{
+    Util::MemoryFootprint footprint;
+    footprint.add("object", sizeof(TPGGraph));
+
+    footprint.add("vertices",
+                  Util::MemoryFootprint::getHeapBytes(this->vertices));
+    for (const TPGVertex* vertex : this->vertices) {
+        footprint.add("vertices",
+                      ((dynamic_cast<const TPGAction*>(vertex) != nullptr)
+                           ? sizeof(TPGAction)
+                           : sizeof(TPGTeam)) +
+                          Util::MemoryFootprint::getHeapBytes(
+                              vertex->getIncomingEdges()) +
+                          Util::MemoryFootprint::getHeapBytes(
+                              vertex->getOutgoingEdges()));
+    }
+
+    footprint.add("edges", Util::MemoryFootprint::getHeapBytes(this->edges) +
+                               this->edges.size() * sizeof(TPGEdge) +
+                               Util::MemoryFootprint::getHeapBytes(
+                                   this->modifiedEdges));
+
+    // Programs may be shared between edges.
+    std::unordered_set<const Program::Program*> programs;
+    for (const std::unique_ptr<TPGEdge>& edge : this->edges) {
+        const Program::Program* program = &edge->getProgram();
+        if (programs.insert(program).second) {
+            footprint.add("programs", program->getMemoryFootprint());
+        }
+    }
+    return footprint;
+}
+
 void TPG::TPGGraph::removeEdge(const TPGEdge& edge)
 {
     // Get the edge (if it is in the graph)
@@ -236,6 +275,7 @@ void TPG::TPGGraph::removeEdge(const TPGEdge& edge)
     (*this->findVertex(iterator->get()->getDestination()))
         ->removeIncomingEdge(iterator->get());
     // Remove the edge
+    this->modifiedEdges.erase(iterator->get());
     this->edges.erase(iterator);
 }
 
@@ -273,6 +313,9 @@ bool TPG::TPGGraph::setEdgeDestination(const TPGEdge& edge,
         (*iterNewDestination)->addIncomingEdge(iterEdge->get());
         // Set the destination
         iterEdge->get()->setDestination(*iterNewDestination);
+        if (this->edgeTracking) {
+            this->modifiedEdges.insert(iterEdge->get());
+        }
         return true;
     }
     else {
@@ -297,6 +340,9 @@ bool TPG::TPGGraph::setEdgeSource(const TPGEdge& edge, const TPGVertex& newSrc)
         (*iterNewSrc)->addOutgoingEdge(iterEdge->get());
         // Set the destination
         iterEdge->get()->setSource(*(iterNewSrc));
+        if (this->edgeTracking) {
+            this->modifiedEdges.insert(iterEdge->get());
+        }
         return true;
     }
     else {
@@ -304,6 +350,30 @@ bool TPG::TPGGraph::setEdgeSource(const TPGEdge& edge, const TPGVertex& newSrc)
     }
 }
 
+void TPG::TPGGraph::setEdgeTracking(bool enabled)
+{
+    this->edgeTracking = enabled;
+    if (!enabled) {
+        this->modifiedEdges.clear();
+    }
+}
+
+bool TPG::TPGGraph::isEdgeTracking() const
+{
+    return this->edgeTracking;
+}
+
+const std::unordered_set<const TPG::TPGEdge*>& TPG::TPGGraph::
+    getModifiedEdges() const
+{
+    return this->modifiedEdges;
+}
+
+void TPG::TPGGraph::clearModifiedEdges()
+{
+    this->modifiedEdges.clear();
+}
+
 std::list<TPG::TPGVertex*>::iterator TPG::TPGGraph::findVertex(
     const TPG::TPGVertex* vertex)
 {
@@ -325,3 +395,10 @@ void TPG::TPGGraph::clearProgramIntrons()
         edge.get()->getProgram().clearIntrons();
     }
 }
+
+void TPG::TPGGraph::optimizePrograms()
+{
+    for (auto& edge : this->edges) {
+        edge.get()->getProgram().optimize();
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include "util/memoryFootprint.h"
+
+void Util::MemoryFootprint::add(const std::string& component, size_t nbBytes)
+{
+    this->components[component] += nbBytes;
+}
+
+void Util::MemoryFootprint::add(const std::string& prefix,
+                                const MemoryFootprint& other)
+{
+    for (const auto& component : other.components) {
+        this->components[prefix + "." + component.first] += component.second;
+    }
+}
+
+void Util::MemoryFootprint::set(const std::string& component, size_t nbBytes)
+{
+    this->components[component] = nbBytes;
+}
+
+size_t Util::MemoryFootprint::get(const std::string& component) const
+{
+    size_t nbBytes = 0;
+    const std::string groupPrefix = component + ".";
+    // Components of the group directly follow the component in the map.
+    for (auto iter = this->components.lower_bound(component);
+         iter != this->components.end(); iter++) {
+        if (iter->first == component) {
+            nbBytes += iter->second;
+        }
+        else if (iter->first.compare(0, groupPrefix.size(), groupPrefix) ==
+                 0) {
+            nbBytes += iter->second;
+        }
+        else if (iter->first.compare(0, component.size(), component) != 0) {
+            break;
+        }
+    }
+    return nbBytes;
+}
+
+size_t Util::MemoryFootprint::getTotal() const
+{
+    size_t nbBytes = 0;
+    for (const auto& component : this->components) {
+        nbBytes += component.second;
+    }
+    return nbBytes;
+}
+
+const std::map<std::string, size_t>& Util::MemoryFootprint::getComponents()
+    const
+{
+    return this->components;
+}
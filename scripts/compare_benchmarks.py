@@ -0,0 +1,90 @@
+# This script compares the results of the GEGELATI benchmarks with a baseline.
+#
+# Both files are JSON files produced by the runBenchmarks executable with the
+# --benchmark_out=<file> --benchmark_out_format=json options.
+# For each benchmark present in both files, the ratio between the new and the
+# baseline time is printed. When benchmarks were repeated, with the
+# --benchmark_repetitions=<n> option, their median time is compared. The script returns a non-zero exit code if any
+# benchmark is slower than the baseline by more than the given threshold.
+#
+# Usage: python3 compare_benchmarks.py <new.json> [<baseline.json>]
+#                                      [--threshold <ratio>] [--cpu]
+#
+# Author: K. Desnos
+# License: CeCILL-C
+
+import argparse
+import json
+import os
+import sys
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                "..", "benchmarks", "baseline.json")
+
+# Time units used by Google Benchmark, in nanoseconds.
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(path, time_key):
+    """Returns a dictionary of benchmark times in ns, indexed by name.
+
+    The median of repeated benchmarks is used when present, and their other
+    aggregates (mean, stddev, cv) are skipped.
+    """
+    with open(path, "r") as file:
+        data = json.load(file)
+    results = {}
+    medians = {}
+    for bench in data["benchmarks"]:
+        unit = TIME_UNITS[bench.get("time_unit", "ns")]
+        name = bench.get("run_name", bench["name"])
+        if bench.get("run_type", "iteration") == "iteration":
+            results[name] = bench[time_key] * unit
+        elif bench.get("aggregate_name") == "median":
+            medians[name] = bench[time_key] * unit
+    results.update(medians)
+    return results
+
+
+parser = argparse.ArgumentParser(
+    description="Compare GEGELATI benchmark results with a baseline.")
+parser.add_argument("new", help="JSON file with the new results.")
+parser.add_argument("baseline", nargs="?", default=DEFAULT_BASELINE,
+                    help="JSON file with the baseline results.")
+parser.add_argument("--threshold", type=float, default=0.10,
+                    help="Tolerated relative slowdown (default: 0.10).")
+parser.add_argument("--cpu", action="store_true",
+                    help="Compare CPU time instead of real time.")
+args = parser.parse_args()
+
+time_key = "cpu_time" if args.cpu else "real_time"
+baseline = load_results(args.baseline, time_key)
+new = load_results(args.new, time_key)
+
+regressions = []
+name_width = max([len(name) for name in new] + [len("Benchmark")])
+print("{:<{w}} {:>14} {:>14} {:>8}".format("Benchmark", "Baseline (ns)",
+                                          "New (ns)", "Ratio", w=name_width))
+for name, time in new.items():
+    if name not in baseline:
+        print("{:<{w}} {:>14} {:>14.1f} {:>8}".format(name, "-", time, "new",
+                                                     w=name_width))
+        continue
+    ratio = time / baseline[name]
+    flag = ""
+    if ratio > 1.0 + args.threshold:
+        flag = "  <-- regression"
+        regressions.append(name)
+    print("{:<{w}} {:>14.1f} {:>14.1f} {:>8.3f}{}".format(
+        name, baseline[name], time, ratio, flag, w=name_width))
+
+for name in baseline:
+    if name not in new:
+        print("{:<{w}} {:>14.1f} {:>14} {:>8}".format(name, baseline[name], "-",
+                                                     "missing", w=name_width))
+
+if regressions:
+    print("\n{} benchmark(s) slower than the baseline by more than {:.0%}."
+          .format(len(regressions), args.threshold))
+    sys.exit(1)
+print("\nNo regression above {:.0%}.".format(args.threshold))
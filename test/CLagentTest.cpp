@@ -129,7 +129,7 @@ class CLagentTest : public ::testing::Test
 
      Learn::CLagent la(le, set, params);
 
-     la.init();
+     la.init(1);
 
      // we add a logger to la to check it logs things
      std::ofstream o("tempFileForTest", std::ofstream::out);
@@ -239,11 +239,63 @@ TEST_F(CLagentTest, EvalRootCL)
     std::shared_ptr<Learn::EvaluationResult> result;
     auto job = *la.makeJob(la.getTPGGraph()->getRootVertices().at(0),
                            Learn::LearningMode::TRAINING);
-    Learn::Job previousJob=nullptr;
-    ASSERT_NO_THROW(
-        result = la.evaluateJobCL(tee, job, previousJob, 0, Learn::LearningMode::TRAINING, le))
+    ASSERT_NO_THROW(result = la.evaluateJobCL(
+                        tee, job, 0, Learn::LearningMode::TRAINING, le))
                     << "Evaluation from a root failed.";
     ASSERT_LE(result->getResult(), 1.0)
                     << "Average score should not exceed the score of a perfect player.";
 
-}
\ No newline at end of file
+}
+
+TEST_F(CLagentTest, EvaluateAllRootsCLParallel)
+{
+    // Check that the parallel evaluation of chains leads to the exact same
+    // results as the sequential one.
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 5;
+
+    params.nbThreads = 1;
+    Learn::CLagent la(le, set, params);
+    la.init(0);
+    auto results = la.evaluateAllRootsCL(0, Learn::LearningMode::TRAINING);
+
+    params.nbThreads = 3;
+    Learn::CLagent laParallel(le, set, params);
+    laParallel.init(0);
+    auto resultsParallel =
+        laParallel.evaluateAllRootsCL(0, Learn::LearningMode::TRAINING);
+
+    ASSERT_EQ(results.size(), resultsParallel.size())
+        << "Result maps have a different size.";
+    auto iter = results.begin();
+    auto iterParallel = resultsParallel.begin();
+    while (iter != results.end()) {
+        ASSERT_EQ(iter->first->getResult(), iterParallel->first->getResult())
+            << "Average score between sequential and parallel evaluations are "
+               "different.";
+        ASSERT_EQ(iter->first->getVariance(),
+                  iterParallel->first->getVariance())
+            << "Score variance between sequential and parallel evaluations "
+               "are different.";
+        iter++;
+        iterParallel++;
+    }
+
+    // Check archives
+    ASSERT_GT(la.getArchive().getNbRecordings(), 0)
+        << "For the archive determinism tests to be meaningful, Archive should "
+           "not be empty.";
+    ASSERT_EQ(la.getArchive().getNbRecordings(),
+              laParallel.getArchive().getNbRecordings())
+        << "Archives have different sizes.";
+    for (auto i = 0; i < la.getArchive().getNbRecordings(); i++) {
+        ASSERT_EQ(la.getArchive().at(i).dataHash,
+                  laParallel.getArchive().at(i).dataHash)
+            << "Archives have different content.";
+        ASSERT_EQ(la.getArchive().at(i).result,
+                  laParallel.getArchive().at(i).result)
+            << "Archives have different content.";
+    }
+}
@@ -39,6 +39,7 @@
 
 #include "data/dataHandler.h"
 #include "data/primitiveTypeArray.h"
+#include "data/snapshotStore.h"
 #include "instructions/addPrimitiveType.h"
 #include "instructions/lambdaInstruction.h"
 #include "instructions/set.h"
@@ -47,6 +48,7 @@
 #include "program/program.h"
 
 #include "archive.h"
+#include "shardedArchive.h"
 
 class ArchiveTest : public ::testing::Test
 {
@@ -230,7 +232,7 @@ TEST_F(ArchiveTest, SetSeed)
     }
     // With a seed set to 0, result is available in
     // AddRecordingWithProbabilityTests
-    ASSERT_EQ(archive.getNbRecordings(), 7)
+    ASSERT_EQ(archive.getNbRecordings(), 8)
         << "Number or recordings in the archive is incorrect with a known "
            "seed.";
 }
@@ -313,3 +315,275 @@ TEST_F(ArchiveTest, Clear)
     ASSERT_EQ(archive.getNbDataHandlers(), 0)
         << "Number or dataHandlers copied in the archive is incorrect.";
 }
+
+TEST_F(ArchiveTest, SharedSnapshots)
+{
+    Archive archive(3);
+    Data::PrimitiveTypeArray<int>& d =
+        (Data::PrimitiveTypeArray<int>&)vect.at(1).get();
+
+    // Only the int DataHandler changes between recordings.
+    for (int i = 0; i < 5; i++) {
+        d.setDataAt(typeid(int), 0, i);
+        archive.addRecording(p, vect, (double)i);
+    }
+    ASSERT_EQ(archive.getNbDataHandlers(), 3)
+        << "Number or dataHandlers in the archive is incorrect.";
+    ASSERT_EQ(archive.getNbSnapshots(), 4)
+        << "Unchanged DataHandler should be copied only once.";
+
+    // All sets of DataHandler share the same copy of the unchanged one.
+    const Data::DataHandler* sharedCopy =
+        &archive.getDataHandlers().at(archive.at(0).dataHash).at(0).get();
+    for (int i = 1; i < 3; i++) {
+        ASSERT_EQ(
+            &archive.getDataHandlers().at(archive.at(i).dataHash).at(0).get(),
+            sharedCopy);
+        ASSERT_NE(
+            &archive.getDataHandlers().at(archive.at(i).dataHash).at(1).get(),
+            &archive.getDataHandlers().at(archive.at(0).dataHash).at(1).get());
+    }
+    ASSERT_EQ(sharedCopy->getHash(), vect.at(0).get().getHash());
+
+    archive.clear();
+    ASSERT_EQ(archive.getNbSnapshots(), 0)
+        << "Snapshots should be freed when clearing the archive.";
+}
+
+TEST_F(ArchiveTest, SnapshotStore)
+{
+    Data::SnapshotStore store;
+    Data::SnapshotStore other;
+    const Data::DataHandler& dh = vect.at(0).get();
+
+    size_t hash = store.acquire(dh);
+    ASSERT_EQ(hash, dh.getHash());
+    const Data::DataHandler* copy = store.get(hash);
+    ASSERT_NE(copy, &dh) << "A snapshot should be a copy of the DataHandler.";
+    ASSERT_EQ(copy->getHash(), hash);
+    ASSERT_EQ(store.acquire(dh), hash);
+    ASSERT_EQ(store.get(hash), copy)
+        << "Identical states should share a single snapshot.";
+    ASSERT_EQ(store.getNbSnapshots(), 1);
+    ASSERT_EQ(store.getNbReferences(hash), 2);
+
+    ASSERT_THROW(other.release(hash), std::out_of_range)
+        << "Releasing a snapshot from another store should fail.";
+    ASSERT_NO_THROW(other.adopt(store, hash));
+    ASSERT_EQ(other.get(hash), copy)
+        << "Adopted snapshot should be moved, not cloned.";
+    ASSERT_THROW(other.adopt(store, vect.at(1).get().getHash()),
+                 std::out_of_range)
+        << "Only snapshots owned by the other store can be adopted.";
+    store.clear();
+
+    ASSERT_NO_THROW(other.release(hash));
+    ASSERT_EQ(other.getNbSnapshots(), 0)
+        << "Snapshot should be freed after its last release.";
+}
+
+TEST_F(ArchiveTest, SnapshotStoreDeltaEncoding)
+{
+    Data::SnapshotStore store(true);
+    Data::PrimitiveTypeArray<double> data(1024);
+    std::unique_ptr<Data::DataHandler> buffer;
+
+    size_t baseHash = store.acquire(data);
+    data.setDataAt(typeid(double), 100, 1.5);
+    size_t hash = store.acquire(data);
+    ASSERT_EQ(store.getNbSnapshots(), 2);
+    ASSERT_EQ(store.getNbDeltas(), 1)
+        << "A state differing by a single block should be delta-encoded.";
+    ASSERT_EQ(store.get(hash), nullptr);
+    ASSERT_EQ(store.getNbReferences(baseHash), 2)
+        << "A delta snapshot should reference its base.";
+    ASSERT_LT(2 * store.getMemoryFootprint().get("deltas"),
+              store.getMemoryFootprint().get("copies"));
+
+    // Materialize the snapshots
+    const Data::DataHandler& materialized = store.materialize(hash, buffer);
+    ASSERT_EQ(&materialized, buffer.get());
+    ASSERT_EQ(materialized.getHash(), hash)
+        << "Materialized snapshot should be in the recorded state.";
+    ASSERT_EQ(&store.materialize(baseHash, buffer), store.get(baseHash))
+        << "Copies should be returned without materialization.";
+
+    // A state differing on all blocks is copied and becomes the new base.
+    for (int i = 0; i < 1024; i++) {
+        data.setDataAt(typeid(double), i, (double)i);
+    }
+    size_t newBaseHash = store.acquire(data);
+    ASSERT_NE(store.get(newBaseHash), nullptr);
+    data.setDataAt(typeid(double), 0, -1.0);
+    size_t newHash = store.acquire(data);
+    ASSERT_EQ(store.getNbDeltas(), 2);
+    ASSERT_EQ(store.getNbReferences(newBaseHash), 2);
+    ASSERT_EQ(store.materialize(newHash, buffer).getHash(), newHash);
+
+    // A base is freed with the last snapshot referencing it.
+    store.release(baseHash);
+    ASSERT_EQ(store.getNbReferences(baseHash), 1);
+    store.release(hash);
+    ASSERT_EQ(store.getNbSnapshots(), 2)
+        << "Base should be freed with its last delta snapshot.";
+
+    // Without the flag, all snapshots are copies.
+    Data::SnapshotStore fullStore;
+    fullStore.acquire(data);
+    data.setDataAt(typeid(double), 0, -2.0);
+    fullStore.acquire(data);
+    ASSERT_EQ(fullStore.getNbDeltas(), 0);
+}
+
+TEST_F(ArchiveTest, AdoptRecordings)
+{
+    Archive archive(3);
+    Archive other(10);
+    Data::PrimitiveTypeArray<int>& d =
+        (Data::PrimitiveTypeArray<int>&)vect.at(1).get();
+
+    // Fill the other archive with 4 recordings on 4 different data
+    for (int i = 0; i < 4; i++) {
+        d.setDataAt(typeid(int), 0, i);
+        other.addRecording(p, vect, (double)i);
+    }
+    const Data::DataHandler* lastCopy =
+        &other.getDataHandlers().at(other.at(3).dataHash).at(0).get();
+
+    ASSERT_THROW(archive.adoptRecordings(archive), std::runtime_error)
+        << "An archive should not adopt its own recordings.";
+
+    // Adopt all but the first recording
+    ASSERT_NO_THROW(archive.adoptRecordings(other, 1))
+        << "Adoption of recordings failed.";
+    ASSERT_EQ(other.getNbRecordings(), 0)
+        << "Adopted archive should be cleared.";
+    ASSERT_EQ(other.getNbDataHandlers(), 0)
+        << "Adopted archive should be cleared.";
+    ASSERT_EQ(archive.getNbRecordings(), 3)
+        << "Number or recordings in the archive is incorrect.";
+    ASSERT_EQ(archive.getNbDataHandlers(), 3)
+        << "Number or dataHandlers in the archive is incorrect.";
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(archive.at(i).result, (double)(i + 1))
+            << "Recordings were not adopted in order.";
+    }
+
+    // DataHandler copies were moved, not cloned.
+    ASSERT_EQ(&archive.getDataHandlers().at(archive.at(2).dataHash).at(0).get(),
+              lastCopy)
+        << "DataHandler copies should be moved during the adoption.";
+
+    // Adopting more recordings than the archive size keeps the last ones.
+    for (int i = 0; i < 5; i++) {
+        d.setDataAt(typeid(int), 0, 10 + i);
+        other.addRecording(p, vect, 10.0 + i);
+    }
+    archive.adoptRecordings(other);
+    ASSERT_EQ(archive.getNbRecordings(), 3);
+    ASSERT_EQ(archive.getNbDataHandlers(), 3);
+    ASSERT_EQ(archive.at(0).result, 12.0);
+    ASSERT_EQ(archive.at(2).result, 14.0);
+}
+
+TEST_F(ArchiveTest, DeltaSnapshots)
+{
+    Data::PrimitiveTypeArray<double> data(1024);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> dataVect{
+        data};
+    Archive archive(3, 1.0, 0, true);
+    Archive other(10, 1.0, 0, true);
+
+    for (int i = 0; i < 5; i++) {
+        data.setDataAt(typeid(double), 0, (double)i);
+        other.addRecording(p, dataVect, (double)i);
+    }
+    ASSERT_EQ(other.getNbSnapshots(), 5);
+    ASSERT_THROW(other.getDataHandlers(), std::runtime_error)
+        << "Delta snapshots should not be accessible without "
+           "materialization.";
+
+    // Adopted delta snapshots keep their base.
+    ASSERT_NO_THROW(archive.adoptRecordings(other, 1));
+    ASSERT_EQ(archive.getNbDataHandlers(), 3);
+    ASSERT_EQ(archive.getNbSnapshots(), 4)
+        << "The base of adopted delta snapshots should be adopted with them.";
+
+    // Each set is materialized in its recorded state.
+    size_t nbSets = 0;
+    archive.forEachDataHandlers(
+        [&nbSets](size_t hash,
+                  const std::vector<std::reference_wrapper<
+                      const Data::DataHandler>>& dHandlers) {
+            ASSERT_EQ(dHandlers.size(), 1);
+            ASSERT_EQ(Archive::getCombinedHash(dHandlers), hash);
+            nbSets++;
+        });
+    ASSERT_EQ(nbSets, 3);
+
+    // Evicting all recordings frees the snapshots.
+    for (int i = 0; i < 3; i++) {
+        data.setDataAt(typeid(double), 0, 10.0 + i);
+        archive.addRecording(p, dataVect, 10.0 + i);
+    }
+    ASSERT_EQ(archive.getNbSnapshots(), 4);
+    archive.clear();
+    ASSERT_EQ(archive.getNbSnapshots(), 0);
+}
+
+TEST_F(ArchiveTest, ShardedArchive)
+{
+    Data::PrimitiveTypeArray<int>& d =
+        (Data::PrimitiveTypeArray<int>&)vect.at(1).get();
+
+    ShardedArchive shardedArchive(5, 0.5);
+    ASSERT_EQ(shardedArchive.getNbShards(), 0);
+
+    // Fill shards in reverse index order, with the same data in several
+    // shards.
+    for (int shard = 3; shard >= 0; shard--) {
+        Archive& archive = shardedArchive.getShard(shard, shard);
+        for (int i = 0; i < 4; i++) {
+            d.setDataAt(typeid(int), 0, i);
+            archive.addRecording(p, vect, shard * 10.0 + i);
+        }
+    }
+    ASSERT_EQ(&shardedArchive.getShard(2), &shardedArchive.getShard(2, 42))
+        << "An existing shard should be returned when accessed again.";
+    ASSERT_EQ(shardedArchive.getNbShards(), 4);
+
+    // Build the expected content with a sequential archive
+    Archive expected(6);
+    size_t nbRecordings = 0;
+    for (int shard = 0; shard < 4; shard++) {
+        Archive archive(5, 0.5, shard);
+        for (int i = 0; i < 4; i++) {
+            d.setDataAt(typeid(int), 0, i);
+            archive.addRecording(p, vect, shard * 10.0 + i);
+        }
+        nbRecordings += archive.getNbRecordings();
+        for (int i = 0; i < archive.getNbRecordings(); i++) {
+            expected.addRecording(
+                p, archive.getDataHandlers().at(archive.at(i).dataHash),
+                archive.at(i).result, true);
+        }
+    }
+    ASSERT_EQ(shardedArchive.getNbRecordings(), nbRecordings);
+    ASSERT_GT(nbRecordings, 6)
+        << "For the test to be meaningful, shards should hold more "
+           "recordings than the merged archive.";
+
+    Archive merged(6);
+    ASSERT_NO_THROW(shardedArchive.mergeInto(merged))
+        << "Merging a ShardedArchive failed.";
+    ASSERT_EQ(shardedArchive.getNbShards(), 0)
+        << "Shards should be removed after the merge.";
+    ASSERT_EQ(merged.getNbRecordings(), expected.getNbRecordings());
+    ASSERT_EQ(merged.getNbDataHandlers(), expected.getNbDataHandlers());
+    for (int i = 0; i < merged.getNbRecordings(); i++) {
+        ASSERT_EQ(merged.at(i).dataHash, expected.at(i).dataHash)
+            << "Merged archive differs from the sequential one.";
+        ASSERT_EQ(merged.at(i).result, expected.at(i).result)
+            << "Merged archive differs from the sequential one.";
+    }
+}
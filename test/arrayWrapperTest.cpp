@@ -62,6 +62,19 @@ TEST(ArrayWrapperTest, SetPointer)
            "ArrayWrapper should fail.";
 }
 
+TEST(ArrayWrapperTest, GetNativeData)
+{
+    Data::ArrayWrapper<double> d(3, nullptr);
+    std::vector<double> values{0.0, 1.1, 2.2};
+
+    ASSERT_EQ(d.getNativeData(), nullptr)
+        << "Native data of an ArrayWrapper without container should be null.";
+    d.setPointer(&values);
+    ASSERT_EQ(d.getNativeData(), values.data())
+        << "Native data of an ArrayWrapper should point to the wrapped "
+           "container data.";
+}
+
 TEST(ArrayWrapperTest, CanProvideTemplateType)
 {
     Data::DataHandler* d = new Data::ArrayWrapper<double>(4);
@@ -0,0 +1,154 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "environment/batchPendulumLE.h"
+#include "environment/pendulumLE.h"
+
+class BatchPendulumLETest : public ::testing::Test
+{
+  protected:
+    const std::vector<double> actions{0.05, 0.1, 0.2, 0.4, 0.6, 0.8, 1.0};
+};
+
+TEST_F(BatchPendulumLETest, Constructor)
+{
+    BatchPendulumLE* le = nullptr;
+    ASSERT_NO_THROW(le = new BatchPendulumLE(actions, 4))
+        << "Construction of the BatchPendulumLE failed.";
+    ASSERT_EQ(le->getNbLanes(), 4) << "Incorrect number of lanes.";
+    ASSERT_EQ(le->getNbActions(), actions.size() * 2 + 1)
+        << "Incorrect number of actions.";
+    ASSERT_TRUE(le->allTerminal())
+        << "Lanes should be frozen until they are reset.";
+    ASSERT_NO_THROW(delete le) << "Destruction of the BatchPendulumLE failed.";
+
+    ASSERT_THROW(BatchPendulumLE(actions, 0), std::runtime_error)
+        << "Construction of a BatchPendulumLE without lanes should fail.";
+}
+
+TEST_F(BatchPendulumLETest, ResetAll)
+{
+    BatchPendulumLE le(actions, 4);
+    PendulumLE scalarLE(actions);
+
+    ASSERT_THROW(le.resetAll({0, 1, 2, 3, 4}), std::runtime_error)
+        << "Resetting more lanes than available should fail.";
+
+    ASSERT_NO_THROW(le.resetAll({0, 1, 2}));
+    for (size_t lane = 0; lane < 3; lane++) {
+        scalarLE.reset(lane);
+        ASSERT_EQ(le.getAngle(lane), scalarLE.getAngle())
+            << "Initial angle differs from the PendulumLE one.";
+        ASSERT_EQ(le.getVelocity(lane), scalarLE.getVelocity())
+            << "Initial velocity differs from the PendulumLE one.";
+        ASSERT_EQ(le.getTerminalMask().at(lane), 0)
+            << "Reset lanes should not be terminal.";
+    }
+    ASSERT_NE(le.getTerminalMask().at(3), 0)
+        << "Lanes not reset should be frozen.";
+}
+
+TEST_F(BatchPendulumLETest, DoActionsMatchesPendulumLE)
+{
+    const size_t nbLanes = 5;
+    BatchPendulumLE le(actions, nbLanes);
+    std::vector<PendulumLE> scalarLEs(nbLanes, PendulumLE(actions));
+
+    std::vector<size_t> seeds;
+    for (size_t lane = 0; lane < nbLanes; lane++) {
+        seeds.push_back(lane * 7);
+        scalarLEs.at(lane).reset(lane * 7);
+    }
+    le.resetAll(seeds);
+
+    ASSERT_THROW(le.doActions({0}), std::runtime_error)
+        << "Doing actions with a wrong number of actions should fail.";
+
+    // Lane 0 always applies no torque, others follow a deterministic
+    // pattern. Enough steps to fill the reward history several times.
+    std::vector<uint64_t> actionIDs(nbLanes);
+    for (uint64_t step = 0; step < 1000; step++) {
+        for (size_t lane = 0; lane < nbLanes; lane++) {
+            actionIDs.at(lane) = (lane == 0)
+                                     ? 0
+                                     : (step * lane) % le.getNbActions();
+            if (!scalarLEs.at(lane).isTerminal()) {
+                scalarLEs.at(lane).doAction(actionIDs.at(lane));
+            }
+        }
+        le.doActions(actionIDs);
+
+        for (size_t lane = 0; lane < nbLanes; lane++) {
+            const PendulumLE& scalarLE = scalarLEs.at(lane);
+            ASSERT_EQ(le.getAngle(lane), scalarLE.getAngle())
+                << "Angle of lane " << lane << " differs at step " << step;
+            ASSERT_EQ(le.getVelocity(lane), scalarLE.getVelocity())
+                << "Velocity of lane " << lane << " differs at step " << step;
+            ASSERT_EQ(le.isTerminal(lane), scalarLE.isTerminal())
+                << "Termination of lane " << lane << " differs at step "
+                << step;
+            ASSERT_EQ(le.getTerminalMask().at(lane) != 0,
+                      scalarLE.isTerminal())
+                << "Terminal mask of lane " << lane << " is incorrect.";
+            ASSERT_EQ(le.getNbActionsExecuted(lane),
+                      scalarLE.getNbActionsExecuted())
+                << "Number of actions of lane " << lane << " differs.";
+            ASSERT_EQ(le.getScore(lane), scalarLE.getScore())
+                << "Score of lane " << lane << " differs at step " << step;
+        }
+    }
+}
+
+TEST_F(BatchPendulumLETest, GetDataSources)
+{
+    BatchPendulumLE le(actions, 2);
+    le.resetAll({3, 4});
+    le.doActions({1, 2});
+
+    auto dataSources = le.getDataSources(1);
+    ASSERT_EQ(dataSources.size(), 1) << "Incorrect number of data sources.";
+    const Data::PrimitiveTypeArray<double>& state =
+        (const Data::PrimitiveTypeArray<double>&)dataSources.at(0).get();
+    ASSERT_EQ(state.getNativeDataAt(0), le.getAngle(1))
+        << "Angle exposed in the data source is incorrect.";
+    ASSERT_EQ(state.getNativeDataAt(1), le.getVelocity(1))
+        << "Velocity exposed in the data source is incorrect.";
+
+    ASSERT_THROW(le.getDataSources(2), std::out_of_range)
+        << "Getting data sources of a non-existing lane should fail.";
+}
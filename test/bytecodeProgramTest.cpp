@@ -0,0 +1,442 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "data/arrayWrapper.h"
+#include "data/constant.h"
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/multByConstant.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/bytecodeProgram.h"
+#include "program/line.h"
+#include "program/optimizedProgram.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+#include "program/superinstructionSet.h"
+#include "tpg/instrumented/tpgExecutionEngineInstrumented.h"
+#include "tpg/instrumented/tpgInstrumentedFactory.h"
+#include "tpg/tpgGraph.h"
+
+class BytecodeProgramTest : public ::testing::Test
+{
+  protected:
+    const size_t size1{8};
+    const size_t size2{4};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Data::PrimitiveTypeArray<double> currentState{size1};
+    Data::PrimitiveTypeArray<int> intState{size2};
+    Instructions::Set set;
+    Environment* e = nullptr;
+    Program::Program* p = nullptr;
+
+    virtual void SetUp()
+    {
+        for (size_t idx = 0; idx < size1; idx++) {
+            currentState.setDataAt(typeid(double), idx, 1.5 * idx - 2.0);
+        }
+        for (size_t idx = 0; idx < size2; idx++) {
+            intState.setDataAt(typeid(int), idx, (int)idx - 1);
+        }
+        vect.push_back(currentState);
+        vect.push_back(intState);
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::MultByConstant<double>()));
+        set.add(*(new Instructions::LambdaInstruction<const double[2]>(
+            [](const double a[2]) { return a[0] - 2.0 * a[1]; })));
+        set.add(*(new Instructions::LambdaInstruction<Data::Constant, double>(
+            [](Data::Constant a, double b) { return (double)a + b; })));
+        set.add(*(new Instructions::LambdaInstruction<double>([](double a) {
+            if (a < 0.0) {
+                throw std::out_of_range("Negative operand.");
+            }
+            return a * a;
+        })));
+        set.add(*(new Instructions::AddPrimitiveType<int>()));
+        set.add(
+            *(new Instructions::LambdaInstruction<double, double, double>(
+                [](double a, double b, double c) { return a * b + c; })));
+
+        e = new Environment(set, vect, 8, 2);
+        e->setBytecodeExecution(true);
+        p = new Program::Program(*e);
+        p->getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                          Data::Constant{5});
+        p->getConstantHandler().setDataAt(typeid(Data::Constant), 1,
+                                          Data::Constant{-3});
+    }
+
+    virtual void TearDown()
+    {
+        delete p;
+        delete e;
+        for (size_t idx = 0; idx < set.getNbInstructions(); idx++) {
+            delete (&set.getInstruction(idx));
+        }
+    }
+
+    /// Add a Line with the given instruction, destination and operands.
+    void addLine(uint64_t instruction, uint64_t destination,
+                 std::vector<std::pair<uint64_t, uint64_t>> operands)
+    {
+        Program::Line& l = p->addNewLine();
+        l.setInstructionIndex(instruction);
+        l.setDestinationIndex(destination);
+        for (size_t idx = 0; idx < operands.size(); idx++) {
+            l.setOperand(idx, operands.at(idx).first,
+                         operands.at(idx).second);
+        }
+    }
+
+    /// Execute a copy of the Program Line by Line.
+    double executeLines(const Program::Program& prog,
+                        bool ignoreException = false)
+    {
+        Program::Program copy(prog);
+        copy.identifyIntrons();
+        EXPECT_EQ(copy.getOptimizedProgram(), nullptr);
+        Program::ProgramExecutionEngine pee(copy);
+        return pee.executeProgram(ignoreException);
+    }
+
+    /// Execute the Program with random Programs and compare results.
+    void checkRandomPrograms(uint64_t& nbCalls, uint64_t& nbGenerics,
+                             uint64_t& nbSuperinstructions)
+    {
+        Mutator::MutationParameters params;
+        params.prog.maxProgramSize = 40;
+        params.prog.minConstValue = -10;
+        params.prog.maxConstValue = 10;
+        Mutator::RNG rng(0);
+
+        for (int i = 0; i < 200; i++) {
+            Program::Program prog(*e);
+            Mutator::ProgramMutator::initRandomProgram(prog, params, rng);
+            ASSERT_NE(prog.getOptimizedProgram(), nullptr);
+            const Program::BytecodeProgram* bytecode =
+                prog.getOptimizedProgram()->getBytecodeProgram();
+            ASSERT_NE(bytecode, nullptr)
+                << "Random Programs should be compiled into bytecode.";
+            for (const Program::BytecodeProgram::Op& op : bytecode->getOps()) {
+                nbCalls += (op.function != nullptr);
+                nbGenerics +=
+                    (op.opcode == Program::BytecodeProgram::Opcode::GENERIC);
+            }
+            nbSuperinstructions += bytecode->getNbSuperinstructions();
+
+            Program::ProgramExecutionEngine pee(prog);
+            double result = pee.executeProgram(true);
+            double expected = executeLines(prog, true);
+            if (std::isnan(expected)) {
+                ASSERT_TRUE(std::isnan(result));
+            }
+            else {
+                ASSERT_EQ(result, expected)
+                    << "BytecodeProgram and Program results differ.";
+            }
+        }
+    }
+};
+
+TEST_F(BytecodeProgramTest, EnvironmentSelection)
+{
+    Environment env(set, vect, 8, 2);
+    ASSERT_FALSE(env.isBytecodeExecution())
+        << "Bytecode execution should be disabled by default.";
+    ASSERT_EQ(env.getSuperinstructions(), nullptr);
+
+    Program::Program prog(env);
+    prog.addNewLine();
+    prog.identifyIntrons();
+    ASSERT_TRUE(prog.optimize());
+    ASSERT_EQ(prog.getOptimizedProgram()->getBytecodeProgram(), nullptr)
+        << "Programs should not be compiled when bytecode execution is "
+           "disabled.";
+
+    auto superinstructions =
+        std::make_shared<Program::SuperinstructionSet>();
+    superinstructions->add(0, 1);
+    env.setBytecodeExecution(true, superinstructions);
+    ASSERT_TRUE(env.isBytecodeExecution());
+    ASSERT_EQ(env.getSuperinstructions(), superinstructions.get());
+    ASSERT_EQ(prog.getOptimizedProgram()->getBytecodeProgram(), nullptr)
+        << "Programs optimized before enabling the bytecode execution should "
+           "not be affected.";
+    ASSERT_TRUE(prog.optimize());
+    ASSERT_NE(prog.getOptimizedProgram()->getBytecodeProgram(), nullptr)
+        << "Programs optimized after enabling the bytecode execution should "
+           "be compiled.";
+}
+
+TEST_F(BytecodeProgramTest, Compile)
+{
+    // Data sources: 0 registers, 1 constants, 2 double, 3 int
+    addLine(0, 1, {{2, 1}, {2, 2}}); // r1 = s[1] + s[2]
+    addLine(1, 0, {{0, 1}, {1, 1}}); // r0 = r1 * c[1]
+    addLine(6, 0, {{0, 0}, {2, 3}, {0, 1}}); // r0 = r0 * s[3] + r1
+    addLine(2, 3, {{2, 4}});                 // r3 = s[4] - 2 * s[5]
+    addLine(0, 0, {{0, 0}, {0, 3}});         // r0 = r0 + r3
+    p->identifyIntrons();
+    ASSERT_TRUE(p->optimize());
+
+    const Program::OptimizedProgram* optimized = p->getOptimizedProgram();
+    const Program::BytecodeProgram* bytecode =
+        optimized->getBytecodeProgram();
+    ASSERT_NE(bytecode, nullptr);
+
+    const std::vector<Program::BytecodeProgram::Op>& ops = bytecode->getOps();
+    ASSERT_EQ(ops.size(), 6) << "Each Operation should be compiled into an "
+                                "Op, followed by an END Op.";
+    ASSERT_EQ(ops.at(0).opcode, Program::BytecodeProgram::Opcode::CALL_2);
+    ASSERT_EQ(ops.at(1).opcode, Program::BytecodeProgram::Opcode::CALL_2);
+    ASSERT_EQ(ops.at(2).opcode, Program::BytecodeProgram::Opcode::CALL);
+    ASSERT_EQ(ops.at(2).nbOperands, 3);
+    ASSERT_EQ(ops.at(3).opcode, Program::BytecodeProgram::Opcode::GENERIC)
+        << "Operations with array operands should not be called natively.";
+    ASSERT_EQ(ops.at(4).opcode, Program::BytecodeProgram::Opcode::CALL_2);
+    ASSERT_EQ(ops.at(5).opcode, Program::BytecodeProgram::Opcode::END);
+    ASSERT_EQ(bytecode->getNbSuperinstructions(), 0);
+
+    // Operands
+    ASSERT_EQ(ops.at(0).operands[0].base,
+              Program::BytecodeProgram::DATA_SOURCES_BASE + 2);
+    ASSERT_EQ(ops.at(0).operands[0].offset, 1);
+    ASSERT_EQ(ops.at(1).operands[0].base,
+              Program::BytecodeProgram::VALUES_BASE);
+    ASSERT_EQ(ops.at(1).operands[0].offset, 0);
+    ASSERT_EQ(ops.at(1).operands[1].base,
+              Program::BytecodeProgram::LITERALS_BASE);
+    ASSERT_EQ(bytecode->getLiterals().at(ops.at(1).operands[1].offset), -3.0)
+        << "Program constants should be compiled as literals.";
+    ASSERT_EQ(bytecode->getNativeDataSources(), std::vector<uint64_t>{2});
+    ASSERT_EQ(bytecode->getResult().base,
+              Program::BytecodeProgram::VALUES_BASE);
+    ASSERT_EQ(bytecode->getResult().offset, 4);
+    ASSERT_GT(
+        optimized->getMemoryFootprint().getComponents().at("bytecode.ops"), 0);
+
+    // Execution
+    Program::ProgramExecutionEngine pee(*p);
+    double r1 = -0.5 + 1.0;
+    double expected = (r1 * -3.0) * 2.5 + r1 + (4.0 - 2.0 * 5.5);
+    ASSERT_EQ(pee.executeProgram(), expected);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(BytecodeProgramTest, Superinstructions)
+{
+    addLine(0, 1, {{2, 1}, {2, 2}}); // r1 = s[1] + s[2]
+    addLine(1, 0, {{0, 1}, {1, 1}}); // r0 = r1 * c[1]
+    addLine(0, 0, {{0, 0}, {2, 3}}); // r0 = r0 + s[3]
+    addLine(1, 0, {{0, 0}, {1, 0}}); // r0 = r0 * c[0]
+    p->identifyIntrons();
+
+    auto superinstructions =
+        std::make_shared<Program::SuperinstructionSet>();
+    ASSERT_TRUE(superinstructions->add(0, 1));
+    ASSERT_FALSE(superinstructions->add(0, 1));
+    ASSERT_EQ(superinstructions->getNbSuperinstructions(), 1);
+    ASSERT_TRUE(superinstructions->contains(0, 1));
+    ASSERT_FALSE(superinstructions->contains(1, 0));
+    e->setBytecodeExecution(true, superinstructions);
+    ASSERT_TRUE(p->optimize());
+
+    const Program::BytecodeProgram* bytecode =
+        p->getOptimizedProgram()->getBytecodeProgram();
+    const std::vector<Program::BytecodeProgram::Op>& ops = bytecode->getOps();
+    ASSERT_EQ(bytecode->getNbSuperinstructions(), 2)
+        << "Both (add, mult) pairs should be fused.";
+    ASSERT_EQ(ops.at(0).opcode, Program::BytecodeProgram::Opcode::FUSED);
+    ASSERT_EQ(ops.at(1).opcode, Program::BytecodeProgram::Opcode::CALL_2);
+    ASSERT_EQ(ops.at(2).opcode, Program::BytecodeProgram::Opcode::FUSED);
+    ASSERT_EQ(ops.at(3).opcode, Program::BytecodeProgram::Opcode::CALL_2);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_EQ(pee.executeProgram(), ((0.5 * -3.0) + 2.5) * 5.0);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(BytecodeProgramTest, ExecutionWithExceptions)
+{
+    addLine(0, 0, {{2, 1}, {2, 2}}); // r0 = s[1] + s[2]
+    addLine(4, 1, {{2, 0}});         // r1 = s[0]^2 -> throws
+    addLine(0, 0, {{0, 0}, {0, 1}}); // r0 = r0 + r1
+    p->identifyIntrons();
+    ASSERT_TRUE(p->optimize());
+    ASSERT_EQ(p->getOptimizedProgram()->getBytecodeProgram()->getOps().at(1)
+                  .opcode,
+              Program::BytecodeProgram::Opcode::CALL);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_THROW(pee.executeProgram(), std::out_of_range);
+    ASSERT_EQ(pee.executeProgram(true), executeLines(*p, true))
+        << "Line throwing an exception should be ignored.";
+}
+
+TEST_F(BytecodeProgramTest, NativeDataSources)
+{
+    Data::ArrayWrapper<double> wrapper(size1, nullptr);
+    std::vector<std::reference_wrapper<const Data::DataHandler>> wrappers{
+        wrapper};
+    Environment env(set, wrappers, 8, 0);
+    env.setBytecodeExecution(true);
+    Program::Program prog(env);
+    Program::Line& l = prog.addNewLine();
+    l.setInstructionIndex(0);
+    l.setOperand(0, 1, 2);
+    l.setOperand(1, 1, 3);
+    prog.identifyIntrons();
+    ASSERT_TRUE(prog.optimize());
+    ASSERT_EQ(prog.getOptimizedProgram()->getBytecodeProgram()
+                  ->getNativeDataSources(),
+              std::vector<uint64_t>{1});
+
+    Program::ProgramExecutionEngine pee(prog);
+    ASSERT_THROW(pee.executeProgram(), std::runtime_error)
+        << "Executing a Program reading an ArrayWrapper without container "
+           "should fail as with the Program Lines.";
+
+    std::vector<double> values1{0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    std::vector<double> values2{0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5};
+    wrapper.setPointer(&values1);
+    ASSERT_EQ(pee.executeProgram(), 5.0);
+    wrapper.setPointer(&values2);
+    ASSERT_EQ(pee.executeProgram(), 6.0)
+        << "Native data should be read from the current container.";
+}
+
+TEST_F(BytecodeProgramTest, RandomPrograms)
+{
+    uint64_t nbCalls = 0;
+    uint64_t nbGenerics = 0;
+    uint64_t nbSuperinstructions = 0;
+    checkRandomPrograms(nbCalls, nbGenerics, nbSuperinstructions);
+    ASSERT_GT(nbCalls, 0);
+    ASSERT_GT(nbGenerics, 0);
+    ASSERT_EQ(nbSuperinstructions, 0);
+
+    // Fuse all pairs of Instructions
+    auto superinstructions =
+        std::make_shared<Program::SuperinstructionSet>();
+    for (uint64_t first = 0; first < set.getNbInstructions(); first++) {
+        for (uint64_t second = 0; second < set.getNbInstructions();
+             second++) {
+            superinstructions->add(first, second);
+        }
+    }
+    e->setBytecodeExecution(true, superinstructions);
+    nbCalls = 0;
+    checkRandomPrograms(nbCalls, nbGenerics, nbSuperinstructions);
+    ASSERT_GT(nbSuperinstructions, 0);
+}
+
+TEST_F(BytecodeProgramTest, Profile)
+{
+    // Program computing (add, mult)
+    auto progAddMult = std::make_shared<Program::Program>(*e);
+    Program::Line* l = &progAddMult->addNewLine();
+    l->setInstructionIndex(0);
+    l->setOperand(0, 2, 1);
+    l->setOperand(1, 2, 2);
+    l = &progAddMult->addNewLine();
+    l->setInstructionIndex(1);
+    l->setOperand(0, 0, 0);
+    l->setOperand(1, 1, 0);
+
+    // Programs computing (mult, add)
+    std::vector<std::shared_ptr<Program::Program>> progsMultAdd;
+    for (uint64_t idx = 0; idx < 2; idx++) {
+        progsMultAdd.push_back(std::make_shared<Program::Program>(*e));
+        l = &progsMultAdd.back()->addNewLine();
+        l->setInstructionIndex(1);
+        l->setOperand(0, 2, idx);
+        l->setOperand(1, 1, 0);
+        l = &progsMultAdd.back()->addNewLine();
+        l->setInstructionIndex(0);
+        l->setOperand(0, 0, 0);
+        l->setOperand(1, 2, 3);
+    }
+
+    // T0 is executed, T1 is not.
+    auto buildGraph = [&](TPG::TPGGraph& graph) {
+        const TPG::TPGVertex& t0 = graph.addNewTeam();
+        const TPG::TPGVertex& t1 = graph.addNewTeam();
+        const TPG::TPGVertex& a0 = graph.addNewAction(0);
+        const TPG::TPGVertex& a1 = graph.addNewAction(1);
+        graph.addNewEdge(t0, a0, progAddMult);
+        graph.addNewEdge(t1, a0, progsMultAdd.at(0));
+        graph.addNewEdge(t1, a1, progsMultAdd.at(0));
+        graph.addNewEdge(t1, a1, progsMultAdd.at(1));
+    };
+
+    TPG::TPGGraph graph(*e);
+    buildGraph(graph);
+    Program::SuperinstructionSet profile =
+        Program::SuperinstructionSet::profile(graph, 1);
+    ASSERT_EQ(profile.getNbSuperinstructions(), 1);
+    ASSERT_TRUE(profile.contains(1, 0))
+        << "The (mult, add) pair appears in more Programs.";
+    ASSERT_EQ(Program::SuperinstructionSet::profile(graph, 10)
+                  .getNbSuperinstructions(),
+              2);
+
+    TPG::TPGGraph instrumentedGraph(
+        *e, std::make_unique<TPG::TPGInstrumentedFactory>());
+    buildGraph(instrumentedGraph);
+    ASSERT_EQ(Program::SuperinstructionSet::profile(instrumentedGraph, 10)
+                  .getNbSuperinstructions(),
+              0)
+        << "Pairs of Programs never executed should not be profiled.";
+
+    TPG::TPGExecutionEngineInstrumented tee(*e);
+    for (int idx = 0; idx < 3; idx++) {
+        tee.executeFromRoot(*instrumentedGraph.getVertices().at(0));
+    }
+    profile = Program::SuperinstructionSet::profile(instrumentedGraph, 10);
+    ASSERT_EQ(profile.getNbSuperinstructions(), 1);
+    ASSERT_TRUE(profile.contains(0, 1))
+        << "Only the (add, mult) pair was executed.";
+}
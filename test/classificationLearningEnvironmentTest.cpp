@@ -70,7 +70,7 @@ TEST(ClassificationLearningEnvironmentTest,
     }
 
     // getClassif table
-    const std::vector<std::vector<uint64_t>>* classifTable = NULL;
+    const std::vector<uint64_t>* classifTable = NULL;
     ASSERT_NO_THROW(classifTable = &fle.getClassificationTable())
         << "Getting the classificationTable failed.";
 
@@ -79,14 +79,62 @@ TEST(ClassificationLearningEnvironmentTest,
 
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
-            ASSERT_EQ(classifTable->at(i).at(j), table[i][j])
+            ASSERT_EQ(classifTable->at(i * 3 + j), table[i][j])
                 << "Classification table contains unexpected values with known "
                    "actions.";
         }
     }
 
+    // check row and column sums
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(fle.getNbDataPerClass().at(i),
+                  table[i][0] + table[i][1] + table[i][2])
+            << "Number of data per class is not as expected with known "
+               "actions.";
+        ASSERT_EQ(fle.getNbGuessesPerClass().at(i),
+                  table[0][i] + table[1][i] + table[2][i])
+            << "Number of guesses per class is not as expected with known "
+               "actions.";
+    }
+
+    // Get f1 score per class
+    std::vector<double> f1Scores;
+    ASSERT_NO_THROW(fle.getF1Scores(f1Scores))
+        << "Computing the F1 scores of the "
+           "ClassificationLearningEnvironment failed.";
+    ASSERT_EQ(f1Scores.size(), 3);
+    ASSERT_NEAR(f1Scores.at(0), 2.0 * 1.0 / (6.0 + 4.0), 0.000001)
+        << "F1 score of class 0 is not as expected with known actions.";
+
     // Get average f1 score
     ASSERT_NEAR(fle.getScore(), 0.323077, 0.000001)
         << "Score of the ClassificationLearningEnvironment is not as expected "
            "with known actions.";
+
+    // reset
+    ASSERT_NO_THROW(fle.reset(0, Learn::LearningMode::TRAINING))
+        << "resetting the ClassificationLearningEnvironment failed";
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(fle.getNbDataPerClass().at(i), 0)
+            << "Number of data per class is not reset.";
+        ASSERT_EQ(fle.getNbGuessesPerClass().at(i), 0)
+            << "Number of guesses per class is not reset.";
+    }
+    ASSERT_EQ(fle.getScore(), 0.0) << "Score after reset should be 0.";
+}
+
+TEST(ClassificationLearningEnvironmentTest, ComputeF1Scores)
+{
+    std::vector<double> f1Scores;
+    ASSERT_THROW(Learn::ClassificationLearningEnvironment::computeF1Scores(
+                     {1, 2, 3}, {3}, {3}, f1Scores),
+                 std::runtime_error)
+        << "F1 scores should not be computed with mismatching sizes.";
+
+    // Perfect classifier for class 0, class 1 never guessed correctly
+    ASSERT_NO_THROW(Learn::ClassificationLearningEnvironment::computeF1Scores(
+        {2, 0, 1, 0}, {2, 1}, {3, 0}, f1Scores));
+    ASSERT_EQ(f1Scores.size(), 2);
+    ASSERT_DOUBLE_EQ(f1Scores.at(0), 0.8);
+    ASSERT_EQ(f1Scores.at(1), 0.0);
 }
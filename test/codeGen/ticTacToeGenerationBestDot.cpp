@@ -173,4 +173,50 @@ TEST_F(TicTacToeGenerationBestDotTest, BestTPG)
     ASSERT_EQ(system(cmdExec.c_str()), 0)
         << "Error inference of TicTacToe has changed";
 }
+
+TEST_F(TicTacToeGenerationBestDotTest, BestTPGMerged)
+{
+    dot = new File::TPGGraphDotImporter(TESTS_DAT_PATH "TicTacToe_out_best.dot",
+                                        *e, *tpg);
+    ASSERT_NO_THROW(dot->importGraph())
+        << "Failed to Import the graph to test inference of TicTacToe";
+
+    CodeGen::TPGGenerationEngineFactory factory;
+    tpgGen = factory.create("TicTacToeBest_TPG", *tpg, "./src/");
+    tpgGen->setMergeTeamPrograms(true);
+    ASSERT_NO_THROW(tpgGen->generateTPGGraph())
+        << "Fail to generate the C file with merged team programs to test "
+           "TicTacToe";
+    // call destructor to close generated files
+    tpgGen.reset();
+
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Fail to compile generated files to test TicTacToe";
+
+    ASSERT_EQ(system(cmdExec.c_str()), 0)
+        << "Error inference of TicTacToe with merged team programs has "
+           "changed";
+}
+
+TEST_F(TicTacToeGenerationBestDotTest, BestTPGTable)
+{
+    dot = new File::TPGGraphDotImporter(TESTS_DAT_PATH "TicTacToe_out_best.dot",
+                                        *e, *tpg);
+    ASSERT_NO_THROW(dot->importGraph())
+        << "Failed to Import the graph to test inference of TicTacToe";
+
+    CodeGen::TPGGenerationEngineFactory factory(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::tableMode);
+    tpgGen = factory.create("TicTacToeBest_TPG", *tpg, "./src/");
+    ASSERT_NO_THROW(tpgGen->generateTPGGraph())
+        << "Fail to generate the C file with tables to test TicTacToe";
+    // call destructor to close generated files
+    tpgGen.reset();
+
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Fail to compile generated files to test TicTacToe";
+
+    ASSERT_EQ(system(cmdExec.c_str()), 0)
+        << "Error inference of TicTacToe with tables has changed";
+}
 #endif // CODE_GENERATION
@@ -253,3 +253,91 @@ TEST_F(CycleDetectionLoggerTest, logAfterPopulateTPG)
 
     ASSERT_GT(s.length(), 0) << "Cycle in custom TPG is not detected.";
 }
+
+TEST_F(CycleDetectionLoggerTest, logAfterPopulateTPGIncremental)
+{
+    la->init();
+    std::stringstream strStr;
+    Log::CycleDetectionLALogger l(*la, strStr, true, true);
+
+    // First check searches the whole TPG
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "No cycle detected in this TPG.")
+        << "TPG after initialization should not contain any cycle.";
+
+    // Build an acyclic TPG
+    //
+    //  T0-->T1
+    //   |   |
+    //   v   v
+    //  T2-->T3-->A0
+    auto tpg = la->getTPGGraph();
+    tpg->clear();
+    std::vector<const TPG::TPGTeam*> teams;
+    for (auto idx = 0; idx < 4; idx++) {
+        teams.push_back(&(tpg->addNewTeam()));
+    }
+    const TPG::TPGAction& action = tpg->addNewAction(0);
+    auto prog = std::make_shared<Program::Program>(la->getEnvironment());
+    tpg->addNewEdge(*teams[0], *teams[1], prog);
+    tpg->addNewEdge(*teams[0], *teams[2], prog);
+    tpg->addNewEdge(*teams[1], *teams[3], prog);
+    tpg->addNewEdge(*teams[2], *teams[3], prog);
+    tpg->addNewEdge(*teams[3], action, prog);
+
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "No cycle detected in this TPG.")
+        << "Custom TPG does not contain any cycle.";
+
+    // The check starts from the edges modified since the previous one.
+    ASSERT_TRUE(tpg->isEdgeTracking())
+        << "Incremental logger should enable the tracking of modified edges.";
+    ASSERT_EQ(tpg->getModifiedEdges().size(), 0)
+        << "Modified edges should be cleared after each check.";
+
+    // Check again without any change
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "No cycle detected in this TPG.")
+        << "Unchanged TPG does not contain any cycle.";
+
+    // Add a new root pointing to existing teams: no cycle.
+    const TPG::TPGTeam& newRoot = tpg->addNewTeam();
+    tpg->addNewEdge(newRoot, *teams[1], prog);
+    tpg->addNewEdge(newRoot, *teams[2], prog);
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "No cycle detected in this TPG.")
+        << "New root does not introduce any cycle.";
+
+    // Modify the edges of an internal team to create a cycle
+    // T1 -> T3 -> T1
+    const TPG::TPGEdge& cycleEdge = tpg->addNewEdge(*teams[3], *teams[1], prog);
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "A cycle was detected in the TPG.")
+        << "Cycle introduced by an internal team is not detected.";
+
+    // The cycle is still detected if nothing changes.
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "A cycle was detected in the TPG.")
+        << "Remaining cycle is not detected.";
+
+    // Remove the cycle
+    tpg->removeEdge(cycleEdge);
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "No cycle detected in this TPG.")
+        << "Cycle removal is not detected.";
+
+    // Change the destination of an existing edge to create a cycle
+    // T0 -> T2 -> T3 -> T0
+    const TPG::TPGEdge& edge = *teams[3]->getOutgoingEdges().front();
+    tpg->setEdgeDestination(edge, *teams[0]);
+    strStr.str(std::string());
+    l.logAfterPopulateTPG();
+    ASSERT_EQ(strStr.str(), "A cycle was detected in the TPG.")
+        << "Cycle introduced by an edge destination change is not detected.";
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+/// doc in ../README.md
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "TwoTeamsBatch.h"
+#include "csvparser.h"
+
+#define ERROR_INFERENCE 1
+#define ERROR_DATA 4
+
+#define NB_ROWS_MAX 16
+#define NB_DATA 8
+#define NB_LANES 100
+
+int main(int argc, char* argv[])
+{
+    int expectedVal[NB_ROWS_MAX];
+    double rows[NB_ROWS_MAX][NB_DATA];
+    int nbRows = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "error the program only require one parameter : the "
+                        "filename of the data.\n");
+        return 3;
+    }
+
+    CsvParser* csvparser = CsvParser_new(argv[1], " ", 0);
+    CsvRow* row;
+    while ((row = CsvParser_getRow(csvparser)) && nbRows < NB_ROWS_MAX) {
+        const char** rowFields = CsvParser_getFields(row);
+        if (CsvParser_getNumFields(row) != NB_DATA + 1) {
+            return ERROR_DATA;
+        }
+        expectedVal[nbRows] = strtol(rowFields[0], NULL, 10);
+        for (int i = 1; i < CsvParser_getNumFields(row); i++) {
+            rows[nbRows][i - 1] = strtod(rowFields[i], NULL);
+        }
+        nbRows++;
+        CsvParser_destroy_row(row);
+    }
+    CsvParser_destroy(csvparser);
+
+    // Lanes cycle through the rows, with a structure of arrays layout.
+    double in1[NB_DATA * NB_LANES];
+    int actions[NB_LANES];
+    for (int l = 0; l < NB_LANES; l++) {
+        for (int idx = 0; idx < NB_DATA; idx++) {
+            in1[idx * NB_LANES + l] = rows[l % nbRows][idx];
+        }
+    }
+
+    inferenceTPGBatch(NB_LANES, in1, actions);
+
+    for (int l = 0; l < NB_LANES; l++) {
+#ifdef DEBUG
+        printf("lane %d action : %d\n", l, actions[l]);
+#endif // DEBUG
+        if (actions[l] != expectedVal[l % nbRows]) {
+            printf("action : %d but expect %d for lane %d\n", actions[l],
+                   expectedVal[l % nbRows], l);
+            return ERROR_INFERENCE;
+        }
+    }
+
+    return 0;
+}
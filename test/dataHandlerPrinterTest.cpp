@@ -181,6 +181,20 @@ TEST_F(DataHandlerPrinterTest, printDataAt)
         << "Error should fail to extract data from 3D DataHandler";
 }
 
+TEST_F(DataHandlerPrinterTest, printDataAtBatch)
+{
+    Data::DataHandlerPrinter batchPrinter("n", "l");
+
+    ASSERT_EQ(batchPrinter.printDataAt(*array1D, scalar, 2, nameVar),
+              " = in1[2 * n + l];")
+        << "Error the batched scalar access does not have the right format.";
+    ASSERT_EQ(batchPrinter.printDataAt(*array1D, array, 4, nameVar),
+              "[] = {in1[4 * n + l], in1[5 * n + l], in1[6 * n + l]};")
+        << "Error the batched array access does not have the right format.";
+    ASSERT_EQ(printer->printElement(2, nameVar), "in1[2]")
+        << "Error a non-batched access should not be strided.";
+}
+
 TEST_F(DataHandlerPrinterTest, getDemangleTemplateType)
 {
     ASSERT_EQ(printer->getDemangleTemplateType(*array1D), "double")
@@ -37,6 +37,7 @@
 
 #include <gtest/gtest.h>
 
+#include "data/blockHash.h"
 #include "data/dataHandler.h"
 #include "data/primitiveTypeArray.h"
 
@@ -165,6 +166,23 @@ TEST(DataHandlersTest, PrimitiveDataArraySetDataAt)
     delete d;
 }
 
+TEST(DataHandlersTest, PrimitiveDataArrayGetNativeDataAt)
+{
+    const size_t size{8};
+    const size_t address{3};
+    Data::PrimitiveTypeArray<double> d(size);
+
+    d.resetData();
+    d.setDataAt(typeid(double), address, 42.0);
+
+    ASSERT_EQ(d.getNativeDataAt(address), 42.0)
+        << "Data accessed through the typed accessor is incorrect.";
+    ASSERT_EQ(d.getNativeDataAt(0), 0.0)
+        << "Data accessed through the typed accessor is incorrect.";
+    ASSERT_THROW(d.getNativeDataAt(size), std::out_of_range)
+        << "Accessing data at an invalid address should fail.";
+}
+
 TEST(DataHandlersTest, PrimitiveDataArrayHash)
 {
     // Create a DataHandler
@@ -182,6 +200,65 @@ TEST(DataHandlersTest, PrimitiveDataArrayHash)
     ASSERT_NE(hash, d.getHash());
 }
 
+TEST(DataHandlersTest, PrimitiveDataArrayIncrementalHash)
+{
+    // Array spanning several blocks of the hash.
+    const size_t size{4 * Data::BlockHash::BLOCK_SIZE + 5};
+    Data::PrimitiveTypeArray<double> d(size);
+    size_t hash = d.getHash();
+
+    // Modify elements in the first and last blocks.
+    d.setDataAt(typeid(double), 3, 1.5);
+    d.setDataAt(typeid(double), size - 1, -2.0);
+    size_t incrementalHash = d.getHash();
+    ASSERT_NE(hash, incrementalHash);
+
+    // The clone keeps the hash of the original.
+    Data::PrimitiveTypeArray<double>* dClone =
+        (Data::PrimitiveTypeArray<double>*)d.clone();
+    ASSERT_EQ(dClone->getHash(), incrementalHash)
+        << "Cloned DataHandler should have the hash of the original.";
+
+    // Hash computed from scratch is identical to the incremental one.
+    dClone->invalidateCachedHash();
+    ASSERT_EQ(dClone->getHash(), incrementalHash)
+        << "Incremental hash differs from the hash computed from scratch.";
+
+    // Back to the initial data
+    d.setDataAt(typeid(double), 3, 0.0);
+    d.setDataAt(typeid(double), size - 1, -0.0);
+    ASSERT_EQ(d.getHash(), hash)
+        << "Hash should only depend on the data, with -0.0 equal to 0.0.";
+
+    delete dClone;
+}
+
+TEST(DataHandlersTest, PrimitiveDataArrayIncrementalHashRepeatedWrites)
+{
+    const size_t size{3 * Data::BlockHash::BLOCK_SIZE};
+    Data::PrimitiveTypeArray<double> d(size);
+    d.getHash();
+
+    // Write the same element many times before the hash is updated.
+    for (int i = 0; i < 1000; i++) {
+        d.setDataAt(typeid(double), 5, (double)i);
+    }
+    d.setDataAt(typeid(double), size - 1, 3.0);
+
+    // Dirty blocks are listed once, whatever the number of writes.
+    ASSERT_LT(d.getMemoryFootprint().get("hashes"), 100 * sizeof(size_t))
+        << "Repeated writes in a block should not grow the list of dirty "
+           "blocks.";
+
+    // Same data hashed from scratch.
+    size_t incrementalHash = d.getHash();
+    Data::PrimitiveTypeArray<double> dFull(d);
+    dFull.invalidateCachedHash();
+    ASSERT_EQ(dFull.getHash(), incrementalHash)
+        << "Incremental hash differs from the hash computed from scratch "
+           "after repeated writes in a block.";
+}
+
 TEST(DataHandlersTest, PrimitiveDataArrayClone)
 {
     // Create a DataHandler
@@ -35,6 +35,7 @@
 
 #include <gtest/gtest.h>
 
+#include "data/blockHash.h"
 #include "data/hash.h"
 
 TEST(DataHashTest, HashInt)
@@ -56,3 +57,16 @@ TEST(DataHashTest, HashNullptr)
     std::nullptr_t t = NULL;
     ASSERT_EQ(Data::Hash<std::nullptr_t>()(t), 12161962213042174405u);
 }
+
+TEST(DataHashTest, BlockHash)
+{
+    const int ints[7] = {0, 1, 2, 3, 4, 5, 6};
+    const double doubles[3] = {1.5, -0.0, 3.25};
+
+    uint64_t blockHashes[2] = {Data::BlockHash::hashBlock(ints, 7),
+                               Data::BlockHash::hashBlock(doubles, 3)};
+    ASSERT_EQ(blockHashes[0], 6051266002727905872u);
+    ASSERT_EQ(blockHashes[1], 8865556942556054578u);
+    ASSERT_EQ(Data::BlockHash::combine(0, blockHashes, 2),
+              10641033989667671476u);
+}
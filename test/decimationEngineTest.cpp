@@ -0,0 +1,133 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "learn/decimationEngine.h"
+
+TEST(DecimationEngineTest, Resize)
+{
+    Learn::DecimationEngine engine;
+    ASSERT_EQ(engine.getNbEntries(), 0);
+
+    ASSERT_NO_THROW(engine.resize(5, 3))
+        << "Resize of DecimationEngine failed.";
+    ASSERT_EQ(engine.getNbEntries(), 5);
+    ASSERT_EQ(engine.getNbClasses(), 3);
+
+    ASSERT_NO_THROW(engine.setScore(4, 1.0));
+    ASSERT_THROW(engine.setScore(5, 1.0), std::out_of_range);
+    ASSERT_NO_THROW(engine.setClassScores(4, {1.0, 2.0, 3.0}));
+    ASSERT_THROW(engine.setClassScores(5, {1.0, 2.0, 3.0}), std::out_of_range);
+    ASSERT_THROW(engine.setClassScores(0, {1.0, 2.0}), std::runtime_error);
+    ASSERT_NO_THROW(engine.setPreserved(4));
+    ASSERT_THROW(engine.setPreserved(5), std::out_of_range);
+    ASSERT_THROW(engine.isKept(5), std::out_of_range);
+}
+
+TEST(DecimationEngineTest, DecimateWorst)
+{
+    Learn::DecimationEngine engine;
+    engine.resize(6);
+    const std::vector<double> scores{3.0, 1.0, 2.0, 1.0, 0.0, 5.0};
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        engine.setScore(idx, scores.at(idx));
+    }
+    // Entry 4 has the worst score but is preserved.
+    engine.setPreserved(4);
+
+    // Entry 1 and 3 have equal scores, entry 1 is considered worse.
+    engine.decimateWorst(1);
+    const std::vector<bool> expected1{true, false, true, true, true, true};
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), expected1.at(idx))
+            << "Wrong selection of entry " << idx << ".";
+    }
+
+    engine.decimateWorst(3);
+    const std::vector<bool> expected3{true, false, false, false, true, true};
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), expected3.at(idx))
+            << "Wrong selection of entry " << idx << ".";
+    }
+
+    // Only non-preserved entries are decimated.
+    engine.decimateWorst(10);
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), idx == 4)
+            << "Wrong selection of entry " << idx << ".";
+    }
+}
+
+TEST(DecimationEngineTest, KeepBest)
+{
+    Learn::DecimationEngine engine;
+    engine.resize(6, 2);
+    const std::vector<double> scores{3.0, 1.0, 2.0, 1.0, 0.0, 5.0};
+    const std::vector<std::vector<double>> classScores{
+        {0.0, 1.0}, {0.5, 0.0}, {0.0, 1.0}, {0.0, 0.5}, {0.5, 0.0}, {1.0, 1.0}};
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        engine.setScore(idx, scores.at(idx));
+        engine.setClassScores(idx, classScores.at(idx));
+    }
+
+    // Best general scores only
+    engine.keepBest(0, 2);
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), idx == 0 || idx == 5)
+            << "Wrong selection of entry " << idx << ".";
+    }
+
+    // Best per class:
+    // - Class 0: entry 5, then entry 4 (equal to entry 1, higher index)
+    // - Class 1: entry 5 (already kept), then entry 2 (equal to 0, higher
+    //   index)
+    // Then best general score: entry 0.
+    engine.keepBest(2, 4);
+    const std::vector<bool> expected{true, false, true, false, true, true};
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), expected.at(idx))
+            << "Wrong selection of entry " << idx << ".";
+    }
+
+    // Preserved entries are kept in addition to the selected ones.
+    engine.setPreserved(3);
+    engine.keepBest(2, 4);
+    for (size_t idx = 0; idx < scores.size(); idx++) {
+        ASSERT_EQ(engine.isKept(idx), expected.at(idx) || idx == 3)
+            << "Wrong selection of entry " << idx << ".";
+    }
+}
@@ -300,3 +300,56 @@ TEST(EnvironmentTest, DataSourceAccessor)
                "to the ones referenced in the Set given at construction.";
     }
 }
+
+TEST(EnvironmentTest, OperandDataSources)
+{
+    const size_t size1{24};
+    const size_t size2{32};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Instructions::Set set;
+
+    Data::PrimitiveTypeArray<double> d1(size1);
+    Data::PrimitiveTypeArray<int> d2(size2);
+
+    Instructions::AddPrimitiveType<int> iAdd; // Two operands, No Parameter
+    auto minus = [](double a, double b) -> double { return a - b; };
+    Instructions::LambdaInstruction<double, double> dMinus(minus);
+
+    set.add(iAdd);
+    set.add(dMinus);
+
+    vect.push_back(d1);
+    vect.push_back(d2);
+
+    Environment e(set, vect, 8, 5);
+
+    // Fake data sources are: registers (double), constants, d1 (double) and
+    // d2 (int).
+    const std::vector<uint64_t>* sources = nullptr;
+    ASSERT_NO_THROW(sources = &e.getOperandDataSources(0, 1))
+        << "Getting the data sources of a valid operand failed.";
+    ASSERT_EQ(*sources, std::vector<uint64_t>({3}))
+        << "Data sources of an int operand are not as expected.";
+    ASSERT_NO_THROW(sources = &e.getOperandDataSources(1, 0))
+        << "Getting the data sources of a valid operand failed.";
+    ASSERT_EQ(*sources, std::vector<uint64_t>({0, 2}))
+        << "Data sources of a double operand are not as expected.";
+
+    ASSERT_EQ(e.getOperandAddressSpace(0, 0, 3), size2)
+        << "Address space of a valid data source is not as expected.";
+    ASSERT_EQ(e.getOperandAddressSpace(1, 1, 0), 8)
+        << "Address space of the registers is not as expected.";
+    ASSERT_EQ(e.getOperandAddressSpace(1, 1, 2), size1)
+        << "Address space of a valid data source is not as expected.";
+    ASSERT_EQ(e.getOperandAddressSpace(1, 1, 3), 0)
+        << "Address space of an invalid data source should be 0.";
+
+    ASSERT_THROW(e.getOperandDataSources(2, 0), std::out_of_range)
+        << "Getting the data sources of a non-existing instruction should "
+           "fail.";
+    ASSERT_THROW(e.getOperandDataSources(0, 2), std::out_of_range)
+        << "Getting the data sources of a non-existing operand should fail.";
+    ASSERT_THROW(e.getOperandAddressSpace(0, 0, 4), std::out_of_range)
+        << "Getting the address space of a non-existing data source should "
+           "fail.";
+}
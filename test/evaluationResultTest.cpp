@@ -64,6 +64,32 @@ TEST(EvaluationResultTest, GetNbEvaluation)
         << "Getter returned an unexpected value.";
 }
 
+TEST(EvaluationResultTest, GetVariance)
+{
+    Learn::EvaluationResult eval(1.0, 10);
+    ASSERT_EQ(eval.getVariance(), 0.0)
+        << "Default variance should be 0.0.";
+
+    Learn::EvaluationResult eval2(1.0, 10, 0.5);
+    ASSERT_EQ(eval2.getVariance(), 0.5)
+        << "Getter returned an unexpected value.";
+}
+
+TEST(EvaluationResultTest, AssignmentAdditionOperatorVariance)
+{
+    // Scores {0, 2} and {4, 6, 8}
+    Learn::EvaluationResult eval1(1.0, 2, 1.0);
+    Learn::EvaluationResult eval2(6.0, 3, 8.0 / 3.0);
+
+    eval1 += eval2;
+
+    // Scores {0, 2, 4, 6, 8}
+    ASSERT_DOUBLE_EQ(eval1.getResult(), 4.0)
+        << "Getter returned an unexpected value after call to operator+=.";
+    ASSERT_DOUBLE_EQ(eval1.getVariance(), 8.0)
+        << "Getter returned an unexpected value after call to operator+=.";
+}
+
 TEST(EvaluationResultTest, AssignmentAdditionOperator)
 {
     Learn::EvaluationResult eval1(1.0, 10);
@@ -0,0 +1,230 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "learn/classificationEvaluationResult.h"
+#include "learn/evaluationResult.h"
+#include "learn/evaluationTable.h"
+#include "tpg/tpgAction.h"
+
+TEST(EvaluationTableTest, AddRow)
+{
+    Learn::EvaluationTable table;
+    TPG::TPGAction a0(0), a1(1);
+
+    ASSERT_EQ(table.getNbRows(), 0);
+    ASSERT_EQ(table.addRow(&a0, 1.0, 10, 0.5), 0);
+    ASSERT_EQ(table.addRow(&a1, 2.0, 20), 1);
+    ASSERT_EQ(table.getNbRows(), 2);
+    ASSERT_EQ(table.getNbClasses(), 0);
+
+    ASSERT_EQ(table.getRoot(0), &a0);
+    ASSERT_EQ(table.getScore(0), 1.0);
+    ASSERT_EQ(table.getNbEvaluation(0), 10);
+    ASSERT_EQ(table.getVariance(0), 0.5);
+    ASSERT_EQ(table.getRoot(1), &a1);
+    ASSERT_EQ(table.getScore(1), 2.0);
+    ASSERT_EQ(table.getNbEvaluation(1), 20);
+    ASSERT_EQ(table.getVariance(1), 0.0);
+    ASSERT_EQ(table.getScores().size(), 2);
+    ASSERT_EQ(table.getRoots().size(), 2);
+
+    ASSERT_THROW(table.getScore(2), std::out_of_range);
+    ASSERT_THROW(table.getClassScores(2), std::out_of_range);
+
+    table.clear(2);
+    ASSERT_EQ(table.getNbRows(), 0);
+    ASSERT_EQ(table.getNbClasses(), 2);
+    table.addRow(&a0, 1.0, 10);
+    ASSERT_EQ(table.getClassScores(0)[1], 0.0);
+    ASSERT_NO_THROW(table.setClassScores(0, {3.0, 4.0}));
+    ASSERT_EQ(table.getClassScores(0)[0], 3.0);
+    ASSERT_EQ(table.getClassScores(0)[1], 4.0);
+    ASSERT_THROW(table.setClassScores(0, {3.0}), std::runtime_error);
+    ASSERT_THROW(table.setClassScores(1, {3.0, 4.0}), std::out_of_range);
+}
+
+TEST(EvaluationTableTest, Fill)
+{
+    Learn::EvaluationTable table;
+    TPG::TPGAction a0(0), a1(1), a2(2);
+
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>
+        results;
+    results.emplace(std::make_shared<Learn::EvaluationResult>(2.0, 3, 1.0),
+                    &a0);
+    results.emplace(std::make_shared<Learn::EvaluationResult>(1.0, 5), &a1);
+
+    ASSERT_NO_THROW(table.fill(results));
+    ASSERT_EQ(table.getNbRows(), 2);
+    ASSERT_EQ(table.getNbClasses(), 0);
+    // Rows are stored in the order of the multimap.
+    ASSERT_EQ(table.getRoot(0), &a1);
+    ASSERT_EQ(table.getScore(0), 1.0);
+    ASSERT_EQ(table.getNbEvaluation(0), 5);
+    ASSERT_EQ(table.getRoot(1), &a0);
+    ASSERT_EQ(table.getVariance(1), 1.0);
+
+    std::multimap<std::shared_ptr<Learn::EvaluationResult>,
+                  const TPG::TPGVertex*>
+        classifResults;
+    classifResults.emplace(
+        std::make_shared<Learn::ClassificationEvaluationResult>(
+            std::vector<double>{1.0, 2.0}, std::vector<size_t>{2, 2}),
+        &a0);
+    classifResults.emplace(
+        std::make_shared<Learn::ClassificationEvaluationResult>(
+            std::vector<double>{0.0, 1.0}, std::vector<size_t>{2, 2}),
+        &a1);
+    classifResults.emplace(
+        std::make_shared<Learn::ClassificationEvaluationResult>(
+            std::vector<double>{4.0, 2.0}, std::vector<size_t>{2, 2}),
+        &a2);
+
+    ASSERT_NO_THROW(table.fill(classifResults));
+    ASSERT_EQ(table.getNbRows(), 3);
+    ASSERT_EQ(table.getNbClasses(), 2);
+    ASSERT_EQ(table.getRoot(0), &a1);
+    ASSERT_EQ(table.getClassScores(0)[1], 1.0);
+    ASSERT_EQ(table.getRoot(2), &a2);
+    ASSERT_EQ(table.getScore(2), 3.0);
+    ASSERT_EQ(table.getClassScores(2)[0], 4.0);
+}
+
+TEST(EvaluationTableTest, AddRowWithResult)
+{
+    Learn::EvaluationTable table;
+    TPG::TPGAction a0(0), a1(1), a2(2);
+
+    auto r0 = std::make_shared<Learn::EvaluationResult>(2.0, 3, 1.0);
+    auto r1 = std::make_shared<Learn::EvaluationResult>(1.0, 5);
+    auto r2 = std::make_shared<Learn::EvaluationResult>(2.0, 4);
+
+    // Rows are stored in the order of addition.
+    ASSERT_EQ(table.addRow(r0, &a0), 0);
+    ASSERT_EQ(table.addRow(r1, &a1), 1);
+    ASSERT_EQ(table.addRow(r2, &a2), 2);
+    ASSERT_EQ(table.getResult(1), r1);
+    ASSERT_EQ(table.getScore(1), 1.0);
+    ASSERT_EQ(table.getNbEvaluation(2), 4);
+    ASSERT_EQ(table.getVariance(0), 1.0);
+
+    // Last row among those with the best score, as in a multimap.
+    ASSERT_EQ(table.getBestRow(), 2);
+    auto resultsMap = table.getResultsMap();
+    ASSERT_EQ(resultsMap.size(), 3);
+    ASSERT_EQ(resultsMap.begin()->second, &a1);
+    ASSERT_EQ((--resultsMap.end())->first, r2);
+    ASSERT_EQ((--resultsMap.end())->second, &a2);
+
+    // Keep rows
+    ASSERT_THROW(table.keepRows({true}), std::runtime_error);
+    ASSERT_NO_THROW(table.keepRows({false, true, true}));
+    ASSERT_EQ(table.getNbRows(), 2);
+    ASSERT_EQ(table.getRoot(0), &a1);
+    ASSERT_EQ(table.getResult(1), r2);
+
+    table.clear();
+    ASSERT_THROW(table.getBestRow(), std::out_of_range);
+}
+
+TEST(EvaluationTableTest, AddRowWithClassificationResult)
+{
+    Learn::EvaluationTable table;
+    TPG::TPGAction a0(0), a1(1);
+
+    table.addRow(std::make_shared<Learn::ClassificationEvaluationResult>(
+                     std::vector<double>{1.0, 2.0}, std::vector<size_t>{2, 2}),
+                 &a0);
+    table.addRow(std::make_shared<Learn::ClassificationEvaluationResult>(
+                     std::vector<double>{4.0, 0.0}, std::vector<size_t>{2, 2}),
+                 &a1);
+    ASSERT_EQ(table.getNbClasses(), 2);
+    ASSERT_EQ(table.getClassScores(1)[0], 4.0);
+
+    table.keepRows({false, true});
+    ASSERT_EQ(table.getClassScores(0)[0], 4.0);
+    ASSERT_EQ(table.getClassScores(0)[1], 0.0);
+}
+
+TEST(EvaluationTableTest, RowsByValue)
+{
+    Learn::EvaluationTable table;
+    TPG::TPGAction a0(0), a1(1);
+
+    auto r1 = std::make_shared<Learn::EvaluationResult>(1.0, 5);
+    table.addRow(&a0, 2.0, 3, 1.0);
+    table.addRow(r1, &a1);
+
+    // Rows added by value hold no shared result.
+    ASSERT_EQ(table.getSharedResult(0), nullptr);
+    ASSERT_EQ(table.getSharedResult(1), r1);
+    std::shared_ptr<Learn::EvaluationResult> r0 = table.getResult(0);
+    ASSERT_NE(r0, nullptr);
+    ASSERT_EQ(r0->getResult(), 2.0);
+    ASSERT_EQ(r0->getNbEvaluation(), 3);
+    ASSERT_EQ(r0->getVariance(), 1.0);
+    ASSERT_EQ(table.getResult(1), r1);
+    auto resultsMap = table.getResultsMap();
+    ASSERT_EQ(resultsMap.size(), 2);
+    ASSERT_EQ((--resultsMap.end())->second, &a0);
+
+    // Copy rows into another table
+    Learn::EvaluationTable copy;
+    ASSERT_EQ(copy.addRow(table, 1), 0);
+    ASSERT_EQ(copy.addRow(table, 0), 1);
+    ASSERT_THROW(copy.addRow(table, 2), std::out_of_range);
+    ASSERT_EQ(copy.getSharedResult(0), r1);
+    ASSERT_EQ(copy.getSharedResult(1), nullptr);
+    ASSERT_EQ(copy.getRoot(1), &a0);
+    ASSERT_EQ(copy.getScore(1), 2.0);
+    ASSERT_EQ(copy.getNbEvaluation(1), 3);
+    ASSERT_EQ(copy.getVariance(1), 1.0);
+
+    // Scores per class are copied with the rows.
+    Learn::EvaluationTable classifTable;
+    classifTable.addRow(
+        std::make_shared<Learn::ClassificationEvaluationResult>(
+            std::vector<double>{1.0, 2.0}, std::vector<size_t>{2, 2}),
+        &a0);
+    copy.clear();
+    copy.addRow(classifTable, 0);
+    ASSERT_EQ(copy.getNbClasses(), 2);
+    ASSERT_EQ(copy.getClassScores(0)[1], 2.0);
+}
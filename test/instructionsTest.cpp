@@ -39,6 +39,7 @@
 
 #include <array>
 
+#include "data/constant.h"
 #include "data/dataHandler.h"
 #include "data/untypedSharedPtr.h"
 #include "instructions/addPrimitiveType.h"
@@ -132,6 +133,40 @@ TEST(InstructionsTest, Execute)
     delete i;
 }
 
+TEST(InstructionsTest, GetScalarFunction)
+{
+    Instructions::Instruction* add =
+        new Instructions::AddPrimitiveType<double>();
+    Instructions::Instruction* addInt =
+        new Instructions::AddPrimitiveType<int>();
+    Instructions::Instruction* mult =
+        new Instructions::MultByConstant<double>();
+
+    ASSERT_EQ(addInt->getScalarFunction(), nullptr)
+        << "AddPrimitiveType<int> should not provide a ScalarFunction.";
+
+    Instructions::Instruction::ScalarFunction function =
+        add->getScalarFunction();
+    ASSERT_NE(function, nullptr)
+        << "AddPrimitiveType<double> should provide a ScalarFunction.";
+    double operands[2]{2.6, 5.5};
+    ASSERT_EQ(function(*add, operands), 2.6 + 5.5)
+        << "ScalarFunction of AddPrimitiveType<double> returns an incorrect "
+           "value.";
+
+    function = mult->getScalarFunction();
+    ASSERT_NE(function, nullptr)
+        << "MultByConstant<double> should provide a ScalarFunction.";
+    operands[1] = (double)Data::Constant{-3};
+    ASSERT_EQ(function(*mult, operands), 2.6 * -3.0)
+        << "ScalarFunction of MultByConstant<double> returns an incorrect "
+           "value.";
+
+    delete add;
+    delete addInt;
+    delete mult;
+}
+
 TEST(InstructionsTest, SetAdd)
 {
     Instructions::Set s;
@@ -142,17 +142,20 @@ TEST_F(LABasicLoggerTest, logHeader)
     for (std::string s2; iss >> s2;)
         result.push_back(s2);
 
-    ASSERT_EQ("Train", result[0]);
-    ASSERT_EQ("Gen", result[1]);
-    ASSERT_EQ("NbVert", result[2]);
-    ASSERT_EQ("Min", result[3]);
-    ASSERT_EQ("Avg", result[4]);
-    ASSERT_EQ("Max", result[5]);
-    ASSERT_EQ("T_mutat", result[6]);
-    ASSERT_EQ("T_eval", result[7]);
-    ASSERT_EQ("T_total", result[8]);
-    ASSERT_EQ("Valid", result[10]);
-    ASSERT_EQ("T_valid", result[21]);
+    ASSERT_EQ("Gen", result[0]);
+    ASSERT_EQ("NbVert", result[1]);
+    ASSERT_EQ("T_Min", result[2]);
+    ASSERT_EQ("T_Avg", result[3]);
+    ASSERT_EQ("T_Max", result[4]);
+    ASSERT_EQ("T_mutat", result[5]);
+    ASSERT_EQ("T_eval", result[6]);
+    ASSERT_EQ("T_total", result[7]);
+    ASSERT_EQ("Gen", result[8]);
+    ASSERT_EQ("V_Min", result[13]);
+    ASSERT_EQ("V_Avg", result[14]);
+    ASSERT_EQ("V_Max", result[15]);
+    ASSERT_EQ("T_valid", result[18]);
+    ASSERT_EQ("T_total", result[19]);
 }
 
 TEST_F(LABasicLoggerTest, logNewGeneration)
@@ -170,9 +173,9 @@ TEST_F(LABasicLoggerTest, logNewGeneration)
     for (std::string s2; iss >> s2;)
         result.push_back(s2);
 
-    // index 9 because we skip the header
-    ASSERT_EQ("42", result[9]);
-    ASSERT_EQ(result.size(), 9 + 1);
+    // index 8 because we skip the header
+    ASSERT_EQ("42", result[8]);
+    ASSERT_EQ(result.size(), 8 + 1);
 }
 
 TEST_F(LABasicLoggerTest, logAfterPopulateTPG)
@@ -190,7 +193,7 @@ TEST_F(LABasicLoggerTest, logAfterPopulateTPG)
         result.push_back(s2);
 
     // index 8 because we skip the header
-    ASSERT_EQ("6", result[9])
+    ASSERT_EQ("6", result[8])
         << "Unexpected number of vertices was printed in the log.";
 }
 
@@ -208,9 +211,9 @@ TEST_F(LABasicLoggerTest, logAfterEvaluate)
         result.push_back(s2);
 
     // index 8 because we skip the header
-    ASSERT_DOUBLE_EQ(5.00, std::stod(result[9]));
-    ASSERT_DOUBLE_EQ(7.50, std::stod(result[10]));
-    ASSERT_DOUBLE_EQ(10.00, std::stod(result[11]));
+    ASSERT_DOUBLE_EQ(5.00, std::stod(result[8]));
+    ASSERT_DOUBLE_EQ(7.50, std::stod(result[9]));
+    ASSERT_DOUBLE_EQ(10.00, std::stod(result[10]));
 }
 
 TEST_F(LABasicLoggerTest, logAfterValidate)
@@ -227,9 +230,9 @@ TEST_F(LABasicLoggerTest, logAfterValidate)
         result.push_back(s2);
 
     // index 8+ because we skip the header
-    ASSERT_DOUBLE_EQ(5.00, std::stod(result[9]));
-    ASSERT_DOUBLE_EQ(7.50, std::stod(result[10]));
-    ASSERT_DOUBLE_EQ(10.00, std::stod(result[11]));
+    ASSERT_DOUBLE_EQ(5.00, std::stod(result[8]));
+    ASSERT_DOUBLE_EQ(7.50, std::stod(result[9]));
+    ASSERT_DOUBLE_EQ(10.00, std::stod(result[10]));
 }
 
 TEST_F(LABasicLoggerTest, logAfterDecimate)
@@ -274,10 +277,10 @@ TEST_F(LABasicLoggerTest, logEndOfTraining)
     for (std::string s2; iss >> s2;)
         result.push_back(s2);
 
-    // index 12+ because we skip the headers and the eval stats
-    double mutatTime = std::stod(result[12]);
-    double evalTime = std::stod(result[13]);
-    double validTime = std::stod(result[14]);
+    // index 11+ because we skip the headers and the eval stats
+    double mutatTime = std::stod(result[11]);
+    double evalTime = std::stod(result[12]);
+    double validTime = std::stod(result[13]);
     double totTime = std::stod(result[14]);
     ASSERT_GE(mutatTime, 0) << "Eval duration should be positive";
     ASSERT_GE(evalTime, 0) << "Eval duration should be positive";
@@ -287,7 +290,7 @@ TEST_F(LABasicLoggerTest, logEndOfTraining)
     ASSERT_GE(totTime, timeToWaitMili / 1000)
         << "Total time should be larger than the time we waited !";
 
-    // Size is headerSize (9) + log size (7 + 3)
-    ASSERT_EQ(result.size(), 9 + 10)
+    // Size is headerSize (8) + log size (7 + 3)
+    ASSERT_EQ(result.size(), 8 + 10)
         << "logEndOfTraining with and without valid should have 4+3=7 elements";
 }
@@ -0,0 +1,93 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "instructions/addPrimitiveType.h"
+#include "instructions/set.h"
+#include "learn/learningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+
+#include "log/laMemoryLogger.h"
+
+TEST(LAMemoryLoggerTest, LogGenerations)
+{
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<int> addInt;
+    Instructions::AddPrimitiveType<double> addDouble;
+    set.add(addInt);
+    set.add(addDouble);
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    params.mutation.tpg.nbRoots = 10;
+    params.mutation.tpg.maxInitOutgoingEdges = 2;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 1;
+    params.archiveSize = 20;
+
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+
+    std::stringstream out;
+    Log::LAMemoryLogger logger(la, out);
+    ASSERT_EQ(logger.getLastFootprint().getTotal(), 0);
+
+    la.trainOneGeneration(0);
+    la.trainOneGeneration(1);
+
+    const Util::MemoryFootprint& footprint = logger.getLastFootprint();
+    ASSERT_EQ(footprint.getTotal(), la.getMemoryFootprint().getTotal())
+        << "Logged footprint differs from the one of the LearningAgent.";
+    for (const char* component :
+         {"archive.recordings", "archive.snapshots", "tpg.vertices",
+          "tpg.edges", "tpg.programs", "resultsPerRoot",
+          "evaluationTable.scores"}) {
+        ASSERT_GT(footprint.get(component), 0)
+            << "Component " << component << " should not be empty.";
+    }
+
+    // Header and one line per generation
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(out, line)) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3);
+    ASSERT_NE(lines.at(0).find("Snapshots"), std::string::npos);
+    ASSERT_NE(lines.at(2).find(std::to_string(footprint.getTotal())),
+              std::string::npos);
+}
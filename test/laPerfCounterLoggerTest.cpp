@@ -0,0 +1,149 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+#include "instructions/addPrimitiveType.h"
+#include "instructions/set.h"
+#include "learn/parallelLearningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+
+#include "log/laPerfCounterLogger.h"
+#include "log/perfCounters.h"
+
+TEST(LAPerfCounterLoggerTest, PerfCounterValues)
+{
+    Log::PerfCounterValues a;
+    ASSERT_FALSE(a.isAvailable()) << "Default values should be unavailable.";
+
+    Log::PerfCounterValues b;
+    b.values[(size_t)Log::PerfCounter::INSTRUCTIONS] = 10;
+    b.available[(size_t)Log::PerfCounter::INSTRUCTIONS] = true;
+    a += b;
+    a += b;
+    ASSERT_TRUE(a.isAvailable());
+    ASSERT_TRUE(a.isAvailable(Log::PerfCounter::INSTRUCTIONS));
+    ASSERT_FALSE(a.isAvailable(Log::PerfCounter::CYCLES));
+    ASSERT_EQ(a.get(Log::PerfCounter::INSTRUCTIONS), 20);
+}
+
+TEST(LAPerfCounterLoggerTest, PerfCounterGroup)
+{
+    Log::PerfCounterGroup group;
+    ASSERT_NO_THROW(group.start());
+    Log::PerfCounterValues values;
+    ASSERT_NO_THROW(values = group.stop());
+    ASSERT_EQ(values.isAvailable(), group.isAvailable());
+    if (!group.isAvailable()) {
+        ASSERT_FALSE(group.getErrorMessage().empty())
+            << "Unavailable counters should be explained.";
+    }
+}
+
+TEST(LAPerfCounterLoggerTest, PerfCounterScope)
+{
+    Log::PerfCounterRegistry& registry =
+        Log::PerfCounterRegistry::getInstance();
+
+    // Inactive registry
+    registry.deactivate();
+    std::thread([]() { Log::PerfCounterScope scope; }).join();
+    ASSERT_EQ(registry.takeWorkerSamples().size(), 0)
+        << "Workers should not be counted when the registry is inactive.";
+
+    // Active registry
+    registry.activate();
+    { Log::PerfCounterScope scope; }
+    ASSERT_EQ(registry.takeWorkerSamples().size(), 0)
+        << "The owner thread of the registry should not be counted.";
+
+    bool available = false;
+    std::thread([&available]() {
+        available = Log::PerfCounterGroup().isAvailable();
+        Log::PerfCounterScope scope;
+    }).join();
+    ASSERT_EQ(registry.takeWorkerSamples().size(), available ? 1 : 0);
+    registry.deactivate();
+}
+
+TEST(LAPerfCounterLoggerTest, TrainingPhases)
+{
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<int> addInt;
+    Instructions::AddPrimitiveType<double> addDouble;
+    set.add(addInt);
+    set.add(addDouble);
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    params.mutation.tpg.nbRoots = 10;
+    params.mutation.tpg.maxInitOutgoingEdges = 2;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 1;
+    params.nbThreads = 2;
+    params.doValidation = true;
+
+    Learn::ParallelLearningAgent la(le, set, params);
+    la.init();
+
+    std::stringstream out;
+    {
+        Log::LAPerfCounterLogger logger(la, out);
+        ASSERT_NO_THROW(la.trainOneGeneration(0));
+
+        if (logger.isAvailable()) {
+            ASSERT_NE(out.str().find("Phase"), std::string::npos);
+            for (const char* phase : {"mutation", "evaluation", "validation"}) {
+                const std::vector<Log::PerfCounterValues>& values =
+                    logger.getPhaseValues(phase);
+                ASSERT_GE(values.size(), 1)
+                    << "Phase " << phase << " was not counted.";
+                ASSERT_TRUE(values.at(0).isAvailable());
+                ASSERT_NE(out.str().find(phase), std::string::npos);
+            }
+            ASSERT_EQ(logger.getPhaseValues("unknown").size(), 0);
+        }
+        else {
+            // Graceful degradation
+            ASSERT_NE(out.str().find("not available"), std::string::npos);
+            ASSERT_EQ(logger.getPhaseValues("evaluation").size(), 0);
+        }
+    }
+
+    ASSERT_FALSE(Log::PerfCounterRegistry::getInstance().isActive())
+        << "The registry should be deactivated with the logger.";
+}
@@ -102,7 +102,7 @@ TEST_F(LAPolicyStatsLoggerTest, Constructor)
 TEST_F(LAPolicyStatsLoggerTest, LogAfterEvaluate)
 {
     // Train one generatio before adding the logger.
-    uint64_t genNumber = 42;
+    uint64_t genNumber = 2;
     la->init();
     la->trainOneGeneration(genNumber);
 
@@ -127,6 +127,40 @@ TEST(LambdaInstructionsTest, ExecuteConstant)
         << "Destruction of the LambdaInstruction failed.";
 }
 
+TEST(LambdaInstructionsTest, GetScalarFunction)
+{
+    Data::Constant a{-4};
+    double b{2.6};
+    std::vector<Data::UntypedSharedPtr> vect;
+    vect.emplace_back(
+        &a, Data::UntypedSharedPtr::emptyDestructor<Data::Constant>());
+    vect.emplace_back(&b, Data::UntypedSharedPtr::emptyDestructor<double>());
+
+    Instructions::LambdaInstruction<Data::Constant, double> multByConst(
+        [](Data::Constant a, double b) { return (double)a.value * b; });
+    Instructions::LambdaInstruction<const double[2]> arrayInstruction(
+        [](const double a[2]) { return a[0] + a[1]; });
+    Instructions::LambdaInstruction<int> intInstruction(
+        [](int a) { return (double)a; });
+
+    ASSERT_EQ(arrayInstruction.getScalarFunction(), nullptr)
+        << "LambdaInstruction with array operands should not provide a "
+           "ScalarFunction.";
+    ASSERT_EQ(intInstruction.getScalarFunction(), nullptr)
+        << "LambdaInstruction with int operands should not provide a "
+           "ScalarFunction.";
+
+    Instructions::Instruction::ScalarFunction function =
+        multByConst.getScalarFunction();
+    ASSERT_NE(function, nullptr)
+        << "LambdaInstruction with double and Constant operands should "
+           "provide a ScalarFunction.";
+    const double operands[2]{(double)a, b};
+    ASSERT_EQ(function(multByConst, operands), multByConst.execute(vect))
+        << "ScalarFunction and execute method of a LambdaInstruction give "
+           "different results.";
+}
+
 #define arrayA 1.1, 2.2, 3.3
 #define arrayB 6.5, 4.3, 2.1
 TEST(LambdaInstructionsTest, ExecuteArray)
@@ -39,7 +39,8 @@
 
 #include "learn/adversarialLearningAgent.h"
 
-// Class only used for testing purpose : we create a custom jobs organization
+// Class only used for testing purpose : we create a custom matches
+// organization
 class AdversarialLearningAgentWithCustomMakeJobs
     : public Learn::AdversarialLearningAgent
 {
@@ -53,7 +54,7 @@ class AdversarialLearningAgentWithCustomMakeJobs
 
   protected:
     // Warning : this override guess there are at least 3 roots in the tpg graph
-    // It creates the following job :
+    // It creates the following matches :
     // root0-root1-root2
     // root0-root2-root1
     // root0-root1-root2
@@ -61,41 +62,30 @@ class AdversarialLearningAgentWithCustomMakeJobs
     // It means root0 is 3 times at pos 0 and 1 time at pos 1
     // root 1 is 1 time at pos 0 2 times at pos 1 and 1 time at pos 3
     // root 2 is 1 time at pos 1 and 3 times at pos 3
-    std::queue<std::shared_ptr<Learn::Job>> makeJobs(
+    Learn::MatchTable makeMatchTable(
         Learn::LearningMode mode, TPG::TPGGraph* tpgGraph = nullptr) override
     {
-        // sets the tpg to the Learning Agent's one if no one was specified
-        std::queue<std::shared_ptr<Learn::Job>> jobs;
+        Learn::MatchTable table(3);
 
         auto roots = tpg->getRootVertices();
+        for (auto root : roots) {
+            table.addParticipant(root);
+        }
 
         uint64_t archiveSeed;
         archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
-
-        auto job =
-            std::make_shared<Learn::AdversarialJob>(Learn::AdversarialJob(
-                {roots[0], roots[1], roots[2]}, archiveSeed, 0));
-        jobs.push(job);
+        table.addMatch({0, 1, 2}, -1, archiveSeed);
 
         archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
-        auto job2 =
-            std::make_shared<Learn::AdversarialJob>(Learn::AdversarialJob(
-                {roots[0], roots[2], roots[1]}, archiveSeed, 1));
-        jobs.push(job2);
+        table.addMatch({0, 2, 1}, -1, archiveSeed);
 
         archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
-        auto job3 =
-            std::make_shared<Learn::AdversarialJob>(Learn::AdversarialJob(
-                {roots[0], roots[1], roots[2]}, archiveSeed, 2));
-        jobs.push(job3);
+        table.addMatch({0, 1, 2}, -1, archiveSeed);
 
         archiveSeed = this->rng.getUnsignedInt64(0, UINT64_MAX);
-        auto job4 =
-            std::make_shared<Learn::AdversarialJob>(Learn::AdversarialJob(
-                {roots[1], roots[0], roots[2]}, archiveSeed, 3));
-        jobs.push(job4);
+        table.addMatch({1, 0, 2}, -1, archiveSeed);
 
-        return jobs;
+        return table;
     }
 };
 
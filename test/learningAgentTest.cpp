@@ -52,9 +52,14 @@
 #include "tpg/policyStats.h"
 #include "tpg/tpgGraph.h"
 
+#include "environment/batchPendulumLE.h"
+#include "environment/pendulumLE.h"
+
 #include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
 #include "mutator/rng.h"
 #include "mutator/tpgMutator.h"
+#include "program/optimizedProgram.h"
 
 #include "learn/learningAgent.h"
 #include "learn/learningEnvironment.h"
@@ -286,6 +291,136 @@ TEST_F(LearningAgentTest, EvalAllRoots)
            "TPGGraph.";
 }
 
+TEST_F(LearningAgentTest, SetBatchLearningEnvironment)
+{
+    // The PendulumLE only provides double data
+    Instructions::Set doubleSet;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    doubleSet.add(add);
+    doubleSet.add(sub);
+
+    const std::vector<double> actions{0.1, 0.5, 1.0};
+    PendulumLE pendulum(actions);
+    Learn::LearningAgent la(pendulum, doubleSet, params);
+
+    ASSERT_EQ(la.getBatchLearningEnvironment(), nullptr)
+        << "No BatchLearningEnvironment should be set by default.";
+
+    BatchPendulumLE ble(pendulum, 4);
+    ASSERT_NO_THROW(la.setBatchLearningEnvironment(&ble))
+        << "Setting a valid BatchLearningEnvironment failed.";
+    ASSERT_EQ(la.getBatchLearningEnvironment(), &ble)
+        << "The BatchLearningEnvironment was not set.";
+
+    // Lanes with data sources which are not copies of the pendulum ones.
+    BatchPendulumLE otherBle(actions, 4);
+    ASSERT_THROW(la.setBatchLearningEnvironment(&otherBle), std::runtime_error)
+        << "Setting a BatchLearningEnvironment with different data sources "
+           "should fail.";
+
+    // Different number of actions
+    BatchPendulumLE wrongBle(std::vector<double>{0.1}, 4);
+    ASSERT_THROW(la.setBatchLearningEnvironment(&wrongBle), std::runtime_error)
+        << "Setting a BatchLearningEnvironment with a different number of "
+           "actions should fail.";
+
+    ASSERT_NO_THROW(la.setBatchLearningEnvironment(nullptr))
+        << "Unsetting the BatchLearningEnvironment failed.";
+    ASSERT_EQ(la.getBatchLearningEnvironment(), nullptr)
+        << "The BatchLearningEnvironment was not unset.";
+}
+
+TEST_F(LearningAgentTest, EvalAllRootsLockstep)
+{
+    // Check that lockstep evaluation leads to the exact same results as the
+    // scalar one.
+    params.archiveSize = 50;
+    params.archivingProbability = 0.1;
+    params.maxNbActionsPerEval = 40;
+    params.nbIterationsPerPolicyEvaluation = 3;
+    params.nbThreads = 3;
+
+    // The PendulumLE only provides double data
+    Instructions::Set doubleSet;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    doubleSet.add(add);
+    doubleSet.add(sub);
+
+    PendulumLE pendulum({0.1, 0.5, 1.0});
+    BatchPendulumLE ble(pendulum, 4);
+
+    Learn::LearningAgent la(pendulum, doubleSet, params);
+    la.init(0);
+    auto results = la.evaluateAllRoots(0, Learn::LearningMode::TRAINING);
+
+    Learn::LearningAgent laLockstep(pendulum, doubleSet, params);
+    laLockstep.setBatchLearningEnvironment(&ble);
+    laLockstep.init(0);
+    auto resultsLockstep =
+        laLockstep.evaluateAllRoots(0, Learn::LearningMode::TRAINING);
+
+    Learn::ParallelLearningAgent plaLockstep(pendulum, doubleSet, params);
+    plaLockstep.setBatchLearningEnvironment(&ble);
+    plaLockstep.init(0);
+    auto resultsParallelLockstep =
+        plaLockstep.evaluateAllRoots(0, Learn::LearningMode::TRAINING);
+
+    for (auto* otherResults : {&resultsLockstep, &resultsParallelLockstep}) {
+        ASSERT_EQ(results.size(), otherResults->size())
+            << "Result maps have a different size.";
+        auto iter = results.begin();
+        auto iterOther = otherResults->begin();
+        while (iter != results.end()) {
+            ASSERT_EQ(iter->first->getResult(), iterOther->first->getResult())
+                << "Average score between scalar and lockstep evaluations are "
+                   "different.";
+            ASSERT_EQ(iter->first->getVariance(),
+                      iterOther->first->getVariance())
+                << "Score variance between scalar and lockstep evaluations "
+                   "are different.";
+            iter++;
+            iterOther++;
+        }
+    }
+
+    // Check archives
+    ASSERT_GT(la.getArchive().getNbRecordings(), 0)
+        << "For the archive determinism tests to be meaningful, Archive should "
+           "not be empty.";
+    for (auto* other : {&laLockstep, (Learn::LearningAgent*)&plaLockstep}) {
+        ASSERT_EQ(la.getArchive().getNbRecordings(),
+                  other->getArchive().getNbRecordings())
+            << "Archives have different sizes.";
+        for (auto i = 0; i < la.getArchive().getNbRecordings(); i++) {
+            ASSERT_EQ(la.getArchive().at(i).dataHash,
+                      other->getArchive().at(i).dataHash)
+                << "Archives have different content.";
+            ASSERT_EQ(la.getArchive().at(i).result,
+                      other->getArchive().at(i).result)
+                << "Archives have different content.";
+        }
+    }
+
+    // Validation mode does not use archives.
+    auto validationResults =
+        la.evaluateAllRoots(0, Learn::LearningMode::VALIDATION);
+    auto validationResultsLockstep =
+        plaLockstep.evaluateAllRoots(0, Learn::LearningMode::VALIDATION);
+    auto iter = validationResults.begin();
+    auto iterLockstep = validationResultsLockstep.begin();
+    while (iter != validationResults.end()) {
+        ASSERT_EQ(iter->first->getResult(), iterLockstep->first->getResult())
+            << "Average score between scalar and lockstep evaluations are "
+               "different.";
+        iter++;
+        iterLockstep++;
+    }
+}
+
 TEST_F(LearningAgentTest, GetArchive)
 {
     params.archiveSize = 50;
@@ -477,6 +612,13 @@ TEST_F(LearningAgentTest, DecimateWorstRoots)
     // Do the decimation
     ASSERT_NO_THROW(la.decimateWorstRoots(results))
         << "Decimating worst roots failed.";
+    ASSERT_EQ(results.size(), roots.size() - floor(params.ratioDeletedRoots *
+                                                   params.mutation.tpg.nbRoots))
+        << "Results of decimated roots should be removed from the map.";
+    for (const auto& result : results) {
+        ASSERT_TRUE(la.getTPGGraph()->hasVertex(*result.second))
+            << "Results of decimated roots should be removed from the map.";
+    }
 
     // Check the number of remaining roots.
     // Initial number of vertex - 2 removed vertices - deleted roots.
@@ -511,7 +653,7 @@ TEST_F(LearningAgentTest, TrainOnegeneration)
                                      la.getRNG(), 1);
     size_t initialNbVertex = la.getTPGGraph()->getNbVertices();
     // Seed selected so that an action becomes a root during next generation
-    ASSERT_NO_THROW(la.trainOneGeneration(4))
+    ASSERT_NO_THROW(la.trainOneGeneration(5))
         << "Training for one generation failed.";
     // Check the number of vertex in the graph.
     // Must be initial number of vertex - number of root removed
@@ -520,6 +662,26 @@ TEST_F(LearningAgentTest, TrainOnegeneration)
                   floor(params.ratioDeletedRoots * params.mutation.tpg.nbRoots))
         << "Number of remaining is under the number of roots from the "
            "TPGGraph.";
+    // The evaluation table holds the results of the remaining roots.
+    const Learn::EvaluationTable& table = la.getEvaluationTable();
+    ASSERT_EQ(table.getNbRows(),
+              params.mutation.tpg.nbRoots -
+                  floor(params.ratioDeletedRoots * params.mutation.tpg.nbRoots))
+        << "Decimated roots should be removed from the EvaluationTable.";
+    for (size_t row = 0; row < table.getNbRows(); row++) {
+        ASSERT_TRUE(la.getTPGGraph()->hasVertex(*table.getRoot(row)))
+            << "Decimated roots should be removed from the EvaluationTable.";
+        ASSERT_EQ(table.getSharedResult(row), nullptr)
+            << "Roots evaluated for the first time should be stored by value "
+               "in the EvaluationTable.";
+        ASSERT_EQ(table.getResult(row)->getNbEvaluation(),
+                  params.nbIterationsPerPolicyEvaluation)
+            << "Rows of the EvaluationTable should hold their result.";
+    }
+    // Records of re-evaluated roots are updated in place.
+    const TPG::TPGVertex* bestVertex = la.getBestRoot().first;
+    std::shared_ptr<Learn::EvaluationResult> bestResult =
+        la.getBestRoot().second;
     // Train a second generation, because most roots were removed, a root
     // actions have appeared and the training algorithm will attempt to remove
     // them.
@@ -531,6 +693,12 @@ TEST_F(LearningAgentTest, TrainOnegeneration)
 
     // Check that bestRoot has been set
     ASSERT_NE(la.getBestRoot().first, nullptr);
+    if (la.getBestRoot().first == bestVertex &&
+        la.getBestRoot().second->getNbEvaluation() >
+            params.nbIterationsPerPolicyEvaluation) {
+        ASSERT_EQ(la.getBestRoot().second, bestResult)
+            << "Stored results should be updated in place.";
+    }
 
     o.close();
     std::ifstream i("tempFileForTest", std::ofstream::in);
@@ -590,14 +758,14 @@ TEST_F(LearningAgentTest, TrainPortability)
     // end up with the same number of vertices, roots, edges and calls to
     // the RNG without being identical.
     TPG::TPGGraph& tpg = *la.getTPGGraph();
-    ASSERT_EQ(tpg.getNbVertices(), 31)
+    ASSERT_EQ(tpg.getNbVertices(), 32)
         << "Graph does not have the expected determinst characteristics.";
-    ASSERT_EQ(tpg.getNbRootVertices(), 25)
+    ASSERT_EQ(tpg.getNbRootVertices(), 24)
         << "Graph does not have the expected determinist characteristics.";
-    ASSERT_EQ(tpg.getEdges().size(), 106)
+    ASSERT_EQ(tpg.getEdges().size(), 104)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
-              14825295448422883263u)
+              11746692907131576226u)
         << "Graph does not have the expected determinst characteristics.";
 }
 
@@ -626,14 +794,14 @@ TEST_F(LearningAgentTest, TrainInstrumented)
     // end up with the same number of vertices, roots, edges and calls to
     // the RNG without being identical.
     TPG::TPGGraph& tpg = *la.getTPGGraph();
-    ASSERT_EQ(tpg.getNbVertices(), 31)
+    ASSERT_EQ(tpg.getNbVertices(), 32)
         << "Graph does not have the expected determinst characteristics.";
-    ASSERT_EQ(tpg.getNbRootVertices(), 25)
+    ASSERT_EQ(tpg.getNbRootVertices(), 24)
         << "Graph does not have the expected determinist characteristics.";
-    ASSERT_EQ(tpg.getEdges().size(), 106)
+    ASSERT_EQ(tpg.getEdges().size(), 104)
         << "Graph does not have the expected determinst characteristics.";
     ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
-              14825295448422883263u)
+              11746692907131576226u)
         << "Graph does not have the expected determinst characteristics.";
 
     // Check number of visits of a few edges & vertices
@@ -641,7 +809,7 @@ TEST_F(LearningAgentTest, TrainInstrumented)
     const auto* edge1 = edgesIterator->get();
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge1)->getNbVisits(),
-        2151);
+        178);
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge1)->getNbTraversal(),
         0);
@@ -650,20 +818,105 @@ TEST_F(LearningAgentTest, TrainInstrumented)
     const auto* edge2 = edgesIterator->get();
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge2)->getNbVisits(),
-        106);
+        82);
     ASSERT_EQ(
         dynamic_cast<const TPG::TPGEdgeInstrumented*>(edge2)->getNbTraversal(),
-        106);
+        0);
 
     auto& verticesIterator = tpg.getVertices();
     ASSERT_EQ(dynamic_cast<const TPG::TPGVertexInstrumentation*>(
                   verticesIterator.at(0))
                   ->getNbVisits(),
-              8488);
+              1736);
     ASSERT_EQ(dynamic_cast<const TPG::TPGVertexInstrumentation*>(
                   verticesIterator.at(3))
                   ->getNbVisits(),
-              2151);
+              690);
+}
+
+TEST_F(LearningAgentTest, TrainBytecode)
+{
+    // Check that training with the bytecode execution leads to the exact same
+    // results as with the execution of Program lines.
+    params.archiveSize = 50;
+    params.archivingProbability = 0.5;
+    params.maxNbActionsPerEval = 40;
+    params.nbIterationsPerPolicyEvaluation = 3;
+    params.ratioDeletedRoots = 0.2;
+    params.nbGenerations = 5;
+
+    // The PendulumLE only provides double data, so that Programs are
+    // compiled into scalar calls instead of generic operations.
+    Instructions::Set doubleSet;
+    Instructions::AddPrimitiveType<double> add;
+    Instructions::LambdaInstruction<double, double> sub(
+        [](double a, double b) { return a - b; });
+    doubleSet.add(add);
+    doubleSet.add(sub);
+
+    PendulumLE pendulum({0.1, 0.5, 1.0});
+
+    Learn::LearningAgent la(pendulum, doubleSet, params);
+    la.init(0);
+
+    // Enable the bytecode after the init to check the recompilation of
+    // existing Programs.
+    Learn::LearningAgent laBytecode(pendulum, doubleSet, params);
+    laBytecode.init(0);
+    ASSERT_NO_THROW(laBytecode.setBytecodeExecution(true))
+        << "Enabling the bytecode execution of a LearningAgent failed.";
+    ASSERT_TRUE(laBytecode.getEnvironment().isBytecodeExecution())
+        << "Bytecode execution was not forwarded to the Environment.";
+    const Program::OptimizedProgram* optimized = laBytecode.getTPGGraph()
+                                                     ->getEdges()
+                                                     .front()
+                                                     ->getProgram()
+                                                     .getOptimizedProgram();
+    ASSERT_NE(optimized, nullptr) << "Programs should be optimized.";
+    ASSERT_NE(optimized->getBytecodeProgram(), nullptr)
+        << "Existing Programs were not compiled into bytecode.";
+
+    for (uint64_t i = 0; i < params.nbGenerations; i++) {
+        la.trainOneGeneration(i);
+        laBytecode.trainOneGeneration(i);
+        ASSERT_EQ(la.getBestScoreLastGen(), laBytecode.getBestScoreLastGen())
+            << "Best score of generation " << i
+            << " differs with the bytecode execution.";
+    }
+
+    ASSERT_EQ(la.getTPGGraph()->getNbVertices(),
+              laBytecode.getTPGGraph()->getNbVertices())
+        << "Training with the bytecode execution results in a different "
+           "TPGGraph.";
+    ASSERT_EQ(la.getTPGGraph()->getEdges().size(),
+              laBytecode.getTPGGraph()->getEdges().size())
+        << "Training with the bytecode execution results in a different "
+           "TPGGraph.";
+    ASSERT_EQ(la.getBestRoot().second->getResult(),
+              laBytecode.getBestRoot().second->getResult())
+        << "Training with the bytecode execution results in a different best "
+           "root.";
+    ASSERT_EQ(la.getRNG().getUnsignedInt64(0, UINT64_MAX),
+              laBytecode.getRNG().getUnsignedInt64(0, UINT64_MAX))
+        << "Training with the bytecode execution results in a different "
+           "number of calls to the RNG.";
+    for (const auto& edge : laBytecode.getTPGGraph()->getEdges()) {
+        optimized = edge->getProgram().getOptimizedProgram();
+        ASSERT_TRUE(optimized == nullptr ||
+                    optimized->getBytecodeProgram() != nullptr)
+            << "Programs mutated during the training were not compiled into "
+               "bytecode.";
+    }
+
+    // Disabling the bytecode execution recompiles Programs without it.
+    laBytecode.setBytecodeExecution(false);
+    for (const auto& edge : laBytecode.getTPGGraph()->getEdges()) {
+        optimized = edge->getProgram().getOptimizedProgram();
+        ASSERT_TRUE(optimized == nullptr ||
+                    optimized->getBytecodeProgram() == nullptr)
+            << "Programs were not recompiled after disabling the bytecode "
+               "execution.";
+    }
 }
 
 TEST_F(LearningAgentTest, KeepBestPolicy)
@@ -146,7 +146,7 @@ TEST(LearningEnvironmentTest, getScoreAndIsTerminal)
         << "Score should be zero until the game is over";
 
     // Play the full game and lose with known seed (0)
-    std::vector<int> actions = {0, 1, 2, 1, 2, 0};
+    std::vector<int> actions = {0, 0, 0, 0, 2, 2};
     for (auto& action : actions) {
         ASSERT_FALSE(le.isTerminal())
             << "With a known seed and action sequence, the game should not be "
@@ -159,7 +159,7 @@ TEST(LearningEnvironmentTest, getScoreAndIsTerminal)
     ASSERT_EQ(le.getScore(), 0.0) << "Score when losing the game should be 0.";
 
     le.reset(0);
-    actions = {0, 1, 2, 2, 1, 2};
+    actions = {0, 0, 0, 1, 2, 2};
     for (auto& action : actions) {
         ASSERT_FALSE(le.isTerminal())
             << "With a known seed and action sequence, the game should not be "
@@ -172,7 +172,7 @@ TEST(LearningEnvironmentTest, getScoreAndIsTerminal)
         << "Score when losing the game with an illegal action should be -1.0.";
 
     le.reset(0);
-    actions = {0, 1, 2, 2, 0, 0};
+    actions = {0, 0, 0, 0, 0, 1};
     for (auto action : actions) {
         ASSERT_FALSE(le.isTerminal())
             << "With a known seed and action sequence, the game should not be "
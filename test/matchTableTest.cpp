@@ -0,0 +1,116 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "learn/matchTable.h"
+#include "tpg/tpgAction.h"
+
+TEST(MatchTableTest, Constructor)
+{
+    Learn::MatchTable* table = nullptr;
+    ASSERT_NO_THROW(table = new Learn::MatchTable(3))
+        << "Construction of the MatchTable failed.";
+    ASSERT_EQ(table->getNbSeats(), 3);
+    ASSERT_EQ(table->getNbMatches(), 0);
+    ASSERT_EQ(table->getNbParticipants(), 0);
+    ASSERT_NO_THROW(delete table) << "Destruction of the MatchTable failed.";
+
+    ASSERT_THROW(Learn::MatchTable(0), std::runtime_error)
+        << "A MatchTable with no seat should not be constructible.";
+}
+
+TEST(MatchTableTest, AddParticipantAndMatch)
+{
+    TPG::TPGAction a(0), b(1), c(2);
+    Learn::MatchTable table(2);
+
+    ASSERT_EQ(table.addParticipant(&a), 0);
+    ASSERT_EQ(table.addParticipant(&b), 1);
+    ASSERT_EQ(table.addParticipant(&a), 0)
+        << "An existing participant should keep its index.";
+    ASSERT_EQ(table.getNbParticipants(), 2);
+    ASSERT_EQ(table.findParticipant(&b), 1);
+    ASSERT_THROW(table.findParticipant(&c), std::out_of_range);
+    ASSERT_EQ(table.getParticipant(1), &b);
+    ASSERT_THROW(table.getParticipant(2), std::out_of_range);
+
+    ASSERT_EQ(table.addMatch({1, 0}, 0, 42, 0), 0);
+    ASSERT_EQ(table.addMatch({0, 1}, -1, 43, 1), 1);
+    ASSERT_THROW(table.addMatch({0, 1, 1}, 0, 0), std::runtime_error)
+        << "Match with a wrong number of seats should not be added.";
+    ASSERT_THROW(table.addMatch({0, 2}, 0, 0), std::runtime_error)
+        << "Match with an unknown participant should not be added.";
+    ASSERT_THROW(table.addMatch({0, 1}, 2, 0), std::runtime_error)
+        << "Match with an invalid studied seat should not be added.";
+    ASSERT_EQ(table.getNbMatches(), 2);
+
+    ASSERT_EQ(table.getParticipantIdx(0, 0), 1);
+    ASSERT_EQ(table.getParticipantIdx(0, 1), 0);
+    ASSERT_THROW(table.getParticipantIdx(0, 2), std::out_of_range);
+    ASSERT_THROW(table.getParticipantIdx(2, 0), std::out_of_range);
+    ASSERT_EQ(table.getStudiedSeat(0), 0);
+    ASSERT_EQ(table.getStudiedSeat(1), -1);
+    ASSERT_EQ(table.getArchiveSeed(1), 43);
+    ASSERT_EQ(table.getOpponentGroup(1), 1);
+
+    std::vector<const TPG::TPGVertex*> participants;
+    table.getMatchParticipants(0, participants);
+    ASSERT_EQ(participants.size(), 2);
+    ASSERT_EQ(participants.at(0), &b);
+    ASSERT_EQ(participants.at(1), &a);
+    ASSERT_THROW(table.getMatchParticipants(2, participants),
+                 std::out_of_range);
+}
+
+TEST(MatchTableTest, GetSchedule)
+{
+    TPG::TPGAction a(0);
+    Learn::MatchTable table(1);
+    table.addParticipant(&a);
+
+    // Groups of the matches, in the order of matches
+    const std::vector<uint32_t> groups{2, 0, 1, 0, 2, 1, 0};
+    for (auto group : groups) {
+        table.addMatch({0}, 0, 0, group);
+    }
+
+    std::vector<size_t> schedule = table.getSchedule();
+    const std::vector<size_t> expected{1, 3, 6, 2, 5, 0, 4};
+    ASSERT_EQ(schedule, expected)
+        << "Schedule should gather matches by group, in increasing index "
+           "order.";
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "data/primitiveTypeArray.h"
+#include "data/primitiveTypeArray2D.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/set.h"
+#include "learn/adversarialEvaluationResult.h"
+#include "learn/classificationEvaluationResult.h"
+#include "learn/evaluationTable.h"
+#include "program/program.h"
+#include "tpg/tpgGraph.h"
+#include "util/memoryFootprint.h"
+
+#include "archive.h"
+
+class MemoryFootprintTest : public ::testing::Test
+{
+  protected:
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Data::PrimitiveTypeArray<double> doubleData{24};
+    Data::PrimitiveTypeArray<int> intData{32};
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<int> addInt;
+    Instructions::LambdaInstruction<double, double> minus{
+        [](double a, double b) -> double { return a - b; }};
+    std::unique_ptr<Environment> e;
+
+    virtual void SetUp()
+    {
+        vect.push_back(doubleData);
+        vect.push_back(intData);
+        set.add(addInt);
+        set.add(minus);
+        e = std::make_unique<Environment>(set, vect, 8, 5);
+    }
+};
+
+TEST_F(MemoryFootprintTest, Components)
+{
+    Util::MemoryFootprint footprint;
+    ASSERT_EQ(footprint.getTotal(), 0);
+    ASSERT_EQ(footprint.get("a"), 0);
+
+    footprint.add("a", 10);
+    footprint.add("a", 5);
+    footprint.add("ab", 7);
+    Util::MemoryFootprint other;
+    other.add("x", 100);
+    other.add("y.z", 1000);
+    footprint.add("a", other);
+    footprint.add("b", 1);
+
+    ASSERT_EQ(footprint.get("a"), 1115)
+        << "Group should contain the component and its subcomponents.";
+    ASSERT_EQ(footprint.get("a.y"), 1000);
+    ASSERT_EQ(footprint.get("ab"), 7)
+        << "Components sharing a name prefix should not be grouped.";
+    ASSERT_EQ(footprint.getTotal(), 1123);
+    ASSERT_EQ(footprint.getComponents().size(), 5);
+
+    footprint.set("ab", 3);
+    ASSERT_EQ(footprint.get("ab"), 3);
+}
+
+TEST_F(MemoryFootprintTest, DataHandler)
+{
+    Util::MemoryFootprint footprint = doubleData.getMemoryFootprint();
+    ASSERT_EQ(footprint.get("object"),
+              sizeof(Data::PrimitiveTypeArray<double>));
+    ASSERT_EQ(footprint.get("data"), 24 * sizeof(double));
+
+    Data::PrimitiveTypeArray2D<float> data2D(4, 5);
+    ASSERT_EQ(data2D.getMemoryFootprint().get("data"), 20 * sizeof(float));
+
+    // Wrapped data is not owned
+    std::vector<double> container(100);
+    Data::ArrayWrapper<double> wrapper(100, &container);
+    ASSERT_EQ(wrapper.getMemoryFootprint().get("data"), 0);
+}
+
+TEST_F(MemoryFootprintTest, Program)
+{
+    Program::Program p(*e);
+    Util::MemoryFootprint empty = p.getMemoryFootprint();
+    ASSERT_EQ(empty.get("lines"), 0);
+    ASSERT_GE(empty.get("constants"), 5 * sizeof(Data::Constant));
+
+    p.addNewLine();
+    p.addNewLine();
+    ASSERT_GE(p.getMemoryFootprint().get("lines"),
+              2 * (sizeof(Program::Line) +
+                   e->getMaxNbOperands() * sizeof(std::pair<uint64_t, uint64_t>)));
+}
+
+TEST_F(MemoryFootprintTest, Archive)
+{
+    Archive archive(10);
+    size_t emptyTotal = archive.getMemoryFootprint().getTotal();
+    ASSERT_EQ(archive.getMemoryFootprint().get("snapshots.copies"), 0);
+
+    Program::Program p(*e);
+    archive.addRecording(&p, vect, 1.0);
+    Util::MemoryFootprint footprint = archive.getMemoryFootprint();
+    ASSERT_GT(footprint.getTotal(), emptyTotal);
+    ASSERT_GE(footprint.get("recordings"), sizeof(ArchiveRecording));
+    ASSERT_GE(footprint.get("snapshots.copies"),
+              24 * sizeof(double) + 32 * sizeof(int))
+        << "Copies of the DataHandler should be counted.";
+
+    archive.clear();
+    ASSERT_EQ(archive.getMemoryFootprint().get("snapshots.copies"), 0);
+}
+
+TEST_F(MemoryFootprintTest, TPGGraph)
+{
+    TPG::TPGGraph tpg(*e);
+    ASSERT_EQ(tpg.getMemoryFootprint().get("vertices"), 0);
+
+    const TPG::TPGTeam& team = tpg.addNewTeam();
+    const TPG::TPGAction& action0 = tpg.addNewAction(0);
+    const TPG::TPGAction& action1 = tpg.addNewAction(1);
+    auto prog = std::make_shared<Program::Program>(*e);
+    prog->addNewLine();
+    tpg.addNewEdge(team, action0, prog);
+    Util::MemoryFootprint oneEdge = tpg.getMemoryFootprint();
+    ASSERT_GT(oneEdge.get("vertices"), 0);
+    ASSERT_GE(oneEdge.get("edges"), sizeof(TPG::TPGEdge));
+    ASSERT_EQ(oneEdge.get("programs"),
+              prog->getMemoryFootprint().getTotal());
+
+    // Shared Programs are counted once.
+    tpg.addNewEdge(team, action1, prog);
+    ASSERT_EQ(tpg.getMemoryFootprint().get("programs"),
+              oneEdge.get("programs"));
+    ASSERT_GT(tpg.getMemoryFootprint().get("edges"), oneEdge.get("edges"));
+}
+
+TEST_F(MemoryFootprintTest, EvaluationResult)
+{
+    Learn::EvaluationResult result(1.0, 2);
+    ASSERT_EQ(result.getMemoryFootprint().getTotal(),
+              sizeof(Learn::EvaluationResult));
+
+    // Child classes count their object and buffers.
+    Learn::ClassificationEvaluationResult classifResult({1.0, 2.0, 3.0},
+                                                        {1, 1, 1});
+    Util::MemoryFootprint footprint = classifResult.getMemoryFootprint();
+    ASSERT_EQ(footprint.get("object"),
+              sizeof(Learn::ClassificationEvaluationResult));
+    ASSERT_GE(footprint.get("scorePerClass"), 3 * sizeof(double));
+    ASSERT_GE(footprint.get("nbEvaluationPerClass"), 3 * sizeof(size_t));
+
+    // Through the base class
+    const Learn::EvaluationResult& base = classifResult;
+    ASSERT_EQ(base.getMemoryFootprint().getTotal(), footprint.getTotal());
+
+    Learn::AdversarialEvaluationResult advResult(4);
+    ASSERT_GE(advResult.getMemoryFootprint().get("scores"),
+              4 * sizeof(double));
+}
+
+TEST_F(MemoryFootprintTest, EvaluationTable)
+{
+    Learn::EvaluationTable table;
+    ASSERT_EQ(table.getMemoryFootprint().getTotal(), 0);
+
+    TPG::TPGGraph tpg(*e);
+    const TPG::TPGAction& action = tpg.addNewAction(0);
+    table.clear(2);
+    table.addRow(&action, 1.0, 2);
+    Util::MemoryFootprint footprint = table.getMemoryFootprint();
+    ASSERT_GE(footprint.get("roots"), sizeof(TPG::TPGVertex*));
+    ASSERT_GE(footprint.get("scores"), sizeof(double));
+    ASSERT_GE(footprint.get("nbEvaluations"), sizeof(size_t));
+    ASSERT_GE(footprint.get("variances"), sizeof(double));
+    ASSERT_GE(footprint.get("sharedResults"),
+              sizeof(std::shared_ptr<Learn::EvaluationResult>));
+    ASSERT_GE(footprint.get("classScores"), 2 * sizeof(double));
+
+    // Memory is kept when the table is cleared.
+    table.clear();
+    ASSERT_EQ(table.getMemoryFootprint().getTotal(), footprint.getTotal());
+}
@@ -119,15 +119,55 @@ TEST_F(MutatorTest, RNG)
     Mutator::RNG rng;
     rng.setSeed(0);
 
-    // With this seed, the current pseudo-random number generator returns 24
+    // With this seed, the current pseudo-random number generator returns 14
     // on its first use
-    ASSERT_EQ(rng.getUnsignedInt64(0, 100), 24)
+    ASSERT_EQ(rng.getUnsignedInt64(0, 100), 14)
         << "Returned pseudo-random value changed with a known seed.";
 
-    ASSERT_EQ(rng.getDouble(0, 1.0), 0.99214520962982877)
+    ASSERT_EQ(rng.getDouble(0, 1.0), 0.70121210952152535)
         << "Returned pseudo-random value changed with a known seed.";
 }
 
+TEST_F(MutatorTest, RNGSplitAndFill)
+{
+    Mutator::RNG rng(0);
+    Mutator::RNG rngCopy(rng);
+
+    // Splitting does not consume any random number.
+    Mutator::RNG split0 = rng.split(0);
+    Mutator::RNG split0Bis = rng.split(0);
+    Mutator::RNG split1 = rng.split(1);
+    ASSERT_EQ(rng.getUnsignedInt64(0, UINT64_MAX),
+              rngCopy.getUnsignedInt64(0, UINT64_MAX))
+        << "Splitting an RNG should not alter its sequence.";
+
+    // Same stream give identical RNG, different streams different ones.
+    uint64_t value0 = split0.getUnsignedInt64(0, UINT64_MAX);
+    ASSERT_EQ(value0, split0Bis.getUnsignedInt64(0, UINT64_MAX))
+        << "RNG split with the same stream should be identical.";
+    ASSERT_NE(value0, split1.getUnsignedInt64(0, UINT64_MAX))
+        << "RNG split with different streams should differ.";
+    ASSERT_NE(value0, rng.getUnsignedInt64(0, UINT64_MAX))
+        << "RNG split should differ from the original RNG.";
+
+    // Filled values are identical to the ones obtained one by one.
+    std::vector<uint64_t> ints(10);
+    std::vector<double> doubles(10);
+    rng.fillUnsignedInt64(3, 42, ints);
+    rng.fillDouble(-1.0, 1.0, doubles);
+    rngCopy.setSeed(0);
+    rngCopy.getUnsignedInt64(0, UINT64_MAX);
+    rngCopy.getUnsignedInt64(0, UINT64_MAX);
+    for (uint64_t value : ints) {
+        ASSERT_EQ(value, rngCopy.getUnsignedInt64(3, 42))
+            << "Batched generation differs from individual generation.";
+    }
+    for (double value : doubles) {
+        ASSERT_EQ(value, rngCopy.getDouble(-1.0, 1.0))
+            << "Batched generation differs from individual generation.";
+    }
+}
+
 TEST_F(MutatorTest, LineMutatorInitRandomCorrectLine1)
 {
     Mutator::RNG rng;
@@ -139,32 +179,32 @@ TEST_F(MutatorTest, LineMutatorInitRandomCorrectLine1)
         << "Pseudo-Random correct line initialization failed within an "
            "environment where failure should not be possible.";
     // With this known seed
-    // InstructionIndex=3 > lambda instruction (plus)
-    // DestinationIndex=6
-    // Operand 0= (0, 12) => 12th register
-    // Covers: correct instruction, correct operand type (register), additional
-    // uneeded operand (not register)
-    ASSERT_EQ(l0.getInstructionIndex(), 3)
+    // InstructionIndex=2 > lambda instruction (minus)
+    // DestinationIndex=7
+    // Operand 0= (3, 6) => 6th double of the second data source
+    // Covers: correct instruction, correct operand type (data source),
+    // additional uneeded operand (not register)
+    ASSERT_EQ(l0.getInstructionIndex(), 2)
         << "Selected pseudo-random instructionIndex changed with a known seed.";
-    ASSERT_EQ(l0.getDestinationIndex(), 6)
+    ASSERT_EQ(l0.getDestinationIndex(), 7)
         << "Selected pseudo-random destinationIndex changed with a known seed.";
-    ASSERT_EQ(l0.getOperand(0).first, 0)
+    ASSERT_EQ(l0.getOperand(0).first, 3)
         << "Selected pseudo-random operand data source index changed with a "
            "known seed.";
-    ASSERT_EQ(l0.getOperand(0).second, 12)
+    ASSERT_EQ(l0.getOperand(0).second, 6)
         << "Selected pseudo-random operand location changed with a known seed.";
 
     // Add another pseudo-random lines to the program
     Program::Line& l1 = p->addNewLine();
-    // Additionally covers correct operand type from data source
-    // Instruction if lambda instruction(plus)
-    // first operand is register 0
+    // Additionally covers correct operand type from registers
+    // Instruction is lambda instruction (minus)
+    // second operand is a register
     ASSERT_NO_THROW(Mutator::LineMutator::initRandomCorrectLine(l1, rng))
         << "Pseudo-Random correct line initialization failed within an "
            "environment where failure should not be possible.";
-    ASSERT_EQ(l1.getInstructionIndex(), 3)
+    ASSERT_EQ(l1.getInstructionIndex(), 2)
         << "Selected pseudo-random instructionIndex changed with a known seed.";
-    ASSERT_EQ(l1.getOperand(0).first, 0)
+    ASSERT_EQ(l1.getOperand(1).first, 0)
         << "Selected pseudo-random operand data source index changed with a "
            "known seed.";
 
@@ -185,9 +225,9 @@ TEST_F(MutatorTest, LineMutatorInitRandomCorrectLine1)
     ASSERT_NO_THROW(Mutator::LineMutator::initRandomCorrectLine(l4, rng))
         << "Pseudo-Random correct line initialization failed within an "
            "environment where failure should not be possible.";
-    ASSERT_EQ(l4.getInstructionIndex(), 3)
+    ASSERT_EQ(l4.getInstructionIndex(), 0)
         << "Selected pseudo-random instructionIndex changed with a known seed.";
-    ASSERT_EQ(l4.getOperand(1).first, 3)
+    ASSERT_EQ(l4.getOperand(1).first, 1)
         << "Selected pseudo-random operand data source index changed with a "
            "known seed.";
 
@@ -207,8 +247,8 @@ TEST_F(MutatorTest, LineMutatorAlterLine)
     Program::Line& l0 = p->addNewLine();
 
     // Alter instruction
-    // i=, d=0, op0=(0,0), op1=(0,0)
-    rng.setSeed(5);
+    // i=2, d=0, op0=(0,0), op1=(0,0)
+    rng.setSeed(10);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getInstructionIndex(), 2)
@@ -216,17 +256,17 @@ TEST_F(MutatorTest, LineMutatorAlterLine)
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter destination
-    // i=2, d=3, op0=(0,0), op1=(0,0)
-    rng.setSeed(29);
+    // i=2, d=7, op0=(0,0), op1=(0,0)
+    rng.setSeed(1);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
-    ASSERT_EQ(l0.getDestinationIndex(), 3)
+    ASSERT_EQ(l0.getDestinationIndex(), 7)
         << "Alteration with known seed changed its result.";
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter operand 0 data source
-    // i=2, d=3, op0=(3,0), op1=(0,0)
-    rng.setSeed(8);
+    // i=2, d=7, op0=(3,0), op1=(0,0)
+    rng.setSeed(2);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getOperand(0).first, 3)
@@ -234,17 +274,17 @@ TEST_F(MutatorTest, LineMutatorAlterLine)
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter operand 0 location
-    // i=2, d=3, op0=(3,17), op1=(0,0)
-    rng.setSeed(1);
+    // i=2, d=7, op0=(3,8), op1=(0,0)
+    rng.setSeed(3);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
-    ASSERT_EQ(l0.getOperand(0).second, 17)
+    ASSERT_EQ(l0.getOperand(0).second, 8)
         << "Alteration with known seed changed its result.";
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter operand 1 data source
-    // i=2, d=3, op0=(3,17), op1=(3,0)
-    rng.setSeed(323);
+    // i=2, d=7, op0=(3,8), op1=(3,0)
+    rng.setSeed(5);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getOperand(1).first, 3)
@@ -252,30 +292,30 @@ TEST_F(MutatorTest, LineMutatorAlterLine)
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter operand 1 location
-    // i=2, d=3, op0=(3,17), op1=(3,28)
-    rng.setSeed(2);
+    // i=2, d=7, op0=(3,8), op1=(3,27)
+    rng.setSeed(4);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
-    ASSERT_EQ(l0.getOperand(1).second, 28)
+    ASSERT_EQ(l0.getOperand(1).second, 27)
         << "Alteration with known seed changed its result.";
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter instruction index
-    // i=1, d=3, op0=(3,17), op1=(3,28)
-    rng.setSeed(5);
+    // i=1, d=7, op0=(3,8), op1=(3,27)
+    rng.setSeed(10);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getInstructionIndex(), 1)
         << "Alteration with known seed changed its result.";
-    ASSERT_EQ(l0.getDestinationIndex(), 3)
+    ASSERT_EQ(l0.getDestinationIndex(), 7)
         << "Alteration with known seed changed its result.";
     ASSERT_EQ(l0.getOperand(0).first, 3)
         << "Alteration with known seed changed its result.";
-    ASSERT_EQ(l0.getOperand(0).second, 17)
+    ASSERT_EQ(l0.getOperand(0).second, 8)
         << "Alteration with known seed changed its result.";
     ASSERT_EQ(l0.getOperand(1).first, 3)
         << "Alteration with known seed changed its result.";
-    ASSERT_EQ(l0.getOperand(1).second, 28)
+    ASSERT_EQ(l0.getOperand(1).second, 27)
         << "Alteration with known seed changed its result.";
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 }
@@ -301,8 +341,8 @@ TEST_F(MutatorTest, LineMutatorAlterLineWithCompositeOperands)
     Program::Line& l0 = p2.addNewLine();
 
     // Alter instruction
-    // i=2, d=0, op0=(0,0), op1=(0,0)
-    rng.setSeed(5);
+    // i=1, d=0, op0=(0,0), op1=(0,0)
+    rng.setSeed(50);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getInstructionIndex(), 1)
@@ -310,17 +350,17 @@ TEST_F(MutatorTest, LineMutatorAlterLineWithCompositeOperands)
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter op1 location
-    // i=2, d=0, op0=(0,0), op1=(0,16),  param=0
-    rng.setSeed(4);
+    // i=1, d=0, op0=(0,0), op1=(0,18),  param=0
+    rng.setSeed(0);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
-    ASSERT_EQ(l0.getOperand(1).second, 16)
+    ASSERT_EQ(l0.getOperand(1).second, 18)
         << "Alteration with known seed changed its result.";
     ASSERT_NO_THROW(pEE.executeProgram()) << "Altered line is not executable.";
 
     // Alter op0 source
-    // i=2, d=0, op0=(3,0), op1=(0,16),  param=0
-    rng.setSeed(3);
+    // i=1, d=0, op0=(3,0), op1=(0,18),  param=0
+    rng.setSeed(1);
     ASSERT_NO_THROW(Mutator::LineMutator::alterCorrectLine(l0, rng))
         << "Line mutation of a correct instruction should not throw.";
     ASSERT_EQ(l0.getOperand(0).first, 3)
@@ -417,15 +457,15 @@ TEST_F(MutatorTest, ProgramMutatorSwapRandomLines)
     }
     // Swap two random lines (with a known seed)
     ASSERT_TRUE(Mutator::ProgramMutator::swapRandomLines(*p, rng));
-    // Only lines 4 and 7 are swapped
+    // Only lines 2 and 4 are swapped
     ASSERT_EQ(lines.at(0), &p->getLine(1));
     ASSERT_EQ(lines.at(1), &p->getLine(0));
-    ASSERT_EQ(lines.at(2), &p->getLine(2));
+    ASSERT_EQ(lines.at(2), &p->getLine(4));
     ASSERT_EQ(lines.at(3), &p->getLine(3));
-    ASSERT_EQ(lines.at(4), &p->getLine(7));
+    ASSERT_EQ(lines.at(4), &p->getLine(2));
     ASSERT_EQ(lines.at(5), &p->getLine(5));
     ASSERT_EQ(lines.at(6), &p->getLine(6));
-    ASSERT_EQ(lines.at(7), &p->getLine(4));
+    ASSERT_EQ(lines.at(7), &p->getLine(7));
     ASSERT_EQ(lines.at(8), &p->getLine(8));
     ASSERT_EQ(lines.at(9), &p->getLine(9));
 }
@@ -458,12 +498,12 @@ TEST_F(MutatorTest, ProgramMutatorInitProgram)
 
     ASSERT_NO_THROW(Mutator::ProgramMutator::initRandomProgram(*p, params, rng))
         << "Empty Program Random init failed";
-    ASSERT_EQ(p->getNbLines(), 15)
+    ASSERT_EQ(p->getNbLines(), 66)
         << "Random number of line is not as expected (with known seed).";
 
     ASSERT_NO_THROW(Mutator::ProgramMutator::initRandomProgram(*p, params, rng))
         << "Non-Empty Program Random init failed";
-    ASSERT_EQ(p->getNbLines(), 38)
+    ASSERT_EQ(p->getNbLines(), 85)
         << "Random number of line is not as expected (with known seed).";
 
     // Count lines marked as introns (with a known seed).
@@ -475,7 +515,7 @@ TEST_F(MutatorTest, ProgramMutatorInitProgram)
     }
 
     // Check nb intron lines with a known seed.
-    ASSERT_EQ(nbIntrons, 36);
+    ASSERT_EQ(nbIntrons, 84);
 }
 
 TEST_F(MutatorTest, ProgramMutatorMutateBehavior)
@@ -513,7 +553,7 @@ TEST_F(MutatorTest, ProgramMutatorMutateBehavior)
     params.prog.minConstValue = 0;
     params.prog.pConstantMutation = 0.2;
 
-    rng.setSeed(0);
+    rng.setSeed(1);
     ASSERT_TRUE(Mutator::ProgramMutator::mutateProgram(p2, params, rng))
         << "Mutation did not occur with known seed.";
     ASSERT_EQ(p2.getNbLines(), 2)
@@ -529,20 +569,20 @@ TEST_F(MutatorTest, ProgramMutatorMutateBehavior)
 
     params.prog.pAdd = 0.0;
     params.prog.pMutate = 0.01;
-    rng.setSeed(86);
+    rng.setSeed(9);
     ASSERT_TRUE(Mutator::ProgramMutator::mutateProgram(p2, params, rng))
         << "Mutation did not occur with known seed.";
 
     params.prog.pMutate = 0.00;
     params.prog.pSwap = 0.1;
-    rng.setSeed(1);
+    rng.setSeed(31);
     ASSERT_TRUE(Mutator::ProgramMutator::mutateProgram(p2, params, rng))
         << "Mutation did not occur with known seed.";
 
     // mutate other instructions
     params.prog.pSwap = 0.0;
     params.prog.pMutate = 1;
-    rng.setSeed(114);
+    rng.setSeed(41);
     ASSERT_TRUE(Mutator::ProgramMutator::mutateProgram(p2, params, rng))
         << "Mutation did not occur with known seed.";
 
@@ -692,8 +732,8 @@ TEST_F(MutatorTest, TPGMutatorAddRandomEdge)
     ASSERT_EQ(vertex2.getOutgoingEdges().size(), 2)
         << "The random edge was not added to the right team.";
 
-    // Edge was added with vertex1 (with known seed)
-    ASSERT_EQ(vertex1.getIncomingEdges().size(), 2)
+    // Edge was added with vertex3 (with known seed)
+    ASSERT_EQ(vertex3.getIncomingEdges().size(), 2)
         << "The random edge was not added with the right (pseudo)random "
            "destination.";
 
@@ -721,7 +761,7 @@ TEST_F(MutatorTest, TPGMutatorMutateEdgeDestination)
     params.tpg.pEdgeDestinationIsAction = 0.5;
 
     Mutator::RNG rng;
-    rng.setSeed(2);
+    rng.setSeed(3);
     ASSERT_NO_THROW(Mutator::TPGMutator::mutateEdgeDestination(
         tpg, &edge1, {&vertex3, &vertex4}, {&vertex1, &vertex2}, params, rng));
     // Check properties of the tpg
@@ -1081,3 +1121,117 @@ TEST_F(MutatorTest, TPGMutatorPopulate)
         Mutator::TPGMutator::populateTPG(tpg2, arch, params, rng, 0))
         << "Populating an empty TPG failed.";
 }
+
+TEST_F(MutatorTest, TPGMutatorPlanAndCommitTeamMutation)
+{
+    Mutator::RNG rng(0);
+    TPG::TPGGraph tpg(*e);
+
+    Mutator::MutationParameters params;
+    params.tpg.nbActions = 4;
+    params.tpg.maxInitOutgoingEdges = 3;
+    params.tpg.maxOutgoingEdges = 5;
+    params.prog.maxProgramSize = 96;
+    params.tpg.pProgramMutation = 0.2;
+    params.tpg.pEdgeDestinationChange = 0.1;
+
+    Mutator::TPGMutator::initRandomTPG(tpg, params, rng);
+    const size_t nbVertices = tpg.getNbVertices();
+    const size_t nbEdges = tpg.getEdges().size();
+
+    std::vector<const TPG::TPGTeam*> rootTeams;
+    std::vector<const TPG::TPGTeam*> teams;
+    std::vector<const TPG::TPGAction*> actions;
+    for (const TPG::TPGVertex* vertex : tpg.getVertices()) {
+        if (dynamic_cast<const TPG::TPGAction*>(vertex) != nullptr) {
+            actions.push_back((const TPG::TPGAction*)vertex);
+        }
+        else {
+            teams.push_back((const TPG::TPGTeam*)vertex);
+            rootTeams.push_back((const TPG::TPGTeam*)vertex);
+        }
+    }
+    std::vector<TPG::TPGEdge*> edges;
+    for (const std::unique_ptr<TPG::TPGEdge>& edge : tpg.getEdges()) {
+        edges.push_back(edge.get());
+    }
+
+    // Planning does not modify the graph
+    Mutator::TPGMutator::TeamMutationPlan plan;
+    ASSERT_NO_THROW(plan = Mutator::TPGMutator::planTPGTeamMutation(
+                        rootTeams, teams, actions, edges, params, rng))
+        << "Planning the mutation of a TPGTeam failed.";
+    ASSERT_EQ(tpg.getNbVertices(), nbVertices)
+        << "Planning a mutation should not modify the graph.";
+    ASSERT_EQ(tpg.getEdges().size(), nbEdges)
+        << "Planning a mutation should not modify the graph.";
+    ASSERT_GE(plan.edges.size(), 2)
+        << "A planned team should keep at least two edges.";
+    ASSERT_LE(plan.edges.size(), params.tpg.maxOutgoingEdges)
+        << "A planned team should not exceed the maximum number of edges.";
+    ASSERT_TRUE(std::any_of(
+        plan.edges.begin(), plan.edges.end(),
+        [](const Mutator::TPGMutator::PlannedEdge& edge) {
+            return edge.mutateProgram;
+        }))
+        << "At least one Program should be mutated in a planned team.";
+
+    // Commit the plan
+    std::list<std::shared_ptr<Program::Program>> newPrograms;
+    const TPG::TPGTeam* newTeam = nullptr;
+    ASSERT_NO_THROW(newTeam = &Mutator::TPGMutator::commitTPGTeamMutation(
+                        tpg, plan, newPrograms))
+        << "Committing the mutation of a TPGTeam failed.";
+    ASSERT_EQ(tpg.getNbVertices(), nbVertices + 1)
+        << "Committing a plan should add exactly one team.";
+    ASSERT_EQ(newTeam->getOutgoingEdges().size(), plan.edges.size())
+        << "Committed team does not have the planned number of edges.";
+    ASSERT_EQ(newPrograms.size(),
+              std::count_if(plan.edges.begin(), plan.edges.end(),
+                            [](const Mutator::TPGMutator::PlannedEdge& edge) {
+                                return edge.mutateProgram;
+                            }))
+        << "A new Program should be created for each mutated edge.";
+}
+
+TEST_F(MutatorTest, TPGMutatorPopulateThreadIndependence)
+{
+    Mutator::MutationParameters params;
+    params.tpg.nbActions = 4;
+    params.tpg.maxInitOutgoingEdges = 3;
+    params.prog.maxProgramSize = 96;
+    params.tpg.nbRoots = 20;
+    params.tpg.pEdgeDestinationChange = 0.1;
+    params.prog.pConstantMutation = 0.5;
+    params.prog.minConstValue = 0;
+    params.prog.maxConstValue = 10;
+    Archive arch;
+
+    // Populate two identical graphs sequentially and in parallel.
+    TPG::TPGGraph tpg1(*e);
+    TPG::TPGGraph tpg2(*e);
+    Mutator::RNG rng1(0);
+    Mutator::RNG rng2(0);
+    Mutator::TPGMutator::initRandomTPG(tpg1, params, rng1);
+    Mutator::TPGMutator::initRandomTPG(tpg2, params, rng2);
+    ASSERT_NO_THROW(
+        Mutator::TPGMutator::populateTPG(tpg1, arch, params, rng1, 1));
+    ASSERT_NO_THROW(
+        Mutator::TPGMutator::populateTPG(tpg2, arch, params, rng2, 4));
+
+    ASSERT_EQ(tpg1.getNbRootVertices(), params.tpg.nbRoots);
+    ASSERT_EQ(tpg1.getNbVertices(), tpg2.getNbVertices())
+        << "Populated graphs should not depend on the number of threads.";
+    ASSERT_EQ(tpg1.getEdges().size(), tpg2.getEdges().size())
+        << "Populated graphs should not depend on the number of threads.";
+    auto iter2 = tpg2.getEdges().begin();
+    for (const std::unique_ptr<TPG::TPGEdge>& edge1 : tpg1.getEdges()) {
+        ASSERT_EQ(edge1->getProgram().getNbLines(),
+                  (*iter2)->getProgram().getNbLines())
+            << "Populated graphs should not depend on the number of threads.";
+        iter2++;
+    }
+    ASSERT_EQ(rng1.getUnsignedInt64(0, UINT64_MAX),
+              rng2.getUnsignedInt64(0, UINT64_MAX))
+        << "RNG state should not depend on the number of threads.";
+}
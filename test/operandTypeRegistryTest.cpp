@@ -0,0 +1,103 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "data/constant.h"
+#include "data/operandTypeRegistry.h"
+
+TEST(OperandTypeRegistryTest, RegisterType)
+{
+    const Data::OperandType* operandType = nullptr;
+    ASSERT_NO_THROW(
+        operandType =
+            &Data::OperandTypeRegistry::registerType<const double[3]>())
+        << "Registration of an array type failed.";
+    ASSERT_EQ(operandType->nbDimensions, 1);
+    ASSERT_EQ(operandType->dim1, 3);
+    ASSERT_EQ(operandType->elementName,
+              Data::OperandTypeRegistry::get(typeid(double)).elementName)
+        << "Element type of an array should not be const qualified.";
+
+    const Data::OperandType& operandType2D =
+        Data::OperandTypeRegistry::registerType<Data::Constant[2][5]>();
+    ASSERT_EQ(operandType2D.nbDimensions, 2);
+    ASSERT_EQ(operandType2D.dim1, 2);
+    ASSERT_EQ(operandType2D.dim2, 5);
+
+    ASSERT_EQ(&Data::OperandTypeRegistry::registerType<const double[3]>(),
+              operandType)
+        << "A type should be registered only once.";
+    ASSERT_EQ(&Data::OperandTypeRegistry::get(typeid(const double[3])),
+              operandType)
+        << "Registered description should be returned.";
+}
+
+TEST(OperandTypeRegistryTest, Get)
+{
+    // Type that is never registered at compile time.
+    const Data::OperandType& operandType =
+        Data::OperandTypeRegistry::get(typeid(unsigned char[7][11]));
+    ASSERT_EQ(operandType.nbDimensions, 2);
+    ASSERT_EQ(operandType.dim1, 7);
+    ASSERT_EQ(operandType.dim2, 11);
+    ASSERT_EQ(operandType.elementName,
+              Data::OperandTypeRegistry::registerType<unsigned char>()
+                  .elementName);
+
+    const Data::OperandType& scalar =
+        Data::OperandTypeRegistry::get(typeid(long));
+    ASSERT_EQ(scalar.nbDimensions, 0);
+
+    // Concurrent accesses return the same description.
+    std::vector<const Data::OperandType*> results(4, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); i++) {
+        threads.emplace_back([&results, i]() {
+            results.at(i) =
+                &Data::OperandTypeRegistry::get(typeid(short[13]));
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const Data::OperandType* result : results) {
+        ASSERT_EQ(result, results.at(0));
+        ASSERT_EQ(result->dim1, 13);
+    }
+}
@@ -0,0 +1,338 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "data/constant.h"
+#include "data/primitiveTypeArray.h"
+#include "instructions/addPrimitiveType.h"
+#include "instructions/lambdaInstruction.h"
+#include "instructions/multByConstant.h"
+#include "instructions/set.h"
+#include "mutator/mutationParameters.h"
+#include "mutator/programMutator.h"
+#include "mutator/rng.h"
+#include "program/line.h"
+#include "program/optimizedProgram.h"
+#include "program/program.h"
+#include "program/programExecutionEngine.h"
+
+class OptimizedProgramTest : public ::testing::Test
+{
+  protected:
+    const size_t size1{8};
+    std::vector<std::reference_wrapper<const Data::DataHandler>> vect;
+    Data::PrimitiveTypeArray<double> currentState{size1};
+    Instructions::Set set;
+    Environment* e = nullptr;
+    Program::Program* p = nullptr;
+
+    virtual void SetUp()
+    {
+        for (size_t idx = 0; idx < size1; idx++) {
+            currentState.setDataAt(typeid(double), idx, 1.5 * idx - 2.0);
+        }
+        vect.push_back(currentState);
+
+        set.add(*(new Instructions::AddPrimitiveType<double>()));
+        set.add(*(new Instructions::MultByConstant<double>()));
+        set.add(*(new Instructions::LambdaInstruction<const double[2]>(
+            [](const double a[2]) { return a[0] - 2.0 * a[1]; })));
+        set.add(*(new Instructions::LambdaInstruction<Data::Constant, double>(
+            [](Data::Constant a, double b) { return (double)a + b; })));
+        set.add(*(new Instructions::LambdaInstruction<double>([](double a) {
+            if (a < 0.0) {
+                throw std::out_of_range("Negative operand.");
+            }
+            return a * a;
+        })));
+
+        e = new Environment(set, vect, 8, 2);
+        p = new Program::Program(*e);
+        p->getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                          Data::Constant{5});
+        p->getConstantHandler().setDataAt(typeid(Data::Constant), 1,
+                                          Data::Constant{3});
+    }
+
+    virtual void TearDown()
+    {
+        delete p;
+        delete e;
+        for (size_t idx = 0; idx < set.getNbInstructions(); idx++) {
+            delete (&set.getInstruction(idx));
+        }
+    }
+
+    /// Add a Line with the given instruction, destination and operands.
+    void addLine(uint64_t instruction, uint64_t destination,
+                 std::vector<std::pair<uint64_t, uint64_t>> operands)
+    {
+        Program::Line& l = p->addNewLine();
+        l.setInstructionIndex(instruction);
+        l.setDestinationIndex(destination);
+        for (size_t idx = 0; idx < operands.size(); idx++) {
+            l.setOperand(idx, operands.at(idx).first,
+                         operands.at(idx).second);
+        }
+    }
+
+    /// Execute a copy of the Program Line by Line.
+    double executeLines(const Program::Program& prog,
+                        bool ignoreException = false)
+    {
+        Program::Program copy(prog);
+        copy.identifyIntrons();
+        EXPECT_EQ(copy.getOptimizedProgram(), nullptr);
+        Program::ProgramExecutionEngine pee(copy);
+        return pee.executeProgram(ignoreException);
+    }
+};
+
+TEST_F(OptimizedProgramTest, Constructor)
+{
+    Program::OptimizedProgram* optimized = nullptr;
+    ASSERT_NO_THROW(optimized = new Program::OptimizedProgram(*p))
+        << "Construction of an OptimizedProgram for an empty Program failed.";
+
+    ASSERT_EQ(optimized->getOperations().size(), 0);
+    ASSERT_EQ(optimized->getNbEffectiveLines(), 0);
+    ASSERT_EQ(optimized->getResult().kind,
+              Program::OptimizedProgram::OperandKind::LITERAL);
+    ASSERT_EQ(optimized->getLiterals().at(optimized->getResult().index), 0.0);
+    ASSERT_GT(optimized->getMemoryFootprint().getTotal(), 0);
+
+    ASSERT_NO_THROW(delete optimized) << "Destruction failed.";
+
+    // Instruction that does not exist.
+    p->addNewLine().setInstructionIndex(7, false);
+    ASSERT_THROW(Program::OptimizedProgram{*p}, std::out_of_range);
+    ASSERT_FALSE(p->optimize());
+    ASSERT_EQ(p->getOptimizedProgram(), nullptr);
+}
+
+TEST_F(OptimizedProgramTest, ConstantFolding)
+{
+    // reg[1] = cst[0] + reg[2]; (5 + 0)
+    addLine(3, 1, {{1, 0}, {0, 2}});
+    // reg[0] = reg[1] * cst[1];
+    addLine(1, 0, {{0, 1}, {1, 1}});
+    p->identifyIntrons();
+
+    ASSERT_TRUE(p->optimize());
+    const Program::OptimizedProgram& optimized = *p->getOptimizedProgram();
+    ASSERT_EQ(optimized.getNbEffectiveLines(), 2);
+    ASSERT_EQ(optimized.getOperations().size(), 0)
+        << "Lines with constant operands should be folded.";
+    ASSERT_EQ(optimized.getResult().kind,
+              Program::OptimizedProgram::OperandKind::LITERAL);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_EQ(pee.executeProgram(), 15.0);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(OptimizedProgramTest, CommonSubexpressionElimination)
+{
+    // reg[1] = in[2] + in[3];
+    addLine(0, 1, {{2, 2}, {2, 3}});
+    // reg[2] = in[2] + in[3];
+    addLine(0, 2, {{2, 2}, {2, 3}});
+    // reg[3] = reg[1] * cst[1];
+    addLine(1, 3, {{0, 1}, {1, 1}});
+    // reg[4] = reg[2] * cst[1];
+    addLine(1, 4, {{0, 2}, {1, 1}});
+    // reg[0] = reg[3] + reg[4];
+    addLine(0, 0, {{0, 3}, {0, 4}});
+    ASSERT_EQ(p->identifyIntrons(), 0);
+
+    ASSERT_TRUE(p->optimize());
+    const Program::OptimizedProgram& optimized = *p->getOptimizedProgram();
+    ASSERT_EQ(optimized.getNbEffectiveLines(), 5);
+    ASSERT_EQ(optimized.getOperations().size(), 3)
+        << "Recomputed values should be eliminated.";
+    ASSERT_EQ(optimized.getOperations().at(2).operands.at(0).kind,
+              Program::OptimizedProgram::OperandKind::VALUE);
+    ASSERT_EQ(optimized.getOperations().at(2).operands.at(0).index, 1);
+    ASSERT_EQ(optimized.getOperations().at(2).operands.at(1).index, 1);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_EQ(pee.executeProgram(), (1.0 + 2.5) * 3 * 2);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(OptimizedProgramTest, DeadStoreElimination)
+{
+    // reg[1] = in[2] + in[3];
+    addLine(0, 1, {{2, 2}, {2, 3}});
+    // reg[1] = in[4] + in[5];
+    addLine(0, 1, {{2, 4}, {2, 5}});
+    // reg[0] = in[6] + in[7];
+    addLine(0, 0, {{2, 6}, {2, 7}});
+
+    // Introns are not identified, all lines are effective.
+    ASSERT_TRUE(p->optimize());
+    const Program::OptimizedProgram& optimized = *p->getOptimizedProgram();
+    ASSERT_EQ(optimized.getNbEffectiveLines(), 3);
+    ASSERT_EQ(optimized.getOperations().size(), 1)
+        << "Values unused by the result should be eliminated.";
+    ASSERT_EQ(optimized.getResult().kind,
+              Program::OptimizedProgram::OperandKind::VALUE);
+    ASSERT_EQ(optimized.getResult().index, 0);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(OptimizedProgramTest, ArrayOperands)
+{
+    // reg[6] = in[2] + in[3];
+    addLine(0, 6, {{2, 2}, {2, 3}});
+    // reg[0] = reg[5] - 2 * reg[6];
+    addLine(2, 0, {{0, 5}, {0, 0}});
+    // reg[1] = reg[0] - 2 * reg[1]; (reg[1] == 0)
+    addLine(2, 1, {{0, 0}, {0, 0}});
+    // reg[0] = reg[1] + reg[6];
+    addLine(0, 0, {{0, 1}, {0, 6}});
+    p->identifyIntrons();
+
+    ASSERT_TRUE(p->optimize());
+    const Program::OptimizedProgram& optimized = *p->getOptimizedProgram();
+    ASSERT_EQ(optimized.getOperations().size(), 4);
+    ASSERT_EQ(optimized.getOperations().at(1).registerWrites.size(), 2);
+    ASSERT_EQ(optimized.getOperations().at(1).registerWrites.at(0).second.kind,
+              Program::OptimizedProgram::OperandKind::LITERAL);
+    ASSERT_EQ(optimized.getOperations().at(1).registerWrites.at(1).second.kind,
+              Program::OptimizedProgram::OperandKind::VALUE);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_EQ(pee.executeProgram(), (-3.5 * 2) + 3.5);
+    ASSERT_EQ(pee.executeProgram(), executeLines(*p));
+}
+
+TEST_F(OptimizedProgramTest, Invalidation)
+{
+    addLine(0, 0, {{2, 2}, {2, 3}});
+    p->identifyIntrons();
+    ASSERT_TRUE(p->optimize());
+
+    Program::Program copy(*p);
+    ASSERT_EQ(copy.getOptimizedProgram(), p->getOptimizedProgram())
+        << "Copied Program should share the OptimizedProgram.";
+
+    copy.clearIntrons();
+    ASSERT_NE(copy.getOptimizedProgram(), nullptr)
+        << "Clearing introns should not discard the OptimizedProgram.";
+
+    copy.getLine(0).setOperand(1, 2, 4);
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr)
+        << "Editing a Line should discard the OptimizedProgram.";
+    ASSERT_NE(p->getOptimizedProgram(), nullptr);
+
+    ASSERT_TRUE(copy.optimize());
+    copy.getConstantHandler();
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr)
+        << "Editing constants should discard the OptimizedProgram.";
+
+    ASSERT_TRUE(copy.optimize());
+    copy.addNewLine();
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr);
+
+    ASSERT_TRUE(copy.optimize());
+    copy.swapLines(0, 1);
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr);
+
+    ASSERT_TRUE(copy.optimize());
+    copy.removeLine(1);
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr);
+
+    ASSERT_TRUE(copy.optimize());
+    copy.identifyIntrons();
+    ASSERT_EQ(copy.getOptimizedProgram(), nullptr);
+}
+
+TEST_F(OptimizedProgramTest, ExecutionWithExceptions)
+{
+    // reg[1] = in[1] * in[1]; (in[1] < 0, throws)
+    addLine(4, 1, {{2, 1}});
+    // reg[0] = reg[1] + in[3];
+    addLine(0, 0, {{0, 1}, {2, 3}});
+    p->identifyIntrons();
+
+    ASSERT_TRUE(p->optimize());
+    ASSERT_EQ(p->getOptimizedProgram()->getOperations().size(), 2);
+
+    Program::ProgramExecutionEngine pee(*p);
+    ASSERT_THROW(pee.executeProgram(), std::out_of_range);
+    ASSERT_EQ(pee.executeProgram(true), 2.5)
+        << "Line throwing an exception should be ignored.";
+    ASSERT_EQ(pee.executeProgram(true), executeLines(*p, true));
+}
+
+TEST_F(OptimizedProgramTest, RandomPrograms)
+{
+    Mutator::MutationParameters params;
+    params.prog.maxProgramSize = 40;
+    params.prog.minConstValue = -10;
+    params.prog.maxConstValue = 10;
+    Mutator::RNG rng(0);
+
+    uint64_t nbEffectiveLines = 0;
+    uint64_t nbOperations = 0;
+    for (int i = 0; i < 200; i++) {
+        Program::Program prog(*e);
+        Mutator::ProgramMutator::initRandomProgram(prog, params, rng);
+        ASSERT_NE(prog.getOptimizedProgram(), nullptr)
+            << "Random Programs should be optimized.";
+        nbEffectiveLines += prog.getOptimizedProgram()->getNbEffectiveLines();
+        nbOperations += prog.getOptimizedProgram()->getOperations().size();
+
+        Program::ProgramExecutionEngine pee(prog);
+        double result = pee.executeProgram(true);
+        double expected = executeLines(prog, true);
+        if (std::isnan(expected)) {
+            ASSERT_TRUE(std::isnan(result));
+        }
+        else {
+            ASSERT_EQ(result, expected)
+                << "OptimizedProgram and Program results differ.";
+        }
+    }
+    ASSERT_LT(nbOperations, nbEffectiveLines);
+}
@@ -60,7 +60,7 @@ TEST(LearningParametersTest, readConfigFile)
         << "Ill-formed parameters file should result in no root filling";
 
     File::ParametersParser::readConfigFile(TESTS_DAT_PATH "params.json", root);
-    ASSERT_EQ(13, root.size())
+    ASSERT_EQ(14, root.size())
         << "Wrong number of elements in parsed json file";
     ASSERT_EQ(10, root["mutation"]["tpg"].size())
         << "Wrong number of elements in parsed json file";
@@ -88,6 +88,7 @@ TEST(LearningParametersTest, setAllParamsFrom)
 
     ASSERT_EQ(50, params.archiveSize);
     ASSERT_EQ(0.5, params.archivingProbability);
+    ASSERT_TRUE(params.archiveDeltaSnapshots);
     ASSERT_EQ(50, params.nbIterationsPerPolicyEvaluation);
     ASSERT_EQ(31, params.nbIterationsPerJob);
     ASSERT_EQ(5, params.maxNbActionsPerEval);
@@ -168,6 +169,7 @@ TEST(LearningParametersTest, writeParametersToJson)
     // Base parameters
     ASSERT_EQ(params.archiveSize, params2.archiveSize);
     ASSERT_EQ(params.archivingProbability, params2.archivingProbability);
+    ASSERT_EQ(params.archiveDeltaSnapshots, params2.archiveDeltaSnapshots);
     ASSERT_EQ(params.doValidation, params2.doValidation);
     ASSERT_EQ(params.maxNbActionsPerEval, params2.maxNbActionsPerEval);
     ASSERT_EQ(params.maxNbEvaluationPerPolicy,
@@ -36,6 +36,8 @@
 
 #ifdef CODE_GENERATION
 #include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
 
 #if defined(_MSC_VER) || (__MINGW32__)
 // C++17 not available in gcc7 or clang7
@@ -250,6 +252,183 @@ TEST_F(ProgramGenerationEngineTest, generateProgram)
         << "Fail to generate a program with constant";
 }
 
+TEST_F(ProgramGenerationEngineTest, generateOptimizedProgram)
+{
+    ASSERT_TRUE(p->optimize());
+    {
+        CodeGen::ProgramGenerationEngine engine("optimizedProgram", *p);
+        ASSERT_NO_THROW(engine.generateProgram(1))
+            << "Fail to generate an optimized program.";
+
+        // The only line of p2 does not contribute to register 0, so its
+        // non-printable instruction is never generated.
+        ASSERT_TRUE(p2->optimize());
+        ASSERT_NO_THROW(engine.setProgram(*p2)) << "Fail to set a program";
+        ASSERT_NO_THROW(engine.generateProgram(2))
+            << "Fail to generate an optimized program without operation.";
+    }
+
+    std::ifstream file("optimizedProgram.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_NE(content.str().find("double val[4];"), std::string::npos)
+        << "Intron line should not be generated.";
+    ASSERT_NE(content.str().find("val[1] = op0 + op1;"), std::string::npos)
+        << "Instruction result should be stored in the values.";
+    ASSERT_NE(content.str().find("return val[3];"), std::string::npos)
+        << "Program should return the value of its last operation.";
+    ASSERT_NE(content.str().find("return 0x0p+0;"), std::string::npos)
+        << "Program without operation should return a literal.";
+}
+
+TEST_F(ProgramGenerationEngineTest, generateBatchProgram)
+{
+    {
+        CodeGen::ProgramGenerationEngine engine("genCurrentLine", *p);
+        ASSERT_THROW(engine.generateBatchProgram(1), std::runtime_error)
+            << "Batch program should not be generated out of batch mode.";
+    }
+    {
+        CodeGen::ProgramGenerationEngine engine("batchProgram", *p, "./",
+                                                true);
+        ASSERT_NO_THROW(engine.generateBatchProgram(1))
+            << "Fail to generate a batch program.";
+
+        ASSERT_TRUE(p->optimize());
+        ASSERT_NO_THROW(engine.generateBatchProgram(2))
+            << "Fail to generate an optimized batch program.";
+
+        CodeGen::ProgramGenerationEngine engineForConstant(
+            "batchProgramWithConstant", *p3, "./", true);
+        ASSERT_NO_THROW(engineForConstant.generateBatchProgram(3))
+            << "Fail to generate a batch program with constant";
+    }
+
+    std::ifstream file("batchProgram.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_EQ(content.str().find("extern double"), std::string::npos)
+        << "Batch programs should not use global variables.";
+    ASSERT_NE(content.str().find(
+                  "void P1Batch(int nb, const int* lanes, int n, const double* "
+                  "TPG_RESTRICT in1, double* TPG_RESTRICT scores){"),
+              std::string::npos)
+        << "Batch program does not have the expected prototype.";
+    ASSERT_NE(content.str().find("double op1 = in1[25 * n + l];"),
+              std::string::npos)
+        << "Data should be accessed with a structure of arrays layout.";
+    ASSERT_NE(content.str().find("double op0 = reg[5];"), std::string::npos)
+        << "Registers should not be accessed with a structure of arrays "
+           "layout.";
+    ASSERT_NE(content.str().find("scores[i] = val[3];"), std::string::npos)
+        << "Optimized batch program should store its result in scores.";
+}
+
+TEST_F(ProgramGenerationEngineTest, generateTeamPrograms)
+{
+    // A clone of p whose last line reads another input.
+    Program::Program clone(*p);
+    clone.getLine(4).setOperand(1, 1, 6);
+    ASSERT_TRUE(p->optimize());
+    {
+        CodeGen::ProgramGenerationEngine engine("teamPrograms", *e);
+        ASSERT_NO_THROW(engine.generateTeamPrograms(3, {p, &clone, p2}))
+            << "Fail to generate the programs of a team.";
+    }
+
+    std::ifstream file("teamPrograms.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_NE(content.str().find("void T3Bids(double* scores){"),
+              std::string::npos)
+        << "Team programs do not have the expected prototype.";
+    ASSERT_NE(content.str().find("double v4;"), std::string::npos)
+        << "The last line of the clone should be computed.";
+    ASSERT_EQ(content.str().find("double v5;"), std::string::npos)
+        << "Lines shared by p and its clone should be computed once.";
+    ASSERT_NE(content.str().find("scores[1] = v4;"), std::string::npos)
+        << "The bid of the clone should be its last value.";
+    ASSERT_NE(content.str().find("scores[2] = 0x0p+0;"), std::string::npos)
+        << "Program without operation should bid a literal.";
+}
+
+TEST_F(ProgramGenerationEngineTest, generateTeamProgramsWithConstant)
+{
+    // reg[0] = cst[0] + in1[1] with cst[0] = 4.
+    Program::Program prog(*envWithConstant);
+    Program::Line& line = prog.addNewLine();
+    line.setInstructionIndex(3);
+    line.setOperand(0, 1, 0);
+    line.setOperand(1, 2, 1);
+    line.setDestinationIndex(0);
+    prog.getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                        Data::Constant{4});
+    // Same Operation reading a constant with the same value.
+    Program::Program sameValue(prog);
+    sameValue.getConstantHandler().setDataAt(typeid(Data::Constant), 1,
+                                             Data::Constant{4});
+    sameValue.getConstantHandler().setDataAt(typeid(Data::Constant), 0,
+                                             Data::Constant{7});
+    sameValue.getLine(0).setOperand(0, 1, 1);
+    // Same Operation reading a constant with another value.
+    Program::Program otherValue(sameValue);
+    otherValue.getLine(0).setOperand(0, 1, 0);
+    {
+        CodeGen::ProgramGenerationEngine engine("teamProgramsWithConstant",
+                                                *envWithConstant);
+        ASSERT_NO_THROW(
+            engine.generateTeamPrograms(1, {&prog, &sameValue, &otherValue}))
+            << "Fail to generate the programs of a team with constants.";
+    }
+
+    std::ifstream file("teamProgramsWithConstant.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_EQ(content.str().find("cst["), std::string::npos)
+        << "Programs reading scalar constants should be merged.";
+    ASSERT_NE(content.str().find("scores[1] = v0;"), std::string::npos)
+        << "Operations reading constants with the same value should be "
+           "computed once.";
+    ASSERT_NE(content.str().find("scores[2] = v1;"), std::string::npos)
+        << "Operations reading constants with different values should be "
+           "computed separately.";
+}
+
+TEST_F(ProgramGenerationEngineTest, generateBatchTeamPrograms)
+{
+    Program::Program clone(*p);
+    clone.getLine(4).setOperand(1, 1, 6);
+    {
+        CodeGen::ProgramGenerationEngine engine("teamProgramsNoBatch", *e);
+        ASSERT_THROW(engine.generateBatchTeamPrograms(3, {p, &clone}),
+                     std::runtime_error)
+            << "Batch team programs should not be generated out of batch "
+               "mode.";
+    }
+    {
+        CodeGen::ProgramGenerationEngine engine("batchTeamPrograms", *e, "./",
+                                                true);
+        ASSERT_NO_THROW(engine.generateBatchTeamPrograms(3, {p, &clone, p2}))
+            << "Fail to generate the batch programs of a team.";
+    }
+
+    std::ifstream file("batchTeamPrograms.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_NE(content.str().find("void T3BidsBatch(int nb, const int* lanes, "
+                                 "int n, const double* TPG_RESTRICT in1, "
+                                 "double* TPG_RESTRICT scores, int stride){"),
+              std::string::npos)
+        << "Batch team programs do not have the expected prototype.";
+    ASSERT_NE(content.str().find("in1[25 * n + l]"), std::string::npos)
+        << "Data should be accessed with a structure of arrays layout.";
+    ASSERT_EQ(content.str().find("double v5;"), std::string::npos)
+        << "Lines shared by p and its clone should be computed once.";
+    ASSERT_NE(content.str().find("scores[1 * stride + i] = v4;"),
+              std::string::npos)
+        << "The bid of the clone should be stored for the current lane.";
+}
+
 TEST_F(ProgramGenerationEngineTest, initOperandCurrentLine)
 {
 
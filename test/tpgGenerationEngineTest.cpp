@@ -40,6 +40,7 @@
 #include <cstddef>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <sstream>
 
 #if defined(_MSC_VER) || (__MINGW32__)
 // C++17 not available in gcc7 or clang7
@@ -55,6 +56,7 @@
 #include "codeGen/tpgGenerationEngineFactory.h"
 #include "codeGen/tpgStackGenerationEngine.h"
 #include "codeGen/tpgSwitchGenerationEngine.h"
+#include "codeGen/tpgTableGenerationEngine.h"
 #include "goldenReferenceComparison.h"
 
 class TPGGenerationEngineTest : public ::testing::Test
@@ -197,6 +199,25 @@ TEST_F(TPGGenerationEngineTest, TPGGenerationEngineFactoryCreateStack)
     ASSERT_NO_THROW(tpgGen.reset()) << "Destruction failed.";
 }
 
+TEST_F(TPGGenerationEngineTest, TPGGenerationEngineFactoryCreateTable)
+{
+    auto& team = tpg->addNewTeam();
+    auto& action = tpg->addNewAction(0);
+    tpg->addNewEdge(team, action, std::make_shared<Program::Program>(*e));
+
+    CodeGen::TPGGenerationEngineFactory factoryTable(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::tableMode);
+    ASSERT_NO_THROW(tpgGen = factoryTable.create("constructor", *tpg))
+        << "Failed to construct a TPGGenerationEngine with a filename and a "
+           "TPG";
+
+    ASSERT_NE(dynamic_cast<CodeGen::TPGTableGenerationEngine*>(tpgGen.get()),
+              nullptr)
+        << "Created TPGGenerationEngine has incorrect type.";
+
+    ASSERT_NO_THROW(tpgGen.reset()) << "Destruction failed.";
+}
+
 TEST_F(TPGGenerationEngineTest, TPGGenerationEngineFactoryCreateNoMode)
 {
     // Create the factory with a non-existing mode.
@@ -270,7 +291,7 @@ std::string executableExtension = ".exe ";
 std::string executableExtension = " ";
 #endif
 
-#define TEST_BOTH_MODE(TEST_NAME, TEST_CODE)                                   \
+#define TEST_ALL_MODES(TEST_NAME, TEST_CODE)                                   \
     TEST_F(TPGGenerationEngineTest, TEST_NAME##Switch)                         \
     {                                                                          \
         CodeGen::TPGGenerationEngineFactory factory(                           \
@@ -284,9 +305,16 @@ std::string executableExtension = " ";
             CodeGen::TPGGenerationEngineFactory::generationEngineMode::        \
                 stackMode);                                                    \
         TEST_CODE                                                              \
+    }                                                                          \
+    TEST_F(TPGGenerationEngineTest, TEST_NAME##Table)                          \
+    {                                                                          \
+        CodeGen::TPGGenerationEngineFactory factory(                           \
+            CodeGen::TPGGenerationEngineFactory::generationEngineMode::        \
+                tableMode);                                                    \
+        TEST_CODE                                                              \
     }
 
-TEST_BOTH_MODE(OneLeaf, {
+TEST_ALL_MODES(OneLeaf, {
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
 
@@ -324,7 +352,7 @@ TEST_BOTH_MODE(OneLeaf, {
         << "Error wrong action returned in test OneLeaf.";
 });
 
-TEST_BOTH_MODE(TwoLeaves, {
+TEST_ALL_MODES(TwoLeaves, {
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
     const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
@@ -370,7 +398,7 @@ TEST_BOTH_MODE(TwoLeaves, {
         << "Error wrong action returned in test TwoLeaves.";
 });
 
-TEST_BOTH_MODE(ThreeLeaves, {
+TEST_ALL_MODES(ThreeLeaves, {
     // P1 < P2 = P3
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
     const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
@@ -430,7 +458,7 @@ TEST_BOTH_MODE(ThreeLeaves, {
         << "Error wrong action returned in test ThreeLeaves.";
 });
 
-TEST_BOTH_MODE(OneTeamOneLeaf, {
+TEST_ALL_MODES(OneTeamOneLeaf, {
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
     const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
@@ -479,7 +507,7 @@ TEST_BOTH_MODE(OneTeamOneLeaf, {
         << "Error wrong action returned in test OneTeamOneLeaf";
 });
 
-TEST_BOTH_MODE(OneTeamTwoLeaves, {
+TEST_ALL_MODES(OneTeamTwoLeaves, {
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
     const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
     const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
@@ -538,7 +566,7 @@ TEST_BOTH_MODE(OneTeamTwoLeaves, {
         << "Error wrong action returned in test OneTeamTwoLeaves.";
 });
 
-TEST_BOTH_MODE(TwoTeams, {
+TEST_ALL_MODES(TwoTeams, {
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
     const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
     const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
@@ -605,7 +633,178 @@ TEST_BOTH_MODE(TwoTeams, {
         << "Error wrong action returned in test TwoTeams.";
 });
 
-TEST_BOTH_MODE(TwoTeamsNegativeBid, {
+TEST_ALL_MODES(TwoTeamsBatch, {
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+
+    const std::shared_ptr<Program::Program> prog1(new Program::Program(*e));
+    Program::Line& prog1L1 = prog1->addNewLine();
+    // reg[0] = in1[0] + in1[1];
+    prog1L1.setDestinationIndex(0);
+    prog1L1.setInstructionIndex(0);
+    prog1L1.setOperand(0, 1, 0);
+    prog1L1.setOperand(1, 1, 1);
+
+    const std::shared_ptr<Program::Program> prog2(new Program::Program(*e));
+    Program::Line& prog2L1 = prog2->addNewLine();
+    // reg[0] = in1[1] + in1[2];
+    prog2L1.setDestinationIndex(0);
+    prog2L1.setInstructionIndex(0);
+    prog2L1.setOperand(0, 1, 1);
+    prog2L1.setOperand(1, 1, 2);
+
+    const std::shared_ptr<Program::Program> prog3(new Program::Program(*e));
+    Program::Line& prog3L1 = prog3->addNewLine();
+    // reg[0] = in1[1] + in1[3];
+    prog3L1.setDestinationIndex(0);
+    prog3L1.setInstructionIndex(0);
+    prog3L1.setOperand(0, 1, 1);
+    prog3L1.setOperand(1, 1, 3);
+
+    const std::shared_ptr<Program::Program> prog4(new Program::Program(*e));
+    Program::Line& prog4L1 = prog4->addNewLine();
+    // reg[0] = in1[1] + in1[4];
+    prog4L1.setDestinationIndex(0);
+    prog4L1.setInstructionIndex(0);
+    prog4L1.setOperand(0, 1, 1);
+    prog4L1.setOperand(1, 1, 4);
+
+    tpg->addNewEdge(*root, *T1, prog1);
+    tpg->addNewEdge(*T1, *leaf, prog2);
+    tpg->addNewEdge(*T1, *T2, prog3);
+    tpg->addNewEdge(*T2, *leaf2, prog4);
+
+    // Programs of T1 are optimized, others are not.
+    ASSERT_TRUE(prog2->optimize());
+    ASSERT_TRUE(prog3->optimize());
+
+    tpgGen = factory.create("TwoTeamsBatch", *tpg, "./src/", true);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    cmdCompile += "TwoTeamsBatch";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoTeamsBatch.";
+
+    cmdExec += "TwoTeamsBatch" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path + "/TwoTeamsBatch/DataTwoTeamsBatch.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test TwoTeamsBatch.";
+});
+
+TEST_ALL_MODES(TwoTeamsBatchMerged, {
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+
+    // reg[0] = in1[0] + in1[1];
+    // reg[0] = in1[1] + in1[2];
+    // reg[0] = in1[1] + in1[3];
+    // reg[0] = in1[1] + in1[4];
+    std::vector<std::shared_ptr<Program::Program>> progs;
+    for (uint64_t operand : {0, 2, 3, 4}) {
+        progs.push_back(std::make_shared<Program::Program>(*e));
+        Program::Line& line = progs.back()->addNewLine();
+        line.setDestinationIndex(0);
+        line.setInstructionIndex(0);
+        line.setOperand(0, 1, (operand == 0) ? 0 : 1);
+        line.setOperand(1, 1, (operand == 0) ? 1 : operand);
+    }
+
+    tpg->addNewEdge(*root, *T1, progs.at(0));
+    tpg->addNewEdge(*T1, *leaf, progs.at(1));
+    tpg->addNewEdge(*T1, *T2, progs.at(2));
+    tpg->addNewEdge(*T2, *leaf2, progs.at(3));
+
+    // Programs share the name of the TwoTeamsBatch test to reuse its main
+    // file and data.
+    tpgGen = factory.create("TwoTeamsBatch", *tpg, "./src/", true);
+    tpgGen->setMergeTeamPrograms(true);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    std::ifstream file("./src/TwoTeamsBatch_program.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_EQ(content.str().find("void P"), std::string::npos)
+        << "Programs of merged teams should not be generated separately.";
+    ASSERT_NE(content.str().find("BidsBatch("), std::string::npos)
+        << "Bids of merged teams should be computed for batches of lanes.";
+
+    cmdCompile += "TwoTeamsBatch";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoTeamsBatchMerged.";
+
+    cmdExec += "TwoTeamsBatch" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path + "/TwoTeamsBatch/DataTwoTeamsBatch.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test TwoTeamsBatchMerged.";
+});
+
+TEST_F(TPGGenerationEngineTest, TableBatch)
+{
+    const TPG::TPGVertex* T0 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+
+    // T1 is created first but reached from T0, it is numbered after T0.
+    tpg->addNewEdge(*T1, *leaf, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T1, *leaf2, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T0, *T1, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T0, *leaf, std::make_shared<Program::Program>(*e));
+
+    CodeGen::TPGGenerationEngineFactory factory(
+        CodeGen::TPGGenerationEngineFactory::generationEngineMode::tableMode);
+    tpgGen = factory.create("TableBatch", *tpg, "./src/", true);
+    ASSERT_NO_THROW(tpgGen->generateTPGGraph())
+        << "Fail to generate the tables of a TPGGraph for batch inference.";
+    tpgGen.reset();
+
+    std::ifstream file("./src/TableBatch.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_NE(content.str().find("static const uint8_t edgeDestinations[4] = "
+                                 "{\n\t1, 2, 2, 3,"),
+              std::string::npos)
+        << "Teams should be numbered in topological order.";
+    ASSERT_NE(content.str().find("P0Batch, P1Batch, P2Batch, P3Batch,"),
+              std::string::npos)
+        << "Batch functions of programs should be stored in a table.";
+    ASSERT_NE(content.str().find("programs[edgePrograms[e]](nb, lanes, n, "
+                                 "in1 + start, scores[e - first]);"),
+              std::string::npos)
+        << "Batch functions should be called through the tables.";
+}
+
+TEST_ALL_MODES(BatchCycle, {
+    const TPG::TPGVertex* T0 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+
+    tpg->addNewEdge(*T0, *T1, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T1, *T2, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T2, *T1, std::make_shared<Program::Program>(*e));
+    tpg->addNewEdge(*T2, *leaf, std::make_shared<Program::Program>(*e));
+
+    tpgGen = factory.create("BatchCycle", *tpg, "./src/", true);
+    ASSERT_THROW(tpgGen->generateTPGGraph(), std::runtime_error)
+        << "Batch code should not be generated for a TPGGraph with a cycle.";
+});
+
+TEST_ALL_MODES(TwoTeamsNegativeBid, {
     const TPG::TPGVertex* root = (&tpg->addNewTeam());
     const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
     const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
@@ -686,6 +885,99 @@ TEST_BOTH_MODE(TwoTeamsNegativeBid, {
         << "Error wrong action returned in test TwoTeamsNegativeBid.";
 });
 
+TEST_ALL_MODES(TwoTeamsNegativeBidMerged, {
+    const TPG::TPGVertex* root = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T1 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* T2 = (&tpg->addNewTeam());
+    const TPG::TPGVertex* leaf = (&tpg->addNewAction(1));
+    const TPG::TPGVertex* leaf2 = (&tpg->addNewAction(2));
+    const TPG::TPGVertex* leaf3 = (&tpg->addNewAction(3));
+
+    // Same bids as in the TwoTeamsNegativeBid test, with programs of T2
+    // sharing their first line.
+    const std::shared_ptr<Program::Program> prog1(new Program::Program(*e));
+    Program::Line& prog1L1 = prog1->addNewLine();
+    // reg[0] = in1[0] + in1[1];
+    prog1L1.setDestinationIndex(0);
+    prog1L1.setInstructionIndex(0);
+    prog1L1.setOperand(0, 1, 0);
+    prog1L1.setOperand(1, 1, 1);
+
+    const std::shared_ptr<Program::Program> prog2(new Program::Program(*e));
+    Program::Line& prog2L1 = prog2->addNewLine();
+    // reg[0] = in1[1] - in1[2];
+    prog2L1.setDestinationIndex(0);
+    prog2L1.setInstructionIndex(1);
+    prog2L1.setOperand(0, 1, 1);
+    prog2L1.setOperand(1, 1, 2);
+
+    const std::shared_ptr<Program::Program> prog3(new Program::Program(*e));
+    Program::Line& prog3L1 = prog3->addNewLine();
+    // reg[0] = in1[1] + in1[3];
+    prog3L1.setDestinationIndex(0);
+    prog3L1.setInstructionIndex(0);
+    prog3L1.setOperand(0, 1, 1);
+    prog3L1.setOperand(1, 1, 3);
+
+    const std::shared_ptr<Program::Program> prog4(new Program::Program(*e));
+    // reg[1] = in1[1] + reg[2];
+    // reg[0] = reg[1] + in1[4];
+    for (uint64_t operand : {2, 4}) {
+        Program::Line& line = prog4->addNewLine();
+        line.setDestinationIndex((operand == 2) ? 1 : 0);
+        line.setInstructionIndex(0);
+        line.setOperand(0, (operand == 2) ? 1 : 0, 1);
+        line.setOperand(1, (operand == 2) ? 0 : 1, operand);
+    }
+
+    const std::shared_ptr<Program::Program> prog5(new Program::Program(*e));
+    // reg[1] = in1[1] + reg[2];
+    // reg[0] = reg[1] + in1[6];
+    for (uint64_t operand : {2, 6}) {
+        Program::Line& line = prog5->addNewLine();
+        line.setDestinationIndex((operand == 2) ? 1 : 0);
+        line.setInstructionIndex(0);
+        line.setOperand(0, (operand == 2) ? 1 : 0, 1);
+        line.setOperand(1, (operand == 2) ? 0 : 1, operand);
+    }
+
+    tpg->addNewEdge(*root, *T1, prog1);
+    tpg->addNewEdge(*T1, *leaf, prog2);
+    tpg->addNewEdge(*T1, *T2, prog3);
+    tpg->addNewEdge(*T2, *leaf2, prog4);
+    tpg->addNewEdge(*T2, *leaf3, prog5);
+
+    // Programs share the name of the TwoTeamsNegativeBid test to reuse its
+    // main file and data.
+    tpgGen = factory.create("TwoTeamsNegativeBid", *tpg, "./src/");
+    tpgGen->setMergeTeamPrograms(true);
+    tpgGen->generateTPGGraph();
+    // call the destructor to close the file
+    tpgGen.reset();
+
+    std::ifstream file("./src/TwoTeamsNegativeBid_program.c");
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_EQ(content.str().find("double P"), std::string::npos)
+        << "Programs of merged teams should not be generated separately.";
+    ASSERT_NE(content.str().find("double v2;"), std::string::npos)
+        << "Merged programs should compute 3 shared values.";
+    ASSERT_EQ(content.str().find("double v3;"), std::string::npos)
+        << "The first line of programs of T2 should be computed once.";
+
+    cmdCompile += "TwoTeamsNegativeBid";
+    ASSERT_EQ(system(cmdCompile.c_str()), 0)
+        << "Error while compiling the test TwoTeamsNegativeBidMerged.";
+
+    cmdExec += "TwoTeamsNegativeBid" + executableExtension;
+
+    ASSERT_EQ(system((cmdExec + path +
+                      "/TwoTeamsNegativeBid/DataTwoTeamsNegativeBid.csv")
+                         .c_str()),
+              0)
+        << "Error wrong action returned in test TwoTeamsNegativeBidMerged.";
+});
+
 static void setProgLine(const std::shared_ptr<Program::Program> prog,
                         int operand)
 {
@@ -697,7 +989,7 @@ static void setProgLine(const std::shared_ptr<Program::Program> prog,
     line.setOperand(1, 0, 1);
 }
 
-TEST_BOTH_MODE(ThreeTeamsThreeLeaves, {
+TEST_ALL_MODES(ThreeTeamsThreeLeaves, {
     const TPG::TPGVertex* A1 = (&tpg->addNewAction(1));
     const TPG::TPGVertex* A2 = (&tpg->addNewAction(2));
     const TPG::TPGVertex* A0 = (&tpg->addNewAction(0));
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <gtest/gtest.h>
+#include <unordered_set>
 
 #include "data/dataHandler.h"
 #include "data/primitiveTypeArray.h"
@@ -695,6 +696,53 @@ TEST_F(TPGTest, TPGGraphSetEdgeSource)
            "succeed.";
 }
 
+TEST_F(TPGTest, TPGGraphEdgeTracking)
+{
+    TPG::TPGGraph tpg(*e);
+    const TPG::TPGTeam& vertex0 = tpg.addNewTeam();
+    const TPG::TPGTeam& vertex1 = tpg.addNewTeam();
+    const TPG::TPGAction& vertex2 = tpg.addNewAction(0);
+    const TPG::TPGEdge& edge0 = tpg.addNewEdge(vertex0, vertex2, progPointer);
+
+    ASSERT_FALSE(tpg.isEdgeTracking())
+        << "Edge tracking should be disabled by default.";
+    ASSERT_EQ(tpg.getModifiedEdges().size(), 0)
+        << "Modified edges should not be recorded without tracking.";
+
+    tpg.setEdgeTracking(true);
+    ASSERT_TRUE(tpg.isEdgeTracking()) << "Edge tracking was not enabled.";
+
+    // Added, cloned and redirected edges are recorded.
+    const TPG::TPGEdge& edge1 = tpg.addNewEdge(vertex1, vertex2, progPointer);
+    const TPG::TPGEdge& edge2 = tpg.cloneEdge(edge1);
+    ASSERT_EQ(tpg.getModifiedEdges(),
+              (std::unordered_set<const TPG::TPGEdge*>{&edge1, &edge2}))
+        << "Added edges are not recorded as modified.";
+
+    tpg.clearModifiedEdges();
+    ASSERT_EQ(tpg.getModifiedEdges().size(), 0)
+        << "Modified edges were not cleared.";
+
+    tpg.setEdgeDestination(edge0, vertex1);
+    tpg.setEdgeSource(edge1, vertex0);
+    ASSERT_EQ(tpg.getModifiedEdges(),
+              (std::unordered_set<const TPG::TPGEdge*>{&edge0, &edge1}))
+        << "Redirected edges are not recorded as modified.";
+
+    // Removed edges are forgotten.
+    tpg.removeEdge(edge1);
+    ASSERT_EQ(tpg.getModifiedEdges(),
+              (std::unordered_set<const TPG::TPGEdge*>{&edge0}))
+        << "Removed edge is still recorded as modified.";
+
+    tpg.setEdgeTracking(false);
+    ASSERT_EQ(tpg.getModifiedEdges().size(), 0)
+        << "Disabling the tracking should clear the modified edges.";
+    tpg.cloneEdge(edge0);
+    ASSERT_EQ(tpg.getModifiedEdges().size(), 0)
+        << "Modified edges should not be recorded without tracking.";
+}
+
 TEST_F(TPGTest, TPGMoveOperator)
 {
     TPG::TPGGraph source(*e);
@@ -0,0 +1,146 @@
+/**
+ * Copyright or © or Copr. IETR/INSA - Rennes (2026) :
+ *
+ * Karol Desnos <kdesnos@insa-rennes.fr> (2026)
+ *
+ * GEGELATI is an open-source reinforcement learning framework for training
+ * artificial intelligence based on Tangled Program Graphs (TPGs).
+ *
+ * This software is governed by the CeCILL-C license under French law and
+ * abiding by the rules of distribution of free software. You can use,
+ * modify and/ or redistribute the software under the terms of the CeCILL-C
+ * license as circulated by CEA, CNRS and INRIA at the following URL
+ * "http://www.cecill.info".
+ *
+ * As a counterpart to the access to the source code and rights to copy,
+ * modify and redistribute granted by the license, users are provided only
+ * with a limited warranty and the software's author, the holder of the
+ * economic rights, and the successive licensors have only limited
+ * liability.
+ *
+ * In this respect, the user's attention is drawn to the risks associated
+ * with loading, using, modifying and/or developing or reproducing the
+ * software by the user in light of its specific status of free software,
+ * that may mean that it is complicated to manipulate, and that also
+ * therefore means that it is reserved for developers and experienced
+ * professionals having in-depth computer knowledge. Users are therefore
+ * encouraged to load and test the software's suitability as regards their
+ * requirements in conditions enabling the security of their systems and/or
+ * data to be ensured and, more generally, to use and operate it in the
+ * same conditions as regards security.
+ *
+ * The fact that you are presently reading this means that you have had
+ * knowledge of the CeCILL-C license and that you accept its terms.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "instructions/addPrimitiveType.h"
+#include "learn/learningAgent.h"
+#include "learn/stickGameWithOpponent.h"
+#include "log/traceRecorder.h"
+
+TEST(TraceRecorderTest, RecordSpans)
+{
+    Log::TraceRecorder& recorder = Log::TraceRecorder::getInstance();
+    recorder.disable();
+    recorder.clear();
+
+    // Disabled recorder
+    {
+        Log::TraceSpan span("disabled");
+    }
+    ASSERT_EQ(recorder.getNbEvents(), 0)
+        << "A span was recorded while the TraceRecorder is disabled.";
+
+    // Enabled recorder
+    recorder.enable();
+    ASSERT_TRUE(recorder.isEnabled());
+    {
+        Log::TraceSpan span("mainThread", 3);
+    }
+    ASSERT_EQ(recorder.getNbEvents(), 1)
+        << "A span was not recorded while the TraceRecorder is enabled.";
+
+    // Spans of other threads
+    std::thread thread([]() {
+        Log::TraceSpan span("otherThread");
+        Log::TraceSpan nestedSpan("nested", 4);
+    });
+    thread.join();
+    ASSERT_EQ(recorder.getNbEvents(), 3)
+        << "Spans of another thread were not recorded.";
+    recorder.disable();
+
+    std::stringstream json;
+    ASSERT_NO_THROW(recorder.writeChromeTrace(json));
+    const std::string str = json.str();
+    ASSERT_NE(str.find("\"traceEvents\""), std::string::npos);
+    ASSERT_NE(str.find("\"name\":\"mainThread\""), std::string::npos);
+    ASSERT_NE(str.find("\"args\":{\"job\":3}"), std::string::npos);
+    ASSERT_NE(str.find("\"name\":\"otherThread\""), std::string::npos);
+    ASSERT_NE(str.find("\"args\":{\"job\":4}"), std::string::npos);
+    ASSERT_EQ(str.find("disabled"), std::string::npos);
+
+    // The two threads have different tids
+    ASSERT_NE(str.find("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                       "\"tid\":1"),
+              std::string::npos)
+        << "Spans of the other thread should be in a separate track.";
+
+    // Clear
+    recorder.clear();
+    ASSERT_EQ(recorder.getNbEvents(), 0);
+
+    ASSERT_THROW(recorder.writeChromeTrace("/nonexistent/dir/trace.json"),
+                 std::runtime_error);
+}
+
+TEST(TraceRecorderTest, TrainingSpans)
+{
+    Instructions::Set set;
+    Instructions::AddPrimitiveType<int> addInt;
+    Instructions::AddPrimitiveType<double> addDouble;
+    set.add(addInt);
+    set.add(addDouble);
+    StickGameWithOpponent le;
+    Learn::LearningParameters params;
+    params.mutation.tpg.nbRoots = 10;
+    params.mutation.tpg.maxInitOutgoingEdges = 2;
+    params.maxNbActionsPerEval = 11;
+    params.nbIterationsPerPolicyEvaluation = 1;
+    params.nbThreads = 2;
+    params.doValidation = true;
+
+    Learn::LearningAgent la(le, set, params);
+    la.init();
+
+    Log::TraceRecorder& recorder = Log::TraceRecorder::getInstance();
+    recorder.clear();
+    recorder.enable();
+    ASSERT_NO_THROW(la.trainOneGeneration(0));
+    recorder.disable();
+
+    std::stringstream json;
+    recorder.writeChromeTrace(json);
+#ifdef GEGELATI_TRACE
+    // Spans of all phases are recorded
+    for (const char* name :
+         {"populateTPG", "evaluateAllRoots", "evaluateJob",
+          "decimateWorstRoots", "validation", "logNewGeneration",
+          "logEndOfTraining"}) {
+        ASSERT_NE(json.str().find("\"name\":\"" + std::string(name) + "\""),
+                  std::string::npos)
+            << "Span " << name << " was not recorded.";
+    }
+#else
+    // Tracing is compiled out
+    ASSERT_EQ(recorder.getNbEvents(), 0)
+        << "Spans were recorded although tracing is compiled out.";
+#endif
+    recorder.clear();
+}